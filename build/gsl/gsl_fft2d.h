@@ -0,0 +1 @@
+../../fft/gsl_fft2d.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../fft/gsl_fft3d.h
\ No newline at end of file
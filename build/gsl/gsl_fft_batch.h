@@ -0,0 +1 @@
+../../fft/gsl_fft_batch.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../fft/gsl_fft_cache.h
\ No newline at end of file
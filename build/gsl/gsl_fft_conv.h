@@ -0,0 +1 @@
+../../fft/gsl_fft_conv.h
\ No newline at end of file
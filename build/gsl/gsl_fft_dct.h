@@ -0,0 +1 @@
+../../fft/gsl_fft_dct.h
\ No newline at end of file
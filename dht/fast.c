@@ -0,0 +1,255 @@
+/* dht/fast.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Fast Hankel transform on logarithmically spaced samples
+ * (Talman 1978, Hamilton 2000).
+ *
+ * With x = exp(s), k = exp(r), the transform
+ *
+ *   F(k) = int_0^inf f(x) J_nu(k x) x dx
+ *
+ * becomes the correlation
+ *
+ *   k^(1-q) F(k) = int g(s) K(s + r) ds,
+ *
+ * with g(s) = x^(1+q) f(x) and K(t) = exp((1-q) t) J_nu(exp(t)).
+ * Taking g to be periodic with the period of the sampled range,
+ * each Fourier mode of g is multiplied by the Mellin transform
+ *
+ *   U(w) = int_0^inf t^(-q+iw) J_nu(t) dt
+ *        = 2^(-q+iw) Gamma((nu+1-q+iw)/2) / Gamma((nu+1+q-iw)/2),
+ *
+ * so the transform costs one real and one halfcomplex FFT. The
+ * bias q moves power between the two ends of the range, and
+ * must satisfy -1/2 < q < nu+1 for U to exist.
+ */
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_sf_gamma.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_dht.h>
+
+
+gsl_dht_fast *
+gsl_dht_fast_alloc (size_t size)
+{
+  gsl_dht_fast * t;
+
+  if(size < 2) {
+    GSL_ERROR_VAL("size must be at least 2", GSL_EDOM, 0);
+  }
+
+  t = (gsl_dht_fast *)calloc(1, sizeof(gsl_dht_fast));
+
+  if(t == 0) {
+    GSL_ERROR_VAL("out of memory", GSL_ENOMEM, 0);
+  }
+
+  t->size = size;
+  t->nu   = -1.0;
+
+  t->u = (double *)malloc(size*sizeof(double));
+  t->real_wavetable = gsl_fft_real_wavetable_alloc(size);
+  t->hc_wavetable = gsl_fft_halfcomplex_wavetable_alloc(size);
+  t->work = gsl_fft_real_workspace_alloc(size);
+
+  if(t->u == 0 || t->real_wavetable == 0 || t->hc_wavetable == 0 || t->work == 0) {
+    gsl_dht_fast_free(t);
+    GSL_ERROR_VAL("could not allocate memory for fast transform", GSL_ENOMEM, 0);
+  }
+
+  return t;
+}
+
+
+/* ln|U(w)| and arg U(w) for the Mellin transform of J_nu */
+static int
+dht_fast_mellin(double nu, double q, double w, double * lnr, double * arg)
+{
+  gsl_sf_result lnr1, arg1, lnr2, arg2;
+  int stat1 = gsl_sf_lngamma_complex_e(0.5*(nu + 1.0 - q),  0.5*w, &lnr1, &arg1);
+  int stat2 = gsl_sf_lngamma_complex_e(0.5*(nu + 1.0 + q), -0.5*w, &lnr2, &arg2);
+
+  *lnr = -q * M_LN2 + lnr1.val - lnr2.val;
+  *arg = w * M_LN2 + arg1.val - arg2.val;
+
+  return GSL_ERROR_SELECT_2(stat1, stat2);
+}
+
+
+int
+gsl_dht_fast_init(gsl_dht_fast * t, double nu, double q, double xmin, double xmax)
+{
+  if(xmin <= 0.0 || xmax <= xmin) {
+    GSL_ERROR ("must have 0 < xmin < xmax", GSL_EDOM);
+  } else if(nu <= -1.0) {
+    GSL_ERROR ("nu must be greater than -1", GSL_EDOM);
+  } else if(q <= -0.5 || q >= nu + 1.0) {
+    GSL_ERROR ("q must satisfy -1/2 < q < nu + 1", GSL_EDOM);
+  }
+  else {
+    const size_t N = t->size;
+    const double dlnx = log(xmax / xmin) / (N - 1.0);
+    const double dw = 2.0 * M_PI / (N * dlnx);
+    double kappa = -(N - 1.0) * dlnx; /* ln(x_0 k_0), centred on x k = 1 */
+    double lnr, arg;
+    int stat = 0;
+    size_t m;
+
+    if(N % 2 == 0) {
+      /* Shift kappa by less than half a sample so that the Nyquist
+       * coefficient U(w) exp(-i w kappa) is real, which removes the
+       * ringing caused by the ambiguous sign of the Nyquist frequency.
+       */
+      const double wN = 0.5 * N * dw;
+      double jpi;
+
+      stat += dht_fast_mellin(nu, q, wN, &lnr, &arg);
+      jpi = M_PI * floor((arg - wN * kappa) / M_PI + 0.5);
+      kappa = (arg - jpi) / wN;
+    }
+
+    t->nu     = nu;
+    t->q      = q;
+    t->dlnx   = dlnx;
+    t->lnxmin = log(xmin);
+    t->lnkmin = kappa - t->lnxmin;
+
+    /* u_m = U(w_m) exp(-i w_m kappa) / N in halfcomplex order */
+    for(m=0; 2*m <= N; m++) {
+      const double w = m * dw;
+      double mag, phase;
+
+      stat += dht_fast_mellin(nu, q, w, &lnr, &arg);
+      mag   = exp(lnr) / N;
+      phase = arg - w * kappa;
+
+      if(m == 0) {
+        t->u[0] = mag;
+      }
+      else if(2*m == N) {
+        t->u[N-1] = mag * cos(phase);
+      }
+      else {
+        t->u[2*m-1] = mag * cos(phase);
+        t->u[2*m]   = mag * sin(phase);
+      }
+    }
+
+    if(stat != 0) {
+      GSL_ERROR("error computing gamma function", GSL_EFAILED);
+    }
+    else {
+      return GSL_SUCCESS;
+    }
+  }
+}
+
+
+double gsl_dht_fast_x_sample(const gsl_dht_fast * t, int n)
+{
+  return exp(t->lnxmin + n * t->dlnx);
+}
+
+
+double gsl_dht_fast_k_sample(const gsl_dht_fast * t, int n)
+{
+  return exp(t->lnkmin + n * t->dlnx);
+}
+
+
+void gsl_dht_fast_free(gsl_dht_fast * t)
+{
+  RETURN_IF_NULL (t);
+  if(t->work) gsl_fft_real_workspace_free(t->work);
+  if(t->hc_wavetable) gsl_fft_halfcomplex_wavetable_free(t->hc_wavetable);
+  if(t->real_wavetable) gsl_fft_real_wavetable_free(t->real_wavetable);
+  free(t->u);
+  free(t);
+}
+
+
+/* Transform from samples on the grid exp(lna + n dlnx) to samples on
+ * the grid exp(lnb + n dlnx). The correlation only depends on
+ * lna + lnb, so the inverse transform uses the same coefficients
+ * with the roles of the grids exchanged.
+ */
+static int
+dht_fast_transform(gsl_dht_fast * t, double lna, double lnb,
+                   const double * f_in, double * f_out)
+{
+  const size_t N = t->size;
+  const double * u = t->u;
+  size_t j, m;
+  int status;
+
+  if(t->nu <= -1.0) {
+    GSL_ERROR("transform is not initialized", GSL_EINVAL);
+  }
+
+  for(j=0; j<N; j++) {
+    f_out[j] = f_in[j] * exp((1.0 + t->q) * (lna + j * t->dlnx));
+  }
+
+  status = gsl_fft_real_transform(f_out, 1, N, t->real_wavetable, t->work);
+  if(status) return status;
+
+  /* multiply by u_m and conjugate, so that the backward transform
+   * computes the sum over exp(-i w_m (s + r)) of the correlation
+   */
+  f_out[0] *= u[0];
+
+  for(m=1; 2*m < N; m++) {
+    const double a_re = f_out[2*m-1];
+    const double a_im = f_out[2*m];
+    f_out[2*m-1] =   a_re * u[2*m-1] - a_im * u[2*m];
+    f_out[2*m]   = -(a_re * u[2*m]   + a_im * u[2*m-1]);
+  }
+
+  if(N % 2 == 0) {
+    f_out[N-1] *= u[N-1];
+  }
+
+  status = gsl_fft_halfcomplex_transform(f_out, 1, N, t->hc_wavetable, t->work);
+  if(status) return status;
+
+  for(j=0; j<N; j++) {
+    f_out[j] *= exp(-(1.0 - t->q) * (lnb + j * t->dlnx));
+  }
+
+  return GSL_SUCCESS;
+}
+
+
+int
+gsl_dht_fast_apply(gsl_dht_fast * t, const double * f_in, double * f_out)
+{
+  return dht_fast_transform(t, t->lnxmin, t->lnkmin, f_in, f_out);
+}
+
+
+int
+gsl_dht_fast_inverse(gsl_dht_fast * t, const double * F_in, double * f_out)
+{
+  return dht_fast_transform(t, t->lnkmin, t->lnxmin, F_in, f_out);
+}
@@ -22,6 +22,10 @@
 #ifndef __GSL_DHT_H__
 #define __GSL_DHT_H__
 
+#include <stddef.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+
 #undef __BEGIN_DECLS
 #undef __END_DECLS
 #ifdef __cplusplus
@@ -82,6 +86,55 @@ void gsl_dht_free(gsl_dht * t);
 int gsl_dht_apply(const gsl_dht * t, double * f_in, double * f_out);
 
 
+/* Fast Hankel transform on logarithmically spaced samples,
+ * computed with two FFTs in O(size log size) operations and
+ * O(size) memory.
+ */
+struct gsl_dht_fast_struct {
+  size_t    size;   /* size of the sample arrays to be transformed    */
+  double    nu;     /* Bessel function order                          */
+  double    q;      /* power law bias exponent                        */
+  double    lnxmin; /* log of the first x sample                      */
+  double    lnkmin; /* log of the first k sample                      */
+  double    dlnx;   /* logarithmic spacing of the samples             */
+  double *  u;      /* kernel coefficients, halfcomplex order         */
+  gsl_fft_real_wavetable *        real_wavetable;
+  gsl_fft_halfcomplex_wavetable * hc_wavetable;
+  gsl_fft_real_workspace *        work;
+};
+typedef struct gsl_dht_fast_struct gsl_dht_fast;
+
+
+/* Create a new fast transform object for a given size.
+ */
+gsl_dht_fast * gsl_dht_fast_alloc(size_t size);
+
+/* Initialize a fast transform of order nu for samples
+ * x_n = xmin (xmax/xmin)^(n/(size-1)), with bias exponent q.
+ * The k samples have the same spacing, and are chosen near
+ * k_n x_{size-1-n} = 1 so as to minimize ringing.
+ */
+int gsl_dht_fast_init(gsl_dht_fast * t, double nu, double q,
+                      double xmin, double xmax);
+
+/* The n'th x and k sample points of a fast transform.
+ * 0 <= n <= size-1
+ */
+double gsl_dht_fast_x_sample(const gsl_dht_fast * t, int n);
+double gsl_dht_fast_k_sample(const gsl_dht_fast * t, int n);
+
+/* Free a fast transform object.
+ */
+void gsl_dht_fast_free(gsl_dht_fast * t);
+
+/* Transform samples f(x_n) into samples F(k_n), and the inverse
+ * transform of samples F(k_n) back to samples f(x_n).
+ * f_in and f_out may be the same array.
+ */
+int gsl_dht_fast_apply(gsl_dht_fast * t, const double * f_in, double * f_out);
+int gsl_dht_fast_inverse(gsl_dht_fast * t, const double * F_in, double * f_out);
+
+
 __END_DECLS
 
 #endif /* __GSL_DHT_H__ */
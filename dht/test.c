@@ -23,8 +23,11 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
 #include <gsl/gsl_ieee_utils.h>
 #include <gsl/gsl_test.h>
+#include <gsl/gsl_sf_bessel.h>
 #include <gsl/gsl_dht.h>
 
 
@@ -180,6 +183,214 @@ test_dht_poly1(void)
 }
 
 
+/* Maximum error of a fast transform of f(x) = x^nu exp(-x^2/2),
+ * F(k) = k^nu exp(-k^2/2), over the samples with k1 <= k <= k2.
+ * f is replaced by the inverse transform, and the maximum error
+ * of the round trip over x1 <= x <= x2 is returned in err_inv.
+ */
+static double
+test_dht_fast_gauss_err(gsl_dht_fast * t, double k1, double k2,
+                        double x1, double x2, double * err_inv)
+{
+  const size_t size = t->size;
+  double * f = malloc(size * sizeof(double));
+  double * F = malloc(size * sizeof(double));
+  double err = 0.0;
+  size_t n;
+  int status;
+
+  *err_inv = GSL_POSINF;
+
+  if(f == 0 || F == 0) {
+    gsl_test(1, "Fast DHT allocation size=%zu", size);
+    free(f);
+    free(F);
+    return GSL_POSINF;
+  }
+
+  for(n=0; n<size; n++) {
+    const double x = gsl_dht_fast_x_sample(t, n);
+    f[n] = pow(x, t->nu) * exp(-0.5*x*x);
+  }
+
+  status = gsl_dht_fast_apply(t, f, F);
+  gsl_test(status, "Fast DHT apply size=%zu nu=%g q=%g",
+           size, t->nu, t->q);
+
+  for(n=0; n<size; n++) {
+    const double k = gsl_dht_fast_k_sample(t, n);
+    if(k >= k1 && k <= k2) {
+      err = GSL_MAX(err, fabs(F[n] - pow(k, t->nu) * exp(-0.5*k*k)));
+    }
+  }
+
+  status = gsl_dht_fast_inverse(t, F, F);
+  gsl_test(status, "Fast DHT inverse size=%zu nu=%g q=%g",
+           size, t->nu, t->q);
+
+  *err_inv = 0.0;
+  for(n=0; n<size; n++) {
+    const double x = gsl_dht_fast_x_sample(t, n);
+    if(x >= x1 && x <= x2) {
+      *err_inv = GSL_MAX(*err_inv, fabs(F[n] - f[n]));
+    }
+  }
+
+  free(f);
+  free(F);
+
+  return err;
+}
+
+
+/* Fast transform of a Gaussian. The log-spaced transform assumes
+ * that x^(1+q) f(x) and k^(1-q) F(k) are periodic over the sampled
+ * range, so the error is smallest in the middle of the range and
+ * grows near the ends, where the periodic images of the function
+ * overlap. Here f ~ x^nu at small x, so the range must extend far
+ * enough below the region of interest for x^(nu+1) f to be small.
+ */
+int
+test_dht_fast_gauss(void)
+{
+  int stat = 0;
+  double err, err_inv;
+  gsl_dht_fast * t = gsl_dht_fast_alloc(256);
+
+  /* 256 samples over 12 decades: about 1e-10 in the middle */
+  gsl_dht_fast_init(t, 0.0, 0.0, 1.0e-8, 1.0e4);
+  err = test_dht_fast_gauss_err(t, 1.0e-2, 1.0e2, 1.0e-2, 1.0e2, &err_inv);
+  if(err > 1.0e-9) stat++;
+  if(err_inv > 1.0e-12) stat++;
+
+  gsl_dht_fast_init(t, 1.0, 0.0, 1.0e-8, 1.0e4);
+  err = test_dht_fast_gauss_err(t, 1.0e-2, 1.0e2, 1.0e-2, 1.0e2, &err_inv);
+  if(err > 1.0e-10) stat++;
+  if(err_inv > 1.0e-12) stat++;
+
+  /* A range starting at 1e-4 leaves x f(x) = 1e-4 at the lower end,
+   * so the error rises to 1e-6 in the middle and is of order 1 for
+   * the smallest k, where k^(1-q) F(k) is not small either.
+   */
+  gsl_dht_fast_init(t, 0.0, 0.0, 1.0e-4, 1.0e4);
+  err = test_dht_fast_gauss_err(t, 1.0e-2, 1.0e2, 1.0e-2, 1.0e2, &err_inv);
+  if(err > 1.0e-5) stat++;
+
+  /* A bias q > 0 makes x^(1+q) f decay faster at small x, but
+   * k^(1-q) F(k) decays slower at small k, which costs accuracy
+   * here since F(0) != 0.
+   */
+  gsl_dht_fast_init(t, 0.0, 0.5, 1.0e-8, 1.0e4);
+  err = test_dht_fast_gauss_err(t, 1.0e-2, 1.0e2, 1.0e-2, 1.0e2, &err_inv);
+  if(err > 1.0e-5) stat++;
+
+  gsl_dht_fast_free(t);
+
+  /* With an odd size there is no Nyquist frequency to adjust the
+   * k samples for, and the ringing is about 50 times larger.
+   */
+  t = gsl_dht_fast_alloc(255);
+  gsl_dht_fast_init(t, 0.0, 0.0, 1.0e-8, 1.0e4);
+  err = test_dht_fast_gauss_err(t, 1.0e-2, 1.0e2, 1.0e-2, 1.0e2, &err_inv);
+  if(err > 1.0e-7) stat++;
+  if(err_inv > 1.0e-12) stat++;
+  gsl_dht_fast_free(t);
+
+  return stat;
+}
+
+
+/* Fast transform of the slowly decaying function of test_dht_simple,
+ * Integrate[x J_0(a x) / (x^2 + 1), {x,0,Inf}] = K_0(a).
+ * Since x f(x) ~ 1/x, the range must extend to large x, but the
+ * log-spaced samples make that cheap: 4096 samples over 12 decades
+ * give 1e-11, where the Bessel zero sampling of gsl_dht gives 2%.
+ */
+int
+test_dht_fast_simple(void)
+{
+  int stat = 0;
+  const size_t size = 4096;
+  size_t n;
+  double err = 0.0;
+  double * f = malloc(size * sizeof(double));
+  gsl_dht_fast * t = gsl_dht_fast_alloc(size);
+
+  if(f == 0 || t == 0) {
+    free(f);
+    gsl_dht_fast_free(t);
+    return 1;
+  }
+
+  gsl_dht_fast_init(t, 0.0, 0.0, 1.0e-6, 1.0e6);
+
+  for(n=0; n<size; n++) {
+    const double x = gsl_dht_fast_x_sample(t, n);
+    f[n] = 1.0/(1.0+x*x);
+  }
+
+  if(gsl_dht_fast_apply(t, f, f) != GSL_SUCCESS) stat++;
+
+  for(n=0; n<size; n++) {
+    const double k = gsl_dht_fast_k_sample(t, n);
+    if(k >= 1.0e-2 && k <= 1.0e2) {
+      err = GSL_MAX(err, fabs(f[n] - gsl_sf_bessel_K0(k)));
+    }
+  }
+
+  if(err > 1.0e-10) stat++;
+
+  gsl_dht_fast_free(t);
+  free(f);
+
+  return stat;
+}
+
+
+/* A large transform, which would need 8 GB for the kernel
+ * matrix of gsl_dht.
+ */
+int
+test_dht_fast_large(void)
+{
+  int stat = 0;
+  double err, err_inv;
+  gsl_dht_fast * t = gsl_dht_fast_alloc(65536);
+
+  gsl_dht_fast_init(t, 1.0, 0.0, 1.0e-10, 1.0e10);
+  err = test_dht_fast_gauss_err(t, 1.0e-4, 1.0e4, 1.0e-4, 1.0e4, &err_inv);
+  if(err > 1.0e-10) stat++;
+  if(err_inv > 1.0e-10) stat++;
+
+  gsl_dht_fast_free(t);
+
+  return stat;
+}
+
+
+/* Invalid parameters */
+int
+test_dht_fast_errors(void)
+{
+  int stat = 0;
+  gsl_error_handler_t * old_handler = gsl_set_error_handler_off();
+  gsl_dht_fast * t = gsl_dht_fast_alloc(16);
+
+  if(gsl_dht_fast_alloc(1) != 0) stat++;
+  if(gsl_dht_fast_apply(t, 0, 0) != GSL_EINVAL) stat++;
+  if(gsl_dht_fast_init(t, 0.0, 0.0, 0.0, 1.0) != GSL_EDOM) stat++;
+  if(gsl_dht_fast_init(t, 0.0, 0.0, 2.0, 1.0) != GSL_EDOM) stat++;
+  if(gsl_dht_fast_init(t, -1.0, 0.0, 1.0, 2.0) != GSL_EDOM) stat++;
+  if(gsl_dht_fast_init(t, 0.0, 1.0, 1.0, 2.0) != GSL_EDOM) stat++;
+  if(gsl_dht_fast_init(t, 0.0, -0.5, 1.0, 2.0) != GSL_EDOM) stat++;
+
+  gsl_dht_fast_free(t);
+  gsl_set_error_handler(old_handler);
+
+  return stat;
+}
+
+
 int main()
 {
   gsl_ieee_env_setup ();
@@ -189,5 +400,10 @@ int main()
   gsl_test( test_dht_exp1(),    "Exp  J1 DHT");
   gsl_test( test_dht_poly1(),   "Poly J1 DHT");
 
+  gsl_test( test_dht_fast_gauss(),  "Fast DHT Gaussian");
+  gsl_test( test_dht_fast_simple(), "Fast DHT K0");
+  gsl_test( test_dht_fast_large(),  "Fast DHT large");
+  gsl_test( test_dht_fast_errors(), "Fast DHT errors");
+
   exit (gsl_test_summary());
 }
@@ -0,0 +1,331 @@
+/* fft/batch.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Batches of howmany transforms of length n, where element j of
+ * transform t is stored at index t*dist + j*stride of the data array
+ * (in units of complex or real elements). Transforms with unit stride
+ * are computed in place one after the other. Strided transforms are
+ * gathered FFT_BATCH_BLOCK at a time into contiguous storage, so that
+ * interleaved batches (dist = 1, stride = howmany) are read and written
+ * in short contiguous runs rather than one element per cache line, and
+ * the mixed-radix passes then run on unit stride data.
+ */
+
+#include <config.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_fft_batch.h>
+
+#define FFT_BATCH_BLOCK 8
+
+typedef enum
+{
+  FFT_BATCH_COMPLEX,
+  FFT_BATCH_COMPLEX_INVERSE,
+  FFT_BATCH_REAL,
+  FFT_BATCH_HALFCOMPLEX,
+  FFT_BATCH_HALFCOMPLEX_INVERSE
+} fft_batch_type;
+
+static int fft_batch (double data[], const size_t stride, const size_t dist,
+                      const size_t n, const size_t howmany,
+                      const void * wavetable, gsl_fft_batch_workspace * w,
+                      const fft_batch_type type, const gsl_fft_direction sign);
+static int fft_batch_one (double x[], const size_t stride, const size_t n,
+                          const void * wavetable, gsl_fft_batch_workspace * w,
+                          const fft_batch_type type, const gsl_fft_direction sign);
+
+/*
+gsl_fft_batch_workspace_alloc()
+  Allocate a workspace for batches of complex, real and halfcomplex
+transforms of length n
+
+Inputs: n - length of each transform
+
+Return: pointer to workspace
+*/
+
+gsl_fft_batch_workspace *
+gsl_fft_batch_workspace_alloc (const size_t n)
+{
+  gsl_fft_batch_workspace *w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("length n must be positive integer", GSL_EDOM);
+    }
+
+  w = calloc (1, sizeof (gsl_fft_batch_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->n = n;
+  w->complex_work = gsl_fft_complex_workspace_alloc (n);
+  w->real_work = gsl_fft_real_workspace_alloc (n);
+  w->buf = malloc (2 * FFT_BATCH_BLOCK * n * sizeof (double));
+
+  if (w->complex_work == NULL || w->real_work == NULL || w->buf == NULL)
+    {
+      gsl_fft_batch_workspace_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_fft_batch_workspace_free (gsl_fft_batch_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->complex_work)
+    gsl_fft_complex_workspace_free (w->complex_work);
+
+  if (w->real_work)
+    gsl_fft_real_workspace_free (w->real_work);
+
+  if (w->buf)
+    free (w->buf);
+
+  free (w);
+}
+
+int
+gsl_fft_complex_batch_forward (gsl_complex_packed_array data,
+                               const size_t stride, const size_t dist,
+                               const size_t n, const size_t howmany,
+                               const gsl_fft_complex_wavetable * wavetable,
+                               gsl_fft_batch_workspace * w)
+{
+  return fft_batch (data, stride, dist, n, howmany, wavetable, w,
+                    FFT_BATCH_COMPLEX, gsl_fft_forward);
+}
+
+int
+gsl_fft_complex_batch_backward (gsl_complex_packed_array data,
+                                const size_t stride, const size_t dist,
+                                const size_t n, const size_t howmany,
+                                const gsl_fft_complex_wavetable * wavetable,
+                                gsl_fft_batch_workspace * w)
+{
+  return fft_batch (data, stride, dist, n, howmany, wavetable, w,
+                    FFT_BATCH_COMPLEX, gsl_fft_backward);
+}
+
+int
+gsl_fft_complex_batch_inverse (gsl_complex_packed_array data,
+                               const size_t stride, const size_t dist,
+                               const size_t n, const size_t howmany,
+                               const gsl_fft_complex_wavetable * wavetable,
+                               gsl_fft_batch_workspace * w)
+{
+  return fft_batch (data, stride, dist, n, howmany, wavetable, w,
+                    FFT_BATCH_COMPLEX_INVERSE, gsl_fft_backward);
+}
+
+int
+gsl_fft_complex_batch_transform (gsl_complex_packed_array data,
+                                 const size_t stride, const size_t dist,
+                                 const size_t n, const size_t howmany,
+                                 const gsl_fft_complex_wavetable * wavetable,
+                                 gsl_fft_batch_workspace * w,
+                                 const gsl_fft_direction sign)
+{
+  return fft_batch (data, stride, dist, n, howmany, wavetable, w,
+                    FFT_BATCH_COMPLEX, sign);
+}
+
+int
+gsl_fft_real_batch_transform (double data[], const size_t stride,
+                              const size_t dist, const size_t n,
+                              const size_t howmany,
+                              const gsl_fft_real_wavetable * wavetable,
+                              gsl_fft_batch_workspace * w)
+{
+  return fft_batch (data, stride, dist, n, howmany, wavetable, w,
+                    FFT_BATCH_REAL, gsl_fft_forward);
+}
+
+int
+gsl_fft_halfcomplex_batch_backward (double data[], const size_t stride,
+                                    const size_t dist, const size_t n,
+                                    const size_t howmany,
+                                    const gsl_fft_halfcomplex_wavetable * wavetable,
+                                    gsl_fft_batch_workspace * w)
+{
+  return fft_batch (data, stride, dist, n, howmany, wavetable, w,
+                    FFT_BATCH_HALFCOMPLEX, gsl_fft_backward);
+}
+
+int
+gsl_fft_halfcomplex_batch_inverse (double data[], const size_t stride,
+                                   const size_t dist, const size_t n,
+                                   const size_t howmany,
+                                   const gsl_fft_halfcomplex_wavetable * wavetable,
+                                   gsl_fft_batch_workspace * w)
+{
+  return fft_batch (data, stride, dist, n, howmany, wavetable, w,
+                    FFT_BATCH_HALFCOMPLEX_INVERSE, gsl_fft_backward);
+}
+
+int
+gsl_fft_halfcomplex_batch_transform (double data[], const size_t stride,
+                                     const size_t dist, const size_t n,
+                                     const size_t howmany,
+                                     const gsl_fft_halfcomplex_wavetable * wavetable,
+                                     gsl_fft_batch_workspace * w)
+{
+  return fft_batch (data, stride, dist, n, howmany, wavetable, w,
+                    FFT_BATCH_HALFCOMPLEX, gsl_fft_backward);
+}
+
+/*
+fft_batch()
+  Compute a batch of transforms
+
+Inputs: data      - array of howmany transforms
+        stride    - distance between elements of a transform
+        dist      - distance between first elements of consecutive transforms
+        n         - length of each transform
+        howmany   - number of transforms
+        wavetable - wavetable of length n of the given type
+        w         - workspace of length n
+        type      - type of transform
+        sign      - direction of complex transforms
+
+Notes:
+1) stride and dist are in units of complex elements for complex
+transforms and real elements otherwise
+*/
+
+static int
+fft_batch (double data[], const size_t stride, const size_t dist,
+           const size_t n, const size_t howmany,
+           const void * wavetable, gsl_fft_batch_workspace * w,
+           const fft_batch_type type, const gsl_fft_direction sign)
+{
+  /* number of doubles per element */
+  const size_t width = (type == FFT_BATCH_COMPLEX ||
+                        type == FFT_BATCH_COMPLEX_INVERSE) ? 2 : 1;
+  size_t t, tt, j, k;
+  int status;
+
+  if (n == 0)
+    {
+      GSL_ERROR ("length n must be positive integer", GSL_EDOM);
+    }
+  else if (stride == 0)
+    {
+      GSL_ERROR ("stride must be positive integer", GSL_EINVAL);
+    }
+  else if (n != w->n)
+    {
+      GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
+    }
+
+  if (stride == 1)
+    {
+      for (t = 0; t < howmany; ++t)
+        {
+          status = fft_batch_one (data + width * t * dist, 1, n, wavetable, w,
+                                  type, sign);
+          if (status)
+            return status;
+        }
+
+      return GSL_SUCCESS;
+    }
+
+  for (t = 0; t < howmany; t += FFT_BATCH_BLOCK)
+    {
+      const size_t nb = GSL_MIN (FFT_BATCH_BLOCK, howmany - t);
+
+      /* gather block of transforms into buf, element by element so that
+         interleaved transforms are read contiguously */
+      for (j = 0; j < n; ++j)
+        {
+          for (tt = 0; tt < nb; ++tt)
+            {
+              const double *x = data + width * ((t + tt) * dist + j * stride);
+
+              for (k = 0; k < width; ++k)
+                w->buf[width * (tt * n + j) + k] = x[k];
+            }
+        }
+
+      for (tt = 0; tt < nb; ++tt)
+        {
+          status = fft_batch_one (w->buf + width * tt * n, 1, n, wavetable, w,
+                                  type, sign);
+          if (status)
+            return status;
+        }
+
+      /* scatter back */
+      for (j = 0; j < n; ++j)
+        {
+          for (tt = 0; tt < nb; ++tt)
+            {
+              double *x = data + width * ((t + tt) * dist + j * stride);
+
+              for (k = 0; k < width; ++k)
+                x[k] = w->buf[width * (tt * n + j) + k];
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+static int
+fft_batch_one (double x[], const size_t stride, const size_t n,
+               const void * wavetable, gsl_fft_batch_workspace * w,
+               const fft_batch_type type, const gsl_fft_direction sign)
+{
+  switch (type)
+    {
+      case FFT_BATCH_COMPLEX:
+        return gsl_fft_complex_transform (x, stride, n, wavetable,
+                                          w->complex_work, sign);
+
+      case FFT_BATCH_COMPLEX_INVERSE:
+        return gsl_fft_complex_inverse (x, stride, n, wavetable,
+                                        w->complex_work);
+
+      case FFT_BATCH_REAL:
+        return gsl_fft_real_transform (x, stride, n, wavetable, w->real_work);
+
+      case FFT_BATCH_HALFCOMPLEX:
+        return gsl_fft_halfcomplex_transform (x, stride, n, wavetable,
+                                              w->real_work);
+
+      case FFT_BATCH_HALFCOMPLEX_INVERSE:
+        return gsl_fft_halfcomplex_inverse (x, stride, n, wavetable,
+                                            w->real_work);
+
+      default:
+        GSL_ERROR ("unknown transform type", GSL_EINVAL);
+    }
+}
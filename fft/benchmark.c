@@ -21,133 +21,209 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
-#include <float.h>
 
 #include <time.h>
 
 #include <gsl/gsl_complex.h>
 #include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_complex_float.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_real_float.h>
 
 #include <gsl/gsl_errno.h>
 
 #include "complex_internal.h"
-#include "bitreverse.h"
 #include "urand.c"
 
+/* Time the complex transforms for the length given on the command
+   line, or for the powers of 2 from 2^10 to 2^24, in double and
+   single precision. The speed is reported in GFLOP/s using the
+   nominal 5 n log2(n) operation count of a radix-2 transform (half
+   of that for real data), so that different lengths, algorithms and
+   precisions can be compared. */
+
 void my_error_handler (const char *reason, const char *file,
                        int line, int err);
 
+static double time_mixed_radix (double *data, const size_t n);
+static double time_radix2 (double *data, const size_t n);
+static double time_mixed_radix_float (float *data, const size_t n);
+static double time_real (double *data, const size_t n);
+static double time_real_float (float *data, const size_t n);
+
 int
 main (int argc, char *argv[])
 {
-  double *data, *fft_data;
-  gsl_fft_complex_wavetable * cw;
-  unsigned int i, logn;
-  int result;
-  int status;
-  clock_t start, end;
-  int resolution = CLOCKS_PER_SEC;
-  unsigned int n = 1;
+  size_t n, nmin = 1 << 10, nmax = 1 << 24;
 
   gsl_set_error_handler (&my_error_handler);
 
   if (argc == 2)
     {
-      n = strtol (argv[1], NULL, 0);
+      nmin = nmax = strtol (argv[1], NULL, 0);
     }
-  else
+
+  for (n = nmin; n <= nmax; n *= 2)
     {
-      printf ("test n\n");
-      exit (EXIT_FAILURE);
+      const double flops = 5.0 * n * log ((double) n) / log (2.0);
+      double *data = (double *) malloc (n * 2 * sizeof (double));
+      float *fdata = (float *) malloc (n * 2 * sizeof (float));
+      double t;
+      size_t i;
+
+      for (i = 0; i < n; i++)
+        {
+          REAL(data,1,i) = urand ();
+          IMAG(data,1,i) = urand ();
+          REAL(fdata,1,i) = (float) REAL(data,1,i);
+          IMAG(fdata,1,i) = (float) IMAG(data,1,i);
+        }
+
+      t = time_mixed_radix (data, n);
+      printf ("n = %lu gsl_fft_complex_forward %g seconds %.2f GFLOP/s\n",
+              (unsigned long) n, t, 1.0e-9 * flops / t);
+
+      t = time_mixed_radix_float (fdata, n);
+      printf ("n = %lu gsl_fft_complex_float_forward %g seconds %.2f GFLOP/s\n",
+              (unsigned long) n, t, 1.0e-9 * flops / t);
+
+      if ((n & (n - 1)) == 0)
+        {
+          t = time_radix2 (data, n);
+          printf ("n = %lu gsl_fft_complex_radix2_forward %g seconds %.2f GFLOP/s\n",
+                  (unsigned long) n, t, 1.0e-9 * flops / t);
+        }
+
+      t = time_real (data, n);
+      printf ("n = %lu gsl_fft_real_transform %g seconds %.2f GFLOP/s\n",
+              (unsigned long) n, t, 0.5e-9 * flops / t);
+
+      t = time_real_float (fdata, n);
+      printf ("n = %lu gsl_fft_real_float_transform %g seconds %.2f GFLOP/s\n",
+              (unsigned long) n, t, 0.5e-9 * flops / t);
+
+      free (data);
+      free (fdata);
+
+      if (n == nmax)
+        break;
     }
 
-  cw = gsl_fft_complex_wavetable_alloc (n);
-  cwork = gsl_fft_complex_wavetable_workspace_alloc (n);
-  status = gsl_fft_complex_init (n, cw, cwork);
-  status = gsl_fft_complex_generate (n, cw, cwork);
+  return 0;
+}
 
-  data = (double *) malloc (n * 2 * sizeof (double));
-  fft_data = (double *) malloc (n * 2 * sizeof (double));
+static double
+time_mixed_radix (double *data, const size_t n)
+{
+  gsl_fft_complex_wavetable * cw = gsl_fft_complex_wavetable_alloc (n);
+  gsl_fft_complex_workspace * cwork = gsl_fft_complex_workspace_alloc (n);
+  clock_t start, end;
+  size_t i = 0;
 
-  for (i = 0; i < n; i++)
+  start = clock ();
+  do
     {
-      REAL(data,1,i) = urand ();
-      IMAG(data,1,i) = urand ();
+      gsl_fft_complex_forward (data, 1, n, cw, cwork);
+      i++;
+      end = clock ();
     }
+  while (end < start + CLOCKS_PER_SEC);
 
+  gsl_fft_complex_wavetable_free (cw);
+  gsl_fft_complex_workspace_free (cwork);
 
-  /* compute the fft */
+  return (end - start) / ((double) i) / ((double) CLOCKS_PER_SEC);
+}
 
-  memcpy (fft_data, data, n * 2 * sizeof (double));
+static double
+time_mixed_radix_float (float *data, const size_t n)
+{
+  gsl_fft_complex_wavetable_float * cw = gsl_fft_complex_wavetable_float_alloc (n);
+  gsl_fft_complex_workspace_float * cwork = gsl_fft_complex_workspace_float_alloc (n);
+  clock_t start, end;
+  size_t i = 0;
 
   start = clock ();
-  i = 0;
   do
     {
-      status = gsl_fft_complex_forward (fft_data, 1, n, cw, cwork);
+      gsl_fft_complex_float_forward (data, 1, n, cw, cwork);
       i++;
       end = clock ();
     }
-  while (end < start + resolution && status == 0);
+  while (end < start + CLOCKS_PER_SEC);
 
-  if (status == 0)
-    {
-      printf ("n = %d gsl_fft_complex_forward %f seconds\n", n, (end - start) / ((double) i) / ((double) CLOCKS_PER_SEC));
-    }
-  else
+  gsl_fft_complex_wavetable_float_free (cw);
+  gsl_fft_complex_workspace_float_free (cwork);
+
+  return (end - start) / ((double) i) / ((double) CLOCKS_PER_SEC);
+}
+
+static double
+time_real (double *data, const size_t n)
+{
+  gsl_fft_real_wavetable * rw = gsl_fft_real_wavetable_alloc (n);
+  gsl_fft_real_workspace * rwork = gsl_fft_real_workspace_alloc (n);
+  clock_t start, end;
+  size_t i = 0;
+
+  start = clock ();
+  do
     {
-      printf ("MR fft failed\n");
+      gsl_fft_real_transform (data, 1, n, rw, rwork);
+      i++;
+      end = clock ();
     }
+  while (end < start + CLOCKS_PER_SEC);
 
+  gsl_fft_real_wavetable_free (rw);
+  gsl_fft_real_workspace_free (rwork);
 
-  /* compute the fft with radix2 */
-  memcpy (fft_data, data, n * 2 * sizeof (double));
-
-  result = fft_binary_logn(n) ;
+  return (end - start) / ((double) i) / ((double) CLOCKS_PER_SEC);
+}
 
-  if (result == -1) {
-    exit(EXIT_SUCCESS) ;
-  } else {
-    logn = result ;
-  }
+static double
+time_real_float (float *data, const size_t n)
+{
+  gsl_fft_real_wavetable_float * rw = gsl_fft_real_wavetable_float_alloc (n);
+  gsl_fft_real_workspace_float * rwork = gsl_fft_real_workspace_float_alloc (n);
+  clock_t start, end;
+  size_t i = 0;
 
   start = clock ();
-  i = 0;
   do
     {
-      status = gsl_fft_complex_radix2_forward (fft_data, 1, n);
+      gsl_fft_real_float_transform (data, 1, n, rw, rwork);
       i++;
       end = clock ();
     }
-  while (end < start + resolution && status == 0);
+  while (end < start + CLOCKS_PER_SEC);
 
-  if (status == 0)
-    {
-      printf ("n = %d gsl_fft_complex_radix2_forward %f seconds\n", n, (end - start) / ((double) i) / ((double) CLOCKS_PER_SEC));
-    }
-  else
-    {
-      printf ("fft_radix2: not a power of 2\n");
-    }
+  gsl_fft_real_wavetable_float_free (rw);
+  gsl_fft_real_workspace_float_free (rwork);
+
+  return (end - start) / ((double) i) / ((double) CLOCKS_PER_SEC);
+}
+
+static double
+time_radix2 (double *data, const size_t n)
+{
+  clock_t start, end;
+  size_t i = 0;
 
   start = clock ();
-  i = 0;
   do
     {
-      status = fft_complex_bitreverse_order (fft_data, 1, n, logn);
+      gsl_fft_complex_radix2_forward (data, 1, n);
       i++;
       end = clock ();
     }
-  while (end < start + resolution && status == 0);
-
-  printf ("n = %d gsl_fft_complex_bitreverse_order %f seconds\n", n, (end - start) / ((double) i) / ((double) CLOCKS_PER_SEC));
-
+  while (end < start + CLOCKS_PER_SEC);
 
-  return 0;
+  return (end - start) / ((double) i) / ((double) CLOCKS_PER_SEC);
 }
 
-
 void
 my_error_handler (const char *reason, const char *file, int line, int err)
 {
@@ -0,0 +1,216 @@
+/* fft/c_bluestein.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Bluestein's algorithm for a DFT of prime length f. Using
+
+   j k = (j^2 + k^2 - (k - j)^2) / 2
+
+   the transform can be written as
+
+   X_k = w_k sum_j (x_j w_j) conj(w_(k-j)),   w_j = exp(-i pi j^2 / f)
+
+   which is a cyclic convolution of length M >= 2f-1. M is chosen to be
+   a power of 2, so the convolution is computed in O(M log M) with the
+   radix-2/4 transforms of the mixed-radix code, and the transform of
+   the filter conj(w) is precomputed in the wavetable. */
+
+static int
+FUNCTION(fft_complex,bluestein_init) (const size_t f,
+                                      TYPE(gsl_complex) ** chirp,
+                                      TYPE(gsl_complex) ** filter,
+                                      TYPE(gsl_fft_complex_wavetable) ** conv)
+{
+  const size_t m = fft_bluestein_length (f);
+  size_t j, s;
+  double *h;
+
+  *chirp = (TYPE(gsl_complex) *) malloc ((f + m) * sizeof (TYPE(gsl_complex)));
+
+  if (*chirp == NULL)
+    {
+      GSL_ERROR ("failed to allocate chirp", GSL_ENOMEM);
+    }
+
+  *filter = *chirp + f;
+
+  /* the filter is computed in double precision for both types */
+
+  h = (double *) calloc (2 * m, sizeof (double));
+
+  if (h == NULL)
+    {
+      free (*chirp);
+      *chirp = NULL;
+      GSL_ERROR ("failed to allocate filter", GSL_ENOMEM);
+    }
+
+  *conv = FUNCTION(gsl_fft_complex_wavetable,alloc) (m);
+
+  if (*conv == NULL)
+    {
+      free (h);
+      free (*chirp);
+      *chirp = NULL;
+      GSL_ERROR ("failed to allocate convolution wavetable", GSL_ENOMEM);
+    }
+
+  /* s = j^2 mod 2f, computed incrementally to avoid overflow and loss
+     of accuracy in the phase for large f */
+
+  s = 0;
+
+  for (j = 0; j < f; j++)
+    {
+      const double theta = M_PI * (double) s / (double) f;
+      const double c = cos (theta);
+      const double d = sin (theta);
+
+      GSL_REAL((*chirp)[j]) = c;
+      GSL_IMAG((*chirp)[j]) = -d;
+
+      /* filter conj(w_j), wrapped around for negative j */
+
+      h[2 * j] = c;
+      h[2 * j + 1] = d;
+
+      if (j > 0)
+        {
+          h[2 * (m - j)] = c;
+          h[2 * (m - j) + 1] = d;
+        }
+
+      s += 2 * j + 1;
+      s %= 2 * f;
+    }
+
+  gsl_fft_complex_radix2_forward (h, 1, m);
+
+  /* include the 1/m normalization of the inverse convolution */
+
+  for (j = 0; j < m; j++)
+    {
+      GSL_REAL((*filter)[j]) = h[2 * j] / (double) m;
+      GSL_IMAG((*filter)[j]) = h[2 * j + 1] / (double) m;
+    }
+
+  free (h);
+
+  return 0;
+}
+
+static int
+FUNCTION(fft_complex,pass_bluestein) (const BASE in[],
+                                      const size_t istride,
+                                      BASE out[],
+                                      const size_t ostride,
+                                      const gsl_fft_direction sign,
+                                      const size_t factor,
+                                      const size_t product,
+                                      const size_t n,
+                                      const TYPE(gsl_complex) twiddle[],
+                                      const TYPE(gsl_complex) chirp[],
+                                      const TYPE(gsl_complex) filter[],
+                                      const TYPE(gsl_fft_complex_wavetable) * conv,
+                                      BASE scratch[])
+{
+  size_t i, j, k, k1, e;
+
+  const size_t m = n / factor;
+  const size_t q = n / product;
+  const size_t p_1 = product / factor;
+  const size_t nconv = conv->n;
+
+  /* the backward transform is conj(forward(conj(x))) */
+
+  const ATOMIC s = (sign == gsl_fft_forward) ? 1 : -1;
+
+  BASE * const buf = scratch;
+  TYPE(gsl_fft_complex_workspace) work;
+
+  work.n = nconv;
+  work.scratch = scratch + 2 * nconv;
+
+  for (k = 0; k < q; k++)
+    {
+      for (k1 = 0; k1 < p_1; k1++)
+        {
+          i = k * p_1 + k1;
+          j = k * product + k1;
+
+          for (e = 0; e < factor; e++)
+            {
+              const ATOMIC x_real = REAL(in,istride,i + e * m);
+              const ATOMIC x_imag = s * IMAG(in,istride,i + e * m);
+              const ATOMIC w_real = GSL_REAL(chirp[e]);
+              const ATOMIC w_imag = GSL_IMAG(chirp[e]);
+
+              REAL(buf,1,e) = w_real * x_real - w_imag * x_imag;
+              IMAG(buf,1,e) = w_real * x_imag + w_imag * x_real;
+            }
+
+          for (e = factor; e < nconv; e++)
+            {
+              REAL(buf,1,e) = 0;
+              IMAG(buf,1,e) = 0;
+            }
+
+          FUNCTION(gsl_fft_complex,forward) (buf, 1, nconv, conv, &work);
+
+          for (e = 0; e < nconv; e++)
+            {
+              const ATOMIC x_real = REAL(buf,1,e);
+              const ATOMIC x_imag = IMAG(buf,1,e);
+              const ATOMIC h_real = GSL_REAL(filter[e]);
+              const ATOMIC h_imag = GSL_IMAG(filter[e]);
+
+              REAL(buf,1,e) = h_real * x_real - h_imag * x_imag;
+              IMAG(buf,1,e) = h_real * x_imag + h_imag * x_real;
+            }
+
+          FUNCTION(gsl_fft_complex,backward) (buf, 1, nconv, conv, &work);
+
+          for (e = 0; e < factor; e++)
+            {
+              const ATOMIC x_real = REAL(buf,1,e);
+              const ATOMIC x_imag = IMAG(buf,1,e);
+              const ATOMIC w_real = GSL_REAL(chirp[e]);
+              const ATOMIC w_imag = GSL_IMAG(chirp[e]);
+
+              ATOMIC y_real = w_real * x_real - w_imag * x_imag;
+              ATOMIC y_imag = s * (w_real * x_imag + w_imag * x_real);
+
+              if (k > 0 && e > 0)
+                {
+                  const ATOMIC t_real = GSL_REAL(twiddle[(e - 1) * q + k - 1]);
+                  const ATOMIC t_imag = s * GSL_IMAG(twiddle[(e - 1) * q + k - 1]);
+                  const ATOMIC z_real = t_real * y_real - t_imag * y_imag;
+                  const ATOMIC z_imag = t_real * y_imag + t_imag * y_real;
+
+                  y_real = z_real;
+                  y_imag = z_imag;
+                }
+
+              REAL(out,ostride,j + e * p_1) = y_real;
+              IMAG(out,ostride,j + e * p_1) = y_imag;
+            }
+        }
+    }
+
+  return 0;
+}
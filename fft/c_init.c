@@ -53,6 +53,13 @@ FUNCTION(gsl_fft_complex_wavetable,alloc) (size_t n)
 
   wavetable->n = n ;
 
+  for (i = 0; i < 64; i++)
+    {
+      wavetable->chirp[i] = NULL;
+      wavetable->filter[i] = NULL;
+      wavetable->conv[i] = NULL;
+    }
+
   status = fft_complex_factorize (n, &n_factors, wavetable->factor);
 
   if (status)
@@ -109,6 +116,29 @@ FUNCTION(gsl_fft_complex_wavetable,alloc) (size_t n)
                         GSL_ESANITY, 0);
     }
 
+  /* large prime factors are transformed with Bluestein's algorithm */
+
+  for (i = 0; i < n_factors; i++)
+    {
+      if (wavetable->factor[i] > FFT_BLUESTEIN_MIN)
+        {
+          status = FUNCTION(fft_complex,bluestein_init) (wavetable->factor[i],
+                                                         &wavetable->chirp[i],
+                                                         &wavetable->filter[i],
+                                                         &wavetable->conv[i]);
+
+          if (status)
+            {
+              /* exception in constructor, avoid memory leak */
+
+              FUNCTION(gsl_fft_complex_wavetable,free) (wavetable);
+
+              GSL_ERROR_VAL ("failed to initialize Bluestein transform",
+                             GSL_ENOMEM, 0);
+            }
+        }
+    }
+
   return wavetable;
 }
 
@@ -133,7 +163,11 @@ FUNCTION(gsl_fft_complex_workspace,alloc) (size_t n)
 
   workspace->n = n ;
 
-  workspace->scratch = (BASE *) malloc (2 * n * sizeof (BASE));
+  /* the Bluestein passes need space for a convolution buffer and the
+     scratch space of its transform after the main scratch array */
+
+  workspace->scratch = (BASE *) malloc ((2 * n + 4 * fft_complex_bluestein_size (n))
+                                        * sizeof (BASE));
 
   if (workspace->scratch == NULL)
     {
@@ -149,7 +183,18 @@ FUNCTION(gsl_fft_complex_workspace,alloc) (size_t n)
 void
 FUNCTION(gsl_fft_complex_wavetable,free) (TYPE(gsl_fft_complex_wavetable) * wavetable)
 {
+  size_t i;
+
   RETURN_IF_NULL (wavetable);
+
+  /* release Bluestein tables */
+
+  for (i = 0; i < wavetable->nf; i++)
+    {
+      free (wavetable->chirp[i]);
+      FUNCTION(gsl_fft_complex_wavetable,free) (wavetable->conv[i]);
+    }
+
   /* release trigonometric lookup tables */
 
   free (wavetable->trig);
@@ -189,6 +234,16 @@ FUNCTION(gsl_fft_complex,memcpy) (TYPE(gsl_fft_complex_wavetable) * dest,
   for (i = 0 ; i < nf ; i++)
     {
       dest->twiddle[i] = dest->trig + (src->twiddle[i] - src->trig) ;
+
+      if (src->chirp[i] != NULL)
+        {
+          const size_t f = src->factor[i];
+          const size_t m = src->conv[i]->n;
+
+          memcpy(dest->chirp[i], src->chirp[i],
+                 (f + m) * sizeof (TYPE(gsl_complex))) ;
+          FUNCTION(gsl_fft_complex,memcpy) (dest->conv[i], src->conv[i]) ;
+        }
     }
 
   return 0 ;
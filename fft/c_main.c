@@ -201,6 +201,16 @@ FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data,
                                         twiddle3, twiddle4, twiddle5, 
                                         twiddle6);
         }
+      else if (wavetable->chirp[i] != NULL)
+        {
+          twiddle1 = wavetable->twiddle[i];
+          FUNCTION(fft_complex,pass_bluestein) (in, istride, out, ostride, sign,
+                                                factor, product, n, twiddle1,
+                                                wavetable->chirp[i],
+                                                wavetable->filter[i],
+                                                wavetable->conv[i],
+                                                scratch + 2 * n);
+        }
       else
         {
           twiddle1 = wavetable->twiddle[i];
@@ -104,3 +104,17 @@ FUNCTION(fft_complex,pass_n) (BASE in[],
                               const size_t n,
                               const TYPE(gsl_complex) twiddle[]);
 
+static int
+FUNCTION(fft_complex,pass_bluestein) (const BASE in[],
+                                      const size_t istride,
+                                      BASE out[],
+                                      const size_t ostride,
+                                      const gsl_fft_direction sign,
+                                      const size_t factor,
+                                      const size_t product,
+                                      const size_t n,
+                                      const TYPE(gsl_complex) twiddle[],
+                                      const TYPE(gsl_complex) chirp[],
+                                      const TYPE(gsl_complex) filter[],
+                                      const TYPE(gsl_fft_complex_wavetable) * conv,
+                                      BASE scratch[]);
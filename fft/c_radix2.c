@@ -17,6 +17,230 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+/* The power of 2 transforms are computed in place two stages at a
+   time. Each group of four elements x0..x3 at distance dual is
+   combined with a radix-4 butterfly, which needs the same number of
+   multiplications as two radix-2 stages but passes over the data half
+   as often. The twiddles for a block of RADIX2_BLOCK consecutive
+   butterflies are generated with the trigonometric recurrence into a
+   small table, and each block is applied to all groups before moving
+   on, so that the data is accessed sequentially in every stage. */
+
+#ifndef RADIX2_BLOCK
+#define RADIX2_BLOCK 256
+#endif
+
+/* generate v_a = exp(i theta a) for a = a0 .. a0+len-1 */
+
+static void
+FUNCTION(fft_complex,radix2_twiddles) (const double theta, const size_t a0,
+                                       const size_t len,
+                                       ATOMIC v_real[], ATOMIC v_imag[])
+{
+  const double s = sin (theta);
+  const double t = sin (theta / 2.0);
+  const double s2 = 2.0 * t * t;
+  double w_real = cos (theta * (double) a0);
+  double w_imag = sin (theta * (double) a0);
+  size_t a;
+
+  for (a = 0; a < len; a++)
+    {
+      v_real[a] = w_real;
+      v_imag[a] = w_imag;
+
+      /* trignometric recurrence for w-> exp(i theta) w */
+      {
+        const double tmp_real = w_real - s * w_imag - s2 * w_real;
+        const double tmp_imag = w_imag + s * w_real - s2 * w_imag;
+        w_real = tmp_real;
+        w_imag = tmp_imag;
+      }
+    }
+}
+
+/* radix-2 stage without twiddles, for dual = 1 */
+
+static void
+FUNCTION(fft_complex,radix2_pass) (BASE data[], const size_t stride,
+                                   const size_t n)
+{
+  size_t b;
+
+  for (b = 0; b < n; b += 2)
+    {
+      const ATOMIC z0_real = REAL(data,stride,b);
+      const ATOMIC z0_imag = IMAG(data,stride,b);
+      const ATOMIC z1_real = REAL(data,stride,b + 1);
+      const ATOMIC z1_imag = IMAG(data,stride,b + 1);
+
+      REAL(data,stride,b) = z0_real + z1_real;
+      IMAG(data,stride,b) = z0_imag + z1_imag;
+      REAL(data,stride,b + 1) = z0_real - z1_real;
+      IMAG(data,stride,b + 1) = z0_imag - z1_imag;
+    }
+}
+
+/* decimation in time stages dual and 2*dual. With v = exp(+/- i pi a /
+   (2 dual)) and w = v^2,
+
+   y0 = x0 + w x1, y1 = x0 - w x1, y2 = x2 + w x3, y3 = x2 - w x3
+   x0 = y0 + v y2, x2 = y0 - v y2, x1 = y1 +/- i v y3, x3 = y1 -/+ i v y3 */
+
+static void
+FUNCTION(fft_complex,radix2_dit4) (BASE data[], const size_t stride,
+                                   const size_t n, const size_t dual,
+                                   const gsl_fft_direction sign)
+{
+  const ATOMIC sgn = (ATOMIC) ((int) sign);
+  const double theta = ((int) sign) * M_PI / (2.0 * (double) dual);
+  ATOMIC v_real[RADIX2_BLOCK], v_imag[RADIX2_BLOCK];
+  size_t a0, a, b;
+
+  for (a0 = 0; a0 < dual; a0 += RADIX2_BLOCK)
+    {
+      const size_t len = GSL_MIN (RADIX2_BLOCK, dual - a0);
+
+      FUNCTION(fft_complex,radix2_twiddles) (theta, a0, len, v_real, v_imag);
+
+      for (b = 0; b < n; b += 4 * dual)
+        {
+          for (a = 0; a < len; a++)
+            {
+              const size_t i0 = b + a0 + a;
+              const size_t i1 = i0 + dual;
+              const size_t i2 = i1 + dual;
+              const size_t i3 = i2 + dual;
+
+              const ATOMIC vr = v_real[a];
+              const ATOMIC vi = v_imag[a];
+              const ATOMIC wr = vr * vr - vi * vi;
+              const ATOMIC wi = 2 * vr * vi;
+
+              const ATOMIC x0_real = REAL(data,stride,i0);
+              const ATOMIC x0_imag = IMAG(data,stride,i0);
+              const ATOMIC x1_real = REAL(data,stride,i1);
+              const ATOMIC x1_imag = IMAG(data,stride,i1);
+              const ATOMIC x2_real = REAL(data,stride,i2);
+              const ATOMIC x2_imag = IMAG(data,stride,i2);
+              const ATOMIC x3_real = REAL(data,stride,i3);
+              const ATOMIC x3_imag = IMAG(data,stride,i3);
+
+              /* first stage, twiddle w */
+
+              const ATOMIC t1_real = wr * x1_real - wi * x1_imag;
+              const ATOMIC t1_imag = wr * x1_imag + wi * x1_real;
+              const ATOMIC t3_real = wr * x3_real - wi * x3_imag;
+              const ATOMIC t3_imag = wr * x3_imag + wi * x3_real;
+
+              const ATOMIC y0_real = x0_real + t1_real;
+              const ATOMIC y0_imag = x0_imag + t1_imag;
+              const ATOMIC y1_real = x0_real - t1_real;
+              const ATOMIC y1_imag = x0_imag - t1_imag;
+              const ATOMIC y2_real = x2_real + t3_real;
+              const ATOMIC y2_imag = x2_imag + t3_imag;
+              const ATOMIC y3_real = x2_real - t3_real;
+              const ATOMIC y3_imag = x2_imag - t3_imag;
+
+              /* second stage, twiddles v and +/- i v */
+
+              const ATOMIC u2_real = vr * y2_real - vi * y2_imag;
+              const ATOMIC u2_imag = vr * y2_imag + vi * y2_real;
+              const ATOMIC u3_real = -sgn * (vr * y3_imag + vi * y3_real);
+              const ATOMIC u3_imag = sgn * (vr * y3_real - vi * y3_imag);
+
+              REAL(data,stride,i0) = y0_real + u2_real;
+              IMAG(data,stride,i0) = y0_imag + u2_imag;
+              REAL(data,stride,i2) = y0_real - u2_real;
+              IMAG(data,stride,i2) = y0_imag - u2_imag;
+              REAL(data,stride,i1) = y1_real + u3_real;
+              IMAG(data,stride,i1) = y1_imag + u3_imag;
+              REAL(data,stride,i3) = y1_real - u3_real;
+              IMAG(data,stride,i3) = y1_imag - u3_imag;
+            }
+        }
+    }
+}
+
+/* decimation in frequency stages 2*dual and dual, the reverse of
+   radix2_dit4 */
+
+static void
+FUNCTION(fft_complex,radix2_dif4) (BASE data[], const size_t stride,
+                                   const size_t n, const size_t dual,
+                                   const gsl_fft_direction sign)
+{
+  const ATOMIC sgn = (ATOMIC) ((int) sign);
+  const double theta = ((int) sign) * M_PI / (2.0 * (double) dual);
+  ATOMIC v_real[RADIX2_BLOCK], v_imag[RADIX2_BLOCK];
+  size_t a0, a, b;
+
+  for (a0 = 0; a0 < dual; a0 += RADIX2_BLOCK)
+    {
+      const size_t len = GSL_MIN (RADIX2_BLOCK, dual - a0);
+
+      FUNCTION(fft_complex,radix2_twiddles) (theta, a0, len, v_real, v_imag);
+
+      for (b = 0; b < n; b += 4 * dual)
+        {
+          for (a = 0; a < len; a++)
+            {
+              const size_t i0 = b + a0 + a;
+              const size_t i1 = i0 + dual;
+              const size_t i2 = i1 + dual;
+              const size_t i3 = i2 + dual;
+
+              const ATOMIC vr = v_real[a];
+              const ATOMIC vi = v_imag[a];
+              const ATOMIC wr = vr * vr - vi * vi;
+              const ATOMIC wi = 2 * vr * vi;
+
+              const ATOMIC x0_real = REAL(data,stride,i0);
+              const ATOMIC x0_imag = IMAG(data,stride,i0);
+              const ATOMIC x1_real = REAL(data,stride,i1);
+              const ATOMIC x1_imag = IMAG(data,stride,i1);
+              const ATOMIC x2_real = REAL(data,stride,i2);
+              const ATOMIC x2_imag = IMAG(data,stride,i2);
+              const ATOMIC x3_real = REAL(data,stride,i3);
+              const ATOMIC x3_imag = IMAG(data,stride,i3);
+
+              /* first stage, twiddles v and +/- i v */
+
+              const ATOMIC y0_real = x0_real + x2_real;
+              const ATOMIC y0_imag = x0_imag + x2_imag;
+              const ATOMIC y1_real = x1_real + x3_real;
+              const ATOMIC y1_imag = x1_imag + x3_imag;
+
+              const ATOMIC d2_real = x0_real - x2_real;
+              const ATOMIC d2_imag = x0_imag - x2_imag;
+              const ATOMIC d3_real = x1_real - x3_real;
+              const ATOMIC d3_imag = x1_imag - x3_imag;
+
+              const ATOMIC y2_real = vr * d2_real - vi * d2_imag;
+              const ATOMIC y2_imag = vr * d2_imag + vi * d2_real;
+              const ATOMIC y3_real = -sgn * (vr * d3_imag + vi * d3_real);
+              const ATOMIC y3_imag = sgn * (vr * d3_real - vi * d3_imag);
+
+              /* second stage, twiddle w */
+
+              const ATOMIC e1_real = y0_real - y1_real;
+              const ATOMIC e1_imag = y0_imag - y1_imag;
+              const ATOMIC e3_real = y2_real - y3_real;
+              const ATOMIC e3_imag = y2_imag - y3_imag;
+
+              REAL(data,stride,i0) = y0_real + y1_real;
+              IMAG(data,stride,i0) = y0_imag + y1_imag;
+              REAL(data,stride,i1) = wr * e1_real - wi * e1_imag;
+              IMAG(data,stride,i1) = wr * e1_imag + wi * e1_real;
+              REAL(data,stride,i2) = y2_real + y3_real;
+              IMAG(data,stride,i2) = y2_imag + y3_imag;
+              REAL(data,stride,i3) = wr * e3_real - wi * e3_imag;
+              IMAG(data,stride,i3) = wr * e3_imag + wi * e3_real;
+            }
+        }
+    }
+}
+
 int
 FUNCTION(gsl_fft_complex,radix2_forward) (TYPE(gsl_complex_packed_array) data,
                                           const size_t stride, const size_t n)
@@ -72,7 +296,6 @@ FUNCTION(gsl_fft_complex,radix2_transform) (TYPE(gsl_complex_packed_array) data,
 {
   int result ;
   size_t dual;
-  size_t bit; 
   size_t logn = 0;
   int status;
 
@@ -98,74 +321,19 @@ FUNCTION(gsl_fft_complex,radix2_transform) (TYPE(gsl_complex_packed_array) data,
   
   status = FUNCTION(fft_complex,bitreverse_order) (data, stride, n, logn) ;
 
-  /* apply fft recursion */
+  /* apply fft recursion, two stages at a time */
 
   dual = 1;
 
-  for (bit = 0; bit < logn; bit++)
+  if (logn % 2)
     {
-      ATOMIC w_real = 1.0;
-      ATOMIC w_imag = 0.0;
-
-      const double theta = 2.0 * ((int) sign) * M_PI / (2.0 * (double) dual);
-
-      const ATOMIC s = sin (theta);
-      const ATOMIC t = sin (theta / 2.0);
-      const ATOMIC s2 = 2.0 * t * t;
-
-      size_t a, b;
-
-      /* a = 0 */
-
-      for (b = 0; b < n; b += 2 * dual)
-        {
-          const size_t i = b ;
-          const size_t j = b + dual;
-          
-          const ATOMIC z1_real = REAL(data,stride,j) ;
-          const ATOMIC z1_imag = IMAG(data,stride,j) ;
-
-          const ATOMIC wd_real = z1_real ;
-          const ATOMIC wd_imag = z1_imag ;
-          
-          REAL(data,stride,j) = REAL(data,stride,i) - wd_real;
-          IMAG(data,stride,j) = IMAG(data,stride,i) - wd_imag;
-          REAL(data,stride,i) += wd_real;
-          IMAG(data,stride,i) += wd_imag;
-        }
-      
-      /* a = 1 .. (dual-1) */
-
-      for (a = 1; a < dual; a++)
-        {
-
-          /* trignometric recurrence for w-> exp(i theta) w */
-
-          {
-            const ATOMIC tmp_real = w_real - s * w_imag - s2 * w_real;
-            const ATOMIC tmp_imag = w_imag + s * w_real - s2 * w_imag;
-            w_real = tmp_real;
-            w_imag = tmp_imag;
-          }
+      FUNCTION(fft_complex,radix2_pass) (data, stride, n);
+      dual = 2;
+    }
 
-          for (b = 0; b < n; b += 2 * dual)
-            {
-              const size_t i = b + a;
-              const size_t j = b + a + dual;
-
-              const ATOMIC z1_real = REAL(data,stride,j) ;
-              const ATOMIC z1_imag = IMAG(data,stride,j) ;
-              
-              const ATOMIC wd_real = w_real * z1_real - w_imag * z1_imag;
-              const ATOMIC wd_imag = w_real * z1_imag + w_imag * z1_real;
-
-              REAL(data,stride,j) = REAL(data,stride,i) - wd_real;
-              IMAG(data,stride,j) = IMAG(data,stride,i) - wd_imag;
-              REAL(data,stride,i) += wd_real;
-              IMAG(data,stride,i) += wd_imag;
-            }
-        }
-      dual *= 2;
+  for (; dual < n; dual *= 4)
+    {
+      FUNCTION(fft_complex,radix2_dit4) (data, stride, n, dual, sign);
     }
 
   return 0;
@@ -251,51 +419,16 @@ FUNCTION(gsl_fft_complex,radix2_dif_transform) (TYPE(gsl_complex_packed_array) d
       logn = result ;
     }
 
-  /* apply fft recursion */
+  /* apply fft recursion, two stages at a time */
 
-  dual = n / 2;
-
-  for (bit = 0; bit < logn; bit++)
+  for (dual = n / 4, bit = 0; bit + 1 < logn; dual /= 4, bit += 2)
     {
-      ATOMIC w_real = 1.0;
-      ATOMIC w_imag = 0.0;
-
-      const double theta = 2.0 * ((int) sign) * M_PI / ((double) (2 * dual));
-
-      const ATOMIC s = sin (theta);
-      const ATOMIC t = sin (theta / 2.0);
-      const ATOMIC s2 = 2.0 * t * t;
-
-      size_t a, b;
-
-      for (b = 0; b < dual; b++)
-        {
-          for (a = 0; a < n; a+= 2 * dual)
-            {
-              const size_t i = b + a;
-              const size_t j = b + a + dual;
-              
-              const ATOMIC t1_real = REAL(data,stride,i) + REAL(data,stride,j);
-              const ATOMIC t1_imag = IMAG(data,stride,i) + IMAG(data,stride,j);
-              const ATOMIC t2_real = REAL(data,stride,i) - REAL(data,stride,j);
-              const ATOMIC t2_imag = IMAG(data,stride,i) - IMAG(data,stride,j);
-
-              REAL(data,stride,i) = t1_real;
-              IMAG(data,stride,i) = t1_imag;
-              REAL(data,stride,j) = w_real*t2_real - w_imag * t2_imag;
-              IMAG(data,stride,j) = w_real*t2_imag + w_imag * t2_real;
-            }
-
-          /* trignometric recurrence for w-> exp(i theta) w */
+      FUNCTION(fft_complex,radix2_dif4) (data, stride, n, dual, sign);
+    }
 
-          {
-            const ATOMIC tmp_real = w_real - s * w_imag - s2 * w_real;
-            const ATOMIC tmp_imag = w_imag + s * w_real - s2 * w_imag;
-            w_real = tmp_real;
-            w_imag = tmp_imag;
-          }
-        }
-      dual /= 2;
+  if (bit < logn)
+    {
+      FUNCTION(fft_complex,radix2_pass) (data, stride, n);
     }
 
   /* bit reverse the ordering of output data for decimation in
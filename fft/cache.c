@@ -0,0 +1,489 @@
+/* fft/cache.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * A cache of wavetables keyed by length and type. Wavetables are only
+ * read by the transforms, so a cached wavetable can be handed out to
+ * any number of callers at once; each lookup takes a reference which
+ * is returned with gsl_fft_cache_release(). The entries are kept in a
+ * doubly linked list in order of last use, and unreferenced entries are
+ * freed from the least recently used end whenever the memory of the
+ * cached wavetables exceeds max_bytes. Entries in use are never freed,
+ * so the bound may be exceeded while they are held.
+ */
+
+#include <config.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_fft_cache.h>
+
+typedef enum
+{
+  FFT_CACHE_COMPLEX,
+  FFT_CACHE_REAL,
+  FFT_CACHE_HALFCOMPLEX,
+  FFT_CACHE_COMPLEX_FLOAT,
+  FFT_CACHE_REAL_FLOAT,
+  FFT_CACHE_HALFCOMPLEX_FLOAT
+} fft_cache_type;
+
+struct gsl_fft_cache_entry_struct
+{
+  fft_cache_type type;
+  size_t n;
+  void *wavetable;
+  size_t refcount;
+  size_t nbytes;
+  struct gsl_fft_cache_entry_struct *prev;
+  struct gsl_fft_cache_entry_struct *next;
+};
+
+static const void *fft_cache_get (gsl_fft_cache * cache, const fft_cache_type type,
+                                  const size_t n);
+static void *fft_cache_wavetable_alloc (const fft_cache_type type, const size_t n);
+static void fft_cache_wavetable_free (const fft_cache_type type, void *wavetable);
+static size_t fft_cache_wavetable_bytes (const fft_cache_type type, const void *wavetable);
+static size_t fft_cache_complex_bytes (const gsl_fft_complex_wavetable * w);
+static size_t fft_cache_complex_float_bytes (const gsl_fft_complex_wavetable_float * w);
+static void fft_cache_unlink (gsl_fft_cache * cache, gsl_fft_cache_entry * e);
+static void fft_cache_push (gsl_fft_cache * cache, gsl_fft_cache_entry * e);
+static void fft_cache_trim (gsl_fft_cache * cache);
+
+#define FFT_CACHE_LOCK(c) do { if ((c)->lock) (c)->lock ((c)->lock_data); } while (0)
+#define FFT_CACHE_UNLOCK(c) do { if ((c)->unlock) (c)->unlock ((c)->lock_data); } while (0)
+
+/*
+gsl_fft_cache_alloc()
+  Allocate an empty wavetable cache
+
+Inputs: max_bytes - bound on the memory used by all cached wavetables;
+                    unreferenced ones are freed to stay within it
+
+Return: pointer to cache
+*/
+
+gsl_fft_cache *
+gsl_fft_cache_alloc (const size_t max_bytes)
+{
+  gsl_fft_cache *cache = calloc (1, sizeof (gsl_fft_cache));
+
+  if (cache == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for cache", GSL_ENOMEM);
+    }
+
+  cache->max_bytes = max_bytes;
+
+  return cache;
+}
+
+/*
+gsl_fft_cache_free()
+  Free a cache and all of its wavetables, which must no longer be in use
+*/
+
+void
+gsl_fft_cache_free (gsl_fft_cache * cache)
+{
+  gsl_fft_cache_entry *e;
+
+  RETURN_IF_NULL (cache);
+
+  e = cache->head;
+  while (e != NULL)
+    {
+      gsl_fft_cache_entry *next = e->next;
+
+      fft_cache_wavetable_free (e->type, e->wavetable);
+      free (e);
+      e = next;
+    }
+
+  free (cache);
+}
+
+/*
+gsl_fft_cache_set_lock()
+  Install functions which are called to lock and unlock the cache around
+every lookup and release, for example to acquire a mutex when the cache
+is shared between threads
+
+Inputs: cache     - cache
+        lock      - lock function, or NULL
+        unlock    - unlock function, or NULL
+        lock_data - argument passed to lock and unlock
+*/
+
+void
+gsl_fft_cache_set_lock (gsl_fft_cache * cache, void (*lock) (void *),
+                        void (*unlock) (void *), void *lock_data)
+{
+  cache->lock = lock;
+  cache->unlock = unlock;
+  cache->lock_data = lock_data;
+}
+
+const gsl_fft_complex_wavetable *
+gsl_fft_cache_complex (gsl_fft_cache * cache, const size_t n)
+{
+  return fft_cache_get (cache, FFT_CACHE_COMPLEX, n);
+}
+
+const gsl_fft_real_wavetable *
+gsl_fft_cache_real (gsl_fft_cache * cache, const size_t n)
+{
+  return fft_cache_get (cache, FFT_CACHE_REAL, n);
+}
+
+const gsl_fft_halfcomplex_wavetable *
+gsl_fft_cache_halfcomplex (gsl_fft_cache * cache, const size_t n)
+{
+  return fft_cache_get (cache, FFT_CACHE_HALFCOMPLEX, n);
+}
+
+const gsl_fft_complex_wavetable_float *
+gsl_fft_cache_complex_float (gsl_fft_cache * cache, const size_t n)
+{
+  return fft_cache_get (cache, FFT_CACHE_COMPLEX_FLOAT, n);
+}
+
+const gsl_fft_real_wavetable_float *
+gsl_fft_cache_real_float (gsl_fft_cache * cache, const size_t n)
+{
+  return fft_cache_get (cache, FFT_CACHE_REAL_FLOAT, n);
+}
+
+const gsl_fft_halfcomplex_wavetable_float *
+gsl_fft_cache_halfcomplex_float (gsl_fft_cache * cache, const size_t n)
+{
+  return fft_cache_get (cache, FFT_CACHE_HALFCOMPLEX_FLOAT, n);
+}
+
+/*
+gsl_fft_cache_release()
+  Return a reference to a wavetable obtained from the cache
+
+Inputs: cache     - cache
+        wavetable - wavetable returned by one of the gsl_fft_cache_*
+                    lookup functions
+*/
+
+int
+gsl_fft_cache_release (gsl_fft_cache * cache, const void * wavetable)
+{
+  gsl_fft_cache_entry *e;
+
+  FFT_CACHE_LOCK (cache);
+
+  for (e = cache->head; e != NULL; e = e->next)
+    {
+      if (e->wavetable == wavetable)
+        break;
+    }
+
+  if (e == NULL || e->refcount == 0)
+    {
+      FFT_CACHE_UNLOCK (cache);
+      GSL_ERROR ("wavetable is not referenced in cache", GSL_EINVAL);
+    }
+
+  --(e->refcount);
+
+  if (e->refcount == 0)
+    fft_cache_trim (cache);
+
+  FFT_CACHE_UNLOCK (cache);
+
+  return GSL_SUCCESS;
+}
+
+/*
+fft_cache_get()
+  Look up a wavetable in the cache, allocating it on a miss, and take a
+reference to it
+*/
+
+static const void *
+fft_cache_get (gsl_fft_cache * cache, const fft_cache_type type, const size_t n)
+{
+  gsl_fft_cache_entry *e;
+
+  FFT_CACHE_LOCK (cache);
+
+  for (e = cache->head; e != NULL; e = e->next)
+    {
+      if (e->type == type && e->n == n)
+        break;
+    }
+
+  if (e != NULL)
+    {
+      ++(cache->hits);
+
+      /* move to front of list */
+      fft_cache_unlink (cache, e);
+      fft_cache_push (cache, e);
+    }
+  else
+    {
+      void *wavetable;
+
+      e = malloc (sizeof (gsl_fft_cache_entry));
+      if (e == NULL)
+        {
+          FFT_CACHE_UNLOCK (cache);
+          GSL_ERROR_NULL ("failed to allocate space for cache entry", GSL_ENOMEM);
+        }
+
+      wavetable = fft_cache_wavetable_alloc (type, n);
+      if (wavetable == NULL)
+        {
+          free (e);
+          FFT_CACHE_UNLOCK (cache);
+          GSL_ERROR_NULL ("failed to allocate wavetable", GSL_ENOMEM);
+        }
+
+      ++(cache->misses);
+
+      e->type = type;
+      e->n = n;
+      e->wavetable = wavetable;
+      e->refcount = 0;
+      e->nbytes = fft_cache_wavetable_bytes (type, wavetable);
+
+      fft_cache_push (cache, e);
+      cache->nbytes += e->nbytes;
+      ++(cache->nentries);
+    }
+
+  ++(e->refcount);
+
+  /* a new entry may push the cache over the bound */
+  fft_cache_trim (cache);
+
+  FFT_CACHE_UNLOCK (cache);
+
+  return e->wavetable;
+}
+
+static void *
+fft_cache_wavetable_alloc (const fft_cache_type type, const size_t n)
+{
+  switch (type)
+    {
+      case FFT_CACHE_COMPLEX:
+        return gsl_fft_complex_wavetable_alloc (n);
+
+      case FFT_CACHE_REAL:
+        return gsl_fft_real_wavetable_alloc (n);
+
+      case FFT_CACHE_HALFCOMPLEX:
+        return gsl_fft_halfcomplex_wavetable_alloc (n);
+
+      case FFT_CACHE_COMPLEX_FLOAT:
+        return gsl_fft_complex_wavetable_float_alloc (n);
+
+      case FFT_CACHE_REAL_FLOAT:
+        return gsl_fft_real_wavetable_float_alloc (n);
+
+      case FFT_CACHE_HALFCOMPLEX_FLOAT:
+        return gsl_fft_halfcomplex_wavetable_float_alloc (n);
+
+      default:
+        return NULL;
+    }
+}
+
+static void
+fft_cache_wavetable_free (const fft_cache_type type, void *wavetable)
+{
+  switch (type)
+    {
+      case FFT_CACHE_COMPLEX:
+        gsl_fft_complex_wavetable_free (wavetable);
+        break;
+
+      case FFT_CACHE_REAL:
+        gsl_fft_real_wavetable_free (wavetable);
+        break;
+
+      case FFT_CACHE_HALFCOMPLEX:
+        gsl_fft_halfcomplex_wavetable_free (wavetable);
+        break;
+
+      case FFT_CACHE_COMPLEX_FLOAT:
+        gsl_fft_complex_wavetable_float_free (wavetable);
+        break;
+
+      case FFT_CACHE_REAL_FLOAT:
+        gsl_fft_real_wavetable_float_free (wavetable);
+        break;
+
+      case FFT_CACHE_HALFCOMPLEX_FLOAT:
+        gsl_fft_halfcomplex_wavetable_float_free (wavetable);
+        break;
+    }
+}
+
+/* approximate memory used by a wavetable, including its trigonometric
+   tables and the nested wavetables of Bluestein passes */
+
+static size_t
+fft_cache_wavetable_bytes (const fft_cache_type type, const void *wavetable)
+{
+  switch (type)
+    {
+      case FFT_CACHE_COMPLEX:
+        return fft_cache_complex_bytes (wavetable);
+
+      case FFT_CACHE_REAL:
+        {
+          const gsl_fft_real_wavetable *w = wavetable;
+          return sizeof (*w) + (w->n / 2) * sizeof (gsl_complex) +
+                 fft_cache_complex_bytes (w->complex_wavetable);
+        }
+
+      case FFT_CACHE_HALFCOMPLEX:
+        {
+          const gsl_fft_halfcomplex_wavetable *w = wavetable;
+          return sizeof (*w) + w->n * sizeof (gsl_complex) +
+                 fft_cache_complex_bytes (w->complex_wavetable);
+        }
+
+      case FFT_CACHE_COMPLEX_FLOAT:
+        return fft_cache_complex_float_bytes (wavetable);
+
+      case FFT_CACHE_REAL_FLOAT:
+        {
+          const gsl_fft_real_wavetable_float *w = wavetable;
+          return sizeof (*w) + (w->n / 2) * sizeof (gsl_complex_float) +
+                 fft_cache_complex_float_bytes (w->complex_wavetable);
+        }
+
+      case FFT_CACHE_HALFCOMPLEX_FLOAT:
+        {
+          const gsl_fft_halfcomplex_wavetable_float *w = wavetable;
+          return sizeof (*w) + w->n * sizeof (gsl_complex_float) +
+                 fft_cache_complex_float_bytes (w->complex_wavetable);
+        }
+
+      default:
+        return 0;
+    }
+}
+
+static size_t
+fft_cache_complex_bytes (const gsl_fft_complex_wavetable * w)
+{
+  size_t nbytes, i;
+
+  if (w == NULL)
+    return 0;
+
+  nbytes = sizeof (*w) + w->n * sizeof (gsl_complex);
+
+  for (i = 0; i < w->nf; ++i)
+    {
+      if (w->chirp[i] != NULL)
+        {
+          nbytes += (w->factor[i] + w->conv[i]->n) * sizeof (gsl_complex);
+          nbytes += fft_cache_complex_bytes (w->conv[i]);
+        }
+    }
+
+  return nbytes;
+}
+
+static size_t
+fft_cache_complex_float_bytes (const gsl_fft_complex_wavetable_float * w)
+{
+  size_t nbytes, i;
+
+  if (w == NULL)
+    return 0;
+
+  nbytes = sizeof (*w) + w->n * sizeof (gsl_complex_float);
+
+  for (i = 0; i < w->nf; ++i)
+    {
+      if (w->chirp[i] != NULL)
+        {
+          nbytes += (w->factor[i] + w->conv[i]->n) * sizeof (gsl_complex_float);
+          nbytes += fft_cache_complex_float_bytes (w->conv[i]);
+        }
+    }
+
+  return nbytes;
+}
+
+static void
+fft_cache_unlink (gsl_fft_cache * cache, gsl_fft_cache_entry * e)
+{
+  if (e->prev)
+    e->prev->next = e->next;
+  else
+    cache->head = e->next;
+
+  if (e->next)
+    e->next->prev = e->prev;
+  else
+    cache->tail = e->prev;
+}
+
+static void
+fft_cache_push (gsl_fft_cache * cache, gsl_fft_cache_entry * e)
+{
+  e->prev = NULL;
+  e->next = cache->head;
+
+  if (cache->head)
+    cache->head->prev = e;
+  else
+    cache->tail = e;
+
+  cache->head = e;
+}
+
+/* free unreferenced entries, least recently used first, until the
+   cache is within its memory bound */
+
+static void
+fft_cache_trim (gsl_fft_cache * cache)
+{
+  gsl_fft_cache_entry *e = cache->tail;
+
+  while (e != NULL && cache->nbytes > cache->max_bytes)
+    {
+      gsl_fft_cache_entry *prev = e->prev;
+
+      if (e->refcount == 0)
+        {
+          fft_cache_unlink (cache, e);
+          cache->nbytes -= e->nbytes;
+          --(cache->nentries);
+          ++(cache->evictions);
+          fft_cache_wavetable_free (e->type, e->wavetable);
+          free (e);
+        }
+
+      e = prev;
+    }
+}
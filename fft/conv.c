@@ -0,0 +1,823 @@
+/* fft/conv.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Linear and circular convolution and correlation of real and complex
+ * sequences. For inputs of lengths na and nb the direct sums cost
+ * O(na nb), while the transform method costs O(N log N) with N >= na +
+ * nb - 1 the smallest length whose factors are 2, 3 and 5; the cheaper
+ * of the two is chosen from the lengths. Linear correlations are
+ * computed as circular ones of the zero padded inputs, with the
+ * negative lags wrapped around to the end of the result.
+ */
+
+#include <config.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_fft_conv.h>
+
+#include "complex_internal.h"
+
+/* the transform method is used when na*nb exceeds this multiple of
+   N log2(N), which matches the measured crossover */
+#define FFT_CONV_RATIO 3.0
+
+/* bound on the memory of cached wavetables */
+#define FFT_CONV_CACHE_BYTES (4 * 1024 * 1024)
+
+static size_t conv_fast_length (const size_t n);
+static int conv_use_fft (const size_t na, const size_t nb, const size_t n);
+static int conv_real_workspace (gsl_fft_conv_workspace * w, const size_t n);
+static int conv_complex_workspace (gsl_fft_conv_workspace * w, const size_t n);
+static void conv_real_direct (const double a[], const size_t na,
+                              const double b[], const size_t nb,
+                              double c[], const int corr, const int circular);
+static void conv_complex_direct (const double a[], const size_t na,
+                                 const double b[], const size_t nb,
+                                 double c[], const int corr, const int circular);
+static int conv_real_fft (const double a[], const size_t na,
+                          const double b[], const size_t nb, double c[],
+                          const size_t nc, const size_t n, const int corr,
+                          const size_t shift, gsl_fft_conv_workspace * w);
+static int conv_complex_fft (const double a[], const size_t na,
+                             const double b[], const size_t nb, double c[],
+                             const size_t nc, const size_t n, const int corr,
+                             const size_t shift, gsl_fft_conv_workspace * w);
+static void conv_hc_multiply (double x[], const double y[], const size_t n,
+                              const int conj);
+static int conv_real (const double a[], const size_t na,
+                      const double b[], const size_t nb, double c[],
+                      const int corr, const int circular,
+                      gsl_fft_conv_workspace * w);
+static int conv_complex (const double a[], const size_t na,
+                         const double b[], const size_t nb, double c[],
+                         const int corr, const int circular,
+                         gsl_fft_conv_workspace * w);
+
+/*
+gsl_fft_conv_alloc()
+  Allocate a workspace for convolutions and correlations
+
+Inputs: n - maximum length of results: na + nb - 1 for linear and
+            n for circular convolutions
+
+Return: pointer to workspace
+*/
+
+gsl_fft_conv_workspace *
+gsl_fft_conv_alloc (const size_t n)
+{
+  gsl_fft_conv_workspace *w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("length n must be positive integer", GSL_EDOM);
+    }
+
+  w = calloc (1, sizeof (gsl_fft_conv_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->nmax = conv_fast_length (n);
+
+  w->cache = gsl_fft_cache_alloc (FFT_CONV_CACHE_BYTES);
+  w->fa = malloc (2 * w->nmax * sizeof (double));
+  w->fb = malloc (2 * w->nmax * sizeof (double));
+
+  if (w->cache == NULL || w->fa == NULL || w->fb == NULL)
+    {
+      gsl_fft_conv_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_fft_conv_free (gsl_fft_conv_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->cache)
+    gsl_fft_cache_free (w->cache);
+
+  if (w->real_work)
+    gsl_fft_real_workspace_free (w->real_work);
+
+  if (w->complex_work)
+    gsl_fft_complex_workspace_free (w->complex_work);
+
+  if (w->fa)
+    free (w->fa);
+
+  if (w->fb)
+    free (w->fb);
+
+  free (w);
+}
+
+/*
+gsl_fft_conv_real()
+  Linear convolution of two real sequences
+
+Inputs: a  - first sequence, length na
+        na - length of a
+        b  - second sequence, length nb
+        nb - length of b
+        c  - (output) c_k = sum_j a_j b_{k-j}, length na + nb - 1
+        w  - workspace
+
+Notes:
+1) c must not overlap a or b
+*/
+
+int
+gsl_fft_conv_real (const double a[], const size_t na,
+                   const double b[], const size_t nb,
+                   double c[], gsl_fft_conv_workspace * w)
+{
+  return conv_real (a, na, b, nb, c, 0, 0, w);
+}
+
+/*
+gsl_fft_corr_real()
+  Linear cross-correlation of two real sequences
+
+Inputs: a  - first sequence, length na
+        na - length of a
+        b  - second sequence, length nb
+        nb - length of b
+        c  - (output) c_k = sum_j a_{j+k-(nb-1)} b_j, for lags
+             k - (nb-1) from -(nb-1) to na-1, length na + nb - 1
+        w  - workspace
+*/
+
+int
+gsl_fft_corr_real (const double a[], const size_t na,
+                   const double b[], const size_t nb,
+                   double c[], gsl_fft_conv_workspace * w)
+{
+  return conv_real (a, na, b, nb, c, 1, 0, w);
+}
+
+/*
+gsl_fft_conv_real_circular()
+  Circular convolution c_k = sum_j a_j b_{(k-j) mod n}
+*/
+
+int
+gsl_fft_conv_real_circular (const double a[], const double b[],
+                            const size_t n, double c[],
+                            gsl_fft_conv_workspace * w)
+{
+  return conv_real (a, n, b, n, c, 0, 1, w);
+}
+
+/*
+gsl_fft_corr_real_circular()
+  Circular correlation c_k = sum_j a_{(j+k) mod n} b_j
+*/
+
+int
+gsl_fft_corr_real_circular (const double a[], const double b[],
+                            const size_t n, double c[],
+                            gsl_fft_conv_workspace * w)
+{
+  return conv_real (a, n, b, n, c, 1, 1, w);
+}
+
+int
+gsl_fft_conv_complex (gsl_const_complex_packed_array a, const size_t na,
+                      gsl_const_complex_packed_array b, const size_t nb,
+                      gsl_complex_packed_array c, gsl_fft_conv_workspace * w)
+{
+  return conv_complex (a, na, b, nb, c, 0, 0, w);
+}
+
+/* complex correlations conjugate the second sequence,
+   c_k = sum_j a_{j+k-(nb-1)} conj(b_j) */
+
+int
+gsl_fft_corr_complex (gsl_const_complex_packed_array a, const size_t na,
+                      gsl_const_complex_packed_array b, const size_t nb,
+                      gsl_complex_packed_array c, gsl_fft_conv_workspace * w)
+{
+  return conv_complex (a, na, b, nb, c, 1, 0, w);
+}
+
+int
+gsl_fft_conv_complex_circular (gsl_const_complex_packed_array a,
+                               gsl_const_complex_packed_array b,
+                               const size_t n, gsl_complex_packed_array c,
+                               gsl_fft_conv_workspace * w)
+{
+  return conv_complex (a, n, b, n, c, 0, 1, w);
+}
+
+int
+gsl_fft_corr_complex_circular (gsl_const_complex_packed_array a,
+                               gsl_const_complex_packed_array b,
+                               const size_t n, gsl_complex_packed_array c,
+                               gsl_fft_conv_workspace * w)
+{
+  return conv_complex (a, n, b, n, c, 1, 1, w);
+}
+
+/*
+gsl_fft_conv_stream_alloc()
+  Allocate a streaming convolution with a fixed real filter, computed
+by the overlap-save method
+
+Inputs: h  - filter, length nh
+        nh - filter length
+        n  - transform length, >= nh; each transform produces n - nh + 1
+             output samples. If 0, a length is chosen from nh
+
+Return: pointer to stream
+*/
+
+gsl_fft_conv_stream *
+gsl_fft_conv_stream_alloc (const double h[], const size_t nh, const size_t n)
+{
+  gsl_fft_conv_stream *s;
+  size_t i;
+
+  if (nh == 0)
+    {
+      GSL_ERROR_NULL ("filter length must be positive integer", GSL_EDOM);
+    }
+  else if (n != 0 && n < nh)
+    {
+      GSL_ERROR_NULL ("transform length must be at least filter length", GSL_EBADLEN);
+    }
+
+  s = calloc (1, sizeof (gsl_fft_conv_stream));
+  if (s == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for stream", GSL_ENOMEM);
+    }
+
+  s->nh = nh;
+  s->n = (n != 0) ? n : conv_fast_length (GSL_MAX (8 * nh, 64));
+
+  s->H = malloc (s->n * sizeof (double));
+  s->buf = malloc (s->n * sizeof (double));
+  s->work = malloc (s->n * sizeof (double));
+  s->real_wavetable = gsl_fft_real_wavetable_alloc (s->n);
+  s->hc_wavetable = gsl_fft_halfcomplex_wavetable_alloc (s->n);
+  s->real_work = gsl_fft_real_workspace_alloc (s->n);
+
+  if (s->H == NULL || s->buf == NULL || s->work == NULL ||
+      s->real_wavetable == NULL || s->hc_wavetable == NULL ||
+      s->real_work == NULL)
+    {
+      gsl_fft_conv_stream_free (s);
+      GSL_ERROR_NULL ("failed to allocate space for stream", GSL_ENOMEM);
+    }
+
+  /* filter spectrum, including the 1/n normalization of the inverse */
+
+  for (i = 0; i < nh; ++i)
+    s->H[i] = h[i] / (double) s->n;
+
+  for (i = nh; i < s->n; ++i)
+    s->H[i] = 0.0;
+
+  gsl_fft_real_transform (s->H, 1, s->n, s->real_wavetable, s->real_work);
+
+  gsl_fft_conv_stream_reset (s);
+
+  return s;
+}
+
+void
+gsl_fft_conv_stream_free (gsl_fft_conv_stream * s)
+{
+  RETURN_IF_NULL (s);
+
+  if (s->H)
+    free (s->H);
+
+  if (s->buf)
+    free (s->buf);
+
+  if (s->work)
+    free (s->work);
+
+  if (s->real_wavetable)
+    gsl_fft_real_wavetable_free (s->real_wavetable);
+
+  if (s->hc_wavetable)
+    gsl_fft_halfcomplex_wavetable_free (s->hc_wavetable);
+
+  if (s->real_work)
+    gsl_fft_real_workspace_free (s->real_work);
+
+  free (s);
+}
+
+/*
+gsl_fft_conv_stream_reset()
+  Reset the stream to the start of a new signal, preceded by zeros
+*/
+
+int
+gsl_fft_conv_stream_reset (gsl_fft_conv_stream * s)
+{
+  size_t i;
+
+  for (i = 0; i < s->n; ++i)
+    s->buf[i] = 0.0;
+
+  s->pos = 0;
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_fft_conv_stream_process()
+  Filter the next block of a signal
+
+Inputs: x - next n samples of the signal
+        n - number of samples
+        y - (output) y_t = sum_j h_j x_{t-j}, for the same n samples;
+            may be the same array as x
+        s - stream
+
+Notes:
+1) The buffer holds the last nh - 1 samples of the signal followed by
+the samples of the current block. When the block is not yet full, the
+missing samples are taken as zero; since the output of a sample only
+depends on earlier ones, the outputs of the samples present are exact,
+and they are not computed again when the block is completed. Calls
+with n a multiple of n - nh + 1 need one transform per block
+*/
+
+int
+gsl_fft_conv_stream_process (const double x[], const size_t n, double y[],
+                             gsl_fft_conv_stream * s)
+{
+  const size_t h = s->nh - 1;          /* length of history */
+  const size_t L = s->n - h;           /* new samples per block */
+  size_t done = 0;
+
+  while (done < n)
+    {
+      const size_t m = GSL_MIN (n - done, L - s->pos);
+      double *in = s->buf + h + s->pos;
+      size_t i;
+      int status;
+
+      for (i = 0; i < m; ++i)
+        in[i] = x[done + i];
+
+      for (i = 0; i < h + s->pos + m; ++i)
+        s->work[i] = s->buf[i];
+
+      for (i = h + s->pos + m; i < s->n; ++i)
+        s->work[i] = 0.0;
+
+      status = gsl_fft_real_transform (s->work, 1, s->n, s->real_wavetable,
+                                       s->real_work);
+      if (status)
+        return status;
+
+      conv_hc_multiply (s->work, s->H, s->n, 0);
+
+      status = gsl_fft_halfcomplex_transform (s->work, 1, s->n, s->hc_wavetable,
+                                              s->real_work);
+      if (status)
+        return status;
+
+      for (i = 0; i < m; ++i)
+        y[done + i] = s->work[h + s->pos + i];
+
+      s->pos += m;
+      done += m;
+
+      if (s->pos == L)
+        {
+          /* keep the last h samples as history of the next block */
+          memmove (s->buf, s->buf + L, h * sizeof (double));
+          s->pos = 0;
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+static int
+conv_real (const double a[], const size_t na,
+           const double b[], const size_t nb, double c[],
+           const int corr, const int circular,
+           gsl_fft_conv_workspace * w)
+{
+  const size_t nc = circular ? na : na + nb - 1;
+
+  if (na == 0 || nb == 0)
+    {
+      GSL_ERROR ("length must be positive integer", GSL_EDOM);
+    }
+  else if (!conv_use_fft (na, nb, circular ? na : conv_fast_length (nc)))
+    {
+      conv_real_direct (a, na, b, nb, c, corr, circular);
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      const size_t n = circular ? na : conv_fast_length (nc);
+
+      if (n > w->nmax)
+        {
+          GSL_ERROR ("workspace is too small for sequence lengths", GSL_EBADLEN);
+        }
+
+      /* c[0] is the lag -(nb-1) of linear correlations */
+      return conv_real_fft (a, na, b, nb, c, nc, n, corr,
+                            (corr && !circular) ? nb - 1 : 0, w);
+    }
+}
+
+static int
+conv_complex (const double a[], const size_t na,
+              const double b[], const size_t nb, double c[],
+              const int corr, const int circular,
+              gsl_fft_conv_workspace * w)
+{
+  const size_t nc = circular ? na : na + nb - 1;
+
+  if (na == 0 || nb == 0)
+    {
+      GSL_ERROR ("length must be positive integer", GSL_EDOM);
+    }
+  else if (!conv_use_fft (na, nb, circular ? na : conv_fast_length (nc)))
+    {
+      conv_complex_direct (a, na, b, nb, c, corr, circular);
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      const size_t n = circular ? na : conv_fast_length (nc);
+
+      if (n > w->nmax)
+        {
+          GSL_ERROR ("workspace is too small for sequence lengths", GSL_EBADLEN);
+        }
+
+      return conv_complex_fft (a, na, b, nb, c, nc, n, corr,
+                               (corr && !circular) ? nb - 1 : 0, w);
+    }
+}
+
+/* smallest length >= n whose only prime factors are 2, 3 and 5 */
+
+static size_t
+conv_fast_length (const size_t n)
+{
+  size_t m = n;
+
+  while (1)
+    {
+      size_t r = m;
+
+      while (r % 2 == 0)
+        r /= 2;
+      while (r % 3 == 0)
+        r /= 3;
+      while (r % 5 == 0)
+        r /= 5;
+
+      if (r == 1)
+        return m;
+
+      ++m;
+    }
+}
+
+static int
+conv_use_fft (const size_t na, const size_t nb, const size_t n)
+{
+  const double direct = (double) na * (double) nb;
+  const double fft = FFT_CONV_RATIO * (double) n * log ((double) n) / M_LN2;
+
+  return direct > fft;
+}
+
+/* keep real and complex workspaces of the most recent length */
+
+static int
+conv_real_workspace (gsl_fft_conv_workspace * w, const size_t n)
+{
+  if (w->real_work != NULL && w->real_work->n == n)
+    return GSL_SUCCESS;
+
+  if (w->real_work != NULL)
+    gsl_fft_real_workspace_free (w->real_work);
+
+  w->real_work = gsl_fft_real_workspace_alloc (n);
+  if (w->real_work == NULL)
+    {
+      GSL_ERROR ("failed to allocate real workspace", GSL_ENOMEM);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static int
+conv_complex_workspace (gsl_fft_conv_workspace * w, const size_t n)
+{
+  if (w->complex_work != NULL && w->complex_work->n == n)
+    return GSL_SUCCESS;
+
+  if (w->complex_work != NULL)
+    gsl_fft_complex_workspace_free (w->complex_work);
+
+  w->complex_work = gsl_fft_complex_workspace_alloc (n);
+  if (w->complex_work == NULL)
+    {
+      GSL_ERROR ("failed to allocate complex workspace", GSL_ENOMEM);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static void
+conv_real_direct (const double a[], const size_t na,
+                  const double b[], const size_t nb,
+                  double c[], const int corr, const int circular)
+{
+  size_t j, k;
+
+  if (circular)
+    {
+      const size_t n = na;
+
+      for (k = 0; k < n; ++k)
+        {
+          double sum = 0.0;
+
+          if (corr)
+            {
+              for (j = 0; j < n; ++j)
+                sum += a[(j + k) % n] * b[j];
+            }
+          else
+            {
+              for (j = 0; j < n; ++j)
+                sum += a[j] * b[(k + n - j) % n];
+            }
+
+          c[k] = sum;
+        }
+    }
+  else
+    {
+      for (k = 0; k < na + nb - 1; ++k)
+        {
+          double sum = 0.0;
+
+          if (corr)
+            {
+              /* a index i = j + k - (nb-1) in [0,na) */
+              const size_t jmin = (k < nb - 1) ? nb - 1 - k : 0;
+              const size_t jmax = GSL_MIN (nb, na + nb - 1 - k);
+
+              for (j = jmin; j < jmax; ++j)
+                sum += a[j + k - (nb - 1)] * b[j];
+            }
+          else
+            {
+              const size_t jmin = (k >= nb) ? k - nb + 1 : 0;
+              const size_t jmax = GSL_MIN (na - 1, k);
+
+              for (j = jmin; j <= jmax; ++j)
+                sum += a[j] * b[k - j];
+            }
+
+          c[k] = sum;
+        }
+    }
+}
+
+static void
+conv_complex_direct (const double a[], const size_t na,
+                     const double b[], const size_t nb,
+                     double c[], const int corr, const int circular)
+{
+  /* conjugate b for correlations */
+  const double s = corr ? -1.0 : 1.0;
+  size_t j, k;
+
+  for (k = 0; k < (circular ? na : na + nb - 1); ++k)
+    {
+      double sum_real = 0.0, sum_imag = 0.0;
+      size_t jmin, jmax;
+
+      if (circular)
+        {
+          jmin = 0;
+          jmax = na;
+        }
+      else if (corr)
+        {
+          jmin = (k < nb - 1) ? nb - 1 - k : 0;
+          jmax = GSL_MIN (nb, na + nb - 1 - k);
+        }
+      else
+        {
+          jmin = (k >= nb) ? k - nb + 1 : 0;
+          jmax = GSL_MIN (na - 1, k) + 1;
+        }
+
+      for (j = jmin; j < jmax; ++j)
+        {
+          size_t ia, ib;
+          double x_real, x_imag, y_real, y_imag;
+
+          if (corr)
+            {
+              ia = circular ? (j + k) % na : j + k - (nb - 1);
+              ib = j;
+            }
+          else
+            {
+              ia = j;
+              ib = circular ? (k + na - j) % na : k - j;
+            }
+
+          x_real = REAL (a, 1, ia);
+          x_imag = IMAG (a, 1, ia);
+          y_real = REAL (b, 1, ib);
+          y_imag = s * IMAG (b, 1, ib);
+
+          sum_real += x_real * y_real - x_imag * y_imag;
+          sum_imag += x_real * y_imag + x_imag * y_real;
+        }
+
+      REAL (c, 1, k) = sum_real;
+      IMAG (c, 1, k) = sum_imag;
+    }
+}
+
+/* x := x * y, or x * conj(y), for halfcomplex sequences of length n */
+
+static void
+conv_hc_multiply (double x[], const double y[], const size_t n,
+                  const int conj)
+{
+  const double s = conj ? -1.0 : 1.0;
+  size_t k;
+
+  x[0] *= y[0];
+
+  for (k = 1; k < n - k; ++k)
+    {
+      const double x_real = x[2 * k - 1];
+      const double x_imag = x[2 * k];
+      const double y_real = y[2 * k - 1];
+      const double y_imag = s * y[2 * k];
+
+      x[2 * k - 1] = x_real * y_real - x_imag * y_imag;
+      x[2 * k] = x_real * y_imag + x_imag * y_real;
+    }
+
+  if (k == n - k)
+    x[n - 1] *= y[n - 1];
+}
+
+static int
+conv_real_fft (const double a[], const size_t na,
+               const double b[], const size_t nb, double c[],
+               const size_t nc, const size_t n, const int corr,
+               const size_t shift, gsl_fft_conv_workspace * w)
+{
+  const gsl_fft_real_wavetable *rw;
+  const gsl_fft_halfcomplex_wavetable *hw;
+  size_t i;
+  int status;
+
+  status = conv_real_workspace (w, n);
+  if (status)
+    return status;
+
+  rw = gsl_fft_cache_real (w->cache, n);
+  hw = gsl_fft_cache_halfcomplex (w->cache, n);
+  if (rw == NULL || hw == NULL)
+    {
+      GSL_ERROR ("failed to allocate wavetables", GSL_ENOMEM);
+    }
+
+  for (i = 0; i < na; ++i)
+    w->fa[i] = a[i];
+  for (i = na; i < n; ++i)
+    w->fa[i] = 0.0;
+
+  for (i = 0; i < nb; ++i)
+    w->fb[i] = b[i];
+  for (i = nb; i < n; ++i)
+    w->fb[i] = 0.0;
+
+  gsl_fft_real_transform (w->fa, 1, n, rw, w->real_work);
+  gsl_fft_real_transform (w->fb, 1, n, rw, w->real_work);
+
+  conv_hc_multiply (w->fa, w->fb, n, corr);
+
+  status = gsl_fft_halfcomplex_inverse (w->fa, 1, n, hw, w->real_work);
+
+  gsl_fft_cache_release (w->cache, rw);
+  gsl_fft_cache_release (w->cache, hw);
+
+  if (status)
+    return status;
+
+  for (i = 0; i < nc; ++i)
+    c[i] = w->fa[(i + n - shift) % n];
+
+  return GSL_SUCCESS;
+}
+
+static int
+conv_complex_fft (const double a[], const size_t na,
+                  const double b[], const size_t nb, double c[],
+                  const size_t nc, const size_t n, const int corr,
+                  const size_t shift, gsl_fft_conv_workspace * w)
+{
+  const double s = corr ? -1.0 : 1.0;
+  const gsl_fft_complex_wavetable *cw;
+  size_t i;
+  int status;
+
+  status = conv_complex_workspace (w, n);
+  if (status)
+    return status;
+
+  cw = gsl_fft_cache_complex (w->cache, n);
+  if (cw == NULL)
+    {
+      GSL_ERROR ("failed to allocate wavetable", GSL_ENOMEM);
+    }
+
+  for (i = 0; i < 2 * na; ++i)
+    w->fa[i] = a[i];
+  for (i = 2 * na; i < 2 * n; ++i)
+    w->fa[i] = 0.0;
+
+  for (i = 0; i < 2 * nb; ++i)
+    w->fb[i] = b[i];
+  for (i = 2 * nb; i < 2 * n; ++i)
+    w->fb[i] = 0.0;
+
+  gsl_fft_complex_forward (w->fa, 1, n, cw, w->complex_work);
+  gsl_fft_complex_forward (w->fb, 1, n, cw, w->complex_work);
+
+  for (i = 0; i < n; ++i)
+    {
+      const double x_real = REAL (w->fa, 1, i);
+      const double x_imag = IMAG (w->fa, 1, i);
+      const double y_real = REAL (w->fb, 1, i);
+      const double y_imag = s * IMAG (w->fb, 1, i);
+
+      REAL (w->fa, 1, i) = x_real * y_real - x_imag * y_imag;
+      IMAG (w->fa, 1, i) = x_real * y_imag + x_imag * y_real;
+    }
+
+  status = gsl_fft_complex_inverse (w->fa, 1, n, cw, w->complex_work);
+
+  gsl_fft_cache_release (w->cache, cw);
+
+  if (status)
+    return status;
+
+  for (i = 0; i < nc; ++i)
+    {
+      const size_t j = (i + n - shift) % n;
+
+      REAL (c, 1, i) = REAL (w->fa, 1, j);
+      IMAG (c, 1, i) = IMAG (w->fa, 1, j);
+    }
+
+  return GSL_SUCCESS;
+}
@@ -0,0 +1,719 @@
+/* fft/dct.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Discrete cosine and sine transforms of types I-IV and the MDCT,
+ * computed in O(n log n) with the mixed-radix FFTs:
+ *
+ * DCT-I:   real FFT of the even extension, length 2(n-1)
+ * DST-I:   real FFT of the odd extension, length 2(n+1)
+ * DCT-II:  real FFT of length n of the even samples followed by the
+ *          odd samples in reverse order, and a post-twiddle (Makhoul)
+ * DCT-III: pre-twiddle and halfcomplex FFT of length n, the inverse of
+ *          the DCT-II steps
+ * DCT-IV:  complex FFT of length n/2 with pre- and post-twiddles for
+ *          even n, or of the zero padded input of length 2n for odd n
+ *
+ * The DST of types II-IV are obtained from the DCT of the same type by
+ * reversing and changing the signs of alternate inputs or outputs. The
+ * twiddle factors are computed once when the workspace is allocated.
+ * The transforms are not normalized and follow the conventions of
+ * FFTW (REDFT00-REDFT11 and RODFT00-RODFT11).
+ */
+
+#include <config.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_fft_dct.h>
+
+#define FFT_DCT_BLOCK 8
+
+static int dct_apply (double x[], gsl_fft_dct_workspace * w);
+static int dct1 (double x[], gsl_fft_dct_workspace * w);
+static int dst1 (double x[], gsl_fft_dct_workspace * w);
+static int dct2 (double x[], gsl_fft_dct_workspace * w);
+static int dct3 (double x[], gsl_fft_dct_workspace * w);
+static int dct4 (double x[], gsl_fft_dct_workspace * w);
+static void dct_reverse (double x[], const size_t n);
+static void dct_alternate (double x[], const size_t n);
+
+/*
+gsl_fft_dct_alloc()
+  Allocate a workspace for a discrete cosine or sine transform
+
+Inputs: type - type of transform
+        n    - length of transform, at least 2 for the DCT-I
+
+Return: pointer to workspace
+*/
+
+gsl_fft_dct_workspace *
+gsl_fft_dct_alloc (const gsl_fft_dct_type type, const size_t n)
+{
+  gsl_fft_dct_workspace *w;
+  size_t k;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("length n must be positive integer", GSL_EDOM);
+    }
+  else if (type == GSL_FFT_DCT1 && n < 2)
+    {
+      GSL_ERROR_NULL ("DCT-I requires n >= 2", GSL_EDOM);
+    }
+  else if (type > GSL_FFT_DST4)
+    {
+      GSL_ERROR_NULL ("unknown transform type", GSL_EINVAL);
+    }
+
+  w = calloc (1, sizeof (gsl_fft_dct_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->type = type;
+  w->n = n;
+
+  w->twiddle = malloc (4 * n * sizeof (double));
+  w->work = malloc ((4 * n + 4) * sizeof (double));
+  w->buf = malloc (FFT_DCT_BLOCK * n * sizeof (double));
+
+  if (w->twiddle == NULL || w->work == NULL || w->buf == NULL)
+    {
+      gsl_fft_dct_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  switch (type)
+    {
+      case GSL_FFT_DCT1:
+      case GSL_FFT_DST1:
+        w->nfft = (type == GSL_FFT_DCT1) ? 2 * (n - 1) : 2 * (n + 1);
+        w->real_wavetable = gsl_fft_real_wavetable_alloc (w->nfft);
+        w->real_work = gsl_fft_real_workspace_alloc (w->nfft);
+        if (w->real_wavetable == NULL || w->real_work == NULL)
+          break;
+        return w;
+
+      case GSL_FFT_DCT2:
+      case GSL_FFT_DCT3:
+      case GSL_FFT_DST2:
+      case GSL_FFT_DST3:
+        w->nfft = n;
+
+        if (type == GSL_FFT_DCT2 || type == GSL_FFT_DST2)
+          w->real_wavetable = gsl_fft_real_wavetable_alloc (n);
+        else
+          w->hc_wavetable = gsl_fft_halfcomplex_wavetable_alloc (n);
+
+        w->real_work = gsl_fft_real_workspace_alloc (n);
+        if ((w->real_wavetable == NULL && w->hc_wavetable == NULL) ||
+            w->real_work == NULL)
+          break;
+
+        /* exp(-i pi k / 2n) */
+        for (k = 0; k < n; ++k)
+          {
+            const double theta = M_PI * (double) k / (2.0 * n);
+            w->twiddle[2 * k] = cos (theta);
+            w->twiddle[2 * k + 1] = sin (theta);
+          }
+
+        return w;
+
+      case GSL_FFT_DCT4:
+      case GSL_FFT_DST4:
+        w->nfft = (n % 2 == 0) ? n / 2 : 2 * n;
+        w->complex_wavetable = gsl_fft_complex_wavetable_alloc (w->nfft);
+        w->complex_work = gsl_fft_complex_workspace_alloc (w->nfft);
+        if (w->complex_wavetable == NULL || w->complex_work == NULL)
+          break;
+
+        if (n % 2 == 0)
+          {
+            const size_t m = n / 2;
+
+            /* pre-twiddle exp(-i pi (k + 1/4) / n), post-twiddle
+               exp(-i pi k / n) */
+            for (k = 0; k < m; ++k)
+              {
+                const double theta1 = M_PI * ((double) k + 0.25) / (double) n;
+                const double theta2 = M_PI * (double) k / (double) n;
+                w->twiddle[2 * k] = cos (theta1);
+                w->twiddle[2 * k + 1] = -sin (theta1);
+                w->twiddle[2 * (m + k)] = cos (theta2);
+                w->twiddle[2 * (m + k) + 1] = -sin (theta2);
+              }
+          }
+        else
+          {
+            /* pre-twiddle exp(-i pi k / 2n), post-twiddle
+               exp(-i pi (2k + 1) / 4n) */
+            for (k = 0; k < n; ++k)
+              {
+                const double theta1 = M_PI * (double) k / (2.0 * n);
+                const double theta2 = M_PI * (2.0 * k + 1.0) / (4.0 * n);
+                w->twiddle[2 * k] = cos (theta1);
+                w->twiddle[2 * k + 1] = -sin (theta1);
+                w->twiddle[2 * (n + k)] = cos (theta2);
+                w->twiddle[2 * (n + k) + 1] = -sin (theta2);
+              }
+          }
+
+        return w;
+    }
+
+  gsl_fft_dct_free (w);
+  GSL_ERROR_NULL ("failed to allocate FFT wavetable", GSL_ENOMEM);
+}
+
+void
+gsl_fft_dct_free (gsl_fft_dct_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->real_wavetable)
+    gsl_fft_real_wavetable_free (w->real_wavetable);
+
+  if (w->hc_wavetable)
+    gsl_fft_halfcomplex_wavetable_free (w->hc_wavetable);
+
+  if (w->real_work)
+    gsl_fft_real_workspace_free (w->real_work);
+
+  if (w->complex_wavetable)
+    gsl_fft_complex_wavetable_free (w->complex_wavetable);
+
+  if (w->complex_work)
+    gsl_fft_complex_workspace_free (w->complex_work);
+
+  if (w->twiddle)
+    free (w->twiddle);
+
+  if (w->work)
+    free (w->work);
+
+  if (w->buf)
+    free (w->buf);
+
+  free (w);
+}
+
+/*
+gsl_fft_dct_transform()
+  Compute a discrete cosine or sine transform in-place
+
+Inputs: data   - input/output data, length n
+        stride - stride of data
+        w      - workspace of the type and length of the transform
+*/
+
+int
+gsl_fft_dct_transform (double data[], const size_t stride,
+                       gsl_fft_dct_workspace * w)
+{
+  return gsl_fft_dct_batch (data, stride, 0, 1, w);
+}
+
+/*
+gsl_fft_dct_batch()
+  Compute howmany transforms in-place, with element j of transform t
+at index t*dist + j*stride
+
+Notes:
+1) Strided transforms are gathered FFT_DCT_BLOCK at a time into
+contiguous storage, so that interleaved data (dist = 1) is read in
+short contiguous runs
+*/
+
+int
+gsl_fft_dct_batch (double data[], const size_t stride, const size_t dist,
+                   const size_t howmany, gsl_fft_dct_workspace * w)
+{
+  const size_t n = w->n;
+  size_t t, tt, j;
+  int status;
+
+  if (stride == 0)
+    {
+      GSL_ERROR ("stride must be positive integer", GSL_EINVAL);
+    }
+
+  if (stride == 1)
+    {
+      for (t = 0; t < howmany; ++t)
+        {
+          status = dct_apply (data + t * dist, w);
+          if (status)
+            return status;
+        }
+
+      return GSL_SUCCESS;
+    }
+
+  for (t = 0; t < howmany; t += FFT_DCT_BLOCK)
+    {
+      const size_t nb = GSL_MIN (FFT_DCT_BLOCK, howmany - t);
+      double *x = data + t * dist;
+
+      for (j = 0; j < n; ++j)
+        for (tt = 0; tt < nb; ++tt)
+          w->buf[tt * n + j] = x[tt * dist + j * stride];
+
+      for (tt = 0; tt < nb; ++tt)
+        {
+          status = dct_apply (w->buf + tt * n, w);
+          if (status)
+            return status;
+        }
+
+      for (j = 0; j < n; ++j)
+        for (tt = 0; tt < nb; ++tt)
+          x[tt * dist + j * stride] = w->buf[tt * n + j];
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_fft_dct2d_transform()
+  Compute a two dimensional transform in-place
+
+Inputs: data - matrix, size1-by-size2, in row-major order
+        tda  - leading dimension of data, >= size2
+        w1   - workspace for the columns, of length size1
+        w2   - workspace for the rows, of length size2
+
+Notes:
+1) The transform types of w1 and w2 may differ
+*/
+
+int
+gsl_fft_dct2d_transform (double data[], const size_t tda,
+                         gsl_fft_dct_workspace * w1,
+                         gsl_fft_dct_workspace * w2)
+{
+  if (tda < w2->n)
+    {
+      GSL_ERROR ("tda must be at least size2", GSL_EBADLEN);
+    }
+  else
+    {
+      int status = gsl_fft_dct_batch (data, 1, tda, w1->n, w2);
+
+      if (status)
+        return status;
+
+      return gsl_fft_dct_batch (data, tda, 1, w2->n, w1);
+    }
+}
+
+/*
+gsl_fft_mdct_forward()
+  Compute the modified discrete cosine transform
+
+  X_k = sum_{j=0}^{2n-1} x_j cos(pi/n (j + 1/2 + n/2) (k + 1/2))
+
+Inputs: in  - input block, length 2n
+        out - (output) coefficients, length n
+        w   - DCT-IV workspace of even length n
+
+Notes:
+1) With in = (a, b, c, d) in blocks of n/2, X is half the DCT-IV of
+(-c_r - d, a - b_r), where _r denotes reversal
+*/
+
+int
+gsl_fft_mdct_forward (const double in[], double out[],
+                      gsl_fft_dct_workspace * w)
+{
+  const size_t n = w->n;
+  const size_t h = n / 2;
+  size_t j;
+  int status;
+
+  if (w->type != GSL_FFT_DCT4)
+    {
+      GSL_ERROR ("workspace must be of type GSL_FFT_DCT4", GSL_EINVAL);
+    }
+  else if (n % 2 != 0)
+    {
+      GSL_ERROR ("MDCT length must be even", GSL_EBADLEN);
+    }
+
+  for (j = 0; j < h; ++j)
+    {
+      out[j] = -in[3 * h - 1 - j] - in[3 * h + j];
+      out[h + j] = in[j] - in[n - 1 - j];
+    }
+
+  status = dct_apply (out, w);
+  if (status)
+    return status;
+
+  for (j = 0; j < n; ++j)
+    out[j] *= 0.5;
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_fft_mdct_backward()
+  Compute the inverse modified discrete cosine transform, without
+normalization
+
+  y_j = sum_{k=0}^{n-1} X_k cos(pi/n (j + 1/2 + n/2) (k + 1/2))
+
+Inputs: in  - coefficients, length n
+        out - (output) block, length 2n
+        w   - DCT-IV workspace of even length n
+
+Notes:
+1) With u = DCT-IV(X)/2 = (u1, u2) in blocks of n/2, the output is
+(u2, -u2_r, -u1_r, -u1)
+
+2) With a window w_j satisfying w_j^2 + w_{j+n}^2 = 1 applied before
+the forward and after the backward transform, overlapping and adding
+the second half of one output block to the first half of the next
+reconstructs the signal up to a factor n/2 (time domain aliasing
+cancellation)
+*/
+
+int
+gsl_fft_mdct_backward (const double in[], double out[],
+                       gsl_fft_dct_workspace * w)
+{
+  const size_t n = w->n;
+  const size_t h = n / 2;
+  double *u = w->buf;
+  size_t j;
+  int status;
+
+  if (w->type != GSL_FFT_DCT4)
+    {
+      GSL_ERROR ("workspace must be of type GSL_FFT_DCT4", GSL_EINVAL);
+    }
+  else if (n % 2 != 0)
+    {
+      GSL_ERROR ("MDCT length must be even", GSL_EBADLEN);
+    }
+
+  for (j = 0; j < n; ++j)
+    u[j] = 0.5 * in[j];
+
+  status = dct_apply (u, w);
+  if (status)
+    return status;
+
+  for (j = 0; j < h; ++j)
+    {
+      out[j] = u[h + j];
+      out[3 * h + j] = -u[j];
+    }
+
+  for (j = h; j < 3 * h; ++j)
+    out[j] = -u[3 * h - 1 - j];
+
+  return GSL_SUCCESS;
+}
+
+/* transform contiguous data in-place */
+
+static int
+dct_apply (double x[], gsl_fft_dct_workspace * w)
+{
+  const size_t n = w->n;
+  int status;
+
+  switch (w->type)
+    {
+      case GSL_FFT_DCT1:
+        return dct1 (x, w);
+
+      case GSL_FFT_DST1:
+        return dst1 (x, w);
+
+      case GSL_FFT_DCT2:
+        return dct2 (x, w);
+
+      case GSL_FFT_DCT3:
+        return dct3 (x, w);
+
+      case GSL_FFT_DCT4:
+        return dct4 (x, w);
+
+      case GSL_FFT_DST2:
+        /* DST-II(x)_k = DCT-II((-1)^j x_j)_{n-1-k} */
+        dct_alternate (x, n);
+        status = dct2 (x, w);
+        dct_reverse (x, n);
+        return status;
+
+      case GSL_FFT_DST3:
+        /* DST-III(x)_k = (-1)^k DCT-III(x_{n-1-j})_k */
+        dct_reverse (x, n);
+        status = dct3 (x, w);
+        dct_alternate (x, n);
+        return status;
+
+      case GSL_FFT_DST4:
+        /* DST-IV(x)_k = (-1)^k DCT-IV(x_{n-1-j})_k */
+        dct_reverse (x, n);
+        status = dct4 (x, w);
+        dct_alternate (x, n);
+        return status;
+
+      default:
+        GSL_ERROR ("unknown transform type", GSL_EINVAL);
+    }
+}
+
+/* DCT-I from the even extension (x_0, ..., x_{n-1}, x_{n-2}, ..., x_1) */
+
+static int
+dct1 (double x[], gsl_fft_dct_workspace * w)
+{
+  const size_t n = w->n;
+  const size_t nfft = w->nfft;
+  double *y = w->work;
+  size_t j;
+  int status;
+
+  for (j = 0; j < n; ++j)
+    y[j] = x[j];
+
+  for (j = 1; j < n - 1; ++j)
+    y[nfft - j] = x[j];
+
+  status = gsl_fft_real_transform (y, 1, nfft, w->real_wavetable, w->real_work);
+  if (status)
+    return status;
+
+  /* real parts of the halfcomplex result */
+  x[0] = y[0];
+
+  for (j = 1; j < n - 1; ++j)
+    x[j] = y[2 * j - 1];
+
+  x[n - 1] = y[nfft - 1];
+
+  return GSL_SUCCESS;
+}
+
+/* DST-I from the odd extension (0, x_0, ..., x_{n-1}, 0, -x_{n-1}, ..., -x_0) */
+
+static int
+dst1 (double x[], gsl_fft_dct_workspace * w)
+{
+  const size_t n = w->n;
+  const size_t nfft = w->nfft;
+  double *y = w->work;
+  size_t j;
+  int status;
+
+  y[0] = 0.0;
+  y[n + 1] = 0.0;
+
+  for (j = 0; j < n; ++j)
+    {
+      y[j + 1] = x[j];
+      y[nfft - 1 - j] = -x[j];
+    }
+
+  status = gsl_fft_real_transform (y, 1, nfft, w->real_wavetable, w->real_work);
+  if (status)
+    return status;
+
+  /* minus the imaginary parts of the halfcomplex result */
+  for (j = 0; j < n; ++j)
+    x[j] = -y[2 * j + 2];
+
+  return GSL_SUCCESS;
+}
+
+static int
+dct2 (double x[], gsl_fft_dct_workspace * w)
+{
+  const size_t n = w->n;
+  const double *tw = w->twiddle;
+  double *v = w->work;
+  size_t j, k;
+  int status;
+
+  /* even samples followed by odd samples in reverse order */
+  for (j = 0; 2 * j < n; ++j)
+    v[j] = x[2 * j];
+
+  for (j = 0; 2 * j + 1 < n; ++j)
+    v[n - 1 - j] = x[2 * j + 1];
+
+  status = gsl_fft_real_transform (v, 1, n, w->real_wavetable, w->real_work);
+  if (status)
+    return status;
+
+  /* X_k = 2 Re(exp(-i pi k / 2n) V_k) */
+  x[0] = 2.0 * v[0];
+
+  for (k = 1; k < n - k; ++k)
+    {
+      const double v_real = v[2 * k - 1];
+      const double v_imag = v[2 * k];
+
+      x[k] = 2.0 * (tw[2 * k] * v_real + tw[2 * k + 1] * v_imag);
+
+      /* V_{n-k} = conj(V_k) */
+      x[n - k] = 2.0 * (tw[2 * (n - k)] * v_real - tw[2 * (n - k) + 1] * v_imag);
+    }
+
+  if (k == n - k)
+    x[k] = 2.0 * tw[2 * k] * v[n - 1];
+
+  return GSL_SUCCESS;
+}
+
+static int
+dct3 (double x[], gsl_fft_dct_workspace * w)
+{
+  const size_t n = w->n;
+  const double *tw = w->twiddle;
+  double *v = w->work;
+  size_t j, k;
+  int status;
+
+  /* V_k = exp(i pi k / 2n) (x_k - i x_{n-k}), in halfcomplex order */
+  v[0] = x[0];
+
+  for (k = 1; k < n - k; ++k)
+    {
+      const double c = tw[2 * k];
+      const double s = tw[2 * k + 1];
+
+      v[2 * k - 1] = c * x[k] + s * x[n - k];
+      v[2 * k] = s * x[k] - c * x[n - k];
+    }
+
+  if (k == n - k)
+    v[n - 1] = (tw[2 * k] + tw[2 * k + 1]) * x[k];
+
+  status = gsl_fft_halfcomplex_transform (v, 1, n, w->hc_wavetable, w->real_work);
+  if (status)
+    return status;
+
+  for (j = 0; 2 * j < n; ++j)
+    x[2 * j] = v[j];
+
+  for (j = 0; 2 * j + 1 < n; ++j)
+    x[2 * j + 1] = v[n - 1 - j];
+
+  return GSL_SUCCESS;
+}
+
+static int
+dct4 (double x[], gsl_fft_dct_workspace * w)
+{
+  const size_t n = w->n;
+  const double *tw = w->twiddle;
+  double *z = w->work;
+  size_t j, k;
+  int status;
+
+  if (n % 2 == 0)
+    {
+      const size_t m = n / 2;
+      const double *post = tw + 2 * m;
+
+      /* z_j = (x_{2j} + i x_{n-1-2j}) exp(-i pi (j + 1/4) / n) */
+      for (j = 0; j < m; ++j)
+        {
+          const double a = x[2 * j];
+          const double b = x[n - 1 - 2 * j];
+
+          z[2 * j] = tw[2 * j] * a - tw[2 * j + 1] * b;
+          z[2 * j + 1] = tw[2 * j] * b + tw[2 * j + 1] * a;
+        }
+
+      status = gsl_fft_complex_forward (z, 1, m, w->complex_wavetable,
+                                        w->complex_work);
+      if (status)
+        return status;
+
+      /* u_k = Z_k exp(-i pi k / n), X_{2k} = 2 Re u_k,
+         X_{n-1-2k} = -2 Im u_k */
+      for (k = 0; k < m; ++k)
+        {
+          const double u_real = post[2 * k] * z[2 * k] - post[2 * k + 1] * z[2 * k + 1];
+          const double u_imag = post[2 * k] * z[2 * k + 1] + post[2 * k + 1] * z[2 * k];
+
+          x[2 * k] = 2.0 * u_real;
+          x[n - 1 - 2 * k] = -2.0 * u_imag;
+        }
+    }
+  else
+    {
+      const double *post = tw + 2 * n;
+
+      /* transform of x_j exp(-i pi j / 2n), zero padded to 2n */
+      for (j = 0; j < n; ++j)
+        {
+          z[2 * j] = tw[2 * j] * x[j];
+          z[2 * j + 1] = tw[2 * j + 1] * x[j];
+        }
+
+      for (j = 2 * n; j < 4 * n; ++j)
+        z[j] = 0.0;
+
+      status = gsl_fft_complex_forward (z, 1, 2 * n, w->complex_wavetable,
+                                        w->complex_work);
+      if (status)
+        return status;
+
+      /* X_k = 2 Re(exp(-i pi (2k + 1) / 4n) Z_k) */
+      for (k = 0; k < n; ++k)
+        x[k] = 2.0 * (post[2 * k] * z[2 * k] - post[2 * k + 1] * z[2 * k + 1]);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static void
+dct_reverse (double x[], const size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n / 2; ++i)
+    {
+      const double tmp = x[i];
+      x[i] = x[n - 1 - i];
+      x[n - 1 - i] = tmp;
+    }
+}
+
+static void
+dct_alternate (double x[], const size_t n)
+{
+  size_t i;
+
+  for (i = 1; i < n; i += 2)
+    x[i] = -x[i];
+}
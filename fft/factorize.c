@@ -174,3 +174,48 @@ fft_binary_logn (const size_t n)
 
 
 
+
+/* length of the cyclic convolution used by Bluestein's algorithm for a
+   factor f, the smallest power of 2 which is at least 2f-1 */
+
+static size_t
+fft_bluestein_length (const size_t f)
+{
+  size_t m = 1;
+
+  while (m < 2 * f - 1)
+    {
+      m *= 2;
+    }
+
+  return m;
+}
+
+/* largest convolution length needed by the complex transform of
+   length n, or 0 if all factors are handled by the direct passes */
+
+static size_t
+fft_complex_bluestein_size (const size_t n)
+{
+  size_t factors[64];
+  size_t nf, i;
+  size_t size = 0;
+
+  if (n < 2 || fft_complex_factorize (n, &nf, factors))
+    {
+      return 0;
+    }
+
+  for (i = 0; i < nf; i++)
+    {
+      if (factors[i] > FFT_BLUESTEIN_MIN)
+        {
+          size_t m = fft_bluestein_length (factors[i]);
+
+          if (m > size)
+            size = m;
+        }
+    }
+
+  return size;
+}
@@ -27,3 +27,12 @@ static int fft_factorize (const size_t n, const size_t implemented_subtransforms
 
 static int fft_binary_logn (const size_t n) ;
 
+/* prime factors larger than this are transformed with Bluestein's
+   algorithm instead of the O(f^2) general pass */
+
+#define FFT_BLUESTEIN_MIN 85
+
+static size_t fft_bluestein_length (const size_t f);
+
+static size_t fft_complex_bluestein_size (const size_t n);
+
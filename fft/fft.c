@@ -26,6 +26,7 @@
 
 #define BASE_DOUBLE
 #include "templates_on.h"
+#include "c_bluestein.c"
 #include "c_init.c"
 #include "c_main.c"
 #include "c_pass_2.c"
@@ -41,6 +42,7 @@
 
 #define BASE_FLOAT
 #include "templates_on.h"
+#include "c_bluestein.c"
 #include "c_init.c"
 #include "c_main.c"
 #include "c_pass_2.c"
@@ -0,0 +1,302 @@
+/* fft/fft2d.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_fft2d.h>
+
+#include "fftnd.c"
+
+/*
+gsl_fft2d_alloc()
+  Allocate a workspace for two dimensional transforms
+
+Inputs: size1 - number of rows
+        size2 - number of columns
+
+Return: pointer to workspace
+*/
+
+gsl_fft2d_workspace *
+gsl_fft2d_alloc (const size_t size1, const size_t size2)
+{
+  gsl_fft2d_workspace *w;
+
+  if (size1 == 0 || size2 == 0)
+    {
+      GSL_ERROR_NULL ("dimensions must be positive integers", GSL_EINVAL);
+    }
+
+  w = calloc (1, sizeof (gsl_fft2d_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->size1 = size1;
+  w->size2 = size2;
+
+  w->wavetable1 = gsl_fft_complex_wavetable_alloc (size1);
+  w->wavetable2 = gsl_fft_complex_wavetable_alloc (size2);
+  w->real_wavetable = gsl_fft_real_wavetable_alloc (size2);
+  w->hc_wavetable = gsl_fft_halfcomplex_wavetable_alloc (size2);
+  w->work1 = gsl_fft_complex_workspace_alloc (size1);
+  w->work2 = gsl_fft_complex_workspace_alloc (size2);
+  w->real_work = gsl_fft_real_workspace_alloc (size2);
+  w->buf = malloc (FFTND_BUFSIZE (size1, size2) * sizeof (double));
+
+  if (w->wavetable1 == NULL || w->wavetable2 == NULL ||
+      w->real_wavetable == NULL || w->hc_wavetable == NULL ||
+      w->work1 == NULL || w->work2 == NULL || w->real_work == NULL ||
+      w->buf == NULL)
+    {
+      gsl_fft2d_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_fft2d_free (gsl_fft2d_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->wavetable1)
+    gsl_fft_complex_wavetable_free (w->wavetable1);
+
+  if (w->wavetable2)
+    gsl_fft_complex_wavetable_free (w->wavetable2);
+
+  if (w->real_wavetable)
+    gsl_fft_real_wavetable_free (w->real_wavetable);
+
+  if (w->hc_wavetable)
+    gsl_fft_halfcomplex_wavetable_free (w->hc_wavetable);
+
+  if (w->work1)
+    gsl_fft_complex_workspace_free (w->work1);
+
+  if (w->work2)
+    gsl_fft_complex_workspace_free (w->work2);
+
+  if (w->real_work)
+    gsl_fft_real_workspace_free (w->real_work);
+
+  if (w->buf)
+    free (w->buf);
+
+  free (w);
+}
+
+/*
+gsl_fft2d_complex_transform()
+  Compute the two dimensional transform of a complex matrix in-place
+
+Inputs: data - complex matrix, size1-by-size2, stored in row-major
+               order as packed real/imaginary pairs
+        tda  - leading dimension of data in complex elements, >= size2
+        sign - direction of transform
+        w    - workspace
+*/
+
+int
+gsl_fft2d_complex_transform (double data[], const size_t tda,
+                             const gsl_fft_direction sign,
+                             gsl_fft2d_workspace * w)
+{
+  if (tda < w->size2)
+    {
+      GSL_ERROR ("tda must be at least size2", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+
+      status = fftnd_rows (data, w->size1, w->size2, tda, w->wavetable2,
+                           w->work2, sign);
+      if (status)
+        return status;
+
+      status = fftnd_columns (data, w->size1, w->size2, tda, w->wavetable1,
+                              w->work1, w->buf, sign);
+
+      return status;
+    }
+}
+
+int
+gsl_fft2d_complex_forward (double data[], const size_t tda,
+                           gsl_fft2d_workspace * w)
+{
+  return gsl_fft2d_complex_transform (data, tda, gsl_fft_forward, w);
+}
+
+int
+gsl_fft2d_complex_backward (double data[], const size_t tda,
+                            gsl_fft2d_workspace * w)
+{
+  return gsl_fft2d_complex_transform (data, tda, gsl_fft_backward, w);
+}
+
+int
+gsl_fft2d_complex_inverse (double data[], const size_t tda,
+                           gsl_fft2d_workspace * w)
+{
+  int status = gsl_fft2d_complex_transform (data, tda, gsl_fft_backward, w);
+
+  if (status)
+    return status;
+
+  /* normalize inverse fft with 1/(size1*size2) */
+  {
+    const double norm = 1.0 / ((double) w->size1 * (double) w->size2);
+    size_t i, j;
+
+    for (i = 0; i < w->size1; ++i)
+      {
+        double *row = data + 2 * i * tda;
+
+        for (j = 0; j < 2 * w->size2; ++j)
+          row[j] *= norm;
+      }
+  }
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_fft2d_real_forward()
+  Compute the two dimensional transform of a real matrix
+
+Inputs: in      - real matrix, size1-by-size2
+        tda_in  - leading dimension of in, >= size2
+        out     - (output) complex matrix, size1-by-(size2/2+1), containing
+                  the non-redundant half of the transform
+        tda_out - leading dimension of out in complex elements, >= size2/2+1
+        w       - workspace
+*/
+
+int
+gsl_fft2d_real_forward (const double in[], const size_t tda_in,
+                        double out[], const size_t tda_out,
+                        gsl_fft2d_workspace * w)
+{
+  const size_t m = w->size2 / 2 + 1;
+
+  if (tda_in < w->size2)
+    {
+      GSL_ERROR ("tda_in must be at least size2", GSL_EBADLEN);
+    }
+  else if (tda_out < m)
+    {
+      GSL_ERROR ("tda_out must be at least size2/2+1", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+
+      status = fftnd_real_rows (in, tda_in, out, tda_out, w->size1, w->size2,
+                                w->real_wavetable, w->real_work,
+                                w->buf + 2 * FFTND_BLOCK * w->size1);
+      if (status)
+        return status;
+
+      status = fftnd_columns (out, w->size1, m, tda_out, w->wavetable1,
+                              w->work1, w->buf, gsl_fft_forward);
+
+      return status;
+    }
+}
+
+/*
+gsl_fft2d_halfcomplex_backward()
+  Compute the two dimensional backward transform of the non-redundant
+half of a real matrix's transform, as produced by gsl_fft2d_real_forward()
+
+Inputs: in      - complex matrix, size1-by-(size2/2+1); overwritten
+                  on output
+        tda_in  - leading dimension of in in complex elements, >= size2/2+1
+        out     - (output) real matrix, size1-by-size2
+        tda_out - leading dimension of out, >= size2
+        w       - workspace
+*/
+
+int
+gsl_fft2d_halfcomplex_backward (double in[], const size_t tda_in,
+                                double out[], const size_t tda_out,
+                                gsl_fft2d_workspace * w)
+{
+  const size_t m = w->size2 / 2 + 1;
+
+  if (tda_in < m)
+    {
+      GSL_ERROR ("tda_in must be at least size2/2+1", GSL_EBADLEN);
+    }
+  else if (tda_out < w->size2)
+    {
+      GSL_ERROR ("tda_out must be at least size2", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+
+      status = fftnd_columns (in, w->size1, m, tda_in, w->wavetable1,
+                              w->work1, w->buf, gsl_fft_backward);
+      if (status)
+        return status;
+
+      status = fftnd_halfcomplex_rows (in, tda_in, out, tda_out, w->size1,
+                                       w->size2, w->hc_wavetable, w->real_work,
+                                       w->buf + 2 * FFTND_BLOCK * w->size1);
+
+      return status;
+    }
+}
+
+int
+gsl_fft2d_halfcomplex_inverse (double in[], const size_t tda_in,
+                               double out[], const size_t tda_out,
+                               gsl_fft2d_workspace * w)
+{
+  int status = gsl_fft2d_halfcomplex_backward (in, tda_in, out, tda_out, w);
+
+  if (status)
+    return status;
+
+  /* normalize inverse fft with 1/(size1*size2) */
+  {
+    const double norm = 1.0 / ((double) w->size1 * (double) w->size2);
+    size_t i, j;
+
+    for (i = 0; i < w->size1; ++i)
+      {
+        double *row = out + i * tda_out;
+
+        for (j = 0; j < w->size2; ++j)
+          row[j] *= norm;
+      }
+  }
+
+  return GSL_SUCCESS;
+}
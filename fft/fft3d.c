@@ -0,0 +1,290 @@
+/* fft/fft3d.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_fft3d.h>
+
+#include "fftnd.c"
+
+static int fft3d_outer (double *data, const size_t m,
+                        const gsl_fft_direction sign, gsl_fft3d_workspace * w);
+
+/*
+gsl_fft3d_alloc()
+  Allocate a workspace for three dimensional transforms
+
+Inputs: size1 - first (slowest varying) dimension
+        size2 - second dimension
+        size3 - third (contiguous) dimension
+
+Return: pointer to workspace
+*/
+
+gsl_fft3d_workspace *
+gsl_fft3d_alloc (const size_t size1, const size_t size2, const size_t size3)
+{
+  gsl_fft3d_workspace *w;
+
+  if (size1 == 0 || size2 == 0 || size3 == 0)
+    {
+      GSL_ERROR_NULL ("dimensions must be positive integers", GSL_EINVAL);
+    }
+
+  w = calloc (1, sizeof (gsl_fft3d_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->size1 = size1;
+  w->size2 = size2;
+  w->size3 = size3;
+
+  w->wavetable1 = gsl_fft_complex_wavetable_alloc (size1);
+  w->wavetable2 = gsl_fft_complex_wavetable_alloc (size2);
+  w->wavetable3 = gsl_fft_complex_wavetable_alloc (size3);
+  w->real_wavetable = gsl_fft_real_wavetable_alloc (size3);
+  w->hc_wavetable = gsl_fft_halfcomplex_wavetable_alloc (size3);
+  w->work1 = gsl_fft_complex_workspace_alloc (size1);
+  w->work2 = gsl_fft_complex_workspace_alloc (size2);
+  w->work3 = gsl_fft_complex_workspace_alloc (size3);
+  w->real_work = gsl_fft_real_workspace_alloc (size3);
+  w->buf = malloc (FFTND_BUFSIZE (GSL_MAX (size1, size2), size3) * sizeof (double));
+
+  if (w->wavetable1 == NULL || w->wavetable2 == NULL || w->wavetable3 == NULL ||
+      w->real_wavetable == NULL || w->hc_wavetable == NULL ||
+      w->work1 == NULL || w->work2 == NULL || w->work3 == NULL ||
+      w->real_work == NULL || w->buf == NULL)
+    {
+      gsl_fft3d_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_fft3d_free (gsl_fft3d_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->wavetable1)
+    gsl_fft_complex_wavetable_free (w->wavetable1);
+
+  if (w->wavetable2)
+    gsl_fft_complex_wavetable_free (w->wavetable2);
+
+  if (w->wavetable3)
+    gsl_fft_complex_wavetable_free (w->wavetable3);
+
+  if (w->real_wavetable)
+    gsl_fft_real_wavetable_free (w->real_wavetable);
+
+  if (w->hc_wavetable)
+    gsl_fft_halfcomplex_wavetable_free (w->hc_wavetable);
+
+  if (w->work1)
+    gsl_fft_complex_workspace_free (w->work1);
+
+  if (w->work2)
+    gsl_fft_complex_workspace_free (w->work2);
+
+  if (w->work3)
+    gsl_fft_complex_workspace_free (w->work3);
+
+  if (w->real_work)
+    gsl_fft_real_workspace_free (w->real_work);
+
+  if (w->buf)
+    free (w->buf);
+
+  free (w);
+}
+
+/*
+gsl_fft3d_complex_transform()
+  Compute the three dimensional transform of a complex array in-place
+
+Inputs: data - complex array, size1-by-size2-by-size3, stored contiguously
+               with element (i,j,k) at index (i*size2 + j)*size3 + k
+        sign - direction of transform
+        w    - workspace
+*/
+
+int
+gsl_fft3d_complex_transform (double data[], const gsl_fft_direction sign,
+                             gsl_fft3d_workspace * w)
+{
+  const size_t n3 = w->size3;
+  int status;
+
+  status = fftnd_rows (data, w->size1 * w->size2, n3, n3, w->wavetable3,
+                       w->work3, sign);
+  if (status)
+    return status;
+
+  return fft3d_outer (data, n3, sign, w);
+}
+
+int
+gsl_fft3d_complex_forward (double data[], gsl_fft3d_workspace * w)
+{
+  return gsl_fft3d_complex_transform (data, gsl_fft_forward, w);
+}
+
+int
+gsl_fft3d_complex_backward (double data[], gsl_fft3d_workspace * w)
+{
+  return gsl_fft3d_complex_transform (data, gsl_fft_backward, w);
+}
+
+int
+gsl_fft3d_complex_inverse (double data[], gsl_fft3d_workspace * w)
+{
+  const size_t n = w->size1 * w->size2 * w->size3;
+  int status = gsl_fft3d_complex_transform (data, gsl_fft_backward, w);
+  const double norm = 1.0 / (double) n;
+  size_t i;
+
+  if (status)
+    return status;
+
+  /* normalize inverse fft with 1/(size1*size2*size3) */
+  for (i = 0; i < 2 * n; ++i)
+    data[i] *= norm;
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_fft3d_real_forward()
+  Compute the three dimensional transform of a real array
+
+Inputs: in  - real array, size1-by-size2-by-size3, stored contiguously
+        out - (output) complex array, size1-by-size2-by-(size3/2+1),
+              containing the non-redundant half of the transform
+        w   - workspace
+*/
+
+int
+gsl_fft3d_real_forward (const double in[], double out[],
+                        gsl_fft3d_workspace * w)
+{
+  const size_t n3 = w->size3;
+  const size_t m = n3 / 2 + 1;
+  int status;
+
+  status = fftnd_real_rows (in, n3, out, m, w->size1 * w->size2, n3,
+                            w->real_wavetable, w->real_work,
+                            w->buf + 2 * FFTND_BLOCK * GSL_MAX (w->size1, w->size2));
+  if (status)
+    return status;
+
+  return fft3d_outer (out, m, gsl_fft_forward, w);
+}
+
+/*
+gsl_fft3d_halfcomplex_backward()
+  Compute the three dimensional backward transform of the non-redundant
+half of a real array's transform, as produced by gsl_fft3d_real_forward()
+
+Inputs: in  - complex array, size1-by-size2-by-(size3/2+1); overwritten
+              on output
+        out - (output) real array, size1-by-size2-by-size3
+        w   - workspace
+*/
+
+int
+gsl_fft3d_halfcomplex_backward (double in[], double out[],
+                                gsl_fft3d_workspace * w)
+{
+  const size_t n3 = w->size3;
+  const size_t m = n3 / 2 + 1;
+  int status;
+
+  status = fft3d_outer (in, m, gsl_fft_backward, w);
+  if (status)
+    return status;
+
+  return fftnd_halfcomplex_rows (in, m, out, n3, w->size1 * w->size2, n3,
+                                 w->hc_wavetable, w->real_work,
+                                 w->buf + 2 * FFTND_BLOCK * GSL_MAX (w->size1, w->size2));
+}
+
+int
+gsl_fft3d_halfcomplex_inverse (double in[], double out[],
+                               gsl_fft3d_workspace * w)
+{
+  const size_t n = w->size1 * w->size2 * w->size3;
+  int status = gsl_fft3d_halfcomplex_backward (in, out, w);
+  const double norm = 1.0 / (double) n;
+  size_t i;
+
+  if (status)
+    return status;
+
+  /* normalize inverse fft with 1/(size1*size2*size3) */
+  for (i = 0; i < n; ++i)
+    out[i] *= norm;
+
+  return GSL_SUCCESS;
+}
+
+/*
+fft3d_outer()
+  Transform a complex size1-by-size2-by-m array along its first two
+dimensions
+
+Inputs: data - complex array, size1-by-size2-by-m
+        m    - length of last dimension
+        sign - direction of transform
+        w    - workspace
+
+Notes:
+1) The second dimension is transformed one plane (size2-by-m matrix) at
+a time, and the first dimension as the columns of a size1-by-(size2*m)
+matrix
+*/
+
+static int
+fft3d_outer (double *data, const size_t m, const gsl_fft_direction sign,
+             gsl_fft3d_workspace * w)
+{
+  const size_t plane = w->size2 * m;
+  size_t i;
+  int status;
+
+  for (i = 0; i < w->size1; ++i)
+    {
+      status = fftnd_columns (data + 2 * i * plane, w->size2, m, m,
+                              w->wavetable2, w->work2, w->buf, sign);
+      if (status)
+        return status;
+    }
+
+  status = fftnd_columns (data, w->size1, plane, plane, w->wavetable1,
+                          w->work1, w->buf, sign);
+
+  return status;
+}
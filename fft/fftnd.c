@@ -0,0 +1,264 @@
+/* fft/fftnd.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Building blocks of the multidimensional transforms, #included by
+ * fft2d.c and fft3d.c. A multidimensional transform is a sequence of
+ * one dimensional transforms along each dimension, which are either
+ * contiguous rows or strided columns of a row-major matrix. Columns
+ * are not transformed in place: a block of FFTND_BLOCK adjacent
+ * columns is transposed into a contiguous buffer, reading short
+ * contiguous segments of each row, transformed there and transposed
+ * back, so that every cache line of the matrix is loaded once per
+ * block instead of once per column.
+ */
+
+#define FFTND_BLOCK 8
+
+/* size in doubles of the buffer needed for columns of length n and a
+   real row of length m */
+#define FFTND_BUFSIZE(n, m) (2 * FFTND_BLOCK * (n) + (m))
+
+static int fftnd_rows (double *data, const size_t nrows, const size_t ncols,
+                       const size_t tda, const gsl_fft_complex_wavetable * wavetable,
+                       gsl_fft_complex_workspace * work, const gsl_fft_direction sign);
+static int fftnd_columns (double *data, const size_t nrows, const size_t ncols,
+                          const size_t tda, const gsl_fft_complex_wavetable * wavetable,
+                          gsl_fft_complex_workspace * work, double *buf,
+                          const gsl_fft_direction sign);
+static int fftnd_real_rows (const double *in, const size_t tda_in, double *out,
+                            const size_t tda_out, const size_t nrows, const size_t ncols,
+                            const gsl_fft_real_wavetable * wavetable,
+                            gsl_fft_real_workspace * work, double *row);
+static int fftnd_halfcomplex_rows (const double *in, const size_t tda_in, double *out,
+                                   const size_t tda_out, const size_t nrows,
+                                   const size_t ncols,
+                                   const gsl_fft_halfcomplex_wavetable * wavetable,
+                                   gsl_fft_real_workspace * work, double *row);
+
+/*
+fftnd_rows()
+  Transform the rows of a complex matrix
+
+Inputs: data      - complex matrix, nrows-by-ncols
+        nrows     - number of rows
+        ncols     - number of columns
+        tda       - leading dimension of data, in complex elements
+        wavetable - wavetable of length ncols
+        work      - workspace of length ncols
+        sign      - direction of transform
+*/
+
+static int
+fftnd_rows (double *data, const size_t nrows, const size_t ncols,
+            const size_t tda, const gsl_fft_complex_wavetable * wavetable,
+            gsl_fft_complex_workspace * work, const gsl_fft_direction sign)
+{
+  size_t i;
+
+  for (i = 0; i < nrows; ++i)
+    {
+      int status = gsl_fft_complex_transform (data + 2 * i * tda, 1, ncols,
+                                              wavetable, work, sign);
+      if (status)
+        return status;
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+fftnd_columns()
+  Transform the columns of a complex matrix
+
+Inputs: data      - complex matrix, nrows-by-ncols
+        nrows     - number of rows
+        ncols     - number of columns
+        tda       - leading dimension of data, in complex elements
+        wavetable - wavetable of length nrows
+        work      - workspace of length nrows
+        buf       - buffer of 2*FFTND_BLOCK*nrows doubles
+        sign      - direction of transform
+*/
+
+static int
+fftnd_columns (double *data, const size_t nrows, const size_t ncols,
+               const size_t tda, const gsl_fft_complex_wavetable * wavetable,
+               gsl_fft_complex_workspace * work, double *buf,
+               const gsl_fft_direction sign)
+{
+  size_t i, j, jj;
+
+  if (nrows == 1)
+    return GSL_SUCCESS;
+
+  for (j = 0; j < ncols; j += FFTND_BLOCK)
+    {
+      const size_t nb = GSL_MIN (FFTND_BLOCK, ncols - j);
+
+      /* transpose block of columns into buf */
+      for (i = 0; i < nrows; ++i)
+        {
+          const double *row = data + 2 * (i * tda + j);
+
+          for (jj = 0; jj < nb; ++jj)
+            {
+              buf[2 * (jj * nrows + i)] = row[2 * jj];
+              buf[2 * (jj * nrows + i) + 1] = row[2 * jj + 1];
+            }
+        }
+
+      for (jj = 0; jj < nb; ++jj)
+        {
+          int status = gsl_fft_complex_transform (buf + 2 * jj * nrows, 1, nrows,
+                                                  wavetable, work, sign);
+          if (status)
+            return status;
+        }
+
+      /* transpose back */
+      for (i = 0; i < nrows; ++i)
+        {
+          double *row = data + 2 * (i * tda + j);
+
+          for (jj = 0; jj < nb; ++jj)
+            {
+              row[2 * jj] = buf[2 * (jj * nrows + i)];
+              row[2 * jj + 1] = buf[2 * (jj * nrows + i) + 1];
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+fftnd_real_rows()
+  Forward transform the rows of a real matrix, storing the
+ncols/2 + 1 non-redundant coefficients of each row as complex numbers
+
+Inputs: in        - real matrix, nrows-by-ncols
+        tda_in    - leading dimension of in
+        out       - (output) complex matrix, nrows-by-(ncols/2+1)
+        tda_out   - leading dimension of out, in complex elements
+        nrows     - number of rows
+        ncols     - number of columns
+        wavetable - real wavetable of length ncols
+        work      - real workspace of length ncols
+        row       - buffer of length ncols
+*/
+
+static int
+fftnd_real_rows (const double *in, const size_t tda_in, double *out,
+                 const size_t tda_out, const size_t nrows, const size_t ncols,
+                 const gsl_fft_real_wavetable * wavetable,
+                 gsl_fft_real_workspace * work, double *row)
+{
+  size_t i, k;
+
+  for (i = 0; i < nrows; ++i)
+    {
+      const double *x = in + i * tda_in;
+      double *z = out + 2 * i * tda_out;
+      int status;
+
+      for (k = 0; k < ncols; ++k)
+        row[k] = x[k];
+
+      status = gsl_fft_real_transform (row, 1, ncols, wavetable, work);
+      if (status)
+        return status;
+
+      /* unpack halfcomplex storage */
+      z[0] = row[0];
+      z[1] = 0.0;
+
+      for (k = 1; k < ncols - k; ++k)
+        {
+          z[2 * k] = row[2 * k - 1];
+          z[2 * k + 1] = row[2 * k];
+        }
+
+      if (k == ncols - k)
+        {
+          z[2 * k] = row[ncols - 1];
+          z[2 * k + 1] = 0.0;
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+fftnd_halfcomplex_rows()
+  Backward transform rows of ncols/2 + 1 complex coefficients into
+real rows of length ncols
+
+Inputs: in        - complex matrix, nrows-by-(ncols/2+1)
+        tda_in    - leading dimension of in, in complex elements
+        out       - (output) real matrix, nrows-by-ncols
+        tda_out   - leading dimension of out
+        nrows     - number of rows
+        ncols     - number of columns
+        wavetable - halfcomplex wavetable of length ncols
+        work      - real workspace of length ncols
+        row       - buffer of length ncols
+
+Notes:
+1) The imaginary parts of the coefficients of frequency 0 and, for
+even ncols, ncols/2 are ignored
+*/
+
+static int
+fftnd_halfcomplex_rows (const double *in, const size_t tda_in, double *out,
+                        const size_t tda_out, const size_t nrows,
+                        const size_t ncols,
+                        const gsl_fft_halfcomplex_wavetable * wavetable,
+                        gsl_fft_real_workspace * work, double *row)
+{
+  size_t i, k;
+
+  for (i = 0; i < nrows; ++i)
+    {
+      const double *z = in + 2 * i * tda_in;
+      double *x = out + i * tda_out;
+      int status;
+
+      /* pack halfcomplex storage */
+      row[0] = z[0];
+
+      for (k = 1; k < ncols - k; ++k)
+        {
+          row[2 * k - 1] = z[2 * k];
+          row[2 * k] = z[2 * k + 1];
+        }
+
+      if (k == ncols - k)
+        row[ncols - 1] = z[2 * k];
+
+      status = gsl_fft_halfcomplex_transform (row, 1, ncols, wavetable, work);
+      if (status)
+        return status;
+
+      for (k = 0; k < ncols; ++k)
+        x[k] = row[k];
+    }
+
+  return GSL_SUCCESS;
+}
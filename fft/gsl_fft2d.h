@@ -0,0 +1,81 @@
+/* fft/gsl_fft2d.h
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_FFT2D_H__
+#define __GSL_FFT2D_H__
+
+#include <stddef.h>
+
+#include <gsl/gsl_fft.h>
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+typedef struct
+{
+  size_t size1;                                /* number of rows */
+  size_t size2;                                /* number of columns */
+  gsl_fft_complex_wavetable *wavetable1;       /* column transforms, length size1 */
+  gsl_fft_complex_wavetable *wavetable2;       /* row transforms, length size2 */
+  gsl_fft_real_wavetable *real_wavetable;      /* real row transforms */
+  gsl_fft_halfcomplex_wavetable *hc_wavetable; /* halfcomplex row transforms */
+  gsl_fft_complex_workspace *work1;
+  gsl_fft_complex_workspace *work2;
+  gsl_fft_real_workspace *real_work;
+  double *buf;                                 /* block of columns and one real row */
+} gsl_fft2d_workspace;
+
+gsl_fft2d_workspace *gsl_fft2d_alloc (const size_t size1, const size_t size2);
+void gsl_fft2d_free (gsl_fft2d_workspace * w);
+
+int gsl_fft2d_complex_transform (double data[], const size_t tda,
+                                 const gsl_fft_direction sign,
+                                 gsl_fft2d_workspace * w);
+int gsl_fft2d_complex_forward (double data[], const size_t tda,
+                               gsl_fft2d_workspace * w);
+int gsl_fft2d_complex_backward (double data[], const size_t tda,
+                                gsl_fft2d_workspace * w);
+int gsl_fft2d_complex_inverse (double data[], const size_t tda,
+                               gsl_fft2d_workspace * w);
+
+int gsl_fft2d_real_forward (const double in[], const size_t tda_in,
+                            double out[], const size_t tda_out,
+                            gsl_fft2d_workspace * w);
+int gsl_fft2d_halfcomplex_backward (double in[], const size_t tda_in,
+                                    double out[], const size_t tda_out,
+                                    gsl_fft2d_workspace * w);
+int gsl_fft2d_halfcomplex_inverse (double in[], const size_t tda_in,
+                                   double out[], const size_t tda_out,
+                                   gsl_fft2d_workspace * w);
+
+__END_DECLS
+
+#endif /* __GSL_FFT2D_H__ */
@@ -0,0 +1,78 @@
+/* fft/gsl_fft3d.h
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_FFT3D_H__
+#define __GSL_FFT3D_H__
+
+#include <stddef.h>
+
+#include <gsl/gsl_fft.h>
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+typedef struct
+{
+  size_t size1;                                /* first (slowest varying) dimension */
+  size_t size2;                                /* second dimension */
+  size_t size3;                                /* third (contiguous) dimension */
+  gsl_fft_complex_wavetable *wavetable1;       /* transforms of length size1 */
+  gsl_fft_complex_wavetable *wavetable2;       /* transforms of length size2 */
+  gsl_fft_complex_wavetable *wavetable3;       /* transforms of length size3 */
+  gsl_fft_real_wavetable *real_wavetable;      /* real transforms of length size3 */
+  gsl_fft_halfcomplex_wavetable *hc_wavetable; /* halfcomplex transforms of length size3 */
+  gsl_fft_complex_workspace *work1;
+  gsl_fft_complex_workspace *work2;
+  gsl_fft_complex_workspace *work3;
+  gsl_fft_real_workspace *real_work;
+  double *buf;                                 /* block of columns and one real row */
+} gsl_fft3d_workspace;
+
+gsl_fft3d_workspace *gsl_fft3d_alloc (const size_t size1, const size_t size2,
+                                      const size_t size3);
+void gsl_fft3d_free (gsl_fft3d_workspace * w);
+
+int gsl_fft3d_complex_transform (double data[], const gsl_fft_direction sign,
+                                 gsl_fft3d_workspace * w);
+int gsl_fft3d_complex_forward (double data[], gsl_fft3d_workspace * w);
+int gsl_fft3d_complex_backward (double data[], gsl_fft3d_workspace * w);
+int gsl_fft3d_complex_inverse (double data[], gsl_fft3d_workspace * w);
+
+int gsl_fft3d_real_forward (const double in[], double out[],
+                            gsl_fft3d_workspace * w);
+int gsl_fft3d_halfcomplex_backward (double in[], double out[],
+                                    gsl_fft3d_workspace * w);
+int gsl_fft3d_halfcomplex_inverse (double in[], double out[],
+                                   gsl_fft3d_workspace * w);
+
+__END_DECLS
+
+#endif /* __GSL_FFT3D_H__ */
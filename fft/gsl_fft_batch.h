@@ -0,0 +1,98 @@
+/* fft/gsl_fft_batch.h
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_FFT_BATCH_H__
+#define __GSL_FFT_BATCH_H__
+
+#include <stddef.h>
+
+#include <gsl/gsl_fft.h>
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+typedef struct
+{
+  size_t n;                                 /* length of each transform */
+  gsl_fft_complex_workspace *complex_work;
+  gsl_fft_real_workspace *real_work;
+  double *buf;                              /* block of gathered transforms */
+} gsl_fft_batch_workspace;
+
+gsl_fft_batch_workspace *gsl_fft_batch_workspace_alloc (const size_t n);
+void gsl_fft_batch_workspace_free (gsl_fft_batch_workspace * w);
+
+int gsl_fft_complex_batch_forward (gsl_complex_packed_array data,
+                                   const size_t stride, const size_t dist,
+                                   const size_t n, const size_t howmany,
+                                   const gsl_fft_complex_wavetable * wavetable,
+                                   gsl_fft_batch_workspace * w);
+int gsl_fft_complex_batch_backward (gsl_complex_packed_array data,
+                                    const size_t stride, const size_t dist,
+                                    const size_t n, const size_t howmany,
+                                    const gsl_fft_complex_wavetable * wavetable,
+                                    gsl_fft_batch_workspace * w);
+int gsl_fft_complex_batch_inverse (gsl_complex_packed_array data,
+                                   const size_t stride, const size_t dist,
+                                   const size_t n, const size_t howmany,
+                                   const gsl_fft_complex_wavetable * wavetable,
+                                   gsl_fft_batch_workspace * w);
+int gsl_fft_complex_batch_transform (gsl_complex_packed_array data,
+                                     const size_t stride, const size_t dist,
+                                     const size_t n, const size_t howmany,
+                                     const gsl_fft_complex_wavetable * wavetable,
+                                     gsl_fft_batch_workspace * w,
+                                     const gsl_fft_direction sign);
+
+int gsl_fft_real_batch_transform (double data[], const size_t stride,
+                                  const size_t dist, const size_t n,
+                                  const size_t howmany,
+                                  const gsl_fft_real_wavetable * wavetable,
+                                  gsl_fft_batch_workspace * w);
+int gsl_fft_halfcomplex_batch_backward (double data[], const size_t stride,
+                                        const size_t dist, const size_t n,
+                                        const size_t howmany,
+                                        const gsl_fft_halfcomplex_wavetable * wavetable,
+                                        gsl_fft_batch_workspace * w);
+int gsl_fft_halfcomplex_batch_inverse (double data[], const size_t stride,
+                                       const size_t dist, const size_t n,
+                                       const size_t howmany,
+                                       const gsl_fft_halfcomplex_wavetable * wavetable,
+                                       gsl_fft_batch_workspace * w);
+int gsl_fft_halfcomplex_batch_transform (double data[], const size_t stride,
+                                         const size_t dist, const size_t n,
+                                         const size_t howmany,
+                                         const gsl_fft_halfcomplex_wavetable * wavetable,
+                                         gsl_fft_batch_workspace * w);
+
+__END_DECLS
+
+#endif /* __GSL_FFT_BATCH_H__ */
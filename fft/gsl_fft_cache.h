@@ -0,0 +1,77 @@
+/* fft/gsl_fft_cache.h
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_FFT_CACHE_H__
+#define __GSL_FFT_CACHE_H__
+
+#include <stddef.h>
+
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_complex_float.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_real_float.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_halfcomplex_float.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+typedef struct gsl_fft_cache_entry_struct gsl_fft_cache_entry;
+
+typedef struct
+{
+  size_t max_bytes;           /* bound on memory of cached wavetables */
+  size_t nbytes;              /* approximate memory of cached wavetables */
+  size_t nentries;            /* number of cached wavetables */
+  size_t hits;                /* lookups returning a cached wavetable */
+  size_t misses;              /* lookups allocating a new wavetable */
+  size_t evictions;           /* wavetables freed to respect max_bytes */
+  gsl_fft_cache_entry *head;  /* most recently used */
+  gsl_fft_cache_entry *tail;  /* least recently used */
+  void (*lock) (void *);      /* optional lock around cache operations */
+  void (*unlock) (void *);
+  void *lock_data;
+} gsl_fft_cache;
+
+gsl_fft_cache *gsl_fft_cache_alloc (const size_t max_bytes);
+void gsl_fft_cache_free (gsl_fft_cache * cache);
+void gsl_fft_cache_set_lock (gsl_fft_cache * cache, void (*lock) (void *),
+                             void (*unlock) (void *), void *lock_data);
+
+const gsl_fft_complex_wavetable *gsl_fft_cache_complex (gsl_fft_cache * cache, const size_t n);
+const gsl_fft_real_wavetable *gsl_fft_cache_real (gsl_fft_cache * cache, const size_t n);
+const gsl_fft_halfcomplex_wavetable *gsl_fft_cache_halfcomplex (gsl_fft_cache * cache, const size_t n);
+const gsl_fft_complex_wavetable_float *gsl_fft_cache_complex_float (gsl_fft_cache * cache, const size_t n);
+const gsl_fft_real_wavetable_float *gsl_fft_cache_real_float (gsl_fft_cache * cache, const size_t n);
+const gsl_fft_halfcomplex_wavetable_float *gsl_fft_cache_halfcomplex_float (gsl_fft_cache * cache, const size_t n);
+
+int gsl_fft_cache_release (gsl_fft_cache * cache, const void * wavetable);
+
+__END_DECLS
+
+#endif /* __GSL_FFT_CACHE_H__ */
@@ -77,13 +77,17 @@ int gsl_fft_complex_radix2_dif_transform (gsl_complex_packed_array data,
 
 /*  Mixed Radix general-N routines  */
 
-typedef struct
+typedef struct gsl_fft_complex_wavetable_struct
   {
     size_t n;
     size_t nf;
     size_t factor[64];
     gsl_complex *twiddle[64];
     gsl_complex *trig;
+    /* Bluestein's algorithm, used for large prime factors */
+    gsl_complex *chirp[64];
+    gsl_complex *filter[64];
+    struct gsl_fft_complex_wavetable_struct *conv[64];
   }
 gsl_fft_complex_wavetable;
 
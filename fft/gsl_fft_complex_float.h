@@ -77,13 +77,17 @@ int gsl_fft_complex_float_radix2_dif_transform (gsl_complex_packed_array_float d
 
 /*  Mixed Radix general-N routines  */
 
-typedef struct
+typedef struct gsl_fft_complex_wavetable_float_struct
   {
     size_t n;
     size_t nf;
     size_t factor[64];
     gsl_complex_float *twiddle[64];
     gsl_complex_float *trig;
+    /* Bluestein's algorithm, used for large prime factors */
+    gsl_complex_float *chirp[64];
+    gsl_complex_float *filter[64];
+    struct gsl_fft_complex_wavetable_float_struct *conv[64];
   }
 gsl_fft_complex_wavetable_float;
 
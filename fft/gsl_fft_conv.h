@@ -0,0 +1,108 @@
+/* fft/gsl_fft_conv.h
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_FFT_CONV_H__
+#define __GSL_FFT_CONV_H__
+
+#include <stddef.h>
+
+#include <gsl/gsl_complex.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_cache.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+typedef struct
+{
+  size_t nmax;                              /* maximum transform length */
+  gsl_fft_cache *cache;                     /* wavetables of used lengths */
+  gsl_fft_real_workspace *real_work;        /* workspace of last real length */
+  gsl_fft_complex_workspace *complex_work;  /* workspace of last complex length */
+  double *fa;                               /* transform of first input, 2*nmax */
+  double *fb;                               /* transform of second input, 2*nmax */
+} gsl_fft_conv_workspace;
+
+gsl_fft_conv_workspace *gsl_fft_conv_alloc (const size_t n);
+void gsl_fft_conv_free (gsl_fft_conv_workspace * w);
+
+int gsl_fft_conv_real (const double a[], const size_t na,
+                       const double b[], const size_t nb,
+                       double c[], gsl_fft_conv_workspace * w);
+int gsl_fft_corr_real (const double a[], const size_t na,
+                       const double b[], const size_t nb,
+                       double c[], gsl_fft_conv_workspace * w);
+int gsl_fft_conv_real_circular (const double a[], const double b[],
+                                const size_t n, double c[],
+                                gsl_fft_conv_workspace * w);
+int gsl_fft_corr_real_circular (const double a[], const double b[],
+                                const size_t n, double c[],
+                                gsl_fft_conv_workspace * w);
+
+int gsl_fft_conv_complex (gsl_const_complex_packed_array a, const size_t na,
+                          gsl_const_complex_packed_array b, const size_t nb,
+                          gsl_complex_packed_array c, gsl_fft_conv_workspace * w);
+int gsl_fft_corr_complex (gsl_const_complex_packed_array a, const size_t na,
+                          gsl_const_complex_packed_array b, const size_t nb,
+                          gsl_complex_packed_array c, gsl_fft_conv_workspace * w);
+int gsl_fft_conv_complex_circular (gsl_const_complex_packed_array a,
+                                   gsl_const_complex_packed_array b,
+                                   const size_t n, gsl_complex_packed_array c,
+                                   gsl_fft_conv_workspace * w);
+int gsl_fft_corr_complex_circular (gsl_const_complex_packed_array a,
+                                   gsl_const_complex_packed_array b,
+                                   const size_t n, gsl_complex_packed_array c,
+                                   gsl_fft_conv_workspace * w);
+
+/* streaming convolution of a real signal with a fixed filter */
+
+typedef struct
+{
+  size_t nh;                                   /* filter length */
+  size_t n;                                    /* transform length */
+  size_t pos;                                  /* samples in current block */
+  double *H;                                   /* filter spectrum, length n */
+  double *buf;                                 /* history and current block, length n */
+  double *work;                                /* length n */
+  gsl_fft_real_wavetable *real_wavetable;
+  gsl_fft_halfcomplex_wavetable *hc_wavetable;
+  gsl_fft_real_workspace *real_work;
+} gsl_fft_conv_stream;
+
+gsl_fft_conv_stream *gsl_fft_conv_stream_alloc (const double h[], const size_t nh,
+                                                const size_t n);
+void gsl_fft_conv_stream_free (gsl_fft_conv_stream * s);
+int gsl_fft_conv_stream_reset (gsl_fft_conv_stream * s);
+int gsl_fft_conv_stream_process (const double x[], const size_t n, double y[],
+                                 gsl_fft_conv_stream * s);
+
+__END_DECLS
+
+#endif /* __GSL_FFT_CONV_H__ */
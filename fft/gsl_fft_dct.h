@@ -0,0 +1,87 @@
+/* fft/gsl_fft_dct.h
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_FFT_DCT_H__
+#define __GSL_FFT_DCT_H__
+
+#include <stddef.h>
+
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+typedef enum
+{
+  GSL_FFT_DCT1,
+  GSL_FFT_DCT2,
+  GSL_FFT_DCT3,
+  GSL_FFT_DCT4,
+  GSL_FFT_DST1,
+  GSL_FFT_DST2,
+  GSL_FFT_DST3,
+  GSL_FFT_DST4
+} gsl_fft_dct_type;
+
+typedef struct
+{
+  gsl_fft_dct_type type;
+  size_t n;                                    /* transform length */
+  size_t nfft;                                 /* length of underlying FFT */
+  gsl_fft_real_wavetable *real_wavetable;      /* types I, II */
+  gsl_fft_halfcomplex_wavetable *hc_wavetable; /* type III */
+  gsl_fft_real_workspace *real_work;
+  gsl_fft_complex_wavetable *complex_wavetable; /* type IV */
+  gsl_fft_complex_workspace *complex_work;
+  double *twiddle;                             /* pre/post twiddle factors */
+  double *work;                                /* FFT data */
+  double *buf;                                 /* block of gathered transforms */
+} gsl_fft_dct_workspace;
+
+gsl_fft_dct_workspace *gsl_fft_dct_alloc (const gsl_fft_dct_type type,
+                                          const size_t n);
+void gsl_fft_dct_free (gsl_fft_dct_workspace * w);
+
+int gsl_fft_dct_transform (double data[], const size_t stride,
+                           gsl_fft_dct_workspace * w);
+int gsl_fft_dct_batch (double data[], const size_t stride, const size_t dist,
+                       const size_t howmany, gsl_fft_dct_workspace * w);
+int gsl_fft_dct2d_transform (double data[], const size_t tda,
+                             gsl_fft_dct_workspace * w1,
+                             gsl_fft_dct_workspace * w2);
+
+int gsl_fft_mdct_forward (const double in[], double out[],
+                          gsl_fft_dct_workspace * w);
+int gsl_fft_mdct_backward (const double in[], double out[],
+                           gsl_fft_dct_workspace * w);
+
+__END_DECLS
+
+#endif /* __GSL_FFT_DCT_H__ */
@@ -25,6 +25,7 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_complex.h>
 #include <gsl/gsl_fft.h>
+#include <gsl/gsl_fft_complex.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -47,6 +48,7 @@ typedef struct
     size_t factor[64];
     gsl_complex *twiddle[64];
     gsl_complex *trig;
+    gsl_fft_complex_wavetable *complex_wavetable; /* lengths with large prime factors */
   }
 gsl_fft_real_wavetable;
 
@@ -54,6 +54,7 @@ FUNCTION(gsl_fft_halfcomplex_wavetable,alloc) (size_t n)
     }
 
   wavetable->n = n ;
+  wavetable->complex_wavetable = NULL;
 
   status = fft_halfcomplex_factorize (n, &n_factors, wavetable->factor);
 
@@ -110,6 +111,24 @@ FUNCTION(gsl_fft_halfcomplex_wavetable,alloc) (size_t n)
       GSL_ERROR_VAL ("overflowed trigonometric lookup table", GSL_ESANITY, 0);
     }
 
+  /* lengths with prime factors too large for the direct passes use
+     the complex transform, which applies Bluestein's algorithm */
+
+  if (fft_complex_bluestein_size (n) > 0)
+    {
+      wavetable->complex_wavetable = FUNCTION(gsl_fft_complex_wavetable,alloc) (n);
+
+      if (wavetable->complex_wavetable == NULL)
+        {
+          /* error in constructor, prevent memory leak */
+
+          free(wavetable->trig) ;
+          free(wavetable) ;
+
+          GSL_ERROR_VAL ("failed to allocate complex wavetable", GSL_ENOMEM, 0);
+        }
+    }
+
   return wavetable;
 }
 
@@ -118,6 +137,9 @@ void
 FUNCTION(gsl_fft_halfcomplex_wavetable,free) (TYPE(gsl_fft_halfcomplex_wavetable) * wavetable)
 {
   RETURN_IF_NULL (wavetable);
+
+  FUNCTION(gsl_fft_complex_wavetable,free) (wavetable->complex_wavetable);
+
   /* release trigonometric lookup tables */
 
   free (wavetable->trig);
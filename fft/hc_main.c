@@ -53,7 +53,7 @@ FUNCTION(gsl_fft_halfcomplex,inverse) (BASE data[], const size_t stride,
   /* normalize inverse fft with 1/n */
 
   {
-    const double norm = 1.0 / n;
+    const ATOMIC norm = 1.0 / n;
     size_t i;
     for (i = 0; i < n; i++)
       {
@@ -103,6 +103,54 @@ FUNCTION(gsl_fft_halfcomplex,transform) (BASE data[], const size_t stride, const
       GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
     }
 
+  if (wavetable->complex_wavetable != NULL)
+    {
+      /* use the complex transform for large prime factors, after
+         expanding the halfcomplex data to the full hermitian sequence */
+
+      BASE * const z = scratch;
+      TYPE(gsl_fft_complex_workspace) cwork;
+      int status;
+
+      cwork.n = n;
+      cwork.scratch = scratch + 2 * n;
+
+      z[0] = data[0];
+      z[1] = 0;
+
+      for (i = 1; i < n - i; i++)
+        {
+          const BASE x_real = data[stride * (2 * i - 1)];
+          const BASE x_imag = data[stride * 2 * i];
+
+          z[2 * i] = x_real;
+          z[2 * i + 1] = x_imag;
+          z[2 * (n - i)] = x_real;
+          z[2 * (n - i) + 1] = -x_imag;
+        }
+
+      if (i == n - i)
+        {
+          z[2 * i] = data[stride * (n - 1)];
+          z[2 * i + 1] = 0;
+        }
+
+      status = FUNCTION(gsl_fft_complex,backward) (z, 1, n,
+                                                   wavetable->complex_wavetable,
+                                                   &cwork);
+      if (status)
+        {
+          return status;
+        }
+
+      for (i = 0; i < n; i++)
+        {
+          data[stride * i] = z[2 * i];
+        }
+
+      return 0;
+    }
+
   nf = wavetable->nf;
   product = 1;
   state = 0;
@@ -96,8 +96,8 @@ FUNCTION(fft_halfcomplex,pass_3) (const BASE in[],
           const ATOMIC t1_imag = z1_imag + z2_imag;
 
           /* t2 = z0 - t1/2 */
-          const ATOMIC t2_real = z0_real - t1_real / 2.0;
-          const ATOMIC t2_imag = z0_imag - t1_imag / 2.0;
+          const ATOMIC t2_real = z0_real - t1_real / 2;
+          const ATOMIC t2_imag = z0_imag - t1_imag / 2;
 
           /* t3 = sin(pi/3)*(z1 - z2) */
           const ATOMIC t3_real = tau * (z1_real - z2_real);
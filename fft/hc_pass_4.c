@@ -31,6 +31,8 @@ FUNCTION(fft_halfcomplex,pass_4) (const BASE in[],
   size_t i, j, k, k1, jump;
   size_t factor, q, m, product_1;
 
+  const ATOMIC sqrt2 = sqrt (2.0);
+
   i = 0;
   j = 0;
 
@@ -167,8 +169,8 @@ FUNCTION(fft_halfcomplex,pass_4) (const BASE in[],
       const ATOMIC z1_real = VECTOR(in,istride,from1);
       const ATOMIC z1_imag = VECTOR(in,istride,from1 + 1);
 
-      const ATOMIC t1_real = sqrt (2.0) * (z0_imag + z1_imag);
-      const ATOMIC t2_real = sqrt (2.0) * (z0_real - z1_real);
+      const ATOMIC t1_real = sqrt2 * (z0_imag + z1_imag);
+      const ATOMIC t2_real = sqrt2 * (z0_real - z1_real);
 
       const ATOMIC x0_real = 2 * (z0_real + z1_real);
       const ATOMIC x1_real = t2_real - t1_real;
@@ -35,6 +35,7 @@ FUNCTION(fft_halfcomplex,pass_5) (const BASE in[],
 
   const ATOMIC sina = sin (2.0 * M_PI / 5.0);
   const ATOMIC sinb = sin (2.0 * M_PI / 10.0);
+  const ATOMIC sqrt5_by_4 = sqrt (5.0) / 4.0;
 
   i = 0;
   j = 0;
@@ -58,8 +59,8 @@ FUNCTION(fft_halfcomplex,pass_5) (const BASE in[],
       const ATOMIC z2_imag = VECTOR(in,istride,from2 + 1);
 
       const ATOMIC t1_real = 2 * (z1_real + z2_real);
-      const ATOMIC t2_real = 2 * (sqrt (5.0) / 4.0) * (z1_real - z2_real);
-      const ATOMIC t3_real = z0_real - t1_real / 4.0;
+      const ATOMIC t2_real = 2 * sqrt5_by_4 * (z1_real - z2_real);
+      const ATOMIC t3_real = z0_real - t1_real / 4;
       const ATOMIC t4_real = t2_real + t3_real;
       const ATOMIC t5_real = -t2_real + t3_real;
       const ATOMIC t6_imag = 2 * (sina * z1_imag + sinb * z2_imag);
@@ -144,12 +145,12 @@ FUNCTION(fft_halfcomplex,pass_5) (const BASE in[],
           const ATOMIC t5_imag = t1_imag + t2_imag;
 
           /* t6 = (sqrt(5)/4)(t1 - t2) */
-          const ATOMIC t6_real = (sqrt (5.0) / 4.0) * (t1_real - t2_real);
-          const ATOMIC t6_imag = (sqrt (5.0) / 4.0) * (t1_imag - t2_imag);
+          const ATOMIC t6_real = sqrt5_by_4 * (t1_real - t2_real);
+          const ATOMIC t6_imag = sqrt5_by_4 * (t1_imag - t2_imag);
 
           /* t7 = z0 - ((t5)/4) */
-          const ATOMIC t7_real = z0_real - t5_real / 4.0;
-          const ATOMIC t7_imag = z0_imag - t5_imag / 4.0;
+          const ATOMIC t7_real = z0_real - t5_real / 4;
+          const ATOMIC t7_imag = z0_imag - t5_imag / 4;
 
           /* t8 = t7 + t6 */
           const ATOMIC t8_real = t7_real + t6_real;
@@ -235,8 +236,8 @@ FUNCTION(fft_halfcomplex,pass_5) (const BASE in[],
       const ATOMIC z2_real = VECTOR(in,istride,from2);
 
       const ATOMIC t1_real = z0_real + z1_real;
-      const ATOMIC t2_real = (t1_real / 4.0) - z2_real;
-      const ATOMIC t3_real = (sqrt (5.0) / 4.0) * (z0_real - z1_real);
+      const ATOMIC t2_real = (t1_real / 4) - z2_real;
+      const ATOMIC t3_real = sqrt5_by_4 * (z0_real - z1_real);
       const ATOMIC t4_real = sinb * z0_imag + sina * z1_imag;
       const ATOMIC t5_real = sina * z0_imag - sinb * z1_imag;
       const ATOMIC t6_real = t3_real + t2_real;
@@ -62,6 +62,7 @@ FUNCTION(gsl_fft_real_wavetable,alloc) (size_t n)
     }
 
   wavetable->n = n;
+  wavetable->complex_wavetable = NULL;
 
   status = fft_real_factorize (n, &n_factors, wavetable->factor);
 
@@ -119,6 +120,24 @@ FUNCTION(gsl_fft_real_wavetable,alloc) (size_t n)
                         GSL_ESANITY, 0);
     }
 
+  /* lengths with prime factors too large for the direct passes use
+     the complex transform, which applies Bluestein's algorithm */
+
+  if (fft_complex_bluestein_size (n) > 0)
+    {
+      wavetable->complex_wavetable = FUNCTION(gsl_fft_complex_wavetable,alloc) (n);
+
+      if (wavetable->complex_wavetable == NULL)
+        {
+          /* error in constructor, prevent memory leak */
+
+          free(wavetable->trig) ;
+          free(wavetable) ;
+
+          GSL_ERROR_VAL ("failed to allocate complex wavetable", GSL_ENOMEM, 0);
+        }
+    }
+
   return wavetable;
 }
 
@@ -142,7 +161,18 @@ FUNCTION(gsl_fft_real_workspace,alloc) (size_t n)
 
   workspace->n = n;
 
-  workspace->scratch = (BASE *) malloc (n * sizeof (BASE));
+  /* the complex transform used for lengths with large prime factors
+     needs space for the complex data and the complex workspace */
+
+  if (fft_complex_bluestein_size (n) > 0)
+    {
+      workspace->scratch = (BASE *) malloc ((4 * n + 4 * fft_complex_bluestein_size (n))
+                                            * sizeof (BASE));
+    }
+  else
+    {
+      workspace->scratch = (BASE *) malloc (n * sizeof (BASE));
+    }
 
   if (workspace->scratch == NULL)
     {
@@ -162,6 +192,9 @@ void
 FUNCTION(gsl_fft_real_wavetable,free) (TYPE(gsl_fft_real_wavetable) * wavetable)
 {
   RETURN_IF_NULL (wavetable);
+
+  FUNCTION(gsl_fft_complex_wavetable,free) (wavetable->complex_wavetable);
+
   /* release trigonometric lookup tables */
 
   free (wavetable->trig);
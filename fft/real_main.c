@@ -69,6 +69,48 @@ FUNCTION(gsl_fft_real,transform) (BASE data[], const size_t stride, const size_t
       GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
     }
 
+  if (wavetable->complex_wavetable != NULL)
+    {
+      /* use the complex transform for large prime factors, and pack
+         the result in halfcomplex order */
+
+      BASE * const z = scratch;
+      TYPE(gsl_fft_complex_workspace) cwork;
+      int status;
+
+      cwork.n = n;
+      cwork.scratch = scratch + 2 * n;
+
+      for (i = 0; i < n; i++)
+        {
+          z[2 * i] = data[stride * i];
+          z[2 * i + 1] = 0;
+        }
+
+      status = FUNCTION(gsl_fft_complex,forward) (z, 1, n,
+                                                  wavetable->complex_wavetable,
+                                                  &cwork);
+      if (status)
+        {
+          return status;
+        }
+
+      data[0] = z[0];
+
+      for (i = 1; i < n - i; i++)
+        {
+          data[stride * (2 * i - 1)] = z[2 * i];
+          data[stride * 2 * i] = z[2 * i + 1];
+        }
+
+      if (i == n - i)
+        {
+          data[stride * (n - 1)] = z[2 * i];
+        }
+
+      return 0;
+    }
+
   for (i = 0; i < nf; i++)
     {
       const size_t factor = wavetable->factor[i];
@@ -35,6 +35,8 @@ FUNCTION(fft_real,pass_4) (const BASE in[],
   const size_t q = n / product;
   const size_t product_1 = product / factor;
 
+  const ATOMIC sqrt1_2 = 1.0 / sqrt (2.0);
+
   for (k1 = 0; k1 < q; k1++)
     {
       const size_t from0 = k1 * product_1;
@@ -187,8 +189,8 @@ FUNCTION(fft_real,pass_4) (const BASE in[],
       const ATOMIC x2 = VECTOR(in,istride,from2);
       const ATOMIC x3 = VECTOR(in,istride,from3);
       
-      const ATOMIC t1 = (1.0 / sqrt (2.0)) * (x1 - x3);
-      const ATOMIC t2 = (1.0 / sqrt (2.0)) * (x1 + x3);
+      const ATOMIC t1 = sqrt1_2 * (x1 - x3);
+      const ATOMIC t2 = sqrt1_2 * (x1 + x3);
       
       const size_t to0 = k1 * product + 2 * k - 1;
       const size_t to1 = to0 + 2 * product_1;
@@ -25,6 +25,7 @@
 #include <math.h>
 #include <float.h>
 
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_complex.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_dft_complex.h>
@@ -34,6 +35,12 @@
 #include <gsl/gsl_fft_real_float.h>
 #include <gsl/gsl_fft_halfcomplex.h>
 #include <gsl/gsl_fft_halfcomplex_float.h>
+#include <gsl/gsl_fft2d.h>
+#include <gsl/gsl_fft3d.h>
+#include <gsl/gsl_fft_batch.h>
+#include <gsl/gsl_fft_cache.h>
+#include <gsl/gsl_fft_conv.h>
+#include <gsl/gsl_fft_dct.h>
 #include <gsl/gsl_ieee_utils.h>
 #include <gsl/gsl_test.h>
 
@@ -42,6 +49,8 @@ void my_error_handler (const char *reason, const char *file,
 
 #include "complex_internal.h"
 
+double urand (void);
+
 /* Usage: test [n]
    Exercise the fft routines for length n. By default n runs from 1 to 100.
    The exit status indicates success or failure. */
@@ -66,6 +75,13 @@ void my_error_handler (const char *reason, const char *file,
 #include "templates_off.h"
 #undef  BASE_FLOAT
 
+#include "test_nd_source.c"
+#include "test_batch_source.c"
+#include "test_cache_source.c"
+#include "test_conv_source.c"
+#include "test_dct_source.c"
+#include "test_float_source.c"
+
 int
 main (int argc, char *argv[])
 {
@@ -111,6 +127,101 @@ main (int argc, char *argv[])
         }
     }
 
+  /* lengths with large prime factors, which use Bluestein's algorithm */
+
+  if (n == 0)
+    {
+      const size_t nlarge[] = { 127, 2 * 131, 1009, 2 * 3 * 257, 0 };
+
+      for (i = 0 ; nlarge[i] != 0 ; i++)
+        {
+          for (stride = 1 ; stride < 3 ; stride++)
+            {
+              test_complex_func (stride, nlarge[i]) ;
+              test_complex_float_func (stride, nlarge[i]) ;
+              test_real_func (stride, nlarge[i]) ;
+              test_real_float_func (stride, nlarge[i]) ;
+            }
+        }
+
+      /* powers of 2 with more than one block of twiddles per stage */
+
+      for (i = 1024 ; i <= 2048 ; i *= 2)
+        {
+          test_complex_radix2 (1, i) ;
+          test_complex_float_radix2 (2, i) ;
+        }
+
+      /* two consecutive Bluestein passes */
+
+      test_complex_noise (2, 89 * 97) ;
+      test_complex_float_noise (2, 89 * 97) ;
+
+      /* multidimensional transforms */
+
+      test_fft2d (12, 37, 40) ;
+      test_fft2d (20, 16, 16) ;
+      test_fft2d (1, 9, 9) ;
+      test_fft3d (5, 6, 7) ;
+      test_fft3d (4, 9, 10) ;
+
+      /* batches of contiguous, interleaved and strided transforms */
+
+      test_fft_batch (24, 11, 1, 27) ;
+      test_fft_batch (24, 11, 11, 1) ;
+      test_fft_batch (30, 5, 2, 61) ;
+      test_fft_batch (127, 3, 3, 1) ;
+
+      test_fft_cache () ;
+
+      /* convolutions by direct sums and transforms */
+
+      test_conv (5, 3) ;
+      test_conv (1, 40) ;
+      test_conv (300, 200) ;
+      test_conv (1000, 7) ;
+      test_conv (1024, 1001) ;
+      test_conv_circular (10) ;
+      test_conv_circular (97) ;
+      test_conv_circular (256) ;
+      test_conv_stream (31, 64, 1000) ;
+      test_conv_stream (1, 1, 100) ;
+      test_conv_stream (100, 0, 2000) ;
+
+      /* cosine and sine transforms against direct sums */
+
+      {
+        const size_t ndct[] = { 2, 3, 5, 8, 15, 16, 64 };
+        int type;
+
+        for (type = GSL_FFT_DCT1; type <= GSL_FFT_DST4; type++)
+          {
+            for (i = 0; i < sizeof (ndct) / sizeof (ndct[0]); i++)
+              {
+                test_dct ((gsl_fft_dct_type) type, ndct[i], 1) ;
+                test_dct ((gsl_fft_dct_type) type, ndct[i], 3) ;
+              }
+
+            test_dct_batch ((gsl_fft_dct_type) type, 12) ;
+          }
+
+        test_dct (GSL_FFT_DCT2, 1, 1) ;
+        test_dct (GSL_FFT_DCT4, 1, 1) ;
+        test_dct2d (9, 12, 14) ;
+        test_mdct (8) ;
+        test_mdct (30) ;
+      }
+
+      /* single precision transforms against double precision */
+
+      test_float_accuracy (64) ;
+      test_float_accuracy (127) ;
+      test_float_accuracy (1000) ;
+      test_float_accuracy (1024) ;
+      test_float_accuracy (3 * 5 * 7 * 9 * 16) ;
+      test_float_accuracy (65536) ;
+    }
+
   gsl_set_error_handler (&my_error_handler);
   test_trap () ;
   test_float_trap () ;
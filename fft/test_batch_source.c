@@ -0,0 +1,122 @@
+/* fft/test_batch_source.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+void test_fft_batch (size_t n, size_t howmany, size_t stride, size_t dist);
+
+/* compare a batch of transforms with the same transforms computed one
+   at a time by the mixed-radix routines */
+
+void
+test_fft_batch (size_t n, size_t howmany, size_t stride, size_t dist)
+{
+  const double tol = 1.0e-14;
+  const size_t len = (howmany - 1) * dist + (n - 1) * stride + 1;
+  gsl_fft_complex_wavetable *cw = gsl_fft_complex_wavetable_alloc (n);
+  gsl_fft_real_wavetable *rw = gsl_fft_real_wavetable_alloc (n);
+  gsl_fft_halfcomplex_wavetable *hw = gsl_fft_halfcomplex_wavetable_alloc (n);
+  gsl_fft_complex_workspace *cwork = gsl_fft_complex_workspace_alloc (n);
+  gsl_fft_real_workspace *rwork = gsl_fft_real_workspace_alloc (n);
+  gsl_fft_batch_workspace *w = gsl_fft_batch_workspace_alloc (n);
+  double *data = malloc (2 * len * sizeof (double));
+  double *orig = malloc (2 * len * sizeof (double));
+  double *ref = malloc (2 * len * sizeof (double));
+  double max_err, max_ref;
+  size_t i, t;
+  int status;
+
+  /* complex */
+
+  for (i = 0; i < 2 * len; i++)
+    data[i] = urand () - 0.5;
+
+  memcpy (orig, data, 2 * len * sizeof (double));
+  memcpy (ref, data, 2 * len * sizeof (double));
+
+  for (t = 0; t < howmany; t++)
+    gsl_fft_complex_forward (ref + 2 * t * dist, stride, n, cw, cwork);
+
+  status = gsl_fft_complex_batch_forward (data, stride, dist, n, howmany, cw, w);
+
+  max_err = 0.0;
+  max_ref = 0.0;
+  for (i = 0; i < 2 * len; i++)
+    {
+      max_err = GSL_MAX (max_err, fabs (data[i] - ref[i]));
+      max_ref = GSL_MAX (max_ref, fabs (ref[i]));
+    }
+
+  gsl_test (status || max_err > tol * max_ref,
+            "gsl_fft_complex_batch_forward, n = %d, howmany = %d, stride = %d, dist = %d",
+            n, howmany, stride, dist);
+
+  status = gsl_fft_complex_batch_inverse (data, stride, dist, n, howmany, cw, w);
+
+  max_err = 0.0;
+  for (i = 0; i < 2 * len; i++)
+    max_err = GSL_MAX (max_err, fabs (data[i] - orig[i]));
+
+  gsl_test (status || max_err > 1.0e-12,
+            "gsl_fft_complex_batch_inverse, n = %d, howmany = %d, stride = %d, dist = %d",
+            n, howmany, stride, dist);
+
+  /* real and halfcomplex */
+
+  for (i = 0; i < len; i++)
+    data[i] = urand () - 0.5;
+
+  memcpy (orig, data, len * sizeof (double));
+  memcpy (ref, data, len * sizeof (double));
+
+  for (t = 0; t < howmany; t++)
+    gsl_fft_real_transform (ref + t * dist, stride, n, rw, rwork);
+
+  status = gsl_fft_real_batch_transform (data, stride, dist, n, howmany, rw, w);
+
+  max_err = 0.0;
+  max_ref = 0.0;
+  for (i = 0; i < len; i++)
+    {
+      max_err = GSL_MAX (max_err, fabs (data[i] - ref[i]));
+      max_ref = GSL_MAX (max_ref, fabs (ref[i]));
+    }
+
+  gsl_test (status || max_err > tol * max_ref,
+            "gsl_fft_real_batch_transform, n = %d, howmany = %d, stride = %d, dist = %d",
+            n, howmany, stride, dist);
+
+  status = gsl_fft_halfcomplex_batch_inverse (data, stride, dist, n, howmany, hw, w);
+
+  max_err = 0.0;
+  for (i = 0; i < len; i++)
+    max_err = GSL_MAX (max_err, fabs (data[i] - orig[i]));
+
+  gsl_test (status || max_err > 1.0e-12,
+            "gsl_fft_halfcomplex_batch_inverse, n = %d, howmany = %d, stride = %d, dist = %d",
+            n, howmany, stride, dist);
+
+  free (data);
+  free (orig);
+  free (ref);
+  gsl_fft_complex_wavetable_free (cw);
+  gsl_fft_real_wavetable_free (rw);
+  gsl_fft_halfcomplex_wavetable_free (hw);
+  gsl_fft_complex_workspace_free (cwork);
+  gsl_fft_real_workspace_free (rwork);
+  gsl_fft_batch_workspace_free (w);
+}
@@ -0,0 +1,107 @@
+/* fft/test_cache_source.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+void test_fft_cache (void);
+
+static size_t test_cache_nlock = 0;
+
+static void
+test_cache_lock (void *data)
+{
+  ++(*(size_t *) data);
+}
+
+static void
+test_cache_unlock (void *data)
+{
+  --(*(size_t *) data);
+}
+
+void
+test_fft_cache (void)
+{
+  gsl_fft_cache *cache = gsl_fft_cache_alloc ((size_t) -1);
+  const gsl_fft_complex_wavetable *a, *a2, *c;
+  const gsl_fft_real_wavetable *b;
+  const gsl_fft_halfcomplex_wavetable_float *h;
+  gsl_error_handler_t *old_handler;
+  int status;
+
+  gsl_fft_cache_set_lock (cache, test_cache_lock, test_cache_unlock,
+                          &test_cache_nlock);
+
+  /* repeated lookups share one wavetable */
+
+  a = gsl_fft_cache_complex (cache, 64);
+  a2 = gsl_fft_cache_complex (cache, 64);
+  b = gsl_fft_cache_real (cache, 64);
+  h = gsl_fft_cache_halfcomplex_float (cache, 2 * 127);
+
+  gsl_test (a == NULL || a != a2 || a->n != 64, "gsl_fft_cache_complex shared wavetable");
+  gsl_test (b == NULL || b->n != 64, "gsl_fft_cache_real wavetable");
+  gsl_test (h == NULL || h->n != 2 * 127, "gsl_fft_cache_halfcomplex_float wavetable");
+  gsl_test (cache->hits != 1 || cache->misses != 3 || cache->nentries != 3,
+            "gsl_fft_cache statistics, hits = %d, misses = %d",
+            cache->hits, cache->misses);
+  gsl_test (test_cache_nlock != 0, "gsl_fft_cache lock balance");
+
+  gsl_fft_cache_release (cache, a);
+  gsl_fft_cache_release (cache, a2);
+  gsl_fft_cache_release (cache, b);
+  gsl_fft_cache_release (cache, h);
+
+  /* releasing an unreferenced wavetable is an error */
+
+  old_handler = gsl_set_error_handler_off ();
+  status = gsl_fft_cache_release (cache, a);
+  gsl_set_error_handler (old_handler);
+
+  gsl_test (status != GSL_EINVAL, "gsl_fft_cache_release unreferenced wavetable");
+
+  /* least recently used unreferenced wavetables are evicted first */
+
+  a = gsl_fft_cache_complex (cache, 64);
+  gsl_fft_cache_release (cache, a);
+
+  cache->max_bytes = cache->nbytes;
+
+  c = gsl_fft_cache_complex (cache, 60);
+
+  gsl_test (cache->nbytes > cache->max_bytes || cache->evictions == 0,
+            "gsl_fft_cache memory bound");
+  gsl_test (gsl_fft_cache_complex (cache, 64) != a || cache->hits != 3,
+            "gsl_fft_cache keeps most recently used wavetable");
+  gsl_fft_cache_release (cache, a);
+
+  gsl_fft_cache_real (cache, 64);
+  gsl_test (cache->misses != 5, "gsl_fft_cache evicts least recently used wavetable");
+
+  /* referenced wavetables are never evicted */
+
+  cache->max_bytes = 0;
+  gsl_fft_cache_release (cache, b = gsl_fft_cache_real (cache, 64));
+  gsl_test (cache->nentries != 2, "gsl_fft_cache keeps referenced wavetables");
+
+  gsl_fft_cache_release (cache, b);
+  gsl_fft_cache_release (cache, c);
+  gsl_test (cache->nentries != 0 || cache->nbytes != 0,
+            "gsl_fft_cache empty after release with zero bound");
+
+  gsl_fft_cache_free (cache);
+}
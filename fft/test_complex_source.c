@@ -26,6 +26,7 @@ int FUNCTION(test,offset) (const BASE data[], size_t stride,
                            size_t n, size_t offset);
 void FUNCTION(test_complex,bitreverse_order) (size_t stride, size_t n) ;
 void FUNCTION(test_complex,radix2) (size_t stride, size_t n);
+void FUNCTION(test_complex,noise) (size_t stride, size_t n);
 
 int FUNCTION(test,offset) (const BASE data[], size_t stride, 
                            size_t n, size_t offset)
@@ -439,10 +440,102 @@ void FUNCTION(test_complex,radix2) (size_t stride, size_t n)
               "_radix2_forward with signal_exp, n = %d, stride = %d", n, stride);
   }
 
-  
+  /* Test the decimation in frequency fft */
+
+  {
+    FUNCTION(fft_signal,complex_noise) (n, stride, complex_data, 
+                                        fft_complex_data);
+    for (i = 0 ; i < n ; i++)
+      {
+        REAL(complex_tmp,stride,i) = REAL(complex_data,stride,i) ;
+        IMAG(complex_tmp,stride,i) = IMAG(complex_data,stride,i) ;
+      }
+
+    FUNCTION(gsl_fft_complex,radix2_dif_forward) (complex_data, stride, n);
+    status = FUNCTION(compare_complex,results) ("dft", fft_complex_data,
+                                                "fft of noise", complex_data,
+                                                stride, n, 1e6);
+    gsl_test (status, NAME(gsl_fft_complex) 
+              "_radix2_dif_forward with signal_noise, n = %d, stride = %d",  
+              n, stride);
+
+    FUNCTION(gsl_fft_complex,radix2_dif_inverse) (complex_data, stride, n);
+    status = FUNCTION(compare_complex,results) ("orig", complex_tmp,
+                                                "fft inverse", complex_data,
+                                                stride, n, 1e6);
+    gsl_test (status, NAME(gsl_fft_complex) 
+              "_radix2_dif_inverse with signal_noise, n = %d, stride = %d",
+              n, stride);
+
+    if (stride > 1) 
+      {
+        status = FUNCTION(test, offset) (complex_data, stride, n, 0) ;
+        
+        gsl_test (status, NAME(gsl_fft_complex) 
+                  "_radix2_dif_inverse other data untouched, n = %d, stride = %d",
+                  n, stride);
+      }
+  }
+
   free (complex_data);
   free (complex_tmp);
   free (fft_complex_data);
   free (fft_complex_tmp);
 }
 
+/* a shorter test of the mixed radix fft with noise only, for lengths
+   where the full set of signals would be too slow */
+
+void FUNCTION(test_complex,noise) (size_t stride, size_t n)
+{
+  size_t i ;
+  int status ;
+
+  TYPE(gsl_fft_complex_wavetable) * cw ;
+  TYPE(gsl_fft_complex_workspace) * cwork ;
+
+  BASE * complex_data = (BASE *) malloc (2 * n * stride * sizeof (BASE));
+  BASE * complex_tmp = (BASE *) malloc (2 * n * stride * sizeof (BASE));
+  BASE * fft_complex_data = (BASE *) malloc (2 * n * stride * sizeof (BASE));
+
+  for (i = 0 ; i < 2 * n * stride ; i++)
+    {
+      complex_data[i] = (BASE)i ;
+      complex_tmp[i] = (BASE)(i + 1000.0) ;
+      fft_complex_data[i] = (BASE)(i + 2000.0) ;
+    }
+
+  cw = FUNCTION(gsl_fft_complex_wavetable,alloc) (n);
+  cwork = FUNCTION(gsl_fft_complex_workspace,alloc) (n);
+
+  FUNCTION(fft_signal,complex_noise) (n, stride, complex_data, fft_complex_data);
+
+  for (i = 0 ; i < n ; i++)
+    {
+      REAL(complex_tmp,stride,i) = REAL(complex_data,stride,i) ;
+      IMAG(complex_tmp,stride,i) = IMAG(complex_data,stride,i) ;
+    }
+
+  FUNCTION(gsl_fft_complex,forward) (complex_data, stride, n, cw, cwork);
+
+  status = FUNCTION(compare_complex,results) ("dft", fft_complex_data,
+                                              "fft of noise", complex_data,
+                                              stride, n, 1e6);
+  gsl_test (status, NAME(gsl_fft_complex) 
+            "_forward with signal_noise, n = %d, stride = %d",  n, stride);
+
+  FUNCTION(gsl_fft_complex,inverse) (complex_data, stride, n, cw, cwork);
+
+  status = FUNCTION(compare_complex,results) ("orig", complex_tmp,
+                                              "fft inverse", complex_data,
+                                              stride, n, 1e6);
+  gsl_test (status, NAME(gsl_fft_complex) 
+            "_inverse with signal_noise, n = %d, stride = %d", n, stride);
+
+  FUNCTION(gsl_fft_complex_wavetable,free) (cw);
+  FUNCTION(gsl_fft_complex_workspace,free) (cwork);
+
+  free (complex_data);
+  free (complex_tmp);
+  free (fft_complex_data);
+}
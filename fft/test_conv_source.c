@@ -0,0 +1,324 @@
+/* fft/test_conv_source.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+void test_conv (size_t na, size_t nb);
+void test_conv_circular (size_t n);
+void test_conv_stream (size_t nh, size_t n, size_t nx);
+
+/* reference linear convolution (corr = 0) or correlation (corr = 1) of
+   complex sequences, with b conjugated for correlations */
+
+static void
+test_conv_ref (const double a[], size_t na, const double b[], size_t nb,
+               double c[], int corr)
+{
+  size_t i, j;
+
+  for (i = 0; i < 2 * (na + nb - 1); i++)
+    c[i] = 0.0;
+
+  for (i = 0; i < na; i++)
+    {
+      for (j = 0; j < nb; j++)
+        {
+          const size_t k = corr ? i + nb - 1 - j : i + j;
+          const double s = corr ? -1.0 : 1.0;
+
+          c[2 * k] += a[2 * i] * b[2 * j] - s * a[2 * i + 1] * b[2 * j + 1];
+          c[2 * k + 1] += s * a[2 * i] * b[2 * j + 1] + a[2 * i + 1] * b[2 * j];
+        }
+    }
+}
+
+static double
+test_conv_error (const double x[], const double y[], size_t n)
+{
+  double max_err = 0.0;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    max_err = GSL_MAX (max_err, fabs (x[i] - y[i]));
+
+  return max_err;
+}
+
+void
+test_conv (size_t na, size_t nb)
+{
+  const double tol = 1.0e-12;
+  const size_t nc = na + nb - 1;
+  gsl_fft_conv_workspace *w = gsl_fft_conv_alloc (nc);
+  double *a = malloc (2 * na * sizeof (double));
+  double *b = malloc (2 * nb * sizeof (double));
+  double *ar = malloc (na * sizeof (double));
+  double *br = malloc (nb * sizeof (double));
+  double *c = malloc (2 * nc * sizeof (double));
+  double *ref = malloc (2 * nc * sizeof (double));
+  double err;
+  size_t i;
+  int corr, status;
+
+  for (i = 0; i < 2 * na; i++)
+    a[i] = urand () - 0.5;
+  for (i = 0; i < 2 * nb; i++)
+    b[i] = urand () - 0.5;
+
+  for (corr = 0; corr <= 1; corr++)
+    {
+      /* complex sequences */
+
+      test_conv_ref (a, na, b, nb, ref, corr);
+
+      if (corr)
+        status = gsl_fft_corr_complex (a, na, b, nb, c, w);
+      else
+        status = gsl_fft_conv_complex (a, na, b, nb, c, w);
+
+      err = test_conv_error (c, ref, 2 * nc);
+      gsl_test (status || err > tol, "gsl_fft_%s_complex, na = %d, nb = %d, err = %g",
+                corr ? "corr" : "conv", na, nb, err);
+
+      /* real sequences */
+
+      for (i = 0; i < na; i++)
+        {
+          ar[i] = a[2 * i];
+          a[2 * i + 1] = 0.0;
+        }
+      for (i = 0; i < nb; i++)
+        {
+          br[i] = b[2 * i];
+          b[2 * i + 1] = 0.0;
+        }
+
+      test_conv_ref (a, na, b, nb, ref, corr);
+
+      if (corr)
+        status = gsl_fft_corr_real (ar, na, br, nb, c, w);
+      else
+        status = gsl_fft_conv_real (ar, na, br, nb, c, w);
+
+      {
+        double max_err = 0.0;
+
+        for (i = 0; i < nc; i++)
+          max_err = GSL_MAX (max_err, fabs (c[i] - ref[2 * i]));
+
+        gsl_test (status || max_err > tol, "gsl_fft_%s_real, na = %d, nb = %d, err = %g",
+                  corr ? "corr" : "conv", na, nb, max_err);
+      }
+
+      for (i = 0; i < 2 * na; i++)
+        a[i] = urand () - 0.5;
+      for (i = 0; i < 2 * nb; i++)
+        b[i] = urand () - 0.5;
+    }
+
+  free (a);
+  free (b);
+  free (ar);
+  free (br);
+  free (c);
+  free (ref);
+  gsl_fft_conv_free (w);
+}
+
+void
+test_conv_circular (size_t n)
+{
+  const double tol = 1.0e-12;
+  gsl_fft_conv_workspace *w = gsl_fft_conv_alloc (n);
+  double *a = malloc (2 * n * sizeof (double));
+  double *b = malloc (2 * n * sizeof (double));
+  double *ar = malloc (n * sizeof (double));
+  double *br = malloc (n * sizeof (double));
+  double *c = malloc (2 * n * sizeof (double));
+  double *ref = malloc (2 * (2 * n - 1) * sizeof (double));
+  size_t i;
+  int corr, status;
+
+  for (i = 0; i < 2 * n; i++)
+    {
+      a[i] = urand () - 0.5;
+      b[i] = urand () - 0.5;
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      ar[i] = a[2 * i];
+      br[i] = b[2 * i];
+    }
+
+  for (corr = 0; corr <= 1; corr++)
+    {
+      double max_err = 0.0;
+
+      /* fold the linear result onto n points */
+
+      test_conv_ref (a, n, b, n, ref, corr);
+
+      for (i = 0; i < n - 1; i++)
+        {
+          /* convolution: c_k += lin_{k+n}; correlation: lag k is at
+             index k + n - 1, and lag k - n at index k - 1 */
+          if (corr)
+            {
+              ref[2 * (i + n)] += ref[2 * i];
+              ref[2 * (i + n) + 1] += ref[2 * i + 1];
+            }
+          else
+            {
+              ref[2 * i] += ref[2 * (i + n)];
+              ref[2 * i + 1] += ref[2 * (i + n) + 1];
+            }
+        }
+
+      {
+        const double *r = corr ? ref + 2 * (n - 1) : ref;
+
+        if (corr)
+          status = gsl_fft_corr_complex_circular (a, b, n, c, w);
+        else
+          status = gsl_fft_conv_complex_circular (a, b, n, c, w);
+
+        max_err = test_conv_error (c, r, 2 * n);
+        gsl_test (status || max_err > tol, "gsl_fft_%s_complex_circular, n = %d, err = %g",
+                  corr ? "corr" : "conv", n, max_err);
+
+        /* real parts of the real sequences alone */
+
+        for (i = 0; i < n; i++)
+          {
+            a[2 * i + 1] = 0.0;
+            b[2 * i + 1] = 0.0;
+          }
+      }
+
+      test_conv_ref (a, n, b, n, ref, corr);
+
+      for (i = 0; i < n - 1; i++)
+        {
+          if (corr)
+            ref[2 * (i + n)] += ref[2 * i];
+          else
+            ref[2 * i] += ref[2 * (i + n)];
+        }
+
+      {
+        const double *r = corr ? ref + 2 * (n - 1) : ref;
+
+        if (corr)
+          status = gsl_fft_corr_real_circular (ar, br, n, c, w);
+        else
+          status = gsl_fft_conv_real_circular (ar, br, n, c, w);
+
+        max_err = 0.0;
+        for (i = 0; i < n; i++)
+          max_err = GSL_MAX (max_err, fabs (c[i] - r[2 * i]));
+
+        gsl_test (status || max_err > tol, "gsl_fft_%s_real_circular, n = %d, err = %g",
+                  corr ? "corr" : "conv", n, max_err);
+      }
+
+      for (i = 0; i < 2 * n; i++)
+        {
+          a[i] = urand () - 0.5;
+          b[i] = urand () - 0.5;
+        }
+
+      for (i = 0; i < n; i++)
+        {
+          ar[i] = a[2 * i];
+          br[i] = b[2 * i];
+        }
+    }
+
+  free (a);
+  free (b);
+  free (ar);
+  free (br);
+  free (c);
+  free (ref);
+  gsl_fft_conv_free (w);
+}
+
+/* streaming convolution of nx samples with a filter of length nh and
+   transforms of length n, fed in blocks of varying size */
+
+void
+test_conv_stream (size_t nh, size_t n, size_t nx)
+{
+  const double tol = 1.0e-12;
+  const size_t chunks[] = { 1, 17, 5, 250, 64, 3 };
+  gsl_fft_conv_stream *s;
+  double *h = malloc (nh * sizeof (double));
+  double *x = malloc (nx * sizeof (double));
+  double *y = malloc (nx * sizeof (double));
+  double *ref = malloc (nx * sizeof (double));
+  double max_err;
+  size_t i, j, k, pass;
+
+  for (i = 0; i < nh; i++)
+    h[i] = urand () - 0.5;
+
+  for (i = 0; i < nx; i++)
+    x[i] = urand () - 0.5;
+
+  for (i = 0; i < nx; i++)
+    {
+      double sum = 0.0;
+
+      for (j = 0; j < nh && j <= i; j++)
+        sum += h[j] * x[i - j];
+
+      ref[i] = sum;
+    }
+
+  s = gsl_fft_conv_stream_alloc (h, nh, n);
+
+  for (pass = 0; pass < 2; pass++)
+    {
+      /* second pass filters in-place after a reset */
+      double *out = (pass == 0) ? y : x;
+
+      if (pass == 1)
+        gsl_fft_conv_stream_reset (s);
+
+      for (i = 0, k = 0; i < nx; k++)
+        {
+          const size_t m = GSL_MIN (chunks[k % 6], nx - i);
+
+          gsl_fft_conv_stream_process (x + i, m, out + i, s);
+          i += m;
+        }
+
+      max_err = 0.0;
+      for (i = 0; i < nx; i++)
+        max_err = GSL_MAX (max_err, fabs (out[i] - ref[i]));
+
+      gsl_test (max_err > tol, "gsl_fft_conv_stream_process%s, nh = %d, n = %d, err = %g",
+                pass ? " in-place" : "", nh, n, max_err);
+    }
+
+  gsl_fft_conv_stream_free (s);
+  free (h);
+  free (x);
+  free (y);
+  free (ref);
+}
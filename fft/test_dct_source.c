@@ -0,0 +1,385 @@
+/* fft/test_dct_source.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+void test_dct (gsl_fft_dct_type type, size_t n, size_t stride);
+void test_dct_batch (gsl_fft_dct_type type, size_t n);
+void test_dct2d (size_t size1, size_t size2, size_t tda);
+void test_mdct (size_t n);
+
+static const char *test_dct_names[] = {
+  "DCT-I", "DCT-II", "DCT-III", "DCT-IV",
+  "DST-I", "DST-II", "DST-III", "DST-IV"
+};
+
+/* reference transforms by direct sums */
+
+static void
+test_dct_ref (gsl_fft_dct_type type, const double x[], double y[], size_t n)
+{
+  size_t j, k;
+
+  for (k = 0; k < n; k++)
+    {
+      double sum = 0.0;
+
+      for (j = 0; j < n; j++)
+        {
+          const double dj = (double) j, dk = (double) k;
+
+          switch (type)
+            {
+              case GSL_FFT_DCT1:
+                if (j == 0)
+                  sum += x[j];
+                else if (j == n - 1)
+                  sum += (k % 2 ? -1.0 : 1.0) * x[j];
+                else
+                  sum += 2.0 * x[j] * cos (M_PI * dj * dk / (n - 1.0));
+                break;
+
+              case GSL_FFT_DCT2:
+                sum += 2.0 * x[j] * cos (M_PI * (dj + 0.5) * dk / n);
+                break;
+
+              case GSL_FFT_DCT3:
+                if (j == 0)
+                  sum += x[j];
+                else
+                  sum += 2.0 * x[j] * cos (M_PI * dj * (dk + 0.5) / n);
+                break;
+
+              case GSL_FFT_DCT4:
+                sum += 2.0 * x[j] * cos (M_PI * (dj + 0.5) * (dk + 0.5) / n);
+                break;
+
+              case GSL_FFT_DST1:
+                sum += 2.0 * x[j] * sin (M_PI * (dj + 1.0) * (dk + 1.0) / (n + 1.0));
+                break;
+
+              case GSL_FFT_DST2:
+                sum += 2.0 * x[j] * sin (M_PI * (dj + 0.5) * (dk + 1.0) / n);
+                break;
+
+              case GSL_FFT_DST3:
+                if (j == n - 1)
+                  sum += (k % 2 ? -1.0 : 1.0) * x[j];
+                else
+                  sum += 2.0 * x[j] * sin (M_PI * (dj + 1.0) * (dk + 0.5) / n);
+                break;
+
+              case GSL_FFT_DST4:
+                sum += 2.0 * x[j] * sin (M_PI * (dj + 0.5) * (dk + 0.5) / n);
+                break;
+            }
+        }
+
+      y[k] = sum;
+    }
+}
+
+/* normalization of the inverse transform */
+
+static double
+test_dct_scale (gsl_fft_dct_type type, size_t n)
+{
+  switch (type)
+    {
+      case GSL_FFT_DCT1:
+        return 2.0 * (n - 1.0);
+      case GSL_FFT_DST1:
+        return 2.0 * (n + 1.0);
+      default:
+        return 2.0 * n;
+    }
+}
+
+static gsl_fft_dct_type
+test_dct_inverse_type (gsl_fft_dct_type type)
+{
+  switch (type)
+    {
+      case GSL_FFT_DCT2:
+        return GSL_FFT_DCT3;
+      case GSL_FFT_DCT3:
+        return GSL_FFT_DCT2;
+      case GSL_FFT_DST2:
+        return GSL_FFT_DST3;
+      case GSL_FFT_DST3:
+        return GSL_FFT_DST2;
+      default:
+        return type;
+    }
+}
+
+void
+test_dct (gsl_fft_dct_type type, size_t n, size_t stride)
+{
+  const double tol = 1.0e-12 * n;
+  gsl_fft_dct_workspace *w = gsl_fft_dct_alloc (type, n);
+  gsl_fft_dct_workspace *winv = gsl_fft_dct_alloc (test_dct_inverse_type (type), n);
+  double *x = malloc (n * sizeof (double));
+  double *ref = malloc (n * sizeof (double));
+  double *data = malloc (n * stride * sizeof (double));
+  double max_err = 0.0, inv_err = 0.0;
+  const double scale = test_dct_scale (type, n);
+  size_t i;
+  int status;
+
+  for (i = 0; i < n * stride; i++)
+    data[i] = -1.0;
+
+  for (i = 0; i < n; i++)
+    {
+      x[i] = urand () - 0.5;
+      data[i * stride] = x[i];
+    }
+
+  test_dct_ref (type, x, ref, n);
+
+  status = gsl_fft_dct_transform (data, stride, w);
+
+  for (i = 0; i < n; i++)
+    max_err = GSL_MAX (max_err, fabs (data[i * stride] - ref[i]));
+
+  gsl_test (status || max_err > tol, "gsl_fft_dct_transform %s, n = %d, stride = %d, err = %g",
+            test_dct_names[type], n, stride, max_err);
+
+  /* transform back and check the padding is untouched */
+
+  status = gsl_fft_dct_transform (data, stride, winv);
+
+  for (i = 0; i < n * stride; i++)
+    {
+      const double expected = (i % stride == 0) ? scale * x[i / stride] : -1.0;
+      inv_err = GSL_MAX (inv_err, fabs (data[i] - expected));
+    }
+
+  gsl_test (status || inv_err > tol * scale, "gsl_fft_dct_transform %s inverse, n = %d, stride = %d, err = %g",
+            test_dct_names[type], n, stride, inv_err);
+
+  free (x);
+  free (ref);
+  free (data);
+  gsl_fft_dct_free (w);
+  gsl_fft_dct_free (winv);
+}
+
+/* batches of contiguous and interleaved transforms against single
+   transforms */
+
+void
+test_dct_batch (gsl_fft_dct_type type, size_t n)
+{
+  const size_t howmany = 11;
+  gsl_fft_dct_workspace *w = gsl_fft_dct_alloc (type, n);
+  double *a = malloc (n * howmany * sizeof (double));
+  double *b = malloc (n * howmany * sizeof (double));
+  double *ref = malloc (n * howmany * sizeof (double));
+  double err1 = 0.0, err2 = 0.0;
+  size_t i, t;
+  int status1, status2;
+
+  for (i = 0; i < n * howmany; i++)
+    a[i] = urand () - 0.5;
+
+  for (t = 0; t < howmany; t++)
+    for (i = 0; i < n; i++)
+      {
+        ref[t * n + i] = a[t * n + i];
+        b[i * howmany + t] = a[t * n + i];
+      }
+
+  for (t = 0; t < howmany; t++)
+    gsl_fft_dct_transform (ref + t * n, 1, w);
+
+  status1 = gsl_fft_dct_batch (a, 1, n, howmany, w);
+  status2 = gsl_fft_dct_batch (b, howmany, 1, howmany, w);
+
+  for (t = 0; t < howmany; t++)
+    for (i = 0; i < n; i++)
+      {
+        err1 = GSL_MAX (err1, fabs (a[t * n + i] - ref[t * n + i]));
+        err2 = GSL_MAX (err2, fabs (b[i * howmany + t] - ref[t * n + i]));
+      }
+
+  gsl_test (status1 || err1 > 0.0, "gsl_fft_dct_batch %s contiguous, n = %d, err = %g",
+            test_dct_names[type], n, err1);
+  gsl_test (status2 || err2 > 0.0, "gsl_fft_dct_batch %s interleaved, n = %d, err = %g",
+            test_dct_names[type], n, err2);
+
+  free (a);
+  free (b);
+  free (ref);
+  gsl_fft_dct_free (w);
+}
+
+/* DCT-II of the columns and DST-IV of the rows against direct sums */
+
+void
+test_dct2d (size_t size1, size_t size2, size_t tda)
+{
+  const double tol = 1.0e-12 * size1 * size2;
+  gsl_fft_dct_workspace *w1 = gsl_fft_dct_alloc (GSL_FFT_DCT2, size1);
+  gsl_fft_dct_workspace *w2 = gsl_fft_dct_alloc (GSL_FFT_DST4, size2);
+  double *data = malloc (size1 * tda * sizeof (double));
+  double *ref = malloc (size1 * size2 * sizeof (double));
+  double *x = malloc (GSL_MAX (size1, size2) * sizeof (double));
+  double *y = malloc (GSL_MAX (size1, size2) * sizeof (double));
+  double max_err = 0.0;
+  size_t i, j;
+  int status;
+
+  for (i = 0; i < size1 * tda; i++)
+    data[i] = urand () - 0.5;
+
+  for (i = 0; i < size1; i++)
+    {
+      for (j = 0; j < size2; j++)
+        x[j] = data[i * tda + j];
+
+      test_dct_ref (GSL_FFT_DST4, x, y, size2);
+
+      for (j = 0; j < size2; j++)
+        ref[i * size2 + j] = y[j];
+    }
+
+  for (j = 0; j < size2; j++)
+    {
+      for (i = 0; i < size1; i++)
+        x[i] = ref[i * size2 + j];
+
+      test_dct_ref (GSL_FFT_DCT2, x, y, size1);
+
+      for (i = 0; i < size1; i++)
+        ref[i * size2 + j] = y[i];
+    }
+
+  status = gsl_fft_dct2d_transform (data, tda, w1, w2);
+
+  for (i = 0; i < size1; i++)
+    for (j = 0; j < size2; j++)
+      max_err = GSL_MAX (max_err, fabs (data[i * tda + j] - ref[i * size2 + j]));
+
+  gsl_test (status || max_err > tol, "gsl_fft_dct2d_transform, size1 = %d, size2 = %d, tda = %d, err = %g",
+            size1, size2, tda, max_err);
+
+  free (data);
+  free (ref);
+  free (x);
+  free (y);
+  gsl_fft_dct_free (w1);
+  gsl_fft_dct_free (w2);
+}
+
+/* MDCT and inverse MDCT against their definitions, and perfect
+   reconstruction by overlap-add with a sine window */
+
+void
+test_mdct (size_t n)
+{
+  const double tol = 1.0e-12 * n;
+  const size_t nblocks = 4;
+  const size_t nx = (nblocks + 1) * n;
+  gsl_fft_dct_workspace *w = gsl_fft_dct_alloc (GSL_FFT_DCT4, n);
+  double *in = malloc (2 * n * sizeof (double));
+  double *out = malloc (2 * n * sizeof (double));
+  double *ref = malloc (2 * n * sizeof (double));
+  double *win = malloc (2 * n * sizeof (double));
+  double *x = malloc (nx * sizeof (double));
+  double *y = malloc (nx * sizeof (double));
+  double max_err;
+  size_t i, j, k, b;
+  int status;
+
+  for (i = 0; i < 2 * n; i++)
+    in[i] = urand () - 0.5;
+
+  for (k = 0; k < n; k++)
+    {
+      double sum = 0.0;
+
+      for (j = 0; j < 2 * n; j++)
+        sum += in[j] * cos (M_PI / n * (j + 0.5 + 0.5 * n) * (k + 0.5));
+
+      ref[k] = sum;
+    }
+
+  status = gsl_fft_mdct_forward (in, out, w);
+
+  max_err = 0.0;
+  for (k = 0; k < n; k++)
+    max_err = GSL_MAX (max_err, fabs (out[k] - ref[k]));
+
+  gsl_test (status || max_err > tol, "gsl_fft_mdct_forward, n = %d, err = %g", n, max_err);
+
+  for (j = 0; j < 2 * n; j++)
+    {
+      double sum = 0.0;
+
+      for (k = 0; k < n; k++)
+        sum += in[k] * cos (M_PI / n * (j + 0.5 + 0.5 * n) * (k + 0.5));
+
+      ref[j] = sum;
+    }
+
+  status = gsl_fft_mdct_backward (in, out, w);
+
+  max_err = 0.0;
+  for (j = 0; j < 2 * n; j++)
+    max_err = GSL_MAX (max_err, fabs (out[j] - ref[j]));
+
+  gsl_test (status || max_err > tol, "gsl_fft_mdct_backward, n = %d, err = %g", n, max_err);
+
+  /* time domain aliasing cancellation */
+
+  for (i = 0; i < 2 * n; i++)
+    win[i] = sin (M_PI * (i + 0.5) / (2.0 * n));
+
+  for (i = 0; i < nx; i++)
+    {
+      x[i] = urand () - 0.5;
+      y[i] = 0.0;
+    }
+
+  for (b = 0; b < nblocks; b++)
+    {
+      for (i = 0; i < 2 * n; i++)
+        in[i] = win[i] * x[b * n + i];
+
+      gsl_fft_mdct_forward (in, ref, w);
+      gsl_fft_mdct_backward (ref, out, w);
+
+      for (i = 0; i < 2 * n; i++)
+        y[b * n + i] += 2.0 * win[i] * out[i] / n;
+    }
+
+  max_err = 0.0;
+  for (i = n; i < nblocks * n; i++)
+    max_err = GSL_MAX (max_err, fabs (y[i] - x[i]));
+
+  gsl_test (max_err > tol, "gsl_fft_mdct reconstruction, n = %d, err = %g", n, max_err);
+
+  free (in);
+  free (out);
+  free (ref);
+  free (win);
+  free (x);
+  free (y);
+  gsl_fft_dct_free (w);
+}
@@ -0,0 +1,126 @@
+/* fft/test_float_source.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+void test_float_accuracy (size_t n);
+
+/* relative rms difference between a single precision result and the
+   double precision result */
+
+static double
+test_float_rms (const float x[], const double y[], size_t n)
+{
+  double sum_err = 0.0, sum_y = 0.0;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      const double e = (double) x[i] - y[i];
+      sum_err += e * e;
+      sum_y += y[i] * y[i];
+    }
+
+  return sqrt (sum_err / sum_y);
+}
+
+/* Compare the single precision complex, real and halfcomplex
+   transforms with the double precision transforms of the same
+   inputs. The rms error of a floating point FFT grows as
+   O(eps sqrt(log n)), so a bound of 4 eps log2(n) leaves a wide
+   margin while catching any systematic loss of precision. */
+
+void
+test_float_accuracy (size_t n)
+{
+  const double tol = 4.0 * GSL_FLT_EPSILON * GSL_MAX (1.0, log ((double) n) / M_LN2);
+  gsl_fft_complex_wavetable *cw = gsl_fft_complex_wavetable_alloc (n);
+  gsl_fft_complex_workspace *cwork = gsl_fft_complex_workspace_alloc (n);
+  gsl_fft_complex_wavetable_float *cwf = gsl_fft_complex_wavetable_float_alloc (n);
+  gsl_fft_complex_workspace_float *cworkf = gsl_fft_complex_workspace_float_alloc (n);
+  gsl_fft_real_wavetable *rw = gsl_fft_real_wavetable_alloc (n);
+  gsl_fft_real_wavetable_float *rwf = gsl_fft_real_wavetable_float_alloc (n);
+  gsl_fft_real_workspace *rwork = gsl_fft_real_workspace_alloc (n);
+  gsl_fft_real_workspace_float *rworkf = gsl_fft_real_workspace_float_alloc (n);
+  gsl_fft_halfcomplex_wavetable *hw = gsl_fft_halfcomplex_wavetable_alloc (n);
+  gsl_fft_halfcomplex_wavetable_float *hwf = gsl_fft_halfcomplex_wavetable_float_alloc (n);
+  double *x = malloc (2 * n * sizeof (double));
+  float *xf = malloc (2 * n * sizeof (float));
+  double err;
+  size_t i;
+
+  /* inputs exactly representable in single precision */
+
+  for (i = 0; i < 2 * n; i++)
+    {
+      xf[i] = (float) (urand () - 0.5);
+      x[i] = xf[i];
+    }
+
+  gsl_fft_complex_forward (x, 1, n, cw, cwork);
+  gsl_fft_complex_float_forward (xf, 1, n, cwf, cworkf);
+
+  err = test_float_rms (xf, x, 2 * n);
+  gsl_test (err > tol, "gsl_fft_complex_float_forward against double, n = %d, rms error = %g",
+            n, err);
+
+  for (i = 0; i < 2 * n; i++)
+    x[i] = xf[i];
+
+  gsl_fft_complex_backward (x, 1, n, cw, cwork);
+  gsl_fft_complex_float_backward (xf, 1, n, cwf, cworkf);
+
+  err = test_float_rms (xf, x, 2 * n);
+  gsl_test (err > tol, "gsl_fft_complex_float_backward against double, n = %d, rms error = %g",
+            n, err);
+
+  for (i = 0; i < n; i++)
+    {
+      xf[i] = (float) (urand () - 0.5);
+      x[i] = xf[i];
+    }
+
+  gsl_fft_real_transform (x, 1, n, rw, rwork);
+  gsl_fft_real_float_transform (xf, 1, n, rwf, rworkf);
+
+  err = test_float_rms (xf, x, n);
+  gsl_test (err > tol, "gsl_fft_real_float_transform against double, n = %d, rms error = %g",
+            n, err);
+
+  for (i = 0; i < n; i++)
+    x[i] = xf[i];
+
+  gsl_fft_halfcomplex_inverse (x, 1, n, hw, rwork);
+  gsl_fft_halfcomplex_float_inverse (xf, 1, n, hwf, rworkf);
+
+  err = test_float_rms (xf, x, n);
+  gsl_test (err > tol, "gsl_fft_halfcomplex_float_inverse against double, n = %d, rms error = %g",
+            n, err);
+
+  free (x);
+  free (xf);
+  gsl_fft_complex_wavetable_free (cw);
+  gsl_fft_complex_workspace_free (cwork);
+  gsl_fft_complex_wavetable_float_free (cwf);
+  gsl_fft_complex_workspace_float_free (cworkf);
+  gsl_fft_real_wavetable_free (rw);
+  gsl_fft_real_wavetable_float_free (rwf);
+  gsl_fft_real_workspace_free (rwork);
+  gsl_fft_real_workspace_float_free (rworkf);
+  gsl_fft_halfcomplex_wavetable_free (hw);
+  gsl_fft_halfcomplex_wavetable_float_free (hwf);
+}
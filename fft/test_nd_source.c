@@ -0,0 +1,260 @@
+/* fft/test_nd_source.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+void test_fft2d (size_t size1, size_t size2, size_t tda);
+void test_fft3d (size_t size1, size_t size2, size_t size3);
+
+/* apply the forward dft along one axis of a contiguous row-major complex
+   array, where nouter and ninner are the products of the dimensions
+   before and after the axis */
+
+static void
+test_nd_dft_axis (double a[], size_t nouter, size_t n, size_t ninner)
+{
+  double *tmp = malloc (2 * n * ninner * sizeof (double));
+  size_t o, r, k;
+
+  /* the dft result has the same stride as its input */
+
+  for (o = 0; o < nouter; o++)
+    {
+      for (r = 0; r < ninner; r++)
+        {
+          double *x = a + 2 * (o * n * ninner + r);
+
+          gsl_dft_complex_forward (x, ninner, n, tmp);
+
+          for (k = 0; k < n; k++)
+            {
+              x[2 * k * ninner] = tmp[2 * k * ninner];
+              x[2 * k * ninner + 1] = tmp[2 * k * ninner + 1];
+            }
+        }
+    }
+
+  free (tmp);
+}
+
+/* maximum difference between the first m columns of a complex
+   matrix with leading dimension tda and a contiguous reference with
+   leading dimension n, relative to the largest reference element */
+
+static double
+test_nd_error (const double a[], size_t tda, const double ref[], size_t n,
+               size_t nrows, size_t m)
+{
+  double max_err = 0.0, max_ref = 0.0;
+  size_t i, j;
+
+  for (i = 0; i < nrows; i++)
+    {
+      for (j = 0; j < 2 * m; j++)
+        {
+          double d = fabs (a[2 * i * tda + j] - ref[2 * i * n + j]);
+          double z = fabs (ref[2 * i * n + j]);
+
+          if (d > max_err)
+            max_err = d;
+
+          if (z > max_ref)
+            max_ref = z;
+        }
+    }
+
+  return max_ref > 0.0 ? max_err / max_ref : max_err;
+}
+
+void
+test_fft2d (size_t size1, size_t size2, size_t tda)
+{
+  const double tol = 1.0e-12;
+  const size_t m = size2 / 2 + 1;
+  gsl_fft2d_workspace *w = gsl_fft2d_alloc (size1, size2);
+  double *data = malloc (2 * size1 * tda * sizeof (double));
+  double *orig = malloc (2 * size1 * tda * sizeof (double));
+  double *ref = malloc (2 * size1 * size2 * sizeof (double));
+  double *x = malloc (size1 * tda * sizeof (double));
+  double *y = malloc (size1 * tda * sizeof (double));
+  double *z = malloc (2 * size1 * m * sizeof (double));
+  size_t i, j;
+  int status;
+
+  /* complex transform */
+
+  for (i = 0; i < 2 * size1 * tda; i++)
+    data[i] = urand () - 0.5;
+
+  memcpy (orig, data, 2 * size1 * tda * sizeof (double));
+
+  for (i = 0; i < size1; i++)
+    for (j = 0; j < 2 * size2; j++)
+      ref[2 * i * size2 + j] = data[2 * i * tda + j];
+
+  test_nd_dft_axis (ref, 1, size1, size2);
+  test_nd_dft_axis (ref, size1, size2, 1);
+
+  status = gsl_fft2d_complex_forward (data, tda, w);
+  gsl_test (status, "gsl_fft2d_complex_forward status, %d-by-%d, tda = %d",
+            size1, size2, tda);
+  gsl_test (test_nd_error (data, tda, ref, size2, size1, size2) > tol,
+            "gsl_fft2d_complex_forward, %d-by-%d, tda = %d", size1, size2, tda);
+
+  /* padding beyond size2 must be left untouched */
+
+  status = 0;
+  for (i = 0; i < size1; i++)
+    for (j = 2 * size2; j < 2 * tda; j++)
+      status |= (data[2 * i * tda + j] != orig[2 * i * tda + j]);
+
+  gsl_test (status, "gsl_fft2d_complex_forward padding, %d-by-%d, tda = %d",
+            size1, size2, tda);
+
+  status = gsl_fft2d_complex_inverse (data, tda, w);
+  gsl_test (status, "gsl_fft2d_complex_inverse status, %d-by-%d, tda = %d",
+            size1, size2, tda);
+  gsl_test (test_nd_error (data, tda, orig, tda, size1, size2) > tol,
+            "gsl_fft2d_complex_inverse, %d-by-%d, tda = %d", size1, size2, tda);
+
+  /* real transform, compared with the complex transform of the same data */
+
+  for (i = 0; i < size1 * tda; i++)
+    x[i] = urand () - 0.5;
+
+  for (i = 0; i < size1; i++)
+    {
+      for (j = 0; j < size2; j++)
+        {
+          ref[2 * (i * size2 + j)] = x[i * tda + j];
+          ref[2 * (i * size2 + j) + 1] = 0.0;
+        }
+    }
+
+  test_nd_dft_axis (ref, 1, size1, size2);
+  test_nd_dft_axis (ref, size1, size2, 1);
+
+  status = gsl_fft2d_real_forward (x, tda, z, m, w);
+  gsl_test (status, "gsl_fft2d_real_forward status, %d-by-%d", size1, size2);
+  gsl_test (test_nd_error (z, m, ref, size2, size1, m) > tol,
+            "gsl_fft2d_real_forward, %d-by-%d", size1, size2);
+
+  status = gsl_fft2d_halfcomplex_inverse (z, m, y, tda, w);
+  gsl_test (status, "gsl_fft2d_halfcomplex_inverse status, %d-by-%d",
+            size1, size2);
+
+  {
+    double max_err = 0.0;
+
+    for (i = 0; i < size1; i++)
+      for (j = 0; j < size2; j++)
+        max_err = GSL_MAX (max_err, fabs (y[i * tda + j] - x[i * tda + j]));
+
+    gsl_test (max_err > tol, "gsl_fft2d_halfcomplex_inverse, %d-by-%d",
+              size1, size2);
+  }
+
+  free (data);
+  free (orig);
+  free (ref);
+  free (x);
+  free (y);
+  free (z);
+  gsl_fft2d_free (w);
+}
+
+void
+test_fft3d (size_t size1, size_t size2, size_t size3)
+{
+  const double tol = 1.0e-12;
+  const size_t n = size1 * size2 * size3;
+  const size_t m = size3 / 2 + 1;
+  gsl_fft3d_workspace *w = gsl_fft3d_alloc (size1, size2, size3);
+  double *data = malloc (2 * n * sizeof (double));
+  double *orig = malloc (2 * n * sizeof (double));
+  double *ref = malloc (2 * n * sizeof (double));
+  double *x = malloc (n * sizeof (double));
+  double *y = malloc (n * sizeof (double));
+  double *z = malloc (2 * size1 * size2 * m * sizeof (double));
+  size_t i;
+  int status;
+
+  /* complex transform */
+
+  for (i = 0; i < 2 * n; i++)
+    data[i] = urand () - 0.5;
+
+  memcpy (orig, data, 2 * n * sizeof (double));
+  memcpy (ref, data, 2 * n * sizeof (double));
+
+  test_nd_dft_axis (ref, 1, size1, size2 * size3);
+  test_nd_dft_axis (ref, size1, size2, size3);
+  test_nd_dft_axis (ref, size1 * size2, size3, 1);
+
+  status = gsl_fft3d_complex_forward (data, w);
+  gsl_test (status, "gsl_fft3d_complex_forward status, %d-by-%d-by-%d",
+            size1, size2, size3);
+  gsl_test (test_nd_error (data, n, ref, n, 1, n) > tol,
+            "gsl_fft3d_complex_forward, %d-by-%d-by-%d", size1, size2, size3);
+
+  status = gsl_fft3d_complex_inverse (data, w);
+  gsl_test (status, "gsl_fft3d_complex_inverse status, %d-by-%d-by-%d",
+            size1, size2, size3);
+  gsl_test (test_nd_error (data, n, orig, n, 1, n) > tol,
+            "gsl_fft3d_complex_inverse, %d-by-%d-by-%d", size1, size2, size3);
+
+  /* real transform */
+
+  for (i = 0; i < n; i++)
+    {
+      x[i] = urand () - 0.5;
+      ref[2 * i] = x[i];
+      ref[2 * i + 1] = 0.0;
+    }
+
+  test_nd_dft_axis (ref, 1, size1, size2 * size3);
+  test_nd_dft_axis (ref, size1, size2, size3);
+  test_nd_dft_axis (ref, size1 * size2, size3, 1);
+
+  status = gsl_fft3d_real_forward (x, z, w);
+  gsl_test (status, "gsl_fft3d_real_forward status, %d-by-%d-by-%d",
+            size1, size2, size3);
+  gsl_test (test_nd_error (z, m, ref, size3, size1 * size2, m) > tol,
+            "gsl_fft3d_real_forward, %d-by-%d-by-%d", size1, size2, size3);
+
+  status = gsl_fft3d_halfcomplex_inverse (z, y, w);
+  gsl_test (status, "gsl_fft3d_halfcomplex_inverse status, %d-by-%d-by-%d",
+            size1, size2, size3);
+
+  {
+    double max_err = 0.0;
+
+    for (i = 0; i < n; i++)
+      max_err = GSL_MAX (max_err, fabs (y[i] - x[i]));
+
+    gsl_test (max_err > tol, "gsl_fft3d_halfcomplex_inverse, %d-by-%d-by-%d",
+              size1, size2, size3);
+  }
+
+  free (data);
+  free (orig);
+  free (ref);
+  free (x);
+  free (y);
+  free (z);
+  gsl_fft3d_free (w);
+}
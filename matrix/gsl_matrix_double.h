@@ -63,6 +63,14 @@ typedef struct
 
 typedef const _gsl_matrix_const_view gsl_matrix_const_view;
 
+typedef struct
+{
+  gsl_matrix matrix;  /* read-only matrix, elements refer to the mapped file */
+  void * addr;        /* start of the file in memory */
+  size_t length;      /* length of the file in bytes */
+  int mapped;         /* 1 if mapped with mmap(), 0 if read into memory */
+} gsl_matrix_mmap;
+
 /* Allocation */
 
 gsl_matrix * 
@@ -213,6 +221,10 @@ int gsl_matrix_fread (FILE * stream, gsl_matrix * m) ;
 int gsl_matrix_fwrite (FILE * stream, const gsl_matrix * m) ;
 int gsl_matrix_fscanf (FILE * stream, gsl_matrix * m);
 int gsl_matrix_fprintf (FILE * stream, const gsl_matrix * m, const char * format);
+
+int gsl_matrix_mmap_write (const char * filename, const gsl_matrix * m);
+gsl_matrix_mmap * gsl_matrix_mmap_open (const char * filename);
+void gsl_matrix_mmap_close (gsl_matrix_mmap * w);
  
 int gsl_matrix_memcpy(gsl_matrix * dest, const gsl_matrix * src);
 int gsl_matrix_swap(gsl_matrix * m1, gsl_matrix * m2);
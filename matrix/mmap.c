@@ -0,0 +1,133 @@
+/* matrix/mmap.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_matrix.h>
+
+#include "mmapfile.c"
+
+/*
+gsl_matrix_mmap_write()
+  Write a matrix to a file in the memory mapped binary format
+
+Inputs: filename - output file
+        m        - matrix
+
+Return: success/error
+
+Notes:
+1) The rows of m are stored contiguously in the file, regardless of
+the tda of m
+*/
+
+int
+gsl_matrix_mmap_write (const char * filename, const gsl_matrix * m)
+{
+  mmapfile_header hdr;
+  mmapfile_array a[MMAPFILE_NARRAY];
+
+  memset(&hdr, 0, sizeof(hdr));
+  memset(a, 0, sizeof(a));
+
+  hdr.object = MMAPFILE_MATRIX;
+  hdr.type = MMAPFILE_DOUBLE;
+  hdr.atomic_size = sizeof(double);
+  hdr.index_size = sizeof(int);
+  hdr.size1 = m->size1;
+  hdr.size2 = m->size2;
+  hdr.nz = (uint64_t) m->size1 * m->size2;
+
+  a[0].ptr = m->data;
+  a[0].nrows = m->size1;
+  a[0].rowbytes = m->size2 * sizeof(double);
+  a[0].stride = m->tda * sizeof(double);
+
+  return mmapfile_write(filename, &hdr, a);
+}
+
+/*
+gsl_matrix_mmap_open()
+  Map a matrix file written by gsl_matrix_mmap_write() into memory
+
+Inputs: filename - input file
+
+Return: pointer to mapped matrix, or NULL on error
+
+Notes:
+1) The elements of the matrix are not copied: the matrix refers
+directly to the pages of the file, which are loaded on first access
+and shared between all processes mapping the same file. The matrix
+is read-only, and must not be modified.
+
+2) On systems without mmap(), the file is read into memory instead
+*/
+
+gsl_matrix_mmap *
+gsl_matrix_mmap_open (const char * filename)
+{
+  gsl_matrix_mmap *w;
+  mmapfile_header hdr;
+  char *addr;
+  size_t length;
+  int mapped;
+  int status;
+
+  w = calloc(1, sizeof(gsl_matrix_mmap));
+  if (!w)
+    {
+      GSL_ERROR_NULL("failed to allocate space for mapped matrix", GSL_ENOMEM);
+    }
+
+  status = mmapfile_open(filename, MMAPFILE_MATRIX, &hdr, &addr, &length, &mapped);
+  if (status)
+    {
+      free(w);
+      return NULL;
+    }
+
+  if (hdr.length[0] != hdr.size1 * hdr.size2 * sizeof(double))
+    {
+      mmapfile_close(addr, length, mapped);
+      free(w);
+      GSL_ERROR_NULL("file is truncated or corrupt", GSL_EINVAL);
+    }
+
+  w->matrix.size1 = (size_t) hdr.size1;
+  w->matrix.size2 = (size_t) hdr.size2;
+  w->matrix.tda = (size_t) hdr.size2;
+  w->matrix.data = (double *) (addr + hdr.offset[0]);
+  w->matrix.block = NULL;
+  w->matrix.owner = 0;
+
+  w->addr = addr;
+  w->length = length;
+  w->mapped = mapped;
+
+  return w;
+}
+
+void
+gsl_matrix_mmap_close (gsl_matrix_mmap * w)
+{
+  RETURN_IF_NULL (w);
+  mmapfile_close(w->addr, w->length, w->mapped);
+  free(w);
+}
@@ -0,0 +1,314 @@
+/* matrix/mmapfile.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Memory mapped binary file format, shared by gsl_matrix and
+ * gsl_spmatrix. This file is #included by the sources which use it.
+ *
+ * The file starts with a header of MMAPFILE_HEADER_SIZE bytes,
+ * followed by up to three arrays (the matrix elements, and the index
+ * arrays of sparse matrices), each starting at a multiple of
+ * MMAPFILE_ALIGN bytes. All values are stored in the native byte
+ * order of the machine which wrote the file, which is recorded in
+ * the header, so that the arrays can be used in place after mapping
+ * the file into memory.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define MMAPFILE_MAGIC        "GSLMMAP\n"
+#define MMAPFILE_VERSION      1
+#define MMAPFILE_ENDIAN       0x01020304
+#define MMAPFILE_ALIGN        64
+#define MMAPFILE_HEADER_SIZE  256
+#define MMAPFILE_NARRAY       3
+
+/* object types */
+#define MMAPFILE_MATRIX       1
+#define MMAPFILE_SPMATRIX     2
+
+/* element types */
+#define MMAPFILE_DOUBLE       1
+
+typedef struct
+{
+  char magic[8];                      /* MMAPFILE_MAGIC */
+  uint32_t version;                   /* MMAPFILE_VERSION */
+  uint32_t endian;                    /* MMAPFILE_ENDIAN, in the byte order of the file */
+  uint32_t object;                    /* MMAPFILE_MATRIX or MMAPFILE_SPMATRIX */
+  uint32_t type;                      /* element type */
+  uint32_t atomic_size;               /* size of an element in bytes */
+  uint32_t index_size;                /* size of an index (int) in bytes */
+  uint32_t sptype;                    /* sparse storage format */
+  uint32_t reserved;
+  uint64_t size1;                     /* number of rows */
+  uint64_t size2;                     /* number of columns */
+  uint64_t nz;                        /* number of stored elements */
+  uint64_t offset[MMAPFILE_NARRAY];   /* byte offset of each array */
+  uint64_t length[MMAPFILE_NARRAY];   /* byte length of each array */
+} mmapfile_header;
+
+/* array of nrows rows of rowbytes bytes, stride bytes apart in memory */
+typedef struct
+{
+  const void *ptr;
+  size_t nrows;
+  size_t rowbytes;
+  size_t stride;
+} mmapfile_array;
+
+static int mmapfile_write(const char *filename, mmapfile_header *hdr,
+                          const mmapfile_array *a);
+static int mmapfile_open(const char *filename, const uint32_t object,
+                         mmapfile_header *hdr, char **addr, size_t *length,
+                         int *mapped);
+static void mmapfile_close(void *addr, const size_t length, const int mapped);
+
+/*
+mmapfile_write()
+  Write a header and arrays to a file
+
+Inputs: filename - output file
+        hdr      - header; the offset and length fields are computed
+                   here, the other fields must be set by the caller
+        a        - MMAPFILE_NARRAY arrays; unused arrays have nrows = 0
+
+Return: success/error
+*/
+
+static int
+mmapfile_write(const char *filename, mmapfile_header *hdr,
+               const mmapfile_array *a)
+{
+  static const char zero[MMAPFILE_HEADER_SIZE] = { 0 };
+  char buf[MMAPFILE_HEADER_SIZE];
+  uint64_t pos = MMAPFILE_HEADER_SIZE;
+  FILE *f;
+  size_t k, r;
+
+  memcpy(hdr->magic, MMAPFILE_MAGIC, sizeof(hdr->magic));
+  hdr->version = MMAPFILE_VERSION;
+  hdr->endian = MMAPFILE_ENDIAN;
+  hdr->reserved = 0;
+
+  for (k = 0; k < MMAPFILE_NARRAY; ++k)
+    {
+      hdr->offset[k] = pos;
+      hdr->length[k] = (uint64_t) a[k].nrows * a[k].rowbytes;
+      pos += hdr->length[k];
+      pos = (pos + MMAPFILE_ALIGN - 1) / MMAPFILE_ALIGN * MMAPFILE_ALIGN;
+    }
+
+  f = fopen(filename, "wb");
+  if (!f)
+    {
+      GSL_ERROR("unable to open file for writing", GSL_EFAILED);
+    }
+
+  memset(buf, 0, sizeof(buf));
+  memcpy(buf, hdr, sizeof(mmapfile_header));
+  if (fwrite(buf, 1, sizeof(buf), f) != sizeof(buf))
+    {
+      fclose(f);
+      GSL_ERROR("fwrite failed", GSL_EFAILED);
+    }
+
+  pos = MMAPFILE_HEADER_SIZE;
+
+  for (k = 0; k < MMAPFILE_NARRAY; ++k)
+    {
+      /* pad to the start of the array */
+      if (hdr->offset[k] > pos)
+        {
+          size_t npad = (size_t) (hdr->offset[k] - pos);
+          if (fwrite(zero, 1, npad, f) != npad)
+            {
+              fclose(f);
+              GSL_ERROR("fwrite failed", GSL_EFAILED);
+            }
+        }
+
+      for (r = 0; r < a[k].nrows; ++r)
+        {
+          const char *row = (const char *) a[k].ptr + r * a[k].stride;
+          if (fwrite(row, 1, a[k].rowbytes, f) != a[k].rowbytes)
+            {
+              fclose(f);
+              GSL_ERROR("fwrite failed", GSL_EFAILED);
+            }
+        }
+
+      pos = hdr->offset[k] + hdr->length[k];
+    }
+
+  if (fclose(f))
+    {
+      GSL_ERROR("unable to close file", GSL_EFAILED);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+mmapfile_open()
+  Map a file into memory and validate its header
+
+Inputs: filename - input file
+        object   - expected object type
+        hdr      - (output) header
+        addr     - (output) start of file in memory
+        length   - (output) length of file in bytes
+        mapped   - (output) 1 if the file was mapped, 0 if it was read
+                   into allocated memory because mmap() is not available
+
+Return: success/error
+*/
+
+static int
+mmapfile_open(const char *filename, const uint32_t object,
+              mmapfile_header *hdr, char **addr, size_t *length,
+              int *mapped)
+{
+  const char *reason = NULL;
+  size_t k;
+
+#ifdef HAVE_SYS_MMAN_H
+  {
+    struct stat st;
+    void *ptr;
+    int fd = open(filename, O_RDONLY);
+
+    if (fd < 0)
+      {
+        GSL_ERROR("unable to open file", GSL_EFAILED);
+      }
+
+    if (fstat(fd, &st) != 0 || st.st_size < MMAPFILE_HEADER_SIZE)
+      {
+        close(fd);
+        GSL_ERROR("file is too short", GSL_EBADLEN);
+      }
+
+    *length = (size_t) st.st_size;
+
+    /* read-only shared mapping: processes mapping the same file share pages */
+    ptr = mmap(NULL, *length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (ptr == MAP_FAILED)
+      {
+        GSL_ERROR("mmap failed", GSL_EFAILED);
+      }
+
+    *addr = (char *) ptr;
+    *mapped = 1;
+  }
+#else
+  {
+    FILE *f = fopen(filename, "rb");
+    long len;
+
+    if (!f)
+      {
+        GSL_ERROR("unable to open file", GSL_EFAILED);
+      }
+
+    if (fseek(f, 0L, SEEK_END) != 0 || (len = ftell(f)) < MMAPFILE_HEADER_SIZE)
+      {
+        fclose(f);
+        GSL_ERROR("file is too short", GSL_EBADLEN);
+      }
+
+    *length = (size_t) len;
+    *addr = malloc(*length);
+    if (!*addr)
+      {
+        fclose(f);
+        GSL_ERROR("failed to allocate space for file", GSL_ENOMEM);
+      }
+
+    rewind(f);
+    if (fread(*addr, 1, *length, f) != *length)
+      {
+        free(*addr);
+        fclose(f);
+        GSL_ERROR("fread failed", GSL_EFAILED);
+      }
+
+    fclose(f);
+    *mapped = 0;
+  }
+#endif
+
+  memcpy(hdr, *addr, sizeof(mmapfile_header));
+
+  if (memcmp(hdr->magic, MMAPFILE_MAGIC, sizeof(hdr->magic)) != 0)
+    reason = "file is not in GSL mapped format";
+  else if (hdr->version != MMAPFILE_VERSION)
+    reason = "unsupported file format version";
+  else if (hdr->endian != MMAPFILE_ENDIAN)
+    reason = "file was written with a different byte order";
+  else if (hdr->object != object)
+    reason = "file contains a different object type";
+  else if (hdr->type != MMAPFILE_DOUBLE || hdr->atomic_size != sizeof(double))
+    reason = "file contains a different element type";
+  else if (hdr->index_size != sizeof(int))
+    reason = "file was written with a different index size";
+
+  for (k = 0; reason == NULL && k < MMAPFILE_NARRAY; ++k)
+    {
+      if (hdr->offset[k] % MMAPFILE_ALIGN != 0 ||
+          hdr->offset[k] > *length || hdr->length[k] > *length - hdr->offset[k])
+        reason = "file is truncated or corrupt";
+    }
+
+  if (reason != NULL)
+    {
+      mmapfile_close(*addr, *length, *mapped);
+      GSL_ERROR(reason, GSL_EINVAL);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static void
+mmapfile_close(void *addr, const size_t length, const int mapped)
+{
+#ifdef HAVE_SYS_MMAN_H
+  if (mapped)
+    {
+      munmap(addr, length);
+      return;
+    }
+#endif
+
+  (void) length;
+  (void) mapped;
+  free(addr);
+}
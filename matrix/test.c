@@ -130,6 +130,55 @@ int status = 0;
 void my_error_handler (const char *reason, const char *file,
                        int line, int err);
 
+/* write a matrix in the mapped format and check the mapped copy */
+static void
+test_mmap (const size_t M, const size_t N)
+{
+#ifdef NO_INLINE
+  const char filename[] = "test_static_mmap.dat";
+#else
+  const char filename[] = "test_mmap.dat";
+#endif
+  gsl_matrix *A = gsl_matrix_alloc (M + 3, N + 5);
+  gsl_matrix_view B = gsl_matrix_submatrix (A, 1, 2, M, N);
+  gsl_matrix_mmap *w;
+  size_t i, j;
+  int s = 0;
+
+  for (i = 0; i < A->size1; i++)
+    for (j = 0; j < A->size2; j++)
+      gsl_matrix_set (A, i, j, (double) (i * A->size2 + j) + 0.25);
+
+  s = gsl_matrix_mmap_write (filename, &B.matrix);
+  gsl_test (s, "gsl_matrix_mmap_write");
+
+  w = gsl_matrix_mmap_open (filename);
+  gsl_test (w == NULL, "gsl_matrix_mmap_open");
+
+  if (w == NULL)
+    {
+      unlink (filename);
+      gsl_matrix_free (A);
+      return;
+    }
+
+  gsl_test (w->matrix.size1 != M || w->matrix.size2 != N || w->matrix.tda != N,
+            "gsl_matrix_mmap_open dimensions");
+
+  gsl_test (((size_t) w->matrix.data) % 64 != 0, "gsl_matrix_mmap_open alignment");
+
+  for (i = 0; i < M; i++)
+    for (j = 0; j < N; j++)
+      if (gsl_matrix_get (&w->matrix, i, j) != gsl_matrix_get (&B.matrix, i, j))
+        s = 1;
+
+  gsl_test (s, "gsl_matrix_mmap_open elements");
+
+  gsl_matrix_mmap_close (w);
+  unlink (filename);
+  gsl_matrix_free (A);
+}
+
 int
 main (void)
 {
@@ -226,6 +275,8 @@ main (void)
   test_complex_float_binary_noncontiguous (M, N);
   test_complex_long_double_binary_noncontiguous (M, N);
 
+  test_mmap (M, N);
+
 #if GSL_RANGE_CHECK
   gsl_set_error_handler (&my_error_handler);
 
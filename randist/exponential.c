@@ -37,6 +37,24 @@ gsl_ran_exponential (const gsl_rng * r, const double mu)
   return -mu * log1p (-u);
 }
 
+/* The array version transforms a block of uniforms from
+   gsl_rng_uniform_array, and gives the same numbers as repeated calls
+   to gsl_ran_exponential */
+
+void
+gsl_ran_exponential_array (const gsl_rng * r, size_t n, double array[],
+                           const double mu)
+{
+  size_t i;
+
+  gsl_rng_uniform_array (r, array, n);
+
+  for (i = 0; i < n; i++)
+    {
+      array[i] = -mu * log1p (-array[i]);
+    }
+}
+
 double
 gsl_ran_exponential_pdf (const double x, const double mu)
 {
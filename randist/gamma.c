@@ -227,3 +227,75 @@ gsl_ran_gamma (const gsl_rng * r, const double a, const double b)
     return b * d * v;
   }
 }
+
+/* The array version runs the method of Marsaglia and Tsang on blocks
+   of candidates, with the gaussians from gsl_ran_gaussian_array and the
+   uniforms from gsl_rng_uniform_pos_array. The accepted candidates are
+   stored in order without branching, and the rejected ones are
+   replaced in the next pass. */
+
+#define GAMMA_BLOCK 256
+
+void
+gsl_ran_gamma_array (const gsl_rng * r, size_t n, double array[],
+                     const double a, const double b)
+{
+  double z[GAMMA_BLOCK], u[GAMMA_BLOCK];
+
+  /* assume a > 0 */
+
+  if (a < 1)
+    {
+      size_t i = 0;
+
+      gsl_ran_gamma_array (r, n, array, 1.0 + a, b);
+
+      while (i < n)
+        {
+          const size_t m = GSL_MIN (n - i, GAMMA_BLOCK);
+          size_t j;
+
+          gsl_rng_uniform_pos_array (r, u, m);
+
+          for (j = 0; j < m; j++)
+            array[i + j] *= pow (u[j], 1.0 / a);
+
+          i += m;
+        }
+
+      return;
+    }
+
+  {
+    const double d = a - 1.0 / 3.0;
+    const double c = (1.0 / 3.0) / sqrt (d);
+    size_t i = 0;
+
+    while (i < n)
+      {
+        const size_t m = GSL_MIN (n - i, GAMMA_BLOCK);
+        size_t j;
+
+        gsl_ran_gaussian_array (r, m, z, 1.0);
+        gsl_rng_uniform_pos_array (r, u, m);
+
+        /* at most m candidates are accepted, so i < n at each store */
+        for (j = 0; j < m; j++)
+          {
+            const double x = z[j];
+            const double w = 1.0 + c * x;
+            const double v = w * w * w;
+            int accept = 0;
+
+            if (w > 0)
+              {
+                accept = (u[j] < 1 - 0.0331 * x * x * x * x)
+                  || (log (u[j]) < 0.5 * x * x + d * (1 - v + log (v)));
+              }
+
+            array[i] = b * d * v;
+            i += accept;
+          }
+      }
+  }
+}
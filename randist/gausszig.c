@@ -163,12 +163,41 @@ static const double wtab[128] = {
 };
 
 
+/* The test for a sample x = j wtab[i] rejected by the rectangle of
+   step i, in the wedge for i < 127 or in the tail for i = 127, where x
+   is replaced by a sample from the exponential wedge */
+
+static inline int
+ziggurat_wedge (const gsl_rng * r, unsigned long int i, double *x)
+{
+  double y;
+
+  if (i < 127)
+    {
+      double y0, y1, U1;
+      y0 = ytab[i];
+      y1 = ytab[i + 1];
+      U1 = gsl_rng_uniform (r);
+      y = y1 + (y0 - y1) * U1;
+    }
+  else
+    {
+      double U1, U2;
+      U1 = 1.0 - gsl_rng_uniform (r);
+      U2 = gsl_rng_uniform (r);
+      *x = PARAM_R - log (U1) / PARAM_R;
+      y = exp (-PARAM_R * (*x - 0.5 * PARAM_R)) * U2;
+    }
+
+  return (y < exp (-0.5 * (*x) * (*x)));
+}
+
 double
 gsl_ran_gaussian_ziggurat (const gsl_rng * r, const double sigma)
 {
   unsigned long int i, j;
   int sign;
-  double x, y;
+  double x;
 
   const unsigned long int range = r->type->max - r->type->min;
   const unsigned long int offset = r->type->min;
@@ -202,26 +231,89 @@ gsl_ran_gaussian_ziggurat (const gsl_rng * r, const double sigma)
       if (j < ktab[i])
         break;
 
-      if (i < 127)
+      if (ziggurat_wedge (r, i, &x))
+        break;
+    }
+
+  return sign * sigma * x;
+}
+
+/* The array version takes one random integer per sample in blocks from
+ * gsl_rng_get_array, and applies the rectangle test, which accepts
+ * about 99% of the samples, to the whole block without branching. The
+ * remaining samples are deferred to a second pass over the block which
+ * applies the wedge and tail tests, and starts a rejected sample again
+ * with gsl_ran_gaussian_ziggurat. The samples have the same
+ * distribution as those of gsl_ran_gaussian_ziggurat, but are not the
+ * same numbers. Generators with fewer than 32 random bits use the
+ * scalar function.
+ */
+
+#define ZIGGURAT_BLOCK 256
+
+static const double sign_tab[2] = { -1.0, 1.0 };
+
+void
+gsl_ran_gaussian_array (const gsl_rng * r, size_t n, double array[],
+                        const double sigma)
+{
+  unsigned long int k[ZIGGURAT_BLOCK];
+  size_t defer[ZIGGURAT_BLOCK];
+
+  const unsigned long int range = r->type->max - r->type->min;
+  const unsigned long int offset = r->type->min;
+
+  if (range < 0xFFFFFFFF)
+    {
+      size_t i;
+
+      for (i = 0; i < n; i++)
+        array[i] = gsl_ran_gaussian_ziggurat (r, sigma);
+
+      return;
+    }
+
+  while (n > 0)
+    {
+      const size_t m = (n < ZIGGURAT_BLOCK) ? n : ZIGGURAT_BLOCK;
+      size_t p, nd = 0;
+
+      gsl_rng_get_array (r, k, m);
+
+      for (p = 0; p < m; p++)
         {
-          double y0, y1, U1;
-          y0 = ytab[i];
-          y1 = ytab[i + 1];
-          U1 = gsl_rng_uniform (r);
-          y = y1 + (y0 - y1) * U1;
+          const unsigned long int kp = k[p] - offset;
+          const unsigned long int i = kp & 0x7F;
+          const unsigned long int j = (kp >> 8) & 0xFFFFFF;
+          const double s = sign_tab[(kp >> 7) & 1] * sigma;
+
+          /* j < 2^24, and the signed conversion is faster */
+          array[p] = s * ((double) (long) j * wtab[i]);
+          defer[nd] = p;
+          nd += (j >= ktab[i]);
         }
-      else
+
+      for (p = 0; p < nd; p++)
         {
-          double U1, U2;
-          U1 = 1.0 - gsl_rng_uniform (r);
-          U2 = gsl_rng_uniform (r);
-          x = PARAM_R - log (U1) / PARAM_R;
-          y = exp (-PARAM_R * (x - 0.5 * PARAM_R)) * U2;
+          const size_t q = defer[p];
+          const unsigned long int kq = k[q] - offset;
+          const unsigned long int i = kq & 0x7F;
+          const unsigned long int j = (kq >> 8) & 0xFFFFFF;
+          double x = j * wtab[i];
+
+          if (ziggurat_wedge (r, i, &x))
+            array[q] = sign_tab[(kq >> 7) & 1] * sigma * x;
+          else
+            array[q] = gsl_ran_gaussian_ziggurat (r, sigma);
         }
 
-      if (y < exp (-0.5 * x * x))
-        break;
+      array += m;
+      n -= m;
     }
+}
 
-  return sign * sigma * x;
+void
+gsl_ran_ugaussian_array (const gsl_rng * r, size_t n, double array[])
+{
+  gsl_ran_gaussian_array (r, n, array, 1.0);
 }
@@ -47,6 +47,8 @@ unsigned int gsl_ran_binomial_tpe (const gsl_rng * r, double p, unsigned int n);
 double gsl_ran_binomial_pdf (const unsigned int k, const double p, const unsigned int n);
 
 double gsl_ran_exponential (const gsl_rng * r, const double mu);
+void gsl_ran_exponential_array (const gsl_rng * r, size_t n, double array[],
+                                const double mu);
 double gsl_ran_exponential_pdf (const double x, const double mu);
 
 double gsl_ran_exppow (const gsl_rng * r, const double a, const double b);
@@ -72,6 +74,8 @@ double gsl_ran_flat (const gsl_rng * r, const double a, const double b);
 double gsl_ran_flat_pdf (double x, const double a, const double b);
 
 double gsl_ran_gamma (const gsl_rng * r, const double a, const double b);
+void gsl_ran_gamma_array (const gsl_rng * r, size_t n, double array[],
+                          const double a, const double b);
 double gsl_ran_gamma_int (const gsl_rng * r, const unsigned int a);
 double gsl_ran_gamma_pdf (const double x, const double a, const double b);
 double gsl_ran_gamma_mt (const gsl_rng * r, const double a, const double b);
@@ -80,10 +84,13 @@ double gsl_ran_gamma_knuth (const gsl_rng * r, const double a, const double b);
 double gsl_ran_gaussian (const gsl_rng * r, const double sigma);
 double gsl_ran_gaussian_ratio_method (const gsl_rng * r, const double sigma);
 double gsl_ran_gaussian_ziggurat (const gsl_rng * r, const double sigma);
+void gsl_ran_gaussian_array (const gsl_rng * r, size_t n, double array[],
+                             const double sigma);
 double gsl_ran_gaussian_pdf (const double x, const double sigma);
 
 double gsl_ran_ugaussian (const gsl_rng * r);
 double gsl_ran_ugaussian_ratio_method (const gsl_rng * r);
+void gsl_ran_ugaussian_array (const gsl_rng * r, size_t n, double array[]);
 double gsl_ran_ugaussian_pdf (const double x);
 
 double gsl_ran_gaussian_tail (const gsl_rng * r, const double a, const double sigma);
@@ -172,6 +179,8 @@ double gsl_ran_pareto_pdf (const double x, const double a, const double b);
 unsigned int gsl_ran_poisson (const gsl_rng * r, double mu);
 void gsl_ran_poisson_array (const gsl_rng * r, size_t n, unsigned int array[],
                             double mu);
+void gsl_ran_poisson_table_array (const gsl_rng * r, size_t n,
+                                  unsigned int array[], double mu);
 double gsl_ran_poisson_pdf (const unsigned int k, const double mu);
 
 double gsl_ran_rayleigh (const gsl_rng * r, const double sigma);
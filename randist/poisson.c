@@ -19,6 +19,7 @@
 
 #include <config.h>
 #include <math.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_sf_gamma.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_randist.h>
@@ -82,6 +83,82 @@ gsl_ran_poisson_array (const gsl_rng * r, size_t n, unsigned int array[],
   return;
 }
 
+/* For mu <= 10 the table version inverts the distribution function
+   with one uniform per sample from gsl_rng_uniform_array, using a table
+   of the distribution function and a guide table indexed by the leading
+   bits of the uniform. The table ends where the terms no longer change
+   the sum, with the last entry set to one. The samples are not the same
+   numbers as those of gsl_ran_poisson. Larger values of mu use
+   gsl_ran_poisson. */
+
+#define POISSON_TABLE 64
+#define POISSON_GUIDE 32
+#define POISSON_BLOCK 256
+
+void
+gsl_ran_poisson_table_array (const gsl_rng * r, size_t n,
+                             unsigned int array[], double mu)
+{
+  double cdf[POISSON_TABLE], u[POISSON_BLOCK];
+  unsigned int guide[POISSON_GUIDE];
+  double p, sum;
+  unsigned int k, g;
+  size_t i;
+
+  if (mu > 10)
+    {
+      for (i = 0; i < n; i++)
+        {
+          array[i] = gsl_ran_poisson (r, mu);
+        }
+
+      return;
+    }
+
+  p = exp (-mu);
+  sum = p;
+  cdf[0] = sum;
+
+  for (k = 1; k < POISSON_TABLE - 1; k++)
+    {
+      p *= mu / k;
+
+      if (k > mu && sum + p == sum)
+        break;
+
+      sum += p;
+      cdf[k] = sum;
+    }
+
+  cdf[k] = 1.0;
+
+  for (g = 0, k = 0; g < POISSON_GUIDE; g++)
+    {
+      while (cdf[k] <= (double) g / POISSON_GUIDE)
+        k++;
+
+      guide[g] = k;
+    }
+
+  for (i = 0; i < n; i += POISSON_BLOCK)
+    {
+      const size_t m = GSL_MIN (n - i, POISSON_BLOCK);
+      size_t j;
+
+      gsl_rng_uniform_array (r, u, m);
+
+      for (j = 0; j < m; j++)
+        {
+          k = guide[(unsigned int) (u[j] * POISSON_GUIDE)];
+
+          while (u[j] >= cdf[k])
+            k++;
+
+          array[i + j] = k;
+        }
+    }
+}
+
 double
 gsl_ran_poisson_pdf (const unsigned int k, const double mu)
 {
@@ -36,6 +36,9 @@
 
 #define N 100000
 
+/* Buffer length for the tests of the array functions */
+#define ARRAY_BUFFER 1000
+
 /* Convient test dimension for multivariant distributions */
 #define MULTI_DIM 10
 
@@ -48,6 +51,7 @@ void testDiscretePDF (double (*f) (void), double (*pdf) (unsigned int),
 
 void test_shuffle (void);
 void test_choose (void);
+void test_poisson_sequence (void);
 double test_beta (void);
 double test_beta_pdf (double x);
 double test_bernoulli (void);
@@ -96,6 +100,8 @@ double test_erlang (void);
 double test_erlang_pdf (double x);
 double test_exponential (void);
 double test_exponential_pdf (double x);
+double test_exponential_array (void);
+double test_exponential_array_pdf (double x);
 double test_exppow0 (void);
 double test_exppow0_pdf (double x);
 double test_exppow1 (void);
@@ -116,6 +122,10 @@ double test_flat (void);
 double test_flat_pdf (double x);
 double test_gamma (void);
 double test_gamma_pdf (double x);
+double test_gamma_array (void);
+double test_gamma_array_pdf (double x);
+double test_gamma_array_small (void);
+double test_gamma_array_small_pdf (double x);
 double test_gamma1 (void);
 double test_gamma1_pdf (double x);
 double test_gamma_int (void);
@@ -144,6 +154,8 @@ double test_gaussian_ratio_method (void);
 double test_gaussian_ratio_method_pdf (double x);
 double test_gaussian_ziggurat (void);
 double test_gaussian_ziggurat_pdf (double x);
+double test_gaussian_array (void);
+double test_gaussian_array_pdf (double x);
 double test_gaussian_tail (void);
 double test_gaussian_tail_pdf (double x);
 double test_gaussian_tail1 (void);
@@ -152,6 +164,8 @@ double test_gaussian_tail2 (void);
 double test_gaussian_tail2_pdf (double x);
 double test_ugaussian (void);
 double test_ugaussian_pdf (double x);
+double test_ugaussian_array (void);
+double test_ugaussian_array_pdf (double x);
 double test_ugaussian_ratio_method (void);
 double test_ugaussian_ratio_method_pdf (double x);
 double test_ugaussian_tail (void);
@@ -231,6 +245,12 @@ double test_pareto (void);
 double test_pareto_pdf (double x);
 double test_poisson (void);
 double test_poisson_pdf (unsigned int x);
+double test_poisson_array (void);
+double test_poisson_array_pdf (unsigned int n);
+double test_poisson_table_array (void);
+double test_poisson_table_array_pdf (unsigned int n);
+double test_poisson_table_array_small (void);
+double test_poisson_table_array_small_pdf (unsigned int n);
 double test_poisson_large (void);
 double test_poisson_large_pdf (unsigned int x);
 double test_dir2d (void);
@@ -277,6 +297,7 @@ main (void)
 
   test_shuffle ();
   test_choose ();
+  test_poisson_sequence ();
 
   testMoments (FUNC (ugaussian), 0.0, 100.0, 0.5);
   testMoments (FUNC (ugaussian), -1.0, 1.0, 0.6826895);
@@ -307,6 +328,7 @@ main (void)
   testPDF (FUNC2 (dirichlet_small));
   testPDF (FUNC2 (erlang));
   testPDF (FUNC2 (exponential));
+  testPDF (FUNC2 (exponential_array));
 
   testPDF (FUNC2 (exppow0));
   testPDF (FUNC2 (exppow1));
@@ -325,6 +347,8 @@ main (void)
   testPDF (FUNC2 (gamma_vlarge));
   testPDF (FUNC2 (gamma_knuth_vlarge));
   testPDF (FUNC2 (gamma_small));
+  testPDF (FUNC2 (gamma_array));
+  testPDF (FUNC2 (gamma_array_small));
   testPDF (FUNC2 (gamma_mt));
   testPDF (FUNC2 (gamma_mt1));
   testPDF (FUNC2 (gamma_mt_int));
@@ -333,7 +357,9 @@ main (void)
   testPDF (FUNC2 (gaussian));
   testPDF (FUNC2 (gaussian_ratio_method));
   testPDF (FUNC2 (gaussian_ziggurat));
+  testPDF (FUNC2 (gaussian_array));
   testPDF (FUNC2 (ugaussian));
+  testPDF (FUNC2 (ugaussian_array));
   testPDF (FUNC2 (ugaussian_ratio_method));
   testPDF (FUNC2 (gaussian_tail));
   testPDF (FUNC2 (gaussian_tail1));
@@ -387,6 +413,9 @@ main (void)
   testDiscretePDF (FUNC2 (discrete2));
   testDiscretePDF (FUNC2 (discrete3));
   testDiscretePDF (FUNC2 (poisson));
+  testDiscretePDF (FUNC2 (poisson_array));
+  testDiscretePDF (FUNC2 (poisson_table_array));
+  testDiscretePDF (FUNC2 (poisson_table_array_small));
   testDiscretePDF (FUNC2 (poisson_large));
   testDiscretePDF (FUNC2 (bernoulli));
   testDiscretePDF (FUNC2 (binomial));
@@ -467,6 +496,45 @@ test_shuffle (void)
 
 }
 
+/* gsl_ran_poisson_array returns the same numbers as gsl_ran_poisson,
+   and gsl_ran_poisson_table_array a fixed sequence for a given seed */
+
+void
+test_poisson_sequence (void)
+{
+  const double mu[3] = { 0.3, 5.0, 30.0 };
+  const unsigned int expected[10] = { 10, 1, 1, 5, 1, 2, 5, 3, 2, 3 };
+  unsigned int x[300];
+  gsl_rng *r = gsl_rng_alloc (gsl_rng_mt19937);
+  size_t i, j;
+  int status;
+
+  for (j = 0; j < 3; j++)
+    {
+      gsl_rng_set (r, 0);
+      gsl_ran_poisson_array (r, 300, x, mu[j]);
+      gsl_rng_set (r, 0);
+
+      status = 0;
+      for (i = 0; i < 300; i++)
+        status |= (x[i] != gsl_ran_poisson (r, mu[j]));
+
+      gsl_test (status, "gsl_ran_poisson_array, mu = %g, same as gsl_ran_poisson",
+                mu[j]);
+    }
+
+  gsl_rng_set (r, 0);
+  gsl_ran_poisson_table_array (r, 300, x, 2.5);
+
+  status = 0;
+  for (i = 0; i < 10; i++)
+    status |= (x[i] != expected[i]);
+
+  gsl_test (status, "gsl_ran_poisson_table_array, mu = 2.5, sequence");
+
+  gsl_rng_free (r);
+}
+
 void
 test_choose (void)
 {
@@ -1242,6 +1310,27 @@ test_exponential_pdf (double x)
   return gsl_ran_exponential_pdf (x, 2.0);
 }
 
+double
+test_exponential_array (void)
+{
+  static double x[ARRAY_BUFFER];
+  static size_t i = ARRAY_BUFFER;
+
+  if (i == ARRAY_BUFFER)
+    {
+      gsl_ran_exponential_array (r_global, ARRAY_BUFFER, x, 2.0);
+      i = 0;
+    }
+
+  return x[i++];
+}
+
+double
+test_exponential_array_pdf (double x)
+{
+  return gsl_ran_exponential_pdf (x, 2.0);
+}
+
 double
 test_exppow0 (void)
 {
@@ -1415,6 +1504,48 @@ test_gamma_small_pdf (double x)
   return gsl_ran_gamma_pdf (x, 0.92, 2.17);
 }
 
+double
+test_gamma_array (void)
+{
+  static double x[ARRAY_BUFFER];
+  static size_t i = ARRAY_BUFFER;
+
+  if (i == ARRAY_BUFFER)
+    {
+      gsl_ran_gamma_array (r_global, ARRAY_BUFFER, x, 2.5, 2.17);
+      i = 0;
+    }
+
+  return x[i++];
+}
+
+double
+test_gamma_array_pdf (double x)
+{
+  return gsl_ran_gamma_pdf (x, 2.5, 2.17);
+}
+
+double
+test_gamma_array_small (void)
+{
+  static double x[ARRAY_BUFFER];
+  static size_t i = ARRAY_BUFFER;
+
+  if (i == ARRAY_BUFFER)
+    {
+      gsl_ran_gamma_array (r_global, ARRAY_BUFFER, x, 0.92, 2.17);
+      i = 0;
+    }
+
+  return x[i++];
+}
+
+double
+test_gamma_array_small_pdf (double x)
+{
+  return gsl_ran_gamma_pdf (x, 0.92, 2.17);
+}
+
 double
 test_gamma_vlarge (void)
 {
@@ -1553,6 +1684,27 @@ test_gaussian_ziggurat_pdf (double x)
   return gsl_ran_gaussian_pdf (x, 3.12);
 }
 
+double
+test_gaussian_array (void)
+{
+  static double x[ARRAY_BUFFER];
+  static size_t i = ARRAY_BUFFER;
+
+  if (i == ARRAY_BUFFER)
+    {
+      gsl_ran_gaussian_array (r_global, ARRAY_BUFFER, x, 3.12);
+      i = 0;
+    }
+
+  return x[i++];
+}
+
+double
+test_gaussian_array_pdf (double x)
+{
+  return gsl_ran_gaussian_pdf (x, 3.12);
+}
+
 double
 test_gaussian_tail (void)
 {
@@ -1602,6 +1754,27 @@ test_ugaussian_pdf (double x)
   return gsl_ran_ugaussian_pdf (x);
 }
 
+double
+test_ugaussian_array (void)
+{
+  static double x[ARRAY_BUFFER];
+  static size_t i = ARRAY_BUFFER;
+
+  if (i == ARRAY_BUFFER)
+    {
+      gsl_ran_ugaussian_array (r_global, ARRAY_BUFFER, x);
+      i = 0;
+    }
+
+  return x[i++];
+}
+
+double
+test_ugaussian_array_pdf (double x)
+{
+  return gsl_ran_ugaussian_pdf (x);
+}
+
 double
 test_ugaussian_ratio_method (void)
 {
@@ -2424,6 +2597,69 @@ test_poisson_pdf (unsigned int n)
   return gsl_ran_poisson_pdf (n, 5.0);
 }
 
+double
+test_poisson_array (void)
+{
+  static unsigned int x[ARRAY_BUFFER];
+  static size_t i = ARRAY_BUFFER;
+
+  if (i == ARRAY_BUFFER)
+    {
+      gsl_ran_poisson_array (r_global, ARRAY_BUFFER, x, 5.0);
+      i = 0;
+    }
+
+  return x[i++];
+}
+
+double
+test_poisson_array_pdf (unsigned int n)
+{
+  return gsl_ran_poisson_pdf (n, 5.0);
+}
+
+double
+test_poisson_table_array (void)
+{
+  static unsigned int x[ARRAY_BUFFER];
+  static size_t i = ARRAY_BUFFER;
+
+  if (i == ARRAY_BUFFER)
+    {
+      gsl_ran_poisson_table_array (r_global, ARRAY_BUFFER, x, 5.0);
+      i = 0;
+    }
+
+  return x[i++];
+}
+
+double
+test_poisson_table_array_pdf (unsigned int n)
+{
+  return gsl_ran_poisson_pdf (n, 5.0);
+}
+
+double
+test_poisson_table_array_small (void)
+{
+  static unsigned int x[ARRAY_BUFFER];
+  static size_t i = ARRAY_BUFFER;
+
+  if (i == ARRAY_BUFFER)
+    {
+      gsl_ran_poisson_table_array (r_global, ARRAY_BUFFER, x, 0.3);
+      i = 0;
+    }
+
+  return x[i++];
+}
+
+double
+test_poisson_table_array_small_pdf (unsigned int n)
+{
+  return gsl_ran_poisson_pdf (n, 0.3);
+}
+
 double
 test_poisson_large (void)
 {
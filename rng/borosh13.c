@@ -86,7 +86,10 @@ static const gsl_rng_type ran_type = {
   sizeof (ran_state_t),
   &ran_set,
   &ran_get,
-  &ran_get_double
+  &ran_get_double,
+  NULL,
+  NULL,
+  NULL
 };
 
 const gsl_rng_type *gsl_rng_borosh13 = &ran_type;
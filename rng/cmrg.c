@@ -20,6 +20,7 @@
 #include <config.h>
 #include <stdlib.h>
 #include <gsl/gsl_rng.h>
+#include "matmod.c"
 
 /* This is a combined multiple recursive generator. The sequence is,
 
@@ -63,6 +64,10 @@
 
    The period of this generator is about 2^205.
 
+   The jump function advances the state by 2^127 steps, multiplying
+   the state vector of each component by its transition matrix raised
+   to the power 2^127 by repeated squaring.
+
    From: P. L'Ecuyer, "Combined Multiple Recursive Random Number
    Generators," Operations Research, 44, 5 (1996), 816--822.
 
@@ -74,6 +79,7 @@
 static inline unsigned long int cmrg_get (void *vstate);
 static double cmrg_get_double (void *vstate);
 static void cmrg_set (void *state, unsigned long int s);
+static void cmrg_jump (void *state);
 
 static const long int m1 = 2147483647, m2 = 2145483479;
 
@@ -185,6 +191,43 @@ cmrg_set (void *vstate, unsigned long int s)
   cmrg_get (state);
 }
 
+static void
+cmrg_jump (void *vstate)
+{
+  /* transition matrices for (x1, x2, x3) and (y1, y2, y3), with the
+     negative coefficients taken modulo m1 and m2 */
+  static const unsigned long int A[9] = {
+    0, 63308, 2147300321UL,
+    1, 0, 0,
+    0, 1, 0
+  };
+  static const unsigned long int B[9] = {
+    86098, 0, 2144943871UL,
+    1, 0, 0,
+    0, 1, 0
+  };
+
+  cmrg_state_t *state = (cmrg_state_t *) vstate;
+  unsigned long int x[3], y[3];
+
+  x[0] = state->x1;
+  x[1] = state->x2;
+  x[2] = state->x3;
+  y[0] = state->y1;
+  y[1] = state->y2;
+  y[2] = state->y3;
+
+  matmod_jump (x, A, 3, 127, 2147483647UL, 46341UL);
+  matmod_jump (y, B, 3, 127, 2145483479UL, 46320UL);
+
+  state->x1 = x[0];
+  state->x2 = x[1];
+  state->x3 = x[2];
+  state->y1 = y[0];
+  state->y2 = y[1];
+  state->y3 = y[2];
+}
+
 static const gsl_rng_type cmrg_type =
 {"cmrg",                        /* name */
  2147483646,                    /* RAND_MAX */
@@ -192,6 +235,9 @@ static const gsl_rng_type cmrg_type =
  sizeof (cmrg_state_t),
  &cmrg_set,
  &cmrg_get,
- &cmrg_get_double};
+ &cmrg_get_double,
+ NULL,
+ NULL,
+ &cmrg_jump};
 
 const gsl_rng_type *gsl_rng_cmrg = &cmrg_type;
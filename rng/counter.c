@@ -0,0 +1,351 @@
+/* rng/counter.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_rng.h>
+
+/* Counter-based generators Philox4x32-10 and Threefry4x32-20 of
+   Salmon, Moraes, Dror and Shaw, "Parallel random numbers: as easy as
+   1, 2, 3", Proceedings of SC11 (2011).
+
+   Each generator is a keyed bijection of 128-bit blocks, and the
+   output is the sequence of 32-bit words of the images of the
+   counters 0, 1, 2, ...  The 128-bit stream key selects one of 2^128
+   independent streams, and the 64-bit counter gives direct access to
+   any block of a stream. Philox4x32 takes a 64-bit key, so the other
+   half of the stream key is used as the upper half of its 128-bit
+   counter block. Threefry4x32 takes the whole stream key, and the
+   upper half of its counter block is zero.
+
+   The results agree with the known answer tests of the Random123
+   library. */
+
+#define MASK 0xffffffffUL
+
+typedef struct
+  {
+    unsigned long int key[4];   /* stream key, 32-bit words */
+    unsigned long int ctr[2];   /* counter of the next block */
+    unsigned long int x[4];     /* current block */
+    unsigned int i;             /* next word of the current block */
+  }
+counter_state_t;
+
+/* Philox4x32: 10 rounds of two 32x32 -> 64 bit multiplications, with
+   a Weyl sequence key schedule */
+
+#define PHILOX_M0 0xD2511F53UL
+#define PHILOX_M1 0xCD9E8D57UL
+#define PHILOX_W0 0x9E3779B9UL
+#define PHILOX_W1 0xBB67AE85UL
+
+static inline void
+mulhilo32 (unsigned long int a, unsigned long int b,
+           unsigned long int *hi, unsigned long int *lo)
+{
+#if ULONG_MAX > 0xffffffffUL
+  const unsigned long int p = a * b;
+  *hi = p >> 32;
+  *lo = p & MASK;
+#else
+  const unsigned long int a0 = a & 0xffffUL, a1 = a >> 16;
+  const unsigned long int b0 = b & 0xffffUL, b1 = b >> 16;
+  const unsigned long int p00 = a0 * b0, p01 = a0 * b1;
+  const unsigned long int p10 = a1 * b0, p11 = a1 * b1;
+  const unsigned long int mid = (p00 >> 16) + (p01 & 0xffffUL) + (p10 & 0xffffUL);
+
+  *lo = ((mid & 0xffffUL) << 16) | (p00 & 0xffffUL);
+  *hi = p11 + (p01 >> 16) + (p10 >> 16) + (mid >> 16);
+#endif
+}
+
+static inline void
+philox_block (const unsigned long int key[4],
+              const unsigned long int ctr[2], unsigned long int x[4])
+{
+  unsigned long int x0 = ctr[0], x1 = ctr[1], x2 = key[2], x3 = key[3];
+  unsigned long int k0 = key[0], k1 = key[1];
+  int r;
+
+  for (r = 0; r < 10; r++)
+    {
+      unsigned long int hi0, lo0, hi1, lo1;
+
+      mulhilo32 (PHILOX_M0, x0, &hi0, &lo0);
+      mulhilo32 (PHILOX_M1, x2, &hi1, &lo1);
+
+      x0 = hi1 ^ x1 ^ k0;
+      x1 = lo1;
+      x2 = hi0 ^ x3 ^ k1;
+      x3 = lo0;
+
+      k0 = (k0 + PHILOX_W0) & MASK;
+      k1 = (k1 + PHILOX_W1) & MASK;
+    }
+
+  x[0] = x0;
+  x[1] = x1;
+  x[2] = x2;
+  x[3] = x3;
+}
+
+/* Threefry4x32: 20 rounds of additions, rotations and exclusive-or,
+   with the key injected every 4 rounds */
+
+#define ROTL32(x,n) ((((x) << (n)) & MASK) | ((x) >> (32 - (n))))
+
+#define THREEFRY_MIX(a,b,c,d,r0,r1)                                    \
+  do {                                                                 \
+    a = (a + b) & MASK; b = ROTL32 (b, r0); b ^= a;                    \
+    c = (c + d) & MASK; d = ROTL32 (d, r1); d ^= c;                    \
+  } while (0)
+
+#define THREEFRY_INJECT(s)                                             \
+  do {                                                                 \
+    x0 = (x0 + ks[(s) % 5]) & MASK;                                    \
+    x1 = (x1 + ks[((s) + 1) % 5]) & MASK;                              \
+    x2 = (x2 + ks[((s) + 2) % 5]) & MASK;                              \
+    x3 = (x3 + ks[((s) + 3) % 5] + (s)) & MASK;                        \
+  } while (0)
+
+static inline void
+threefry_block (const unsigned long int key[4],
+                const unsigned long int ctr[2], unsigned long int x[4])
+{
+  unsigned long int ks[5];
+  unsigned long int x0, x1, x2, x3;
+  int s;
+
+  ks[0] = key[0];
+  ks[1] = key[1];
+  ks[2] = key[2];
+  ks[3] = key[3];
+  ks[4] = 0x1BD11BDAUL ^ key[0] ^ key[1] ^ key[2] ^ key[3];
+
+  x0 = ctr[0];
+  x1 = ctr[1];
+  x2 = 0;
+  x3 = 0;
+
+  THREEFRY_INJECT (0);
+
+  for (s = 1; s < 5; s += 2)
+    {
+      THREEFRY_MIX (x0, x1, x2, x3, 10, 26);
+      THREEFRY_MIX (x0, x3, x2, x1, 11, 21);
+      THREEFRY_MIX (x0, x1, x2, x3, 13, 27);
+      THREEFRY_MIX (x0, x3, x2, x1, 23, 5);
+      THREEFRY_INJECT (s);
+
+      THREEFRY_MIX (x0, x1, x2, x3, 6, 20);
+      THREEFRY_MIX (x0, x3, x2, x1, 17, 11);
+      THREEFRY_MIX (x0, x1, x2, x3, 25, 10);
+      THREEFRY_MIX (x0, x3, x2, x1, 18, 20);
+      THREEFRY_INJECT (s + 1);
+    }
+
+  /* rounds 16-19 and the last injection */
+  THREEFRY_MIX (x0, x1, x2, x3, 10, 26);
+  THREEFRY_MIX (x0, x3, x2, x1, 11, 21);
+  THREEFRY_MIX (x0, x1, x2, x3, 13, 27);
+  THREEFRY_MIX (x0, x3, x2, x1, 23, 5);
+  THREEFRY_INJECT (5);
+
+  x[0] = x0;
+  x[1] = x1;
+  x[2] = x2;
+  x[3] = x3;
+}
+
+static inline void
+counter_increment (counter_state_t * state)
+{
+  state->ctr[0] = (state->ctr[0] + 1) & MASK;
+
+  if (state->ctr[0] == 0)
+    state->ctr[1] = (state->ctr[1] + 1) & MASK;
+}
+
+static void
+counter_set (void *vstate, unsigned long int s)
+{
+  counter_state_t *state = (counter_state_t *) vstate;
+
+  state->key[0] = s & MASK;
+  state->key[1] = (s >> 16 >> 16) & MASK;
+  state->key[2] = 0;
+  state->key[3] = 0;
+  state->ctr[0] = 0;
+  state->ctr[1] = 0;
+  state->i = 4;
+}
+
+/* The generators differ only in the block function, so the get
+   functions are generated from a template for each of them */
+
+#define COUNTER_FUNCTIONS(name)                                         \
+                                                                        \
+static inline unsigned long int                                         \
+name ## _get (void *vstate)                                             \
+{                                                                       \
+  counter_state_t *state = (counter_state_t *) vstate;                  \
+                                                                        \
+  if (state->i == 4)                                                    \
+    {                                                                   \
+      name ## _block (state->key, state->ctr, state->x);                \
+      counter_increment (state);                                        \
+      state->i = 0;                                                     \
+    }                                                                   \
+                                                                        \
+  return state->x[state->i++];                                          \
+}                                                                       \
+                                                                        \
+static double                                                           \
+name ## _get_double (void *vstate)                                      \
+{                                                                       \
+  return name ## _get (vstate) / 4294967296.0;                          \
+}                                                                       \
+                                                                        \
+/* the bulk functions work on copies of the key and counter, which the  \
+   output cannot alias */                                               \
+                                                                        \
+static void                                                             \
+name ## _get_array (void *vstate, unsigned long int *x, size_t n)       \
+{                                                                       \
+  counter_state_t *state = (counter_state_t *) vstate;                  \
+  unsigned long int key[4], ctr[2];                                     \
+                                                                        \
+  while (n > 0 && state->i < 4)                                         \
+    {                                                                   \
+      *x++ = state->x[state->i++];                                      \
+      n--;                                                              \
+    }                                                                   \
+                                                                        \
+  key[0] = state->key[0];                                               \
+  key[1] = state->key[1];                                               \
+  key[2] = state->key[2];                                               \
+  key[3] = state->key[3];                                               \
+  ctr[0] = state->ctr[0];                                               \
+  ctr[1] = state->ctr[1];                                               \
+                                                                        \
+  for (; n >= 4; n -= 4, x += 4)                                        \
+    {                                                                   \
+      name ## _block (key, ctr, x);                                     \
+      ctr[0] = (ctr[0] + 1) & MASK;                                     \
+      ctr[1] = (ctr[1] + (ctr[0] == 0)) & MASK;                         \
+    }                                                                   \
+                                                                        \
+  state->ctr[0] = ctr[0];                                               \
+  state->ctr[1] = ctr[1];                                               \
+                                                                        \
+  while (n-- > 0)                                                       \
+    *x++ = name ## _get (vstate);                                       \
+}                                                                       \
+                                                                        \
+static void                                                             \
+name ## _get_double_array (void *vstate, double *x, size_t n)           \
+{                                                                       \
+  counter_state_t *state = (counter_state_t *) vstate;                  \
+  unsigned long int key[4], ctr[2], b[4];                               \
+                                                                        \
+  while (n > 0 && state->i < 4)                                         \
+    {                                                                   \
+      *x++ = state->x[state->i++] / 4294967296.0;                       \
+      n--;                                                              \
+    }                                                                   \
+                                                                        \
+  key[0] = state->key[0];                                               \
+  key[1] = state->key[1];                                               \
+  key[2] = state->key[2];                                               \
+  key[3] = state->key[3];                                               \
+  ctr[0] = state->ctr[0];                                               \
+  ctr[1] = state->ctr[1];                                               \
+                                                                        \
+  for (; n >= 4; n -= 4, x += 4)                                        \
+    {                                                                   \
+      name ## _block (key, ctr, b);                                     \
+      ctr[0] = (ctr[0] + 1) & MASK;                                     \
+      ctr[1] = (ctr[1] + (ctr[0] == 0)) & MASK;                         \
+      x[0] = b[0] / 4294967296.0;                                       \
+      x[1] = b[1] / 4294967296.0;                                       \
+      x[2] = b[2] / 4294967296.0;                                       \
+      x[3] = b[3] / 4294967296.0;                                       \
+    }                                                                   \
+                                                                        \
+  state->ctr[0] = ctr[0];                                               \
+  state->ctr[1] = ctr[1];                                               \
+                                                                        \
+  while (n-- > 0)                                                       \
+    *x++ = name ## _get_double (vstate);                                \
+}
+
+COUNTER_FUNCTIONS (philox)
+COUNTER_FUNCTIONS (threefry)
+
+static const gsl_rng_type philox4x32_type =
+{"philox4x32",                  /* name */
+ 0xffffffffUL,                  /* RAND_MAX */
+ 0,                             /* RAND_MIN */
+ sizeof (counter_state_t),
+ &counter_set,
+ &philox_get,
+ &philox_get_double,
+ &philox_get_array,
+ &philox_get_double_array,
+ NULL};
+
+static const gsl_rng_type threefry4x32_type =
+{"threefry4x32",                /* name */
+ 0xffffffffUL,                  /* RAND_MAX */
+ 0,                             /* RAND_MIN */
+ sizeof (counter_state_t),
+ &counter_set,
+ &threefry_get,
+ &threefry_get_double,
+ &threefry_get_array,
+ &threefry_get_double_array,
+ NULL};
+
+const gsl_rng_type *gsl_rng_philox4x32 = &philox4x32_type;
+const gsl_rng_type *gsl_rng_threefry4x32 = &threefry4x32_type;
+
+int
+gsl_rng_counter_set (const gsl_rng * r, const unsigned long int key[4],
+                     const unsigned long int ctr[2])
+{
+  counter_state_t *state = (counter_state_t *) r->state;
+  size_t i;
+
+  if (r->type != gsl_rng_philox4x32 && r->type != gsl_rng_threefry4x32)
+    {
+      GSL_ERROR ("generator is not counter-based", GSL_EINVAL);
+    }
+
+  for (i = 0; i < 4; i++)
+    state->key[i] = key[i] & MASK;
+
+  state->ctr[0] = ctr[0] & MASK;
+  state->ctr[1] = ctr[1] & MASK;
+  state->i = 4;
+
+  return GSL_SUCCESS;
+}
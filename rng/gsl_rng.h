@@ -45,6 +45,9 @@ typedef struct
     void (*set) (void *state, unsigned long int seed);
     unsigned long int (*get) (void *state);
     double (*get_double) (void *state);
+    void (*get_array) (void *state, unsigned long int *x, size_t n);
+    void (*get_double_array) (void *state, double *x, size_t n);
+    void (*jump) (void *state);
   }
 gsl_rng_type;
 
@@ -75,6 +78,8 @@ GSL_VAR const gsl_rng_type *gsl_rng_mrg;
 GSL_VAR const gsl_rng_type *gsl_rng_mt19937;
 GSL_VAR const gsl_rng_type *gsl_rng_mt19937_1999;
 GSL_VAR const gsl_rng_type *gsl_rng_mt19937_1998;
+GSL_VAR const gsl_rng_type *gsl_rng_pcg64;
+GSL_VAR const gsl_rng_type *gsl_rng_philox4x32;
 GSL_VAR const gsl_rng_type *gsl_rng_r250;
 GSL_VAR const gsl_rng_type *gsl_rng_ran0;
 GSL_VAR const gsl_rng_type *gsl_rng_ran1;
@@ -111,15 +116,19 @@ GSL_VAR const gsl_rng_type *gsl_rng_ranlxs1;
 GSL_VAR const gsl_rng_type *gsl_rng_ranlxs2;
 GSL_VAR const gsl_rng_type *gsl_rng_ranmar;
 GSL_VAR const gsl_rng_type *gsl_rng_slatec;
+GSL_VAR const gsl_rng_type *gsl_rng_splitmix64;
 GSL_VAR const gsl_rng_type *gsl_rng_taus;
 GSL_VAR const gsl_rng_type *gsl_rng_taus2;
 GSL_VAR const gsl_rng_type *gsl_rng_taus113;
+GSL_VAR const gsl_rng_type *gsl_rng_threefry4x32;
 GSL_VAR const gsl_rng_type *gsl_rng_transputer;
 GSL_VAR const gsl_rng_type *gsl_rng_tt800;
 GSL_VAR const gsl_rng_type *gsl_rng_uni;
 GSL_VAR const gsl_rng_type *gsl_rng_uni32;
 GSL_VAR const gsl_rng_type *gsl_rng_vax;
 GSL_VAR const gsl_rng_type *gsl_rng_waterman14;
+GSL_VAR const gsl_rng_type *gsl_rng_xoshiro256plus;
+GSL_VAR const gsl_rng_type *gsl_rng_xoshiro256starstar;
 GSL_VAR const gsl_rng_type *gsl_rng_zuf;
 
 const gsl_rng_type ** gsl_rng_types_setup(void);
@@ -148,6 +157,18 @@ void gsl_rng_print_state (const gsl_rng * r);
 
 const gsl_rng_type * gsl_rng_env_setup (void);
 
+void gsl_rng_get_array (const gsl_rng * r, unsigned long int * x, size_t n);
+void gsl_rng_uniform_array (const gsl_rng * r, double * x, size_t n);
+void gsl_rng_uniform_pos_array (const gsl_rng * r, double * x, size_t n);
+int gsl_rng_uniform_int_array (const gsl_rng * r, unsigned long int n,
+                               unsigned long int * x, size_t count);
+
+int gsl_rng_counter_set (const gsl_rng * r, const unsigned long int key[4],
+                         const unsigned long int ctr[2]);
+
+int gsl_rng_jump (const gsl_rng * r);
+int gsl_rng_split (const gsl_rng * r, gsl_rng ** s, size_t n);
+
 INLINE_DECL unsigned long int gsl_rng_get (const gsl_rng * r);
 INLINE_DECL double gsl_rng_uniform (const gsl_rng * r);
 INLINE_DECL double gsl_rng_uniform_pos (const gsl_rng * r);
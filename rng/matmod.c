@@ -0,0 +1,91 @@
+/* rng/matmod.c
+ * 
+ * Copyright (C) 2019 Patrick Alken
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Arithmetic with small square matrices modulo m < 2^31, used by the
+   multiple recursive generators to jump ahead. The transition matrix A
+   of the recurrence is squared k times to give A^(2^k), which is then
+   applied to the state. The products are formed with Schrage's method
+   so that no overflow occurs with 32-bit longs. */
+
+#include "schrage.c"
+
+#define MATMOD_MAX 5
+
+/* C = A B mod m for n x n matrices, C may be the same as A or B */
+static void
+matmod_mul (unsigned long int *C, const unsigned long int *A,
+            const unsigned long int *B, size_t n,
+            unsigned long int m, unsigned long int sqrtm)
+{
+  unsigned long int t[MATMOD_MAX * MATMOD_MAX];
+  size_t i, j, k;
+
+  for (i = 0; i < n; i++)
+    {
+      for (j = 0; j < n; j++)
+        {
+          unsigned long int s = 0;
+
+          for (k = 0; k < n; k++)
+            {
+              s += schrage_mult (A[i * n + k], B[k * n + j], m, sqrtm);
+              if (s >= m)
+                s -= m;
+            }
+
+          t[i * n + j] = s;
+        }
+    }
+
+  for (i = 0; i < n * n; i++)
+    C[i] = t[i];
+}
+
+/* x = A^(2^k) x mod m */
+static void
+matmod_jump (unsigned long int *x, const unsigned long int *A, size_t n,
+             unsigned int k, unsigned long int m, unsigned long int sqrtm)
+{
+  unsigned long int P[MATMOD_MAX * MATMOD_MAX];
+  unsigned long int y[MATMOD_MAX];
+  size_t i, j;
+
+  for (i = 0; i < n * n; i++)
+    P[i] = A[i];
+
+  while (k-- > 0)
+    matmod_mul (P, P, P, n, m, sqrtm);
+
+  for (i = 0; i < n; i++)
+    {
+      unsigned long int s = 0;
+
+      for (j = 0; j < n; j++)
+        {
+          s += schrage_mult (P[i * n + j], x[j], m, sqrtm);
+          if (s >= m)
+            s -= m;
+        }
+
+      y[i] = s;
+    }
+
+  for (i = 0; i < n; i++)
+    x[i] = y[i];
+}
@@ -104,6 +104,9 @@ static const gsl_rng_type minstd_type =
  sizeof (minstd_state_t),
  &minstd_set,
  &minstd_get,
- &minstd_get_double};
+ &minstd_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 const gsl_rng_type *gsl_rng_minstd = &minstd_type;
@@ -20,6 +20,7 @@
 #include <config.h>
 #include <stdlib.h>
 #include <gsl/gsl_rng.h>
+#include "matmod.c"
 
 /* This is a fifth-order multiple recursive generator. The sequence is,
 
@@ -46,6 +47,10 @@
 
    The period of this generator is about 2^155.
 
+   The jump function advances the state by 2^100 steps, multiplying
+   the state vector by the transition matrix of the recurrence raised
+   to the power 2^100 by repeated squaring.
+
    From: P. L'Ecuyer, F. Blouin, and R. Coutre, "A search for good
    multiple recursive random number generators", ACM Transactions on
    Modeling and Computer Simulation 3, 87-98 (1993). */
@@ -53,6 +58,7 @@
 static inline unsigned long int mrg_get (void *vstate);
 static double mrg_get_double (void *vstate);
 static void mrg_set (void *state, unsigned long int s);
+static void mrg_jump (void *state);
 
 static const long int m = 2147483647;
 static const long int a1 = 107374182, q1 = 20, r1 = 7;
@@ -137,6 +143,36 @@ mrg_set (void *vstate, unsigned long int s)
   return;
 }
 
+static void
+mrg_jump (void *vstate)
+{
+  /* transition matrix for the state (x1, x2, x3, x4, x5) */
+  static const unsigned long int A[25] = {
+    107374182, 0, 0, 0, 104480,
+    1, 0, 0, 0, 0,
+    0, 1, 0, 0, 0,
+    0, 0, 1, 0, 0,
+    0, 0, 0, 1, 0
+  };
+
+  mrg_state_t *state = (mrg_state_t *) vstate;
+  unsigned long int x[5];
+
+  x[0] = state->x1;
+  x[1] = state->x2;
+  x[2] = state->x3;
+  x[3] = state->x4;
+  x[4] = state->x5;
+
+  matmod_jump (x, A, 5, 100, 2147483647UL, 46341UL);
+
+  state->x1 = x[0];
+  state->x2 = x[1];
+  state->x3 = x[2];
+  state->x4 = x[3];
+  state->x5 = x[4];
+}
+
 static const gsl_rng_type mrg_type =
 {"mrg",                         /* name */
  2147483646,                    /* RAND_MAX */
@@ -144,6 +180,9 @@ static const gsl_rng_type mrg_type =
  sizeof (mrg_state_t),
  &mrg_set,
  &mrg_get,
- &mrg_get_double};
+ &mrg_get_double,
+ NULL,
+ NULL,
+ &mrg_jump};
 
 const gsl_rng_type *gsl_rng_mrg = &mrg_type;
@@ -0,0 +1,206 @@
+/* rng/pcg.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <gsl/gsl_rng.h>
+
+/* The PCG64 generator of O'Neill (PCG-XSL-RR 128/64). The state is a
+   128-bit linear congruential generator,
+
+   x_{n+1} = (a x_n + c) mod 2^128
+
+   with a = 0x2360ed051fc65da44385df649fccf645 and the default
+   increment c = 0x5851f42d4c957f2d14057b7ef767814f, and each output is
+   the xor of the two halves of the new state rotated right by its top
+   6 bits,
+
+   out = rotr (hi (x) ^ lo (x), x >> 122)
+
+   The period is 2^128. The integer output is the upper 32 bits of each
+   64-bit value, and the double output uses the upper 53 bits. The
+   seeding follows the reference implementation, x_0 = 0 followed by a
+   step, adding the seed s and another step. The jump function advances
+   the state by 2^64 steps, using the multiplier and increment of the
+   combined step computed by repeated squaring (Brown, 1994).
+
+   M. E. O'Neill, "PCG: A family of simple fast space-efficient
+   statistically good algorithms for random number generation",
+   Technical Report HMC-CS-2014-0905, Harvey Mudd College (2014).
+
+   F. B. Brown, "Random number generation with arbitrary strides",
+   Transactions of the American Nuclear Society 71, 202 (1994). */
+
+typedef struct
+  {
+    uint64_t hi, lo;
+  }
+pcg128_t;
+
+typedef struct
+  {
+    pcg128_t x;
+  }
+pcg64_state_t;
+
+static const pcg128_t pcg_mult = {
+  UINT64_C(0x2360ed051fc65da4), UINT64_C(0x4385df649fccf645)
+};
+
+static const pcg128_t pcg_inc = {
+  UINT64_C(0x5851f42d4c957f2d), UINT64_C(0x14057b7ef767814f)
+};
+
+/* upper 64 bits of the 128-bit product a b */
+static inline uint64_t
+pcg_mulhi (uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 pcg_uint128;
+  return (uint64_t) (((pcg_uint128) a * b) >> 64);
+#else
+  const uint64_t a0 = a & 0xffffffffU, a1 = a >> 32;
+  const uint64_t b0 = b & 0xffffffffU, b1 = b >> 32;
+  const uint64_t p01 = a0 * b1, p10 = a1 * b0;
+  const uint64_t mid = ((a0 * b0) >> 32) + (p01 & 0xffffffffU)
+    + (p10 & 0xffffffffU);
+  return a1 * b1 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
+}
+
+/* a b + c mod 2^128 */
+static inline pcg128_t
+pcg_muladd (pcg128_t a, pcg128_t b, pcg128_t c)
+{
+  pcg128_t r;
+
+  r.hi = a.hi * b.lo + a.lo * b.hi + pcg_mulhi (a.lo, b.lo);
+  r.lo = a.lo * b.lo;
+
+  r.lo += c.lo;
+  r.hi += c.hi + (r.lo < c.lo);
+
+  return r;
+}
+
+static inline uint64_t
+pcg_output (pcg128_t x)
+{
+  const uint64_t v = x.hi ^ x.lo;
+  const unsigned int r = (unsigned int) (x.hi >> 58);
+
+  return (v >> r) | (v << ((64 - r) & 63));
+}
+
+static inline uint64_t
+pcg64_next (pcg128_t * x)
+{
+  *x = pcg_muladd (*x, pcg_mult, pcg_inc);
+  return pcg_output (*x);
+}
+
+static inline unsigned long int
+pcg64_get (void *vstate)
+{
+  pcg64_state_t *state = (pcg64_state_t *) vstate;
+
+  return (unsigned long int) (pcg64_next (&state->x) >> 32);
+}
+
+static double
+pcg64_get_double (void *vstate)
+{
+  pcg64_state_t *state = (pcg64_state_t *) vstate;
+
+  return (pcg64_next (&state->x) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void
+pcg64_get_array (void *vstate, unsigned long int *x, size_t n)
+{
+  pcg64_state_t *state = (pcg64_state_t *) vstate;
+  pcg128_t s = state->x;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    x[i] = (unsigned long int) (pcg64_next (&s) >> 32);
+
+  state->x = s;
+}
+
+static void
+pcg64_get_double_array (void *vstate, double *x, size_t n)
+{
+  pcg64_state_t *state = (pcg64_state_t *) vstate;
+  pcg128_t s = state->x;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    x[i] = (pcg64_next (&s) >> 11) * (1.0 / 9007199254740992.0);
+
+  state->x = s;
+}
+
+static void
+pcg64_jump (void *vstate)
+{
+  pcg64_state_t *state = (pcg64_state_t *) vstate;
+  const pcg128_t zero = { 0, 0 };
+  const pcg128_t one = { 0, 1 };
+  pcg128_t a = pcg_mult, c = pcg_inc;
+  int k;
+
+  /* the step x -> a x + c applied twice is x -> a^2 x + (a + 1) c */
+  for (k = 0; k < 64; k++)
+    {
+      c = pcg_muladd (pcg_muladd (a, one, one), c, zero);
+      a = pcg_muladd (a, a, zero);
+    }
+
+  state->x = pcg_muladd (a, state->x, c);
+}
+
+static void
+pcg64_set (void *vstate, unsigned long int s)
+{
+  pcg64_state_t *state = (pcg64_state_t *) vstate;
+
+  state->x.hi = 0;
+  state->x.lo = 0;
+  pcg64_next (&state->x);
+
+  state->x.lo += s;
+  state->x.hi += (state->x.lo < s);
+  pcg64_next (&state->x);
+}
+
+static const gsl_rng_type pcg64_type =
+{"pcg64",                       /* name */
+ 0xffffffffUL,                  /* RAND_MAX */
+ 0,                             /* RAND_MIN */
+ sizeof (pcg64_state_t),
+ &pcg64_set,
+ &pcg64_get,
+ &pcg64_get_double,
+ &pcg64_get_array,
+ &pcg64_get_double_array,
+ &pcg64_jump};
+
+const gsl_rng_type *gsl_rng_pcg64 = &pcg64_type;
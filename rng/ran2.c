@@ -141,6 +141,9 @@ static const gsl_rng_type ran2_type =
  sizeof (ran2_state_t),
  &ran2_set,
  &ran2_get,
- &ran2_get_double};
+ &ran2_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 const gsl_rng_type *gsl_rng_ran2 = &ran2_type;
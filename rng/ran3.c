@@ -130,6 +130,9 @@ static const gsl_rng_type ran3_type =
  sizeof (ran3_state_t),
  &ran3_set,
  &ran3_get,
- &ran3_get_double};
+ &ran3_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 const gsl_rng_type *gsl_rng_ran3 = &ran3_type;
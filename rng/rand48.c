@@ -137,7 +137,10 @@ static const gsl_rng_type rand48_type =
  sizeof (rand48_state_t),
  &rand48_set,
  &rand48_get,
- &rand48_get_double
+ &rand48_get_double,
+ NULL,
+ NULL,
+ NULL
 };
 
 const gsl_rng_type *gsl_rng_rand48 = &rand48_type;
@@ -475,7 +475,10 @@ static const gsl_rng_type random_glibc2_type =
  sizeof (random128_state_t),
  &random128_glibc2_set,
  &random128_get,
- &random128_get_double};
+ &random128_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random8_glibc2_type =
 {"random8-glibc2",                      /* name */
@@ -484,7 +487,10 @@ static const gsl_rng_type random8_glibc2_type =
  sizeof (random8_state_t),
  &random8_glibc2_set,
  &random8_get,
- &random8_get_double};
+ &random8_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random32_glibc2_type =
 {"random32-glibc2",                     /* name */
@@ -493,7 +499,10 @@ static const gsl_rng_type random32_glibc2_type =
  sizeof (random32_state_t),
  &random32_glibc2_set,
  &random32_get,
- &random32_get_double};
+ &random32_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random64_glibc2_type =
 {"random64-glibc2",                     /* name */
@@ -502,7 +511,10 @@ static const gsl_rng_type random64_glibc2_type =
  sizeof (random64_state_t),
  &random64_glibc2_set,
  &random64_get,
- &random64_get_double};
+ &random64_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random128_glibc2_type =
 {"random128-glibc2",                    /* name */
@@ -511,7 +523,10 @@ static const gsl_rng_type random128_glibc2_type =
  sizeof (random128_state_t),
  &random128_glibc2_set,
  &random128_get,
- &random128_get_double};
+ &random128_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random256_glibc2_type =
 {"random256-glibc2",                    /* name */
@@ -520,7 +535,10 @@ static const gsl_rng_type random256_glibc2_type =
  sizeof (random256_state_t),
  &random256_glibc2_set,
  &random256_get,
- &random256_get_double};
+ &random256_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random_libc5_type =
 {"random-libc5",                        /* name */
@@ -529,7 +547,10 @@ static const gsl_rng_type random_libc5_type =
  sizeof (random128_state_t),
  &random128_libc5_set,
  &random128_get,
- &random128_get_double};
+ &random128_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random8_libc5_type =
 {"random8-libc5",                       /* name */
@@ -538,7 +559,10 @@ static const gsl_rng_type random8_libc5_type =
  sizeof (random8_state_t),
  &random8_libc5_set,
  &random8_get,
- &random8_get_double};
+ &random8_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random32_libc5_type =
 {"random32-libc5",                      /* name */
@@ -547,7 +571,10 @@ static const gsl_rng_type random32_libc5_type =
  sizeof (random32_state_t),
  &random32_libc5_set,
  &random32_get,
- &random32_get_double};
+ &random32_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random64_libc5_type =
 {"random64-libc5",                      /* name */
@@ -556,7 +583,10 @@ static const gsl_rng_type random64_libc5_type =
  sizeof (random64_state_t),
  &random64_libc5_set,
  &random64_get,
- &random64_get_double};
+ &random64_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random128_libc5_type =
 {"random128-libc5",                     /* name */
@@ -565,7 +595,10 @@ static const gsl_rng_type random128_libc5_type =
  sizeof (random128_state_t),
  &random128_libc5_set,
  &random128_get,
- &random128_get_double};
+ &random128_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random256_libc5_type =
 {"random256-libc5",                     /* name */
@@ -574,7 +607,10 @@ static const gsl_rng_type random256_libc5_type =
  sizeof (random256_state_t),
  &random256_libc5_set,
  &random256_get,
- &random256_get_double};
+ &random256_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random_bsd_type =
 {"random-bsd",                  /* name */
@@ -583,7 +619,10 @@ static const gsl_rng_type random_bsd_type =
  sizeof (random128_state_t),
  &random128_bsd_set,
  &random128_get,
- &random128_get_double};
+ &random128_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random8_bsd_type =
 {"random8-bsd",                 /* name */
@@ -592,7 +631,10 @@ static const gsl_rng_type random8_bsd_type =
  sizeof (random8_state_t),
  &random8_bsd_set,
  &random8_get,
- &random8_get_double};
+ &random8_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random32_bsd_type =
 {"random32-bsd",                        /* name */
@@ -601,7 +643,10 @@ static const gsl_rng_type random32_bsd_type =
  sizeof (random32_state_t),
  &random32_bsd_set,
  &random32_get,
- &random32_get_double};
+ &random32_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random64_bsd_type =
 {"random64-bsd",                        /* name */
@@ -610,7 +655,10 @@ static const gsl_rng_type random64_bsd_type =
  sizeof (random64_state_t),
  &random64_bsd_set,
  &random64_get,
- &random64_get_double};
+ &random64_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random128_bsd_type =
 {"random128-bsd",               /* name */
@@ -619,7 +667,10 @@ static const gsl_rng_type random128_bsd_type =
  sizeof (random128_state_t),
  &random128_bsd_set,
  &random128_get,
- &random128_get_double};
+ &random128_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 static const gsl_rng_type random256_bsd_type =
 {"random256-bsd",               /* name */
@@ -628,7 +679,10 @@ static const gsl_rng_type random256_bsd_type =
  sizeof (random256_state_t),
  &random256_bsd_set,
  &random256_get,
- &random256_get_double};
+ &random256_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 const gsl_rng_type *gsl_rng_random_libc5    = &random_libc5_type;
 const gsl_rng_type *gsl_rng_random8_libc5   = &random8_libc5_type;
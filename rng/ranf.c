@@ -156,7 +156,10 @@ static const gsl_rng_type ranf_type =
  sizeof (ranf_state_t),
  &ranf_set,
  &ranf_get,
- &ranf_get_double
+ &ranf_get_double,
+ NULL,
+ NULL,
+ NULL
 };
 
 const gsl_rng_type *gsl_rng_ranf = &ranf_type;
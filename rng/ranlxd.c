@@ -167,6 +167,54 @@ ranlxd_get_double (void *vstate)
   return state->xdbl[state->ir];
 }
 
+static void
+ranlxd_get_double_array (void *vstate, double *x, size_t n)
+{
+  ranlxd_state_t *state = (ranlxd_state_t *) vstate;
+  unsigned int ir = state->ir;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      ir = next[ir];
+
+      if (ir == state->ir_old)
+        {
+          state->ir = ir;
+          increment_state (state);
+          ir = state->ir;
+        }
+
+      x[i] = state->xdbl[ir];
+    }
+
+  state->ir = ir;
+}
+
+static void
+ranlxd_get_array (void *vstate, unsigned long int *x, size_t n)
+{
+  ranlxd_state_t *state = (ranlxd_state_t *) vstate;
+  unsigned int ir = state->ir;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      ir = next[ir];
+
+      if (ir == state->ir_old)
+        {
+          state->ir = ir;
+          increment_state (state);
+          ir = state->ir;
+        }
+
+      x[i] = state->xdbl[ir] * 4294967296.0;    /* 2^32 */
+    }
+
+  state->ir = ir;
+}
+
 static void
 ranlxd_set_lux (void *vstate, unsigned long int s, unsigned int luxury)
 {
@@ -234,7 +282,10 @@ static const gsl_rng_type ranlxd1_type =
  sizeof (ranlxd_state_t),
  &ranlxd1_set,
  &ranlxd_get,
- &ranlxd_get_double};
+ &ranlxd_get_double,
+ &ranlxd_get_array,
+ &ranlxd_get_double_array,
+ NULL};
 
 static const gsl_rng_type ranlxd2_type =
 {"ranlxd2",                     /* name */
@@ -243,7 +294,10 @@ static const gsl_rng_type ranlxd2_type =
  sizeof (ranlxd_state_t),
  &ranlxd2_set,
  &ranlxd_get,
- &ranlxd_get_double};
+ &ranlxd_get_double,
+ &ranlxd_get_array,
+ &ranlxd_get_double_array,
+ NULL};
 
 const gsl_rng_type *gsl_rng_ranlxd1 = &ranlxd1_type;
 const gsl_rng_type *gsl_rng_ranlxd2 = &ranlxd2_type;
@@ -168,6 +168,9 @@ static const gsl_rng_type ranmar_type =
  sizeof (ranmar_state_t),
  &ranmar_set,
  &ranmar_get,
- &ranmar_get_double};
+ &ranmar_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 const gsl_rng_type *gsl_rng_ranmar = &ranmar_type;
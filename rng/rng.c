@@ -152,3 +152,151 @@ gsl_rng_free (gsl_rng * r)
   free (r->state);
   free (r);
 }
+
+/* The array functions produce the same numbers as the corresponding
+   loops over the scalar functions, using the bulk generation of the
+   generator when it has one. */
+
+void
+gsl_rng_get_array (const gsl_rng * r, unsigned long int *x, size_t n)
+{
+  if (r->type->get_array)
+    {
+      (r->type->get_array) (r->state, x, n);
+    }
+  else
+    {
+      unsigned long int (*get) (void *) = r->type->get;
+      void *state = r->state;
+      size_t i;
+
+      for (i = 0; i < n; i++)
+        x[i] = get (state);
+    }
+}
+
+void
+gsl_rng_uniform_array (const gsl_rng * r, double *x, size_t n)
+{
+  if (r->type->get_double_array)
+    {
+      (r->type->get_double_array) (r->state, x, n);
+    }
+  else
+    {
+      double (*get_double) (void *) = r->type->get_double;
+      void *state = r->state;
+      size_t i;
+
+      for (i = 0; i < n; i++)
+        x[i] = get_double (state);
+    }
+}
+
+void
+gsl_rng_uniform_pos_array (const gsl_rng * r, double *x, size_t n)
+{
+  size_t i = 0;
+
+  /* discard the zeros, keeping the order of the other samples, and
+     refill the end of the array */
+  while (i < n)
+    {
+      size_t j, k;
+
+      gsl_rng_uniform_array (r, x + i, n - i);
+
+      for (j = i, k = i; j < n; j++)
+        {
+          if (x[j] != 0)
+            x[k++] = x[j];
+        }
+
+      i = k;
+    }
+}
+
+int
+gsl_rng_uniform_int_array (const gsl_rng * r, unsigned long int n,
+                           unsigned long int *x, size_t count)
+{
+  const unsigned long int offset = r->type->min;
+  const unsigned long int range = r->type->max - offset;
+  unsigned long int scale;
+  size_t i = 0;
+
+  if (n > range || n == 0)
+    {
+      GSL_ERROR ("invalid n, either 0 or exceeds maximum value of generator",
+                 GSL_EINVAL);
+    }
+
+  /* see gsl_rng_uniform_int */
+  scale = range / n;
+
+  while (i < count)
+    {
+      size_t j, k;
+
+      gsl_rng_get_array (r, x + i, count - i);
+
+      for (j = i, k = i; j < count; j++)
+        {
+          const unsigned long int v = (x[j] - offset) / scale;
+
+          if (v < n)
+            x[k++] = v;
+        }
+
+      i = k;
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* Jumping ahead advances the state by a fixed number of steps, which
+   depends on the generator, without producing the numbers in
+   between. */
+
+int
+gsl_rng_jump (const gsl_rng * r)
+{
+  if (r->type->jump == NULL)
+    {
+      GSL_ERROR ("generator does not support jumping ahead", GSL_EINVAL);
+    }
+
+  (r->type->jump) (r->state);
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_rng_split (const gsl_rng * r, gsl_rng ** s, size_t n)
+{
+  size_t i;
+
+  if (r->type->jump == NULL)
+    {
+      GSL_ERROR ("generator does not support jumping ahead", GSL_EINVAL);
+    }
+
+  /* substream i starts i jumps ahead of r, and r is left at the start
+     of the substream after the last one */
+  for (i = 0; i < n; i++)
+    {
+      s[i] = gsl_rng_clone (r);
+
+      if (s[i] == 0)
+        {
+          while (i > 0)
+            gsl_rng_free (s[--i]);
+
+          GSL_ERROR ("failed to allocate substream", GSL_ENOMEM);
+        }
+
+      (r->type->jump) (r->state);
+    }
+
+  return GSL_SUCCESS;
+}
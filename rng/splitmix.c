@@ -0,0 +1,133 @@
+/* rng/splitmix.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <gsl/gsl_rng.h>
+
+/* SplitMix64 generator of Steele, Lea and Flood. The state is a 64-bit
+   counter x, advanced by the odd constant gamma = 0x9e3779b97f4a7c15,
+   and each output is the counter passed through a bijective mixing
+   function,
+
+   x_{n+1} = x_n + gamma mod 2^64
+   z = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9
+   z = (z ^ (z >> 27)) * 0x94d049bb133111eb
+   out = z ^ (z >> 31)
+
+   The period is 2^64. The integer output is the upper 32 bits of each
+   64-bit value, and the double output uses the upper 53 bits. The
+   generator is seeded with x_0 = s, and the first output for s =
+   1234567 is 6457827717110365317. The jump function advances the
+   state by 2^48 steps.
+
+   G. L. Steele, D. Lea and C. H. Flood, "Fast splittable pseudorandom
+   number generators", Proceedings of OOPSLA 2014, 453-472. */
+
+#define SPLITMIX_GAMMA UINT64_C(0x9e3779b97f4a7c15)
+
+typedef struct
+  {
+    uint64_t x;
+  }
+splitmix64_state_t;
+
+static inline uint64_t
+splitmix64_next (uint64_t * x)
+{
+  uint64_t z = (*x += SPLITMIX_GAMMA);
+
+  z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+  z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+
+  return z ^ (z >> 31);
+}
+
+static inline unsigned long int
+splitmix64_get (void *vstate)
+{
+  splitmix64_state_t *state = (splitmix64_state_t *) vstate;
+
+  return (unsigned long int) (splitmix64_next (&state->x) >> 32);
+}
+
+static double
+splitmix64_get_double (void *vstate)
+{
+  splitmix64_state_t *state = (splitmix64_state_t *) vstate;
+
+  return (splitmix64_next (&state->x) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void
+splitmix64_get_array (void *vstate, unsigned long int *x, size_t n)
+{
+  splitmix64_state_t *state = (splitmix64_state_t *) vstate;
+  uint64_t s = state->x;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    x[i] = (unsigned long int) (splitmix64_next (&s) >> 32);
+
+  state->x = s;
+}
+
+static void
+splitmix64_get_double_array (void *vstate, double *x, size_t n)
+{
+  splitmix64_state_t *state = (splitmix64_state_t *) vstate;
+  uint64_t s = state->x;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    x[i] = (splitmix64_next (&s) >> 11) * (1.0 / 9007199254740992.0);
+
+  state->x = s;
+}
+
+static void
+splitmix64_jump (void *vstate)
+{
+  splitmix64_state_t *state = (splitmix64_state_t *) vstate;
+
+  state->x += SPLITMIX_GAMMA << 48;
+}
+
+static void
+splitmix64_set (void *vstate, unsigned long int s)
+{
+  splitmix64_state_t *state = (splitmix64_state_t *) vstate;
+
+  state->x = s;
+}
+
+static const gsl_rng_type splitmix64_type =
+{"splitmix64",                  /* name */
+ 0xffffffffUL,                  /* RAND_MAX */
+ 0,                             /* RAND_MIN */
+ sizeof (splitmix64_state_t),
+ &splitmix64_set,
+ &splitmix64_get,
+ &splitmix64_get_double,
+ &splitmix64_get_array,
+ &splitmix64_get_double_array,
+ &splitmix64_jump};
+
+const gsl_rng_type *gsl_rng_splitmix64 = &splitmix64_type;
@@ -45,6 +45,10 @@
    After this, the state is passed through the RNG 10 times to ensure the
    state satisfies a recurrence relation.
 
+   Each component is a linear map over GF(2) of the bits of zi, so the
+   jump function, which advances the state by 2^64 steps, squares the
+   32x32 bit matrix of each component 64 times and applies it.
+
    References:
    P. L'Ecuyer, "Tables of Maximally-Equidistributed Combined LFSR Generators",
    Mathematics of Computation, 68, 225 (1999), 261--269.
@@ -100,6 +104,115 @@ taus113_get_double (void *vstate)
   return taus113_get (vstate) / 4294967296.0;
 }
 
+/* The bulk functions keep the four components in local variables */
+
+#define TAUS113_STEP(z1,z2,z3,z4)                                         \
+  do {                                                                    \
+    z1 = ((((z1 & 4294967294UL) << 18UL) & MASK) ^                        \
+          (((((z1 << 6UL) & MASK) ^ z1) >> 13UL)));                       \
+    z2 = ((((z2 & 4294967288UL) << 2UL) & MASK) ^                         \
+          (((((z2 << 2UL) & MASK) ^ z2) >> 27UL)));                       \
+    z3 = ((((z3 & 4294967280UL) << 7UL) & MASK) ^                         \
+          (((((z3 << 13UL) & MASK) ^ z3) >> 21UL)));                      \
+    z4 = ((((z4 & 4294967168UL) << 13UL) & MASK) ^                        \
+          (((((z4 << 3UL) & MASK) ^ z4) >> 12UL)));                       \
+  } while (0)
+
+static void
+taus113_get_array (void *vstate, unsigned long int *x, size_t n)
+{
+  taus113_state_t *state = (taus113_state_t *) vstate;
+  unsigned long int z1 = state->z1, z2 = state->z2;
+  unsigned long int z3 = state->z3, z4 = state->z4;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      TAUS113_STEP (z1, z2, z3, z4);
+      x[i] = z1 ^ z2 ^ z3 ^ z4;
+    }
+
+  state->z1 = z1;
+  state->z2 = z2;
+  state->z3 = z3;
+  state->z4 = z4;
+}
+
+static void
+taus113_get_double_array (void *vstate, double *x, size_t n)
+{
+  taus113_state_t *state = (taus113_state_t *) vstate;
+  unsigned long int z1 = state->z1, z2 = state->z2;
+  unsigned long int z3 = state->z3, z4 = state->z4;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      TAUS113_STEP (z1, z2, z3, z4);
+      x[i] = (z1 ^ z2 ^ z3 ^ z4) / 4294967296.0;
+    }
+
+  state->z1 = z1;
+  state->z2 = z2;
+  state->z3 = z3;
+  state->z4 = z4;
+}
+
+/* The bit matrices are stored as the images of the 32 unit vectors */
+
+static unsigned long int
+taus113_apply (const unsigned long int *T, unsigned long int z)
+{
+  unsigned long int y = 0;
+  int j;
+
+  for (j = 0; j < 32; j++, z >>= 1)
+    {
+      if (z & 0x1UL)
+        y ^= T[j];
+    }
+
+  return y;
+}
+
+static void
+taus113_jump (void *vstate)
+{
+  taus113_state_t *state = (taus113_state_t *) vstate;
+  unsigned long int T[4][32], U[32];
+  int c, j, k;
+
+  for (j = 0; j < 32; j++)
+    {
+      unsigned long int z1, z2, z3, z4;
+
+      z1 = z2 = z3 = z4 = 1UL << j;
+      TAUS113_STEP (z1, z2, z3, z4);
+
+      T[0][j] = z1;
+      T[1][j] = z2;
+      T[2][j] = z3;
+      T[3][j] = z4;
+    }
+
+  for (c = 0; c < 4; c++)
+    {
+      for (k = 0; k < 64; k++)
+        {
+          for (j = 0; j < 32; j++)
+            U[j] = taus113_apply (T[c], T[c][j]);
+
+          for (j = 0; j < 32; j++)
+            T[c][j] = U[j];
+        }
+    }
+
+  state->z1 = taus113_apply (T[0], state->z1);
+  state->z2 = taus113_apply (T[1], state->z2);
+  state->z3 = taus113_apply (T[2], state->z3);
+  state->z4 = taus113_apply (T[3], state->z4);
+}
+
 static void
 taus113_set (void *vstate, unsigned long int s)
 {
@@ -143,7 +256,10 @@ static const gsl_rng_type taus113_type = {
   sizeof (taus113_state_t),
   &taus113_set,
   &taus113_get,
-  &taus113_get_double
+  &taus113_get_double,
+  &taus113_get_array,
+  &taus113_get_double_array,
+  &taus113_jump
 };
 
 const gsl_rng_type *gsl_rng_taus113 = &taus113_type;
@@ -30,6 +30,14 @@ void rng_test (const gsl_rng_type * T, unsigned long int seed, unsigned int n,
 void rng_float_test (const gsl_rng_type * T);
 void generic_rng_test (const gsl_rng_type * T);
 void rng_state_test (const gsl_rng_type * T);
+void rng_array_test (const gsl_rng_type * T);
+void rng_counter_test (const gsl_rng_type * T, const unsigned long int key[4],
+                       const unsigned long int ctr[2],
+                       const unsigned long int result[4]);
+void rng_jump_test (const gsl_rng_type * T, unsigned long int seed,
+                    unsigned int n, unsigned long int result);
+void rng_double_test (const gsl_rng_type * T, unsigned long int seed,
+                      double result);
 void rng_parallel_state_test (const gsl_rng_type * T);
 void rng_read_write_test (const gsl_rng_type * T);
 int rng_max_test (gsl_rng * r, unsigned long int *kmax, unsigned long int ran_max) ;
@@ -181,11 +189,70 @@ main (void)
   rng_test (gsl_rng_ranf, 0, 10000, 2152890433UL);
   rng_test (gsl_rng_ranf, 2, 10000, 339327233);
 
+  /* The 64-bit generators were checked against the published outputs
+     of the reference implementations (SplitMix64 for seed 1234567,
+     PCG64 for initial state 42 on the default stream, i.e.
+     pcg_oneseq_128_xsl_rr_64 in the C reference) */
+
+  rng_test (gsl_rng_splitmix64, 1234567, 5, 3820500071UL);
+  rng_test (gsl_rng_splitmix64, 1234567, 10000, 1181120168UL);
+  rng_test (gsl_rng_xoshiro256starstar, 1, 10000, 1363609523UL);
+  rng_test (gsl_rng_xoshiro256plus, 1, 10000, 256864729UL);
+  rng_test (gsl_rng_pcg64, 42, 10000, 3600002760UL);
+
+  rng_double_test (gsl_rng_splitmix64, 1234567, 0.35007954202140812);
+  rng_double_test (gsl_rng_xoshiro256starstar, 1, 0.70292183315885048);
+  rng_double_test (gsl_rng_xoshiro256plus, 1, 0.010920792228052978);
+  rng_double_test (gsl_rng_pcg64, 42, 0.15802686859384152);
+
+  /* Known answer tests of the Random123 library. For Philox the upper
+     half of the stream key is the upper half of the counter block. */
+
+  {
+    const unsigned long int zero[4] = { 0, 0, 0, 0 };
+    const unsigned long int ones[4] = { 0xffffffffUL, 0xffffffffUL,
+                                        0xffffffffUL, 0xffffffffUL };
+    const unsigned long int pi_key[4] = { 0xa4093822UL, 0x299f31d0UL,
+                                          0x13198a2eUL, 0x03707344UL };
+    const unsigned long int pi_ctr[2] = { 0x243f6a88UL, 0x85a308d3UL };
+    const unsigned long int philox_zero[4] = { 0x6627e8d5UL, 0xe169c58dUL,
+                                               0xbc57ac4cUL, 0x9b00dbd8UL };
+    const unsigned long int philox_ones[4] = { 0x408f276dUL, 0x41c83b0eUL,
+                                               0xa20bc7c6UL, 0x6d5451fdUL };
+    const unsigned long int philox_pi[4] = { 0xd16cfe09UL, 0x94fdccebUL,
+                                             0x5001e420UL, 0x24126ea1UL };
+    const unsigned long int threefry_zero[4] = { 0x9c6ca96aUL, 0xe17eae66UL,
+                                                 0xfc10ecd4UL, 0x5256a7d8UL };
+
+    rng_counter_test (gsl_rng_philox4x32, zero, zero, philox_zero);
+    rng_counter_test (gsl_rng_philox4x32, ones, ones, philox_ones);
+    rng_counter_test (gsl_rng_philox4x32, pi_key, pi_ctr, philox_pi);
+    rng_counter_test (gsl_rng_threefry4x32, zero, zero, threefry_zero);
+  }
+
+  /* The jumps were computed independently by matrix powers for mrg
+     and cmrg, and by stepping each component of taus113 2^64 modulo
+     its period */
+
+  rng_jump_test (gsl_rng_mrg, 1, 1000, 1613508843UL);
+  rng_jump_test (gsl_rng_cmrg, 1, 1000, 1914535591UL);
+  rng_jump_test (gsl_rng_taus113, 1, 1000, 3108262004UL);
+  rng_jump_test (gsl_rng_mt19937, 4357, 1000, 4280526947UL);
+  rng_jump_test (gsl_rng_splitmix64, 1234567, 1000, 2903599757UL);
+  rng_jump_test (gsl_rng_xoshiro256starstar, 1, 1000, 1848914080UL);
+  rng_jump_test (gsl_rng_xoshiro256plus, 1, 1000, 1303340766UL);
+  rng_jump_test (gsl_rng_pcg64, 42, 1000, 1503016592UL);
+
   /* Test constant relationship between int and double functions */
 
   for (r = rngs ; *r != 0; r++)
     rng_float_test (*r);
 
+  /* Test the array functions against the scalar functions */
+
+  for (r = rngs ; *r != 0; r++)
+    rng_array_test (*r);
+
   /* Test save/restore functions */
 
   for (r = rngs ; *r != 0; r++)
@@ -291,6 +358,193 @@ rng_float_test (const gsl_rng_type * T)
 }
 
 
+/* Check the block of a counter-based generator, and that setting the
+   counter skips the blocks in between */
+
+void
+rng_counter_test (const gsl_rng_type * T, const unsigned long int key[4],
+                  const unsigned long int ctr[2],
+                  const unsigned long int result[4])
+{
+  gsl_rng *r = gsl_rng_alloc (T);
+  gsl_rng *s = gsl_rng_alloc (T);
+  const unsigned long int ctr2[2] = { (ctr[0] + 1000) & 0xffffffffUL,
+                                      ctr[1] + (ctr[0] > 0xffffffffUL - 1000) };
+  unsigned long int k;
+  int status = 0;
+  size_t i;
+
+  gsl_rng_counter_set (r, key, ctr);
+
+  for (i = 0; i < 4; i++)
+    {
+      k = gsl_rng_get (r);
+      status |= (k != result[i]);
+    }
+
+  gsl_test (status, "%s, known answer test (%lx %lx %lx %lx expected)",
+            gsl_rng_name (r), result[0], result[1], result[2], result[3]);
+
+  /* skip to block ctr + 1000 in steps of 1 and directly */
+  for (i = 4; i < 4000; i++)
+    gsl_rng_get (r);
+
+  gsl_rng_counter_set (s, key, ctr2);
+
+  status = 0;
+
+  for (i = 0; i < 10; i++)
+    status |= (gsl_rng_get (r) != gsl_rng_get (s));
+
+  gsl_test (status, "%s, counter skip", gsl_rng_name (r));
+
+  gsl_rng_free (r);
+  gsl_rng_free (s);
+}
+
+/* The first double of generators with 53-bit doubles */
+
+void
+rng_double_test (const gsl_rng_type * T, unsigned long int seed,
+                 double result)
+{
+  gsl_rng *r = gsl_rng_alloc (T);
+  double u;
+
+  gsl_rng_set (r, seed);
+  u = gsl_rng_uniform (r);
+
+  gsl_test (u != result, "%s, 53-bit double (%.17g observed vs %.17g expected)",
+            gsl_rng_name (r), u, result);
+
+  gsl_rng_free (r);
+}
+
+/* Check the value n steps after one jump, that jumping commutes with
+   stepping, and that the substreams of a split agree with repeated
+   jumps */
+
+void
+rng_jump_test (const gsl_rng_type * T, unsigned long int seed,
+               unsigned int n, unsigned long int result)
+{
+  gsl_rng *r = gsl_rng_alloc (T);
+  gsl_rng *s = gsl_rng_alloc (T);
+  gsl_rng *sub[3];
+  unsigned long int k = 0;
+  int status = 0;
+  size_t i, j;
+
+  gsl_rng_set (r, seed);
+  gsl_rng_jump (r);
+
+  for (i = 0; i < n; i++)
+    k = gsl_rng_get (r);
+
+  gsl_test (k != result, "%s, jump and %u steps (%lu observed vs %lu expected)",
+            gsl_rng_name (r), n, k, result);
+
+  gsl_rng_set (r, seed);
+  gsl_rng_set (s, seed);
+
+  for (i = 0; i < 700; i++)
+    gsl_rng_get (r);
+
+  gsl_rng_jump (r);
+  gsl_rng_jump (s);
+
+  for (i = 0; i < 700; i++)
+    gsl_rng_get (s);
+
+  for (i = 0; i < 1000; i++)
+    status |= (gsl_rng_get (r) != gsl_rng_get (s));
+
+  gsl_test (status, "%s, jump commutes with steps", gsl_rng_name (r));
+
+  gsl_rng_set (r, seed);
+  gsl_rng_set (s, seed);
+  status = gsl_rng_split (r, sub, 3);
+
+  for (j = 0; j < 4; j++)
+    {
+      gsl_rng *t = (j < 3) ? sub[j] : r;
+
+      for (i = 0; i < 10; i++)
+        status |= (gsl_rng_get (t) != gsl_rng_get (s));
+
+      gsl_rng_set (s, seed);
+      for (i = 0; i <= j; i++)
+        gsl_rng_jump (s);
+    }
+
+  gsl_test (status, "%s, split into substreams", gsl_rng_name (r));
+
+  for (j = 0; j < 3; j++)
+    gsl_rng_free (sub[j]);
+
+  gsl_rng_free (r);
+  gsl_rng_free (s);
+}
+
+/* Fill arrays of various lengths and check that they agree with the
+   scalar functions, and that the generators remain in step */
+
+void
+rng_array_test (const gsl_rng_type * T)
+{
+  static const size_t len[6] = { 1, 2, 7, 624, 1000, 2001 };
+  static unsigned long int ka[N], kb[N];
+  static double ua[N], ub[N];
+
+  gsl_rng *ra = gsl_rng_alloc (T);
+  gsl_rng *rb = gsl_rng_alloc (T);
+  const unsigned long int range = gsl_rng_max (ra) - gsl_rng_min (ra);
+  const unsigned long int nint[2] = { 3, range / 3 * 2 + 1 };
+  int status = 0;
+  size_t i, j, m;
+
+  for (j = 0; j < 6; j++)
+    {
+      const size_t n = len[j];
+
+      gsl_rng_get_array (ra, ka, n);
+      for (i = 0; i < n; i++)
+        kb[i] = gsl_rng_get (rb);
+      for (i = 0; i < n; i++)
+        status |= (ka[i] != kb[i]);
+
+      gsl_rng_uniform_array (ra, ua, n);
+      for (i = 0; i < n; i++)
+        ub[i] = gsl_rng_uniform (rb);
+      for (i = 0; i < n; i++)
+        status |= (ua[i] != ub[i]);
+
+      gsl_rng_uniform_pos_array (ra, ua, n);
+      for (i = 0; i < n; i++)
+        ub[i] = gsl_rng_uniform_pos (rb);
+      for (i = 0; i < n; i++)
+        status |= (ua[i] != ub[i] || ua[i] == 0);
+
+      for (m = 0; m < 2; m++)
+        {
+          gsl_rng_uniform_int_array (ra, nint[m], ka, n);
+          for (i = 0; i < n; i++)
+            kb[i] = gsl_rng_uniform_int (rb, nint[m]);
+          for (i = 0; i < n; i++)
+            status |= (ka[i] != kb[i] || ka[i] >= nint[m]);
+        }
+    }
+
+  status |= (gsl_rng_get (ra) != gsl_rng_get (rb));
+
+  gsl_test (status, "%s, array functions agree with scalar functions",
+            gsl_rng_name (ra));
+
+  gsl_rng_free (ra);
+  gsl_rng_free (rb);
+}
+
+
 void
 rng_state_test (const gsl_rng_type * T)
 {
@@ -78,6 +78,9 @@ static const gsl_rng_type transputer_type =
  sizeof (transputer_state_t),
  &transputer_set,
  &transputer_get,
- &transputer_get_double};
+ &transputer_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 const gsl_rng_type *gsl_rng_transputer = &transputer_type;
@@ -138,6 +138,9 @@ static const gsl_rng_type tt_type =
  sizeof (tt_state_t),
  &tt_set,
  &tt_get,
- &tt_get_double};
+ &tt_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 const gsl_rng_type *gsl_rng_tt800 = &tt_type;
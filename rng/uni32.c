@@ -198,6 +198,9 @@ static const gsl_rng_type uni32_type =
  sizeof (uni32_state_t),
  &uni32_set,
  &uni32_get,
- &uni32_get_double};
+ &uni32_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 const gsl_rng_type *gsl_rng_uni32 = &uni32_type;
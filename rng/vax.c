@@ -78,6 +78,9 @@ static const gsl_rng_type vax_type =
  sizeof (vax_state_t),
  &vax_set,
  &vax_get,
- &vax_get_double};
+ &vax_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 const gsl_rng_type *gsl_rng_vax = &vax_type;
@@ -0,0 +1,233 @@
+/* rng/xoshiro.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <gsl/gsl_rng.h>
+
+/* The xoshiro256** and xoshiro256+ generators of Blackman and Vigna.
+   Both use the same linear engine on a state of four 64-bit words,
+
+   t = s1 << 17
+   s2 ^= s0, s3 ^= s1, s1 ^= s2, s0 ^= s3, s2 ^= t
+   s3 = rotl (s3, 45)
+
+   with period 2^256 - 1, and differ in the scrambler which forms the
+   output from the state before the update,
+
+   xoshiro256**: rotl (s1 * 5, 7) * 9
+   xoshiro256+ : s0 + s3
+
+   The lowest bits of xoshiro256+ are weak, so the integer output of
+   both generators is the upper 32 bits of each 64-bit value, and the
+   double output uses the upper 53 bits.
+
+   The state is seeded with four successive outputs of SplitMix64
+   started from the seed s, as recommended by the authors. The jump
+   function advances the state by 2^128 steps, using the jump
+   polynomial of the reference implementation.
+
+   D. Blackman and S. Vigna, "Scrambled linear pseudorandom number
+   generators", ACM Transactions on Mathematical Software 47, 36
+   (2021). */
+
+typedef struct
+  {
+    uint64_t s[4];
+  }
+xoshiro256_state_t;
+
+#define ROTL64(x,k) (((x) << (k)) | ((x) >> (64 - (k))))
+
+#define XOSHIRO256_STEP(s0,s1,s2,s3)            \
+  do {                                          \
+    const uint64_t t = s1 << 17;                \
+    s2 ^= s0;                                   \
+    s3 ^= s1;                                   \
+    s1 ^= s2;                                   \
+    s0 ^= s3;                                   \
+    s2 ^= t;                                    \
+    s3 = ROTL64 (s3, 45);                       \
+  } while (0)
+
+#define XOSHIRO256STARSTAR_OUT(s0,s1,s2,s3) (ROTL64 ((s1) * 5, 7) * 9)
+#define XOSHIRO256PLUS_OUT(s0,s1,s2,s3) ((s0) + (s3))
+
+/* The bulk functions keep the state in local variables */
+
+#define XOSHIRO_FUNCTIONS(name, OUT)                                    \
+                                                                        \
+static inline uint64_t                                                  \
+name ## _next (xoshiro256_state_t * state)                              \
+{                                                                       \
+  uint64_t s0 = state->s[0], s1 = state->s[1];                          \
+  uint64_t s2 = state->s[2], s3 = state->s[3];                          \
+  const uint64_t r = OUT (s0, s1, s2, s3);                              \
+                                                                        \
+  XOSHIRO256_STEP (s0, s1, s2, s3);                                     \
+                                                                        \
+  state->s[0] = s0;                                                     \
+  state->s[1] = s1;                                                     \
+  state->s[2] = s2;                                                     \
+  state->s[3] = s3;                                                     \
+                                                                        \
+  return r;                                                             \
+}                                                                       \
+                                                                        \
+static inline unsigned long int                                         \
+name ## _get (void *vstate)                                             \
+{                                                                       \
+  return (unsigned long int)                                            \
+    (name ## _next ((xoshiro256_state_t *) vstate) >> 32);              \
+}                                                                       \
+                                                                        \
+static double                                                           \
+name ## _get_double (void *vstate)                                      \
+{                                                                       \
+  return (name ## _next ((xoshiro256_state_t *) vstate) >> 11)          \
+    * (1.0 / 9007199254740992.0);                                       \
+}                                                                       \
+                                                                        \
+static void                                                             \
+name ## _get_array (void *vstate, unsigned long int *x, size_t n)       \
+{                                                                       \
+  xoshiro256_state_t *state = (xoshiro256_state_t *) vstate;            \
+  uint64_t s0 = state->s[0], s1 = state->s[1];                          \
+  uint64_t s2 = state->s[2], s3 = state->s[3];                          \
+  size_t i;                                                             \
+                                                                        \
+  for (i = 0; i < n; i++)                                               \
+    {                                                                   \
+      x[i] = (unsigned long int) (OUT (s0, s1, s2, s3) >> 32);          \
+      XOSHIRO256_STEP (s0, s1, s2, s3);                                 \
+    }                                                                   \
+                                                                        \
+  state->s[0] = s0;                                                     \
+  state->s[1] = s1;                                                     \
+  state->s[2] = s2;                                                     \
+  state->s[3] = s3;                                                     \
+}                                                                       \
+                                                                        \
+static void                                                             \
+name ## _get_double_array (void *vstate, double *x, size_t n)           \
+{                                                                       \
+  xoshiro256_state_t *state = (xoshiro256_state_t *) vstate;            \
+  uint64_t s0 = state->s[0], s1 = state->s[1];                          \
+  uint64_t s2 = state->s[2], s3 = state->s[3];                          \
+  size_t i;                                                             \
+                                                                        \
+  for (i = 0; i < n; i++)                                               \
+    {                                                                   \
+      x[i] = (OUT (s0, s1, s2, s3) >> 11) * (1.0 / 9007199254740992.0); \
+      XOSHIRO256_STEP (s0, s1, s2, s3);                                 \
+    }                                                                   \
+                                                                        \
+  state->s[0] = s0;                                                     \
+  state->s[1] = s1;                                                     \
+  state->s[2] = s2;                                                     \
+  state->s[3] = s3;                                                     \
+}
+
+XOSHIRO_FUNCTIONS (xoshiro256starstar, XOSHIRO256STARSTAR_OUT)
+XOSHIRO_FUNCTIONS (xoshiro256plus, XOSHIRO256PLUS_OUT)
+
+/* The new state is the sum over GF(2) of the states T^i s for which
+   bit i of the jump polynomial x^(2^128) mod phi(x) is set, where phi
+   is the characteristic polynomial of the transition T */
+
+static void
+xoshiro256_jump (void *vstate)
+{
+  static const uint64_t jump[4] = {
+    UINT64_C(0x180ec6d33cfd0aba), UINT64_C(0xd5a61266f0c9392c),
+    UINT64_C(0xa9582618e03fc9aa), UINT64_C(0x39abdc4529b1661c)
+  };
+
+  xoshiro256_state_t *state = (xoshiro256_state_t *) vstate;
+  uint64_t s0 = state->s[0], s1 = state->s[1];
+  uint64_t s2 = state->s[2], s3 = state->s[3];
+  uint64_t a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+  int i, b;
+
+  for (i = 0; i < 4; i++)
+    {
+      for (b = 0; b < 64; b++)
+        {
+          if ((jump[i] >> b) & 1)
+            {
+              a0 ^= s0;
+              a1 ^= s1;
+              a2 ^= s2;
+              a3 ^= s3;
+            }
+
+          XOSHIRO256_STEP (s0, s1, s2, s3);
+        }
+    }
+
+  state->s[0] = a0;
+  state->s[1] = a1;
+  state->s[2] = a2;
+  state->s[3] = a3;
+}
+
+static void
+xoshiro256_set (void *vstate, unsigned long int s)
+{
+  xoshiro256_state_t *state = (xoshiro256_state_t *) vstate;
+  uint64_t x = s;
+  int i;
+
+  /* SplitMix64 */
+  for (i = 0; i < 4; i++)
+    {
+      uint64_t z = (x += UINT64_C(0x9e3779b97f4a7c15));
+      z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+      z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+      state->s[i] = z ^ (z >> 31);
+    }
+}
+
+static const gsl_rng_type xoshiro256starstar_type =
+{"xoshiro256starstar",          /* name */
+ 0xffffffffUL,                  /* RAND_MAX */
+ 0,                             /* RAND_MIN */
+ sizeof (xoshiro256_state_t),
+ &xoshiro256_set,
+ &xoshiro256starstar_get,
+ &xoshiro256starstar_get_double,
+ &xoshiro256starstar_get_array,
+ &xoshiro256starstar_get_double_array,
+ &xoshiro256_jump};
+
+static const gsl_rng_type xoshiro256plus_type =
+{"xoshiro256plus",              /* name */
+ 0xffffffffUL,                  /* RAND_MAX */
+ 0,                             /* RAND_MIN */
+ sizeof (xoshiro256_state_t),
+ &xoshiro256_set,
+ &xoshiro256plus_get,
+ &xoshiro256plus_get_double,
+ &xoshiro256plus_get_array,
+ &xoshiro256plus_get_double_array,
+ &xoshiro256_jump};
+
+const gsl_rng_type *gsl_rng_xoshiro256starstar = &xoshiro256starstar_type;
+const gsl_rng_type *gsl_rng_xoshiro256plus = &xoshiro256plus_type;
@@ -136,6 +136,9 @@ static const gsl_rng_type zuf_type =
  sizeof (zuf_state_t),
  &zuf_set,
  &zuf_get,
- &zuf_get_double};
+ &zuf_get_double,
+ NULL,
+ NULL,
+ NULL};
 
 const gsl_rng_type *gsl_rng_zuf = &zuf_type;
@@ -47,8 +47,17 @@ __BEGIN_DECLS
 int gsl_spblas_dgemv(const CBLAS_TRANSPOSE_t TransA, const double alpha,
                      const gsl_spmatrix *A, const gsl_vector *x,
                      const double beta, gsl_vector *y);
+int gsl_spblas_dspmm(const CBLAS_TRANSPOSE_t TransA, const double alpha,
+                     const gsl_spmatrix *A, const gsl_matrix *B,
+                     const double beta, gsl_matrix *C);
 int gsl_spblas_dgemm(const double alpha, const gsl_spmatrix *A,
                      const gsl_spmatrix *B, gsl_spmatrix *C);
+int gsl_spblas_dgemm_symbolic(const gsl_spmatrix *A, const gsl_spmatrix *B,
+                              gsl_spmatrix *C);
+int gsl_spblas_dgemm_numeric(const double alpha, const gsl_spmatrix *A,
+                             const gsl_spmatrix *B, gsl_spmatrix *C);
+int gsl_spblas_dgemm_ata(const double alpha, const gsl_spmatrix *A,
+                         gsl_spmatrix *C);
 size_t gsl_spblas_scatter(const gsl_spmatrix *A, const size_t j,
                           const double alpha, int *w, double *x,
                           const int mark, gsl_spmatrix *C, size_t nz);
@@ -36,12 +36,46 @@ Inputs: alpha - scalar factor
 Return: success or error
 
 Notes:
-1) based on CSparse routine cs_multiply
+1) C is computed in two phases: the symbolic phase computes the
+exact pattern of C, so that C is allocated once, and the numeric
+phase computes the values. When the product must be recomputed for
+matrices with unchanged patterns, call gsl_spblas_dgemm_numeric()
+directly.
 */
 
 int
 gsl_spblas_dgemm(const double alpha, const gsl_spmatrix *A,
                  const gsl_spmatrix *B, gsl_spmatrix *C)
+{
+  int status = gsl_spblas_dgemm_symbolic(A, B, C);
+
+  if (status)
+    return status;
+
+  return gsl_spblas_dgemm_numeric(alpha, A, B, C);
+} /* gsl_spblas_dgemm() */
+
+/*
+gsl_spblas_dgemm_symbolic()
+  Compute the sparsity pattern of the product C = A * B
+
+Inputs: A - sparse matrix
+        B - sparse matrix
+        C - (output) on output, C has the exact pattern of A * B,
+            with all values set to 0
+
+Return: success or error
+
+Notes:
+1) C is reallocated at most once, to the exact number of nonzeros
+of the product; the row indices in each column are not sorted
+
+2) based on the symbolic part of CSparse routine cs_multiply
+*/
+
+int
+gsl_spblas_dgemm_symbolic(const gsl_spmatrix *A, const gsl_spmatrix *B,
+                          gsl_spmatrix *C)
 {
   if (A->size2 != B->size1 || A->size1 != C->size1 || B->size2 != C->size2)
     {
@@ -57,72 +91,389 @@ gsl_spblas_dgemm(const double alpha, const gsl_spmatrix *A,
     }
   else
     {
-      int status = GSL_SUCCESS;
       const size_t M = A->size1;
       const size_t N = B->size2;
-      int *Bi = B->i;
-      int *Bp = B->p;
-      double *Bd = B->data;
-      int *w = A->work.work_int;      /* workspace of length M */
-      double *x = C->work.work_atomic; /* workspace of length M */
-      int *Cp, *Ci;
-      double *Cd;
-      size_t j;
-      int p;
+      const int *Ai = A->i;
+      const int *Ap = A->p;
+      const int *Bi = B->i;
+      const int *Bp = B->p;
+      int *w = A->work.work_int; /* workspace of length M */
+      int *Cp = C->p;
+      size_t i, j;
       size_t nz = 0;
+      int p, q;
+
+      /* first pass: count the nonzeros in each column of C */
+      for (i = 0; i < M; ++i)
+        w[i] = 0;
 
-      if (C->nzmax < A->nz + B->nz)
+      for (j = 0; j < N; ++j)
         {
-          status = gsl_spmatrix_realloc(A->nz + B->nz, C);
+          const int mark = (int) (j + 1);
+
+          Cp[j] = (int) nz;
+
+          for (p = Bp[j]; p < Bp[j + 1]; ++p)
+            {
+              const int k = Bi[p];
+
+              for (q = Ap[k]; q < Ap[k + 1]; ++q)
+                {
+                  if (w[Ai[q]] < mark)
+                    {
+                      w[Ai[q]] = mark;
+                      ++nz;
+                    }
+                }
+            }
+        }
+
+      Cp[N] = (int) nz;
+
+      C->nz = 0;
+      if (C->nzmax < nz)
+        {
+          int status = gsl_spmatrix_realloc(nz, C);
           if (status)
             {
               GSL_ERROR("unable to realloc matrix C", status);
             }
         }
 
-      /* initialize workspace to 0 */
-      for (j = 0; j < M; ++j)
-        w[j] = 0;
+      /* second pass: fill in the row indices */
+      for (i = 0; i < M; ++i)
+        w[i] = 0;
+
+      for (j = 0; j < N; ++j)
+        {
+          const int mark = (int) (j + 1);
+          int *Ci = C->i + Cp[j];
+
+          for (p = Bp[j]; p < Bp[j + 1]; ++p)
+            {
+              const int k = Bi[p];
+
+              for (q = Ap[k]; q < Ap[k + 1]; ++q)
+                {
+                  if (w[Ai[q]] < mark)
+                    {
+                      w[Ai[q]] = mark;
+                      *Ci++ = Ai[q];
+                    }
+                }
+            }
+        }
+
+      for (j = 0; j < nz; ++j)
+        C->data[j] = 0.0;
+
+      C->nz = nz;
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spblas_dgemm_symbolic() */
+
+/*
+gsl_spblas_dgemm_numeric()
+  Compute the values of the product C = alpha * A * B, where the
+pattern of C has been computed by gsl_spblas_dgemm_symbolic()
+
+Inputs: alpha - scalar factor
+        A     - sparse matrix
+        B     - sparse matrix
+        C     - (input/output) on input, C contains the pattern of
+                A * B; on output, C = alpha * A * B
+
+Return: success or error
+
+Notes:
+1) A and B may have different values, but must have the same
+patterns, as the matrices given to gsl_spblas_dgemm_symbolic()
+
+2) Each column of C depends only on the corresponding column of B
+and is accumulated in a dense vector, which is reset only at the
+pattern of that column. Columns may therefore be computed
+independently of each other.
+*/
+
+int
+gsl_spblas_dgemm_numeric(const double alpha, const gsl_spmatrix *A,
+                         const gsl_spmatrix *B, gsl_spmatrix *C)
+{
+  if (A->size2 != B->size1 || A->size1 != C->size1 || B->size2 != C->size2)
+    {
+      GSL_ERROR("matrix dimensions do not match", GSL_EBADLEN);
+    }
+  else if (A->sptype != B->sptype || A->sptype != C->sptype)
+    {
+      GSL_ERROR("matrix storage formats do not match", GSL_EINVAL);
+    }
+  else if (!GSL_SPMATRIX_ISCCS(A))
+    {
+      GSL_ERROR("compressed column format required", GSL_EINVAL);
+    }
+  else if ((size_t) C->p[C->size2] != C->nz)
+    {
+      GSL_ERROR("matrix C does not contain a valid pattern", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t N = B->size2;
+      const int *Ai = A->i;
+      const int *Ap = A->p;
+      const double *Ad = A->data;
+      const int *Bi = B->i;
+      const int *Bp = B->p;
+      const double *Bd = B->data;
+      const int *Ci = C->i;
+      const int *Cp = C->p;
+      double *Cd = C->data;
+      double *x = C->work.work_atomic; /* workspace of length M */
+      size_t j;
+      int p, q;
+
+      for (j = 0; j < N; ++j)
+        {
+          for (p = Cp[j]; p < Cp[j + 1]; ++p)
+            x[Ci[p]] = 0.0;
+
+          /* x = A * B(:,j) */
+          for (p = Bp[j]; p < Bp[j + 1]; ++p)
+            {
+              const int k = Bi[p];
+              const double bkj = Bd[p];
+
+              for (q = Ap[k]; q < Ap[k + 1]; ++q)
+                x[Ai[q]] += Ad[q] * bkj;
+            }
+
+          for (p = Cp[j]; p < Cp[j + 1]; ++p)
+            Cd[p] = alpha * x[Ci[p]];
+        }
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spblas_dgemm_numeric() */
+
+/*
+gsl_spblas_dgemm_ata()
+  Compute the symmetric product C = alpha * A^T * A
+
+Inputs: alpha - scalar factor
+        A     - sparse matrix in compressed column format, M-by-N
+        C     - (output) C = alpha * A^T * A, N-by-N, compressed column
+
+Return: success or error
+
+Notes:
+1) The rows of A are formed once in temporary index arrays, instead
+of building A^T as a separate matrix and multiplying. Only the lower
+triangle of the product is computed; each element C(i,j), i > j, is
+also stored as C(j,i). This halves the number of floating point
+operations compared to gsl_spblas_dgemm().
+
+2) Column j of the lower triangle is
+
+   C(j:N,j) = sum_k A(k,j) A(k,j:N)^T
+
+summed over the rows k of column j. The column indices of each row of
+A are sorted, so the position of the first column >= j in each row
+only advances as j increases.
+
+3) In column i of C, the elements above the diagonal are stored first
+in increasing row order, followed by the elements of the lower triangle
+*/
+
+int
+gsl_spblas_dgemm_ata(const double alpha, const gsl_spmatrix *A,
+                     gsl_spmatrix *C)
+{
+  if (A->size2 != C->size1 || A->size2 != C->size2)
+    {
+      GSL_ERROR("matrix dimensions do not match", GSL_EBADLEN);
+    }
+  else if (A->sptype != C->sptype)
+    {
+      GSL_ERROR("matrix storage formats do not match", GSL_EINVAL);
+    }
+  else if (!GSL_SPMATRIX_ISCCS(A))
+    {
+      GSL_ERROR("compressed column format required", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t M = A->size1;
+      const size_t N = A->size2;
+      const size_t nzA = A->nz;
+      const int *Ai = A->i;
+      const int *Ap = A->p;
+      const double *Ad = A->data;
+      int *Cp = C->p;
+      int *Tp, *Tj, *first, *w, *upper, *lower;
+      double *Tx, *x = C->work.work_atomic;
+      size_t i, j;
+      size_t nz = 0;
+      int p, q;
+
+      Tp = malloc((2 * M + 1 + nzA + 3 * N) * sizeof(int));
+      Tx = malloc((nzA + 1) * sizeof(double));
+      if (!Tp || !Tx)
+        {
+          free(Tp);
+          free(Tx);
+          GSL_ERROR("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      first = Tp + M + 1;  /* first[k]: position of first column >= j in row k */
+      Tj = first + M;
+      w = Tj + nzA;        /* length N */
+      upper = w + N;       /* number of elements above the diagonal in each column */
+      lower = upper + N;   /* insertion point of the lower triangle in each column */
+
+      /* rows of A, with sorted column indices */
+      for (i = 0; i <= M; ++i)
+        Tp[i] = 0;
+
+      for (p = 0; p < (int) nzA; ++p)
+        Tp[Ai[p] + 1]++;
+
+      for (i = 0; i < M; ++i)
+        Tp[i + 1] += Tp[i];
+
+      for (i = 0; i < M; ++i)
+        first[i] = Tp[i];
+
+      for (j = 0; j < N; ++j)
+        {
+          for (p = Ap[j]; p < Ap[j + 1]; ++p)
+            {
+              q = first[Ai[p]]++;
+              Tj[q] = (int) j;
+              Tx[q] = Ad[p];
+            }
+        }
+
+      /* symbolic: count the lower triangle of each column, and its transpose */
+      for (j = 0; j < N; ++j)
+        {
+          w[j] = -1;
+          upper[j] = 0;
+        }
 
-      Cp = C->p;
-      Ci = C->i;
-      Cd = C->data;
+      for (i = 0; i < M; ++i)
+        first[i] = Tp[i];
 
       for (j = 0; j < N; ++j)
         {
-          if (nz + M > C->nzmax)
+          int cnt = 0;
+
+          for (p = Ap[j]; p < Ap[j + 1]; ++p)
             {
-              status = gsl_spmatrix_realloc(2 * C->nzmax + M, C);
-              if (status)
+              const int k = Ai[p];
+
+              while (Tj[first[k]] < (int) j)
+                ++first[k];
+
+              for (q = first[k]; q < Tp[k + 1]; ++q)
                 {
-                  GSL_ERROR("unable to realloc matrix C", status);
+                  const int c = Tj[q];
+
+                  if (w[c] != (int) j)
+                    {
+                      w[c] = (int) j;
+                      ++cnt;
+
+                      if (c != (int) j)
+                        upper[c]++;
+                    }
                 }
+            }
 
-              /* these pointers could have changed due to reallocation */
-              Ci = C->i;
-              Cd = C->data;
+          lower[j] = cnt;
+        }
+
+      for (j = 0; j < N; ++j)
+        {
+          Cp[j] = (int) nz;
+          nz += upper[j] + lower[j];
+        }
+
+      Cp[N] = (int) nz;
+
+      C->nz = 0;
+      if (C->nzmax < nz)
+        {
+          int status = gsl_spmatrix_realloc(nz, C);
+          if (status)
+            {
+              free(Tp);
+              free(Tx);
+              GSL_ERROR("unable to realloc matrix C", status);
             }
+        }
+
+      /* numeric: compute the lower triangle and mirror it */
+      for (j = 0; j < N; ++j)
+        {
+          lower[j] = Cp[j] + upper[j];
+          upper[j] = Cp[j];
+          w[j] = -1;
+        }
 
-          Cp[j] = nz; /* column j of C starts here */
+      for (i = 0; i < M; ++i)
+        first[i] = Tp[i];
 
-          for (p = Bp[j]; p < Bp[j + 1]; ++p)
+      for (j = 0; j < N; ++j)
+        {
+          const int start = lower[j];
+
+          for (p = Ap[j]; p < Ap[j + 1]; ++p)
             {
-              nz = gsl_spblas_scatter(A, Bi[p], Bd[p], w, x, (int) (j + 1), C, nz);
+              const int k = Ai[p];
+              const double akj = Ad[p];
+
+              while (Tj[first[k]] < (int) j)
+                ++first[k];
+
+              for (q = first[k]; q < Tp[k + 1]; ++q)
+                {
+                  const int c = Tj[q];
+
+                  if (w[c] != (int) j)
+                    {
+                      w[c] = (int) j;
+                      C->i[lower[j]++] = c;
+                      x[c] = 0.0;
+                    }
+
+                  x[c] += akj * Tx[q];
+                }
             }
 
-          for (p = Cp[j]; p < (int) nz; ++p)
-            Cd[p] = x[Ci[p]];
+          for (p = start; p < lower[j]; ++p)
+            {
+              const int c = C->i[p];
+              const double val = alpha * x[c];
+
+              C->data[p] = val;
+
+              if (c != (int) j)
+                {
+                  q = upper[c]++;
+                  C->i[q] = (int) j;
+                  C->data[q] = val;
+                }
+            }
         }
 
-      Cp[N] = nz;
       C->nz = nz;
 
-      /* scale by alpha */
-      gsl_spmatrix_scale(C, alpha);
+      free(Tp);
+      free(Tx);
 
-      return status;
+      return GSL_SUCCESS;
     }
-} /* gsl_spblas_dgemm() */
+} /* gsl_spblas_dgemm_ata() */
 
 /*
 gsl_spblas_scatter()
@@ -153,7 +504,7 @@ necessarily in order - ie: the row indices C->i may not be in ascending order.
 */
 
 size_t
-gsl_spblas_scatterer(const gsl_spmatrix *A, const size_t j, const double alpha,
+gsl_spblas_scatter(const gsl_spmatrix *A, const size_t j, const double alpha,
                    int *w, double *x, const int mark, gsl_spmatrix *C,
                    size_t nz)
 {
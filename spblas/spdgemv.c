@@ -157,6 +157,96 @@ gsl_spblas_dgemv(const CBLAS_TRANSPOSE_t TransA, const double alpha,
               Y[Ai[p] * incY] += alpha * Ad[p] * X[Aj[p] * incX];
             }
         }
+      else if (GSL_SPMATRIX_ISBSR(A))
+        {
+          const size_t b = A->block_size;
+          const size_t bs2 = b * b;
+          const size_t nb1 = M / b;
+          size_t r, c;
+
+          Ai = A->i;
+
+          for (j = 0; j < nb1; ++j)
+            {
+              for (p = Ap[j]; p < Ap[j + 1]; ++p)
+                {
+                  const double *Bk = Ad + p * bs2; /* dense block, row-major */
+                  const size_t row0 = j * b;
+                  const size_t col0 = Ai[p] * b;
+
+                  if (TransA == CblasNoTrans)
+                    {
+                      for (r = 0; r < b; ++r)
+                        {
+                          double sum = 0.0;
+
+                          for (c = 0; c < b; ++c)
+                            sum += Bk[r * b + c] * X[(col0 + c) * incX];
+
+                          Y[(row0 + r) * incY] += alpha * sum;
+                        }
+                    }
+                  else
+                    {
+                      for (r = 0; r < b; ++r)
+                        {
+                          const double xr = alpha * X[(row0 + r) * incX];
+
+                          for (c = 0; c < b; ++c)
+                            Y[(col0 + c) * incY] += Bk[r * b + c] * xr;
+                        }
+                    }
+                }
+            }
+        }
+      else if (GSL_SPMATRIX_ISSELL(A))
+        {
+          const size_t C = A->block_size;
+          const size_t nslices = (M + C - 1) / C;
+          const int *perm = A->perm;
+          size_t s, r, k;
+
+          Ai = A->i;
+
+          for (s = 0; s < nslices; ++s)
+            {
+              const size_t width = (Ap[s + 1] - Ap[s]) / C;
+              const size_t nlanes = GSL_MIN(C, M - s * C);
+              const double *Sd = Ad + Ap[s];
+              const int *Si = Ai + Ap[s];
+
+              if (TransA == CblasNoTrans)
+                {
+                  /*
+                   * accumulate all lanes of the slice together; the inner
+                   * loop runs over C contiguous elements
+                   */
+                  double *sum = A->work.work_atomic;
+
+                  for (r = 0; r < C; ++r)
+                    sum[r] = 0.0;
+
+                  for (k = 0; k < width; ++k)
+                    {
+                      for (r = 0; r < C; ++r)
+                        sum[r] += Sd[k * C + r] * X[Si[k * C + r] * incX];
+                    }
+
+                  for (r = 0; r < nlanes; ++r)
+                    Y[perm[s * C + r] * incY] += alpha * sum[r];
+                }
+              else
+                {
+                  for (r = 0; r < nlanes; ++r)
+                    {
+                      const double xr = alpha * X[perm[s * C + r] * incX];
+
+                      for (k = 0; k < width; ++k)
+                        Y[Si[k * C + r] * incY] += Sd[k * C + r] * xr;
+                    }
+                }
+            }
+        }
       else
         {
           GSL_ERROR("unsupported matrix type", GSL_EINVAL);
@@ -0,0 +1,223 @@
+/* spdspmm.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_blas.h>
+
+/*
+ * number of columns of the dense block accumulated together in the
+ * gather kernel; the accumulators are kept in registers and the inner
+ * loop over them is vectorized by the compiler
+ */
+#define SPMM_BLOCK 8
+
+static void spmm_gather(const size_t nouter, const int *Ap, const int *Ai,
+                        const double *Ad, const double alpha,
+                        const double *B, const size_t tdb, const size_t ncols,
+                        double *C, const size_t tdc);
+static void spmm_scatter(const size_t nouter, const int *Ap, const int *Ai,
+                         const double *Ad, const double alpha,
+                         const double *B, const size_t tdb, const size_t ncols,
+                         double *C, const size_t tdc);
+
+/*
+gsl_spblas_dspmm()
+  Multiply a sparse matrix and a dense matrix
+
+Inputs: TransA - op(A) = A or A^T
+        alpha  - scalar factor
+        A      - sparse matrix in COO, CSC or CSR format
+        B      - dense matrix
+        beta   - scalar factor
+        C      - (input/output) dense matrix, must not overlap B
+
+Return: C = alpha*op(A)*B + beta*C
+
+Notes:
+1) Each nonzero of A is loaded once and applied to a whole row of B,
+which is contiguous in memory, instead of once per column as with
+repeated calls to gsl_spblas_dgemv()
+
+2) When op(A) is accessed by rows (CSR with A, CSC with A^T), each row
+of C is computed independently of the others
+*/
+
+int
+gsl_spblas_dspmm(const CBLAS_TRANSPOSE_t TransA, const double alpha,
+                 const gsl_spmatrix *A, const gsl_matrix *B,
+                 const double beta, gsl_matrix *C)
+{
+  const size_t M = (TransA == CblasNoTrans) ? A->size1 : A->size2;
+  const size_t K = (TransA == CblasNoTrans) ? A->size2 : A->size1;
+
+  if (B->size1 != K)
+    {
+      GSL_ERROR("B matrix dimensions do not match op(A)", GSL_EBADLEN);
+    }
+  else if (C->size1 != M || C->size2 != B->size2)
+    {
+      GSL_ERROR("C matrix dimensions do not match", GSL_EBADLEN);
+    }
+  else if (!GSL_SPMATRIX_ISCOO(A) && !GSL_SPMATRIX_ISCSC(A) && !GSL_SPMATRIX_ISCSR(A))
+    {
+      GSL_ERROR("matrix must be in COO, CSC or CSR format", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t ncols = B->size2;
+      const double *Bd = B->data;
+      double *Cd = C->data;
+      size_t i;
+
+      /* form C := beta*C */
+      if (beta == 0.0)
+        {
+          gsl_matrix_set_zero(C);
+        }
+      else if (beta != 1.0)
+        {
+          gsl_matrix_scale(C, beta);
+        }
+
+      if (alpha == 0.0 || ncols == 0)
+        return GSL_SUCCESS;
+
+      /* form C := alpha*op(A)*B + C */
+      if ((GSL_SPMATRIX_ISCSR(A) && TransA == CblasNoTrans) ||
+          (GSL_SPMATRIX_ISCSC(A) && TransA == CblasTrans))
+        {
+          spmm_gather(M, A->p, A->i, A->data, alpha, Bd, B->tda, ncols, Cd, C->tda);
+        }
+      else if ((GSL_SPMATRIX_ISCSC(A) && TransA == CblasNoTrans) ||
+               (GSL_SPMATRIX_ISCSR(A) && TransA == CblasTrans))
+        {
+          spmm_scatter(K, A->p, A->i, A->data, alpha, Bd, B->tda, ncols, Cd, C->tda);
+        }
+      else
+        {
+          const int *Ai = (TransA == CblasNoTrans) ? A->i : A->p;
+          const int *Aj = (TransA == CblasNoTrans) ? A->p : A->i;
+
+          for (i = 0; i < A->nz; ++i)
+            {
+              const double a = alpha * A->data[i];
+              const double *Bj = Bd + Aj[i] * B->tda;
+              double *Ci = Cd + Ai[i] * C->tda;
+              size_t k;
+
+              for (k = 0; k < ncols; ++k)
+                Ci[k] += a * Bj[k];
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spblas_dspmm() */
+
+/*
+spmm_gather()
+  C(i,:) += alpha * sum_p Ad[p] * B(Ai[p],:), for rows i stored as
+the outer vectors of a compressed matrix
+*/
+
+static void
+spmm_gather(const size_t nouter, const int *Ap, const int *Ai,
+            const double *Ad, const double alpha,
+            const double *B, const size_t tdb, const size_t ncols,
+            double *C, const size_t tdc)
+{
+  size_t i, k, t;
+  int p;
+
+  for (i = 0; i < nouter; ++i)
+    {
+      double *Ci = C + i * tdc;
+
+      for (k = 0; k + SPMM_BLOCK <= ncols; k += SPMM_BLOCK)
+        {
+          double acc[SPMM_BLOCK];
+
+          for (t = 0; t < SPMM_BLOCK; ++t)
+            acc[t] = 0.0;
+
+          for (p = Ap[i]; p < Ap[i + 1]; ++p)
+            {
+              const double a = Ad[p];
+              const double *Bj = B + Ai[p] * tdb + k;
+
+              for (t = 0; t < SPMM_BLOCK; ++t)
+                acc[t] += a * Bj[t];
+            }
+
+          for (t = 0; t < SPMM_BLOCK; ++t)
+            Ci[k + t] += alpha * acc[t];
+        }
+
+      /* remaining columns */
+      if (k < ncols)
+        {
+          for (p = Ap[i]; p < Ap[i + 1]; ++p)
+            {
+              const double a = alpha * Ad[p];
+              const double *Bj = B + Ai[p] * tdb;
+
+              for (t = k; t < ncols; ++t)
+                Ci[t] += a * Bj[t];
+            }
+        }
+    }
+}
+
+/*
+spmm_scatter()
+  C(Ai[p],:) += alpha * Ad[p] * B(j,:), for rows j of B stored as the
+outer vectors of a compressed matrix
+*/
+
+static void
+spmm_scatter(const size_t nouter, const int *Ap, const int *Ai,
+             const double *Ad, const double alpha,
+             const double *B, const size_t tdb, const size_t ncols,
+             double *C, const size_t tdc)
+{
+  size_t j, k;
+  int p;
+
+  for (j = 0; j < nouter; ++j)
+    {
+      const double *Bj = B + j * tdb;
+
+      for (p = Ap[j]; p < Ap[j + 1]; ++p)
+        {
+          const double a = alpha * Ad[p];
+          double *Ci = C + Ai[p] * tdc;
+
+          for (k = 0; k < ncols; ++k)
+            Ci[k] += a * Bj[k];
+        }
+    }
+}
@@ -166,6 +166,33 @@ test_dgemv(const size_t N, const size_t M, const double alpha,
   /* test y_sp = y_gsl */
   test_vectors(y_sp, y_gsl, 1.0e-10, "test_dgemv: CRS format");
 
+  /* compute y = alpha*op(A)*x + beta*y0 with spblas/SELL */
+  {
+    gsl_spmatrix *S = gsl_spmatrix_alloc_sell(M, N, 1, 4, 8);
+
+    gsl_spmatrix_sell(S, C);
+    gsl_vector_memcpy(y_sp, y);
+    gsl_spblas_dgemv(TransA, alpha, S, x, beta, y_sp);
+
+    test_vectors(y_sp, y_gsl, 1.0e-10, "test_dgemv: SELL format");
+
+    gsl_spmatrix_free(S);
+  }
+
+  /* compute y = alpha*op(A)*x + beta*y0 with spblas/BSR */
+  {
+    const size_t b = (M % 3 == 0 && N % 3 == 0) ? 3 : ((M % 2 == 0 && N % 2 == 0) ? 2 : 1);
+    gsl_spmatrix *S = gsl_spmatrix_alloc_bsr(M, N, 1, b);
+
+    gsl_spmatrix_bsr(S, C);
+    gsl_vector_memcpy(y_sp, y);
+    gsl_spblas_dgemv(TransA, alpha, S, x, beta, y_sp);
+
+    test_vectors(y_sp, y_gsl, 1.0e-10, "test_dgemv: BSR format");
+
+    gsl_spmatrix_free(S);
+  }
+
   gsl_spmatrix_free(A);
   gsl_spmatrix_free(B);
   gsl_spmatrix_free(C);
@@ -217,6 +244,31 @@ test_dgemm(const double alpha, const size_t M, const size_t N,
             }
         }
 
+      /* recompute with new values and the same patterns */
+      for (i = 0; i < A->nz; ++i)
+        A->data[i] = gsl_rng_uniform(r);
+
+      for (i = 0; i < B->nz; ++i)
+        B->data[i] = gsl_rng_uniform(r);
+
+      gsl_spblas_dgemm_numeric(alpha, A, B, C);
+
+      gsl_spmatrix_sp2d(&Ad.matrix, A);
+      gsl_spmatrix_sp2d(&Bd.matrix, B);
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, alpha, &Ad.matrix,
+                     &Bd.matrix, 0.0, C_dense);
+
+      for (i = 0; i < M; ++i)
+        {
+          for (j = 0; j < N; ++j)
+            {
+              double Cij = gsl_spmatrix_get(C, i, j);
+              double Dij = gsl_matrix_get(C_dense, i, j);
+
+              gsl_test_rel(Cij, Dij, 1.0e-12, "test_dgemm: _dgemm_numeric");
+            }
+        }
+
       gsl_spmatrix_free(TA);
       gsl_spmatrix_free(TB);
       gsl_spmatrix_free(A);
@@ -229,6 +281,116 @@ test_dgemm(const double alpha, const size_t M, const size_t N,
   gsl_matrix_free(C_dense);
 } /* test_dgemm() */
 
+static void
+test_dgemm_ata(const double alpha, const size_t M, const size_t N,
+               const gsl_rng *r)
+{
+  gsl_spmatrix *TA = create_random_sparse(M, N, 0.2, r);
+  gsl_spmatrix *A = gsl_spmatrix_ccs(TA);
+  gsl_spmatrix *C = gsl_spmatrix_alloc_nzmax(N, N, 1, GSL_SPMATRIX_CCS);
+  gsl_matrix *A_dense = gsl_matrix_alloc(M, N);
+  gsl_matrix *C_dense = gsl_matrix_alloc(N, N);
+  size_t i, j;
+
+  gsl_spblas_dgemm_ata(alpha, A, C);
+
+  gsl_spmatrix_sp2d(A_dense, TA);
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, alpha, A_dense, A_dense, 0.0, C_dense);
+
+  for (i = 0; i < N; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          double Cij = gsl_spmatrix_get(C, i, j);
+          double Dij = gsl_matrix_get(C_dense, i, j);
+
+          gsl_test_rel(Cij, Dij, 1.0e-12, "test_dgemm_ata: M=%zu N=%zu i=%zu j=%zu",
+                       M, N, i, j);
+        }
+    }
+
+  /* compare the pattern with the general product */
+  {
+    gsl_spmatrix *AT = gsl_spmatrix_alloc_nzmax(N, M, A->nz, GSL_SPMATRIX_CCS);
+    gsl_spmatrix *D = gsl_spmatrix_alloc_nzmax(N, N, 1, GSL_SPMATRIX_CCS);
+
+    gsl_spmatrix_transpose_memcpy(AT, A);
+    gsl_spblas_dgemm(alpha, AT, A, D);
+
+    gsl_test(C->nz != D->nz, "test_dgemm_ata: M=%zu N=%zu nnz=%zu expected=%zu",
+             M, N, C->nz, D->nz);
+
+    gsl_spmatrix_free(AT);
+    gsl_spmatrix_free(D);
+  }
+
+  gsl_spmatrix_free(TA);
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(C);
+  gsl_matrix_free(A_dense);
+  gsl_matrix_free(C_dense);
+} /* test_dgemm_ata() */
+
+static void
+test_dspmm(const size_t M, const size_t N, const size_t ncols, const double alpha,
+           const double beta, const CBLAS_TRANSPOSE_t TransA, const gsl_rng *r)
+{
+  gsl_spmatrix *A = create_random_sparse(M, N, 0.2, r);
+  gsl_spmatrix *S[3];
+  const char *names[] = { "triplet", "CCS", "CRS" };
+  const size_t lenX = (TransA == CblasNoTrans) ? N : M;
+  const size_t lenY = (TransA == CblasNoTrans) ? M : N;
+  gsl_matrix *A_dense = gsl_matrix_alloc(M, N);
+  gsl_matrix *B = gsl_matrix_alloc(lenX, ncols);
+  gsl_matrix *C0 = gsl_matrix_alloc(lenY, ncols);
+  gsl_matrix *C_gsl = gsl_matrix_alloc(lenY, ncols);
+  gsl_matrix *C_sp = gsl_matrix_alloc(lenY, ncols);
+  size_t i, j, k;
+
+  for (i = 0; i < lenX; ++i)
+    for (j = 0; j < ncols; ++j)
+      gsl_matrix_set(B, i, j, gsl_rng_uniform(r));
+
+  for (i = 0; i < lenY; ++i)
+    for (j = 0; j < ncols; ++j)
+      gsl_matrix_set(C0, i, j, gsl_rng_uniform(r));
+
+  gsl_spmatrix_sp2d(A_dense, A);
+
+  /* C = alpha*op(A)*B + beta*C0 with gsl */
+  gsl_matrix_memcpy(C_gsl, C0);
+  gsl_blas_dgemm(TransA, CblasNoTrans, alpha, A_dense, B, beta, C_gsl);
+
+  S[0] = A;
+  S[1] = gsl_spmatrix_ccs(A);
+  S[2] = gsl_spmatrix_crs(A);
+
+  for (k = 0; k < 3; ++k)
+    {
+      gsl_matrix_memcpy(C_sp, C0);
+      gsl_spblas_dspmm(TransA, alpha, S[k], B, beta, C_sp);
+
+      for (i = 0; i < lenY; ++i)
+        {
+          for (j = 0; j < ncols; ++j)
+            {
+              gsl_test_rel(gsl_matrix_get(C_sp, i, j), gsl_matrix_get(C_gsl, i, j), 1.0e-10,
+                           "test_dspmm: %s format M=%zu N=%zu ncols=%zu trans=%d (%zu,%zu)",
+                           names[k], M, N, ncols, TransA, i, j);
+            }
+        }
+    }
+
+  gsl_spmatrix_free(S[0]);
+  gsl_spmatrix_free(S[1]);
+  gsl_spmatrix_free(S[2]);
+  gsl_matrix_free(A_dense);
+  gsl_matrix_free(B);
+  gsl_matrix_free(C0);
+  gsl_matrix_free(C_gsl);
+  gsl_matrix_free(C_sp);
+} /* test_dspmm() */
+
 int
 main()
 {
@@ -251,11 +413,30 @@ main()
         }
     }
 
+  for (m = 1; m <= N_max; m += 7)
+    {
+      for (n = 1; n <= N_max; n += 5)
+        {
+          test_dspmm(m, n, 1, 1.0, 0.0, CblasNoTrans, r);
+          test_dspmm(m, n, 3, 2.4, -0.5, CblasNoTrans, r);
+          test_dspmm(m, n, 3, 2.4, -0.5, CblasTrans, r);
+          test_dspmm(m, n, 8, 0.1, 10.0, CblasNoTrans, r);
+          test_dspmm(m, n, 19, -1.3, 1.0, CblasNoTrans, r);
+          test_dspmm(m, n, 19, -1.3, 0.0, CblasTrans, r);
+        }
+    }
+
   test_dgemm(1.0, 10, 10, r);
   test_dgemm(2.3, 20, 15, r);
   test_dgemm(1.8, 12, 30, r);
   test_dgemm(0.4, 45, 35, r);
 
+  for (m = 1; m <= N_max; m += 3)
+    {
+      for (n = 1; n <= N_max; n += 3)
+        test_dgemm_ata(1.7, m, n, r);
+    }
+
   gsl_rng_free(r);
 
   exit (gsl_test_summary());
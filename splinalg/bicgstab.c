@@ -0,0 +1,317 @@
+/* bicgstab.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * The code in this module implements the right preconditioned
+ * BiCGStab method for general nonsymmetric systems, see
+ *
+ * [1] H. A. van der Vorst, Bi-CGSTAB: A fast and smoothly converging
+ *     variant of Bi-CG for the solution of nonsymmetric linear systems,
+ *     SIAM J. Sci. Stat. Comput. 13(2), 1992.
+ *
+ * [2] Y. Saad, Iterative methods for sparse linear systems,
+ *     2nd edition, SIAM, 2003, algorithm 7.7.
+ */
+
+typedef struct
+{
+  size_t n;        /* size of linear system */
+  size_t maxit;    /* maximum iterations per call to iterate */
+  gsl_vector *r;   /* residual vector r = b - A*x */
+  gsl_vector *r0;  /* shadow residual */
+  gsl_vector *p;   /* search direction */
+  gsl_vector *v;   /* v = A*M^{-1}*p */
+  gsl_vector *s;   /* intermediate residual */
+  gsl_vector *t;   /* t = A*M^{-1}*s */
+  gsl_vector *z;   /* preconditioned vector */
+
+  double normr;    /* residual norm ||r|| */
+} bicgstab_state_t;
+
+static void bicgstab_free(void *vstate);
+static int bicgstab_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+                            const double tol, gsl_vector *x,
+                            const gsl_splinalg_precon *P,
+                            gsl_splinalg_history *h, void *vstate);
+
+#include "common.c"
+
+/*
+bicgstab_alloc()
+  Allocate a BiCGStab workspace for solving an n-by-n system A x = b
+
+Inputs: n - size of system
+        m - maximum number of iterations performed by each call
+            to iterate; if 0, the value n is used
+
+Return: pointer to workspace
+*/
+
+static void *
+bicgstab_alloc(const size_t n, const size_t m)
+{
+  bicgstab_state_t *state;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  state = calloc(1, sizeof(bicgstab_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate bicgstab state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+  state->maxit = (m == 0) ? n : m;
+
+  state->r = gsl_vector_alloc(n);
+  state->r0 = gsl_vector_alloc(n);
+  state->p = gsl_vector_alloc(n);
+  state->v = gsl_vector_alloc(n);
+  state->s = gsl_vector_alloc(n);
+  state->t = gsl_vector_alloc(n);
+  state->z = gsl_vector_alloc(n);
+  if (!state->r || !state->r0 || !state->p || !state->v ||
+      !state->s || !state->t || !state->z)
+    {
+      bicgstab_free(state);
+      GSL_ERROR_NULL("failed to allocate bicgstab vectors", GSL_ENOMEM);
+    }
+
+  state->normr = 0.0;
+
+  return state;
+} /* bicgstab_alloc() */
+
+static void
+bicgstab_free(void *vstate)
+{
+  bicgstab_state_t *state = (bicgstab_state_t *) vstate;
+
+  if (state->r)
+    gsl_vector_free(state->r);
+
+  if (state->r0)
+    gsl_vector_free(state->r0);
+
+  if (state->p)
+    gsl_vector_free(state->p);
+
+  if (state->v)
+    gsl_vector_free(state->v);
+
+  if (state->s)
+    gsl_vector_free(state->s);
+
+  if (state->t)
+    gsl_vector_free(state->t);
+
+  if (state->z)
+    gsl_vector_free(state->z);
+
+  free(state);
+} /* bicgstab_free() */
+
+/*
+bicgstab_iterate()
+  Solve A*x = b using the BiCGStab method
+
+Inputs: A    - sparse square matrix
+        b    - right hand side vector
+        tol  - stopping tolerance
+        x    - (input/output) on input, initial estimate x_0;
+               on output, solution vector
+        P    - right preconditioner M, or NULL
+        h    - (output) iteration count and residual history
+        work - workspace
+
+Return:
+GSL_SUCCESS if ||b - A*x|| <= tol * ||b||, GSL_CONTINUE if the
+maximum number of iterations was reached or the method broke down.
+In the latter case calling this function again restarts the method
+from the current x with a new shadow residual.
+*/
+
+static int
+bicgstab_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+                 const double tol, gsl_vector *x,
+                 const gsl_splinalg_precon *P,
+                 gsl_splinalg_history *h, void *vstate)
+{
+  const size_t N = A->size1;
+  bicgstab_state_t *state = (bicgstab_state_t *) vstate;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (N != b->size)
+    {
+      GSL_ERROR("matrix does not match right hand side", GSL_EBADLEN);
+    }
+  else if (N != x->size)
+    {
+      GSL_ERROR("matrix does not match solution vector", GSL_EBADLEN);
+    }
+  else if (N != state->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      const double normb = gsl_blas_dnrm2(b);
+      const double reltol = tol * normb;
+      gsl_vector *r = state->r;
+      gsl_vector *r0 = state->r0;
+      gsl_vector *p = state->p;
+      gsl_vector *v = state->v;
+      gsl_vector *s = state->s;
+      gsl_vector *t = state->t;
+      gsl_vector *z = state->z;
+      double rho, rho_old, alpha, beta, omega, tmp, tt;
+      double normr;
+      size_t k;
+
+      /* r = b - A*x_0, choose shadow residual r0 = r */
+      gsl_vector_memcpy(r, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r);
+      normr = gsl_blas_dnrm2(r);
+
+      if (normr <= reltol)
+        {
+          state->normr = normr;
+          return GSL_SUCCESS;
+        }
+
+      gsl_vector_memcpy(r0, r);
+      gsl_vector_memcpy(p, r);
+      gsl_blas_ddot(r0, r, &rho);
+
+      for (k = 0; k < state->maxit; ++k)
+        {
+          /* v = A*M^{-1}*p */
+          status = splinalg_precon(P, p, z);
+          if (status)
+            return status;
+
+          gsl_spblas_dgemv(CblasNoTrans, 1.0, A, z, 0.0, v);
+
+          gsl_blas_ddot(r0, v, &tmp);
+          if (tmp == 0.0)
+            break; /* breakdown */
+
+          alpha = rho / tmp;
+
+          /* x = x + alpha*M^{-1}*p, s = r - alpha*v */
+          gsl_blas_daxpy(alpha, z, x);
+          gsl_vector_memcpy(s, r);
+          gsl_blas_daxpy(-alpha, v, s);
+
+          normr = gsl_blas_dnrm2(s);
+          if (normr <= reltol)
+            {
+              splinalg_history_add(h, normr);
+              break;
+            }
+
+          /* t = A*M^{-1}*s */
+          status = splinalg_precon(P, s, z);
+          if (status)
+            return status;
+
+          gsl_spblas_dgemv(CblasNoTrans, 1.0, A, z, 0.0, t);
+
+          gsl_blas_ddot(t, t, &tt);
+          if (tt == 0.0)
+            {
+              splinalg_history_add(h, normr);
+              break;
+            }
+
+          gsl_blas_ddot(t, s, &tmp);
+          omega = tmp / tt;
+
+          /* x = x + omega*M^{-1}*s, r = s - omega*t */
+          gsl_blas_daxpy(omega, z, x);
+          gsl_vector_memcpy(r, s);
+          gsl_blas_daxpy(-omega, t, r);
+
+          normr = gsl_blas_dnrm2(r);
+          splinalg_history_add(h, normr);
+
+          if (normr <= reltol || omega == 0.0)
+            break;
+
+          rho_old = rho;
+          gsl_blas_ddot(r0, r, &rho);
+          if (rho == 0.0)
+            break; /* breakdown */
+
+          /* p = r + beta*(p - omega*v) */
+          beta = (rho / rho_old) * (alpha / omega);
+          gsl_blas_daxpy(-omega, v, p);
+          gsl_vector_scale(p, beta);
+          gsl_vector_add(p, r);
+        }
+
+      /* compute true residual r = b - A*x */
+      gsl_vector_memcpy(r, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r);
+      normr = gsl_blas_dnrm2(r);
+
+      state->normr = normr;
+
+      if (normr <= reltol)
+        return GSL_SUCCESS;
+      else
+        return GSL_CONTINUE;
+    }
+} /* bicgstab_iterate() */
+
+static double
+bicgstab_normr(const void *vstate)
+{
+  const bicgstab_state_t *state = (const bicgstab_state_t *) vstate;
+  return state->normr;
+} /* bicgstab_normr() */
+
+static const gsl_splinalg_itersolve_type bicgstab_type =
+{
+  "bicgstab",
+  &bicgstab_alloc,
+  &bicgstab_iterate,
+  &bicgstab_normr,
+  &bicgstab_free
+};
+
+const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_bicgstab =
+  &bicgstab_type;
@@ -0,0 +1,269 @@
+/* cg.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * The code in this module implements the preconditioned conjugate
+ * gradient method for symmetric positive definite systems, see
+ *
+ * [1] Y. Saad, Iterative methods for sparse linear systems,
+ *     2nd edition, SIAM, 2003, algorithm 9.1.
+ */
+
+typedef struct
+{
+  size_t n;        /* size of linear system */
+  size_t maxit;    /* maximum iterations per call to iterate */
+  gsl_vector *r;   /* residual vector r = b - A*x */
+  gsl_vector *z;   /* preconditioned residual z = M^{-1} r */
+  gsl_vector *p;   /* search direction */
+  gsl_vector *q;   /* q = A*p */
+
+  double normr;    /* residual norm ||r|| */
+} cg_state_t;
+
+static void cg_free(void *vstate);
+static int cg_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+                      const double tol, gsl_vector *x,
+                      const gsl_splinalg_precon *P,
+                      gsl_splinalg_history *h, void *vstate);
+
+#include "common.c"
+
+/*
+cg_alloc()
+  Allocate a CG workspace for solving an n-by-n system A x = b
+
+Inputs: n - size of system
+        m - maximum number of iterations performed by each call
+            to iterate; if 0, the value n is used
+
+Return: pointer to workspace
+*/
+
+static void *
+cg_alloc(const size_t n, const size_t m)
+{
+  cg_state_t *state;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  state = calloc(1, sizeof(cg_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate cg state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+  state->maxit = (m == 0) ? n : m;
+
+  state->r = gsl_vector_alloc(n);
+  state->z = gsl_vector_alloc(n);
+  state->p = gsl_vector_alloc(n);
+  state->q = gsl_vector_alloc(n);
+  if (!state->r || !state->z || !state->p || !state->q)
+    {
+      cg_free(state);
+      GSL_ERROR_NULL("failed to allocate cg vectors", GSL_ENOMEM);
+    }
+
+  state->normr = 0.0;
+
+  return state;
+} /* cg_alloc() */
+
+static void
+cg_free(void *vstate)
+{
+  cg_state_t *state = (cg_state_t *) vstate;
+
+  if (state->r)
+    gsl_vector_free(state->r);
+
+  if (state->z)
+    gsl_vector_free(state->z);
+
+  if (state->p)
+    gsl_vector_free(state->p);
+
+  if (state->q)
+    gsl_vector_free(state->q);
+
+  free(state);
+} /* cg_free() */
+
+/*
+cg_iterate()
+  Solve A*x = b using the preconditioned conjugate gradient method
+
+Inputs: A    - sparse symmetric positive definite matrix
+        b    - right hand side vector
+        tol  - stopping tolerance
+        x    - (input/output) on input, initial estimate x_0;
+               on output, solution vector
+        P    - symmetric positive definite preconditioner M, or NULL
+        h    - (output) iteration count and residual history
+        work - workspace
+
+Return:
+GSL_SUCCESS if ||b - A*x|| <= tol * ||b||, GSL_CONTINUE if the
+maximum number of iterations was reached first. In the latter case
+calling this function again continues (restarts) from the current x.
+*/
+
+static int
+cg_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+           const double tol, gsl_vector *x,
+           const gsl_splinalg_precon *P,
+           gsl_splinalg_history *h, void *vstate)
+{
+  const size_t N = A->size1;
+  cg_state_t *state = (cg_state_t *) vstate;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (N != b->size)
+    {
+      GSL_ERROR("matrix does not match right hand side", GSL_EBADLEN);
+    }
+  else if (N != x->size)
+    {
+      GSL_ERROR("matrix does not match solution vector", GSL_EBADLEN);
+    }
+  else if (N != state->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      const double normb = gsl_blas_dnrm2(b);
+      const double reltol = tol * normb;
+      gsl_vector *r = state->r;
+      gsl_vector *z = state->z;
+      gsl_vector *p = state->p;
+      gsl_vector *q = state->q;
+      double rho, rho_old, alpha, beta, pq;
+      double normr;
+      size_t k;
+
+      /* r = b - A*x_0 */
+      gsl_vector_memcpy(r, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r);
+      normr = gsl_blas_dnrm2(r);
+
+      if (normr <= reltol)
+        {
+          state->normr = normr;
+          return GSL_SUCCESS;
+        }
+
+      /* z = M^{-1} r, p = z */
+      status = splinalg_precon(P, r, z);
+      if (status)
+        return status;
+
+      gsl_vector_memcpy(p, z);
+      gsl_blas_ddot(r, z, &rho);
+
+      for (k = 0; k < state->maxit; ++k)
+        {
+          /* q = A*p, alpha = (r,z) / (p,Ap) */
+          gsl_spblas_dgemv(CblasNoTrans, 1.0, A, p, 0.0, q);
+          gsl_blas_ddot(p, q, &pq);
+
+          if (pq <= 0.0)
+            {
+              GSL_ERROR("matrix is not positive definite", GSL_EDOM);
+            }
+
+          alpha = rho / pq;
+
+          /* x = x + alpha*p, r = r - alpha*q */
+          gsl_blas_daxpy(alpha, p, x);
+          gsl_blas_daxpy(-alpha, q, r);
+
+          normr = gsl_blas_dnrm2(r);
+          splinalg_history_add(h, normr);
+
+          if (normr <= reltol)
+            break;
+
+          status = splinalg_precon(P, r, z);
+          if (status)
+            return status;
+
+          rho_old = rho;
+          gsl_blas_ddot(r, z, &rho);
+
+          if (rho == 0.0)
+            break;
+
+          /* p = z + beta*p */
+          beta = rho / rho_old;
+          gsl_vector_scale(p, beta);
+          gsl_vector_add(p, z);
+        }
+
+      /* compute true residual r = b - A*x, which may drift from the recurrence */
+      gsl_vector_memcpy(r, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r);
+      normr = gsl_blas_dnrm2(r);
+
+      state->normr = normr;
+
+      if (normr <= reltol)
+        return GSL_SUCCESS;
+      else
+        return GSL_CONTINUE;
+    }
+} /* cg_iterate() */
+
+static double
+cg_normr(const void *vstate)
+{
+  const cg_state_t *state = (const cg_state_t *) vstate;
+  return state->normr;
+} /* cg_normr() */
+
+static const gsl_splinalg_itersolve_type cg_type =
+{
+  "cg",
+  &cg_alloc,
+  &cg_iterate,
+  &cg_normr,
+  &cg_free
+};
+
+const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_cg =
+  &cg_type;
@@ -0,0 +1,824 @@
+/* splinalg/cholesky.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * This module implements a sparse supernodal Cholesky factorization
+ *
+ * P A P^T = L L^T
+ *
+ * of a symmetric positive definite matrix A, where P is a fill-reducing
+ * permutation.
+ *
+ * The symbolic phase computes the ordering, the elimination tree (which
+ * is postordered so that supernodes consist of consecutive columns),
+ * the column counts of L, and the supernode partition. A supernode is a
+ * set of consecutive columns f..l of L with identical sparsity below the
+ * diagonal block; its nonzeros are stored as a dense nrow-by-ncol
+ * row-major block, whose first ncol rows are the (lower triangular)
+ * diagonal block.
+ *
+ * The numeric phase is left-looking: supernode s is assembled from
+ * the columns of A, updated by every descendant supernode d with rows
+ * in f..l using a dense gsl_blas_dgemm, and then factored with
+ * gsl_linalg_cholesky_decomp1 and gsl_blas_dtrsm.
+ *
+ * See
+ *
+ * [1] T. A. Davis, Direct methods for sparse linear systems, SIAM, 2006.
+ *
+ * [2] E. Ng and B. W. Peyton, Block sparse Cholesky algorithms on
+ *     advanced uniprocessor computers, SIAM J. Sci. Comput. 14(5), 1993.
+ */
+
+#include "pattern.c"
+
+static void cholesky_free_symbolic(gsl_splinalg_cholesky_workspace *w);
+static int cholesky_pattern(const gsl_spmatrix *A, int *Tp, int *Ti,
+                            gsl_splinalg_cholesky_workspace *w);
+static void cholesky_etree(const int n, const int *Tp, const int *Ti,
+                           int *parent, int *ancestor);
+static int cholesky_postorder(const int n, const int *parent, int *post);
+
+/*
+gsl_splinalg_cholesky_alloc()
+  Allocate a workspace for the sparse Cholesky factorization of
+n-by-n matrices
+
+Inputs: n - size of matrix
+
+Return: pointer to workspace
+*/
+
+gsl_splinalg_cholesky_workspace *
+gsl_splinalg_cholesky_alloc(const size_t n)
+{
+  gsl_splinalg_cholesky_workspace *w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  w = calloc(1, sizeof(gsl_splinalg_cholesky_workspace));
+  if (!w)
+    {
+      GSL_ERROR_NULL("failed to allocate cholesky workspace", GSL_ENOMEM);
+    }
+
+  w->n = n;
+
+  w->perm = gsl_permutation_alloc(n);
+  if (!w->perm)
+    {
+      gsl_splinalg_cholesky_free(w);
+      GSL_ERROR_NULL("failed to allocate permutation", GSL_ENOMEM);
+    }
+
+  w->pinv = malloc(n * sizeof(int));
+  w->parent = malloc(n * sizeof(int));
+  w->Cp = malloc((n + 1) * sizeof(int));
+  w->iwork = malloc(4 * n * sizeof(int));
+  if (!w->pinv || !w->parent || !w->Cp || !w->iwork)
+    {
+      gsl_splinalg_cholesky_free(w);
+      GSL_ERROR_NULL("failed to allocate index arrays", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_splinalg_cholesky_free(gsl_splinalg_cholesky_workspace *w)
+{
+  cholesky_free_symbolic(w);
+
+  if (w->perm)
+    gsl_permutation_free(w->perm);
+
+  if (w->pinv)
+    free(w->pinv);
+
+  if (w->parent)
+    free(w->parent);
+
+  if (w->Cp)
+    free(w->Cp);
+
+  if (w->iwork)
+    free(w->iwork);
+
+  free(w);
+}
+
+/*
+gsl_splinalg_cholesky_symbolic()
+  Symbolic analysis for the sparse Cholesky factorization of A
+
+Inputs: A - symmetric sparse matrix in COO, CSC or CSR format; only
+            the sparsity pattern of its lower triangle is used
+        p - fill-reducing permutation; if NULL, an approximate
+            minimum degree ordering is computed
+        w - workspace
+
+Return: success/error
+
+Notes:
+1) The analysis may be reused by gsl_splinalg_cholesky_numeric() for
+any matrix with the same sparsity pattern and storage format as A
+
+2) On output, w->perm contains the permutation P, which differs from
+p by a postordering of the elimination tree
+*/
+
+int
+gsl_splinalg_cholesky_symbolic(const gsl_spmatrix *A, const gsl_permutation *p,
+                               gsl_splinalg_cholesky_workspace *w)
+{
+  const size_t n = w->n;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (A->size1 != n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else if (p != NULL && p->size != n)
+    {
+      GSL_ERROR("permutation does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t nzA = gsl_spmatrix_nnz(A);
+      int *parent = w->parent;
+      int *count, *post, *flag, *Tp, *Ti;
+      size_t j, k, s, nsuper, maxrow = 0, maxcol = 0;
+      int status;
+
+      cholesky_free_symbolic(w);
+
+      if (p != NULL)
+        status = gsl_permutation_memcpy(w->perm, p);
+      else
+        status = gsl_splinalg_amd(A, w->perm);
+
+      if (status)
+        return status;
+
+      w->nnz = nzA;
+      w->Ci = malloc((nzA + 1) * sizeof(int));
+      w->Cx = malloc((nzA + 1) * sizeof(double));
+      w->map = malloc((nzA + 1) * sizeof(int));
+      Tp = malloc((n + 1 + nzA + 1) * sizeof(int));
+      if (!w->Ci || !w->Cx || !w->map || !Tp)
+        {
+          free(Tp);
+          cholesky_free_symbolic(w);
+          GSL_ERROR("failed to allocate pattern arrays", GSL_ENOMEM);
+        }
+
+      Ti = Tp + n + 1;
+      count = w->iwork;
+      post = count + n;
+      flag = post + n;
+
+      /* elimination tree of P A P^T */
+      status = cholesky_pattern(A, Tp, Ti, w);
+      if (status)
+        {
+          free(Tp);
+          cholesky_free_symbolic(w);
+          return status;
+        }
+
+      cholesky_etree(n, Tp, Ti, parent, flag);
+
+      /* renumber the columns in postorder, so supernodes are contiguous */
+      status = cholesky_postorder(n, parent, post);
+      if (status)
+        {
+          free(Tp);
+          cholesky_free_symbolic(w);
+          return status;
+        }
+
+      for (k = 0; k < n; ++k)
+        flag[k] = (int) w->perm->data[post[k]];
+
+      for (k = 0; k < n; ++k)
+        w->perm->data[k] = (size_t) flag[k];
+
+      status = cholesky_pattern(A, Tp, Ti, w);
+      if (status)
+        {
+          free(Tp);
+          cholesky_free_symbolic(w);
+          return status;
+        }
+
+      cholesky_etree(n, Tp, Ti, parent, flag);
+
+      /*
+       * column counts: row k of L is the set of nodes on the paths from
+       * each i in row k of the lower triangle up to k in the etree
+       */
+      for (j = 0; j < n; ++j)
+        {
+          count[j] = 1;
+          flag[j] = -1;
+        }
+
+      for (k = 0; k < n; ++k)
+        {
+          int jj;
+
+          flag[k] = (int) k;
+
+          for (jj = Tp[k]; jj < Tp[k + 1]; ++jj)
+            {
+              int i;
+              for (i = Ti[jj]; flag[i] != (int) k; i = parent[i])
+                {
+                  flag[i] = (int) k;
+                  count[i]++;
+                }
+            }
+        }
+
+      /* supernode partition: merge column j-1 into j when their patterns nest */
+      w->super = malloc((n + 1) * sizeof(int));
+      w->col2super = malloc(n * sizeof(int));
+      if (!w->super || !w->col2super)
+        {
+          free(Tp);
+          cholesky_free_symbolic(w);
+          GSL_ERROR("failed to allocate supernode arrays", GSL_ENOMEM);
+        }
+
+      nsuper = 0;
+      w->nnzL = 0;
+      for (j = 0; j < n; ++j)
+        {
+          if (j == 0 || parent[j - 1] != (int) j || count[j - 1] != count[j] + 1)
+            w->super[nsuper++] = (int) j;
+
+          w->col2super[j] = (int) nsuper - 1;
+          w->nnzL += count[j];
+        }
+
+      w->super[nsuper] = (int) n;
+      w->nsuper = nsuper;
+
+      /* row indices and storage offsets of each supernode */
+      w->Rp = malloc((nsuper + 1) * sizeof(size_t));
+      w->Lp = malloc((nsuper + 1) * sizeof(size_t));
+      if (!w->Rp || !w->Lp)
+        {
+          free(Tp);
+          cholesky_free_symbolic(w);
+          GSL_ERROR("failed to allocate supernode arrays", GSL_ENOMEM);
+        }
+
+      w->Rp[0] = 0;
+      w->Lp[0] = 0;
+      for (s = 0; s < nsuper; ++s)
+        {
+          size_t nrow = count[w->super[s]];
+          size_t ncol = w->super[s + 1] - w->super[s];
+
+          w->Rp[s + 1] = w->Rp[s] + nrow;
+          w->Lp[s + 1] = w->Lp[s] + nrow * ncol;
+
+          maxrow = GSL_MAX(maxrow, nrow);
+          maxcol = GSL_MAX(maxcol, ncol);
+        }
+
+      w->Ri = malloc(w->Rp[nsuper] * sizeof(int));
+      w->Lx = malloc(w->Lp[nsuper] * sizeof(double));
+      w->nwork = GSL_MAX(maxrow * maxcol, n + maxrow);
+      w->work = malloc(w->nwork * sizeof(double));
+      if (!w->Ri || !w->Lx || !w->work)
+        {
+          free(Tp);
+          cholesky_free_symbolic(w);
+          GSL_ERROR("failed to allocate factor", GSL_ENOMEM);
+        }
+
+      /* fill row indices, in increasing order, using post as insertion pointer */
+      for (s = 0; s < nsuper; ++s)
+        post[s] = (int) w->Rp[s];
+
+      for (j = 0; j < n; ++j)
+        flag[j] = -1;
+
+      for (k = 0; k < n; ++k)
+        {
+          int jj;
+
+          flag[k] = (int) k;
+
+          if (w->super[w->col2super[k]] == (int) k)
+            w->Ri[post[w->col2super[k]]++] = (int) k;
+
+          for (jj = Tp[k]; jj < Tp[k + 1]; ++jj)
+            {
+              int i;
+              for (i = Ti[jj]; flag[i] != (int) k; i = parent[i])
+                {
+                  flag[i] = (int) k;
+
+                  if (w->super[w->col2super[i]] == i)
+                    w->Ri[post[w->col2super[i]]++] = (int) k;
+                }
+            }
+        }
+
+      free(Tp);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_cholesky_numeric()
+  Numeric sparse Cholesky factorization P A P^T = L L^T, using a
+symbolic analysis previously computed by gsl_splinalg_cholesky_symbolic()
+
+Inputs: A - symmetric positive definite sparse matrix, with the same
+            pattern and storage format as the matrix given to the
+            symbolic phase; only the lower triangle is referenced
+        w - workspace
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_cholesky_numeric(const gsl_spmatrix *A,
+                              gsl_splinalg_cholesky_workspace *w)
+{
+  if (w->Lx == NULL)
+    {
+      GSL_ERROR("symbolic analysis has not been computed", GSL_EINVAL);
+    }
+  else if (A->size1 != w->n || A->size2 != w->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else if (gsl_spmatrix_nnz(A) != w->nnz)
+    {
+      GSL_ERROR("matrix pattern does not match symbolic analysis", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t nsuper = w->nsuper;
+      const int *Cp = w->Cp;
+      const int *Ci = w->Ci;
+      double *Cx = w->Cx;
+      int *relmap = w->iwork;
+      int *head = relmap + w->n;
+      int *next = head + nsuper;
+      int *pos = next + nsuper;
+      size_t k, s;
+
+      /* gather values of the lower triangle of P A P^T */
+      for (k = 0; k < w->nnz; ++k)
+        {
+          if (w->map[k] >= 0)
+            Cx[w->map[k]] = A->data[k];
+        }
+
+      for (s = 0; s < nsuper; ++s)
+        head[s] = -1;
+
+      for (s = 0; s < nsuper; ++s)
+        {
+          const int f = w->super[s];
+          const int l = w->super[s + 1] - 1;
+          const size_t ncol = l - f + 1;
+          const size_t nrow = w->Rp[s + 1] - w->Rp[s];
+          const int *rows = w->Ri + w->Rp[s];
+          double *Ls = w->Lx + w->Lp[s];
+          int d, dnext, j;
+          size_t t;
+
+          /* assemble columns f..l of A */
+          for (t = 0; t < nrow; ++t)
+            relmap[rows[t]] = (int) t;
+
+          for (t = 0; t < nrow * ncol; ++t)
+            Ls[t] = 0.0;
+
+          for (j = f; j <= l; ++j)
+            {
+              int jj;
+              for (jj = Cp[j]; jj < Cp[j + 1]; ++jj)
+                Ls[relmap[Ci[jj]] * ncol + (j - f)] += Cx[jj];
+            }
+
+          /* apply updates from descendant supernodes d with rows in f..l */
+          for (d = head[s]; d >= 0; d = dnext)
+            {
+              const size_t ncol_d = w->super[d + 1] - w->super[d];
+              const size_t nrow_d = w->Rp[d + 1] - w->Rp[d];
+              const int *rows_d = w->Ri + w->Rp[d];
+              const size_t p1 = pos[d];
+              size_t p2 = p1, n1, n2, a, b;
+
+              dnext = next[d];
+
+              while (p2 < nrow_d && rows_d[p2] <= l)
+                ++p2;
+
+              n1 = p2 - p1;
+              n2 = nrow_d - p1;
+
+              {
+                gsl_matrix_view L1 = gsl_matrix_view_array(w->Lx + w->Lp[d] + p1 * ncol_d, n1, ncol_d);
+                gsl_matrix_view L2 = gsl_matrix_view_array(w->Lx + w->Lp[d] + p1 * ncol_d, n2, ncol_d);
+                gsl_matrix_view C = gsl_matrix_view_array(w->work, n2, n1);
+
+                /* C = L_d(p1:end,:) L_d(p1:p2-1,:)^T */
+                gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, &L2.matrix, &L1.matrix, 0.0, &C.matrix);
+              }
+
+              /* scatter-subtract the lower triangular part of C */
+              for (a = 0; a < n2; ++a)
+                {
+                  double *Lrow = Ls + relmap[rows_d[p1 + a]] * ncol;
+                  const double *Crow = w->work + a * n1;
+                  size_t bmax = GSL_MIN(a + 1, n1);
+
+                  for (b = 0; b < bmax; ++b)
+                    Lrow[rows_d[p1 + b] - f] -= Crow[b];
+                }
+
+              /* move d to the list of the next supernode it updates */
+              pos[d] = (int) p2;
+              if (p2 < nrow_d)
+                {
+                  int s2 = w->col2super[rows_d[p2]];
+                  next[d] = head[s2];
+                  head[s2] = d;
+                }
+            }
+
+          /* factor diagonal block and solve for the off-diagonal block */
+          {
+            gsl_matrix_view L11 = gsl_matrix_view_array(Ls, ncol, ncol);
+            int status = gsl_linalg_cholesky_decomp1(&L11.matrix);
+
+            if (status)
+              return status;
+
+            if (nrow > ncol)
+              {
+                gsl_matrix_view L21 = gsl_matrix_view_array(Ls + ncol * ncol, nrow - ncol, ncol);
+                gsl_blas_dtrsm(CblasRight, CblasLower, CblasTrans, CblasNonUnit, 1.0,
+                               &L11.matrix, &L21.matrix);
+
+                pos[s] = (int) ncol;
+                d = w->col2super[rows[ncol]];
+                next[s] = head[d];
+                head[d] = (int) s;
+              }
+          }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_cholesky_solve()
+  Solve A x = b using the sparse Cholesky factorization
+
+Inputs: w - workspace containing factorization
+        b - right hand side vector
+        x - (output) solution vector
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_cholesky_solve(gsl_splinalg_cholesky_workspace *w,
+                            const gsl_vector *b, gsl_vector *x)
+{
+  if (w->n != b->size)
+    {
+      GSL_ERROR("right hand side vector does not match factorization", GSL_EBADLEN);
+    }
+  else if (w->n != x->size)
+    {
+      GSL_ERROR("solution vector does not match factorization", GSL_EBADLEN);
+    }
+  else
+    {
+      int status = gsl_vector_memcpy(x, b);
+
+      if (status)
+        return status;
+
+      return gsl_splinalg_cholesky_svx(w, x);
+    }
+}
+
+/*
+gsl_splinalg_cholesky_svx()
+  Solve A x = b in place using the sparse Cholesky factorization
+
+Inputs: w - workspace containing factorization
+        x - (input/output) on input, right hand side vector b;
+            on output, solution vector
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_cholesky_svx(gsl_splinalg_cholesky_workspace *w, gsl_vector *x)
+{
+  if (w->Lx == NULL)
+    {
+      GSL_ERROR("factorization has not been computed", GSL_EINVAL);
+    }
+  else if (w->n != x->size)
+    {
+      GSL_ERROR("solution vector does not match factorization", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t n = w->n;
+      const size_t *perm = w->perm->data;
+      double *y = w->work;
+      double *t = w->work + n;
+      size_t k, s, a;
+
+      /* y = P b */
+      for (k = 0; k < n; ++k)
+        y[k] = gsl_vector_get(x, perm[k]);
+
+      /* forward substitution L y = P b, one supernode at a time */
+      for (s = 0; s < w->nsuper; ++s)
+        {
+          const size_t f = w->super[s];
+          const size_t ncol = w->super[s + 1] - f;
+          const size_t nrow = w->Rp[s + 1] - w->Rp[s];
+          const int *rows = w->Ri + w->Rp[s];
+          double *Ls = w->Lx + w->Lp[s];
+          gsl_matrix_view L11 = gsl_matrix_view_array(Ls, ncol, ncol);
+          gsl_vector_view y1 = gsl_vector_view_array(y + f, ncol);
+
+          gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit, &L11.matrix, &y1.vector);
+
+          if (nrow > ncol)
+            {
+              gsl_matrix_view L21 = gsl_matrix_view_array(Ls + ncol * ncol, nrow - ncol, ncol);
+              gsl_vector_view tv = gsl_vector_view_array(t, nrow - ncol);
+
+              gsl_blas_dgemv(CblasNoTrans, 1.0, &L21.matrix, &y1.vector, 0.0, &tv.vector);
+
+              for (a = 0; a < nrow - ncol; ++a)
+                y[rows[ncol + a]] -= t[a];
+            }
+        }
+
+      /* back substitution L^T z = y */
+      for (s = w->nsuper; s-- > 0; )
+        {
+          const size_t f = w->super[s];
+          const size_t ncol = w->super[s + 1] - f;
+          const size_t nrow = w->Rp[s + 1] - w->Rp[s];
+          const int *rows = w->Ri + w->Rp[s];
+          double *Ls = w->Lx + w->Lp[s];
+          gsl_matrix_view L11 = gsl_matrix_view_array(Ls, ncol, ncol);
+          gsl_vector_view y1 = gsl_vector_view_array(y + f, ncol);
+
+          if (nrow > ncol)
+            {
+              gsl_matrix_view L21 = gsl_matrix_view_array(Ls + ncol * ncol, nrow - ncol, ncol);
+              gsl_vector_view tv = gsl_vector_view_array(t, nrow - ncol);
+
+              for (a = 0; a < nrow - ncol; ++a)
+                t[a] = y[rows[ncol + a]];
+
+              gsl_blas_dgemv(CblasTrans, -1.0, &L21.matrix, &tv.vector, 1.0, &y1.vector);
+            }
+
+          gsl_blas_dtrsv(CblasLower, CblasTrans, CblasNonUnit, &L11.matrix, &y1.vector);
+        }
+
+      /* x = P^T z */
+      for (k = 0; k < n; ++k)
+        gsl_vector_set(x, perm[k], y[k]);
+
+      return GSL_SUCCESS;
+    }
+}
+
+static void
+cholesky_free_symbolic(gsl_splinalg_cholesky_workspace *w)
+{
+  free(w->Ci);
+  free(w->Cx);
+  free(w->map);
+  free(w->super);
+  free(w->col2super);
+  free(w->Rp);
+  free(w->Ri);
+  free(w->Lp);
+  free(w->Lx);
+  free(w->work);
+
+  w->Ci = NULL;
+  w->Cx = NULL;
+  w->map = NULL;
+  w->super = NULL;
+  w->col2super = NULL;
+  w->Rp = NULL;
+  w->Ri = NULL;
+  w->Lp = NULL;
+  w->Lx = NULL;
+  w->work = NULL;
+  w->nsuper = 0;
+  w->nnzL = 0;
+}
+
+/*
+cholesky_pattern()
+  Compute the pattern of the lower triangle of C = P A P^T in CSC
+format (w->Cp, w->Ci, w->map) and its transpose (Tp, Ti), in which
+row k lists the columns j < k of row k of C
+*/
+
+static int
+cholesky_pattern(const gsl_spmatrix *A, int *Tp, int *Ti,
+                 gsl_splinalg_cholesky_workspace *w)
+{
+  const int n = (int) w->n;
+  int *pinv = w->pinv;
+  int *cnt = w->iwork + 3 * w->n;
+  int status;
+  int j, k;
+
+  for (k = 0; k < n; ++k)
+    pinv[w->perm->data[k]] = k;
+
+  status = pattern_csc(A, pinv, pinv, 1, w->Cp, w->Ci, w->map);
+  if (status)
+    return status;
+
+  /* transpose, omitting the diagonal */
+  for (k = 0; k < n; ++k)
+    cnt[k] = 0;
+
+  for (j = 0; j < n; ++j)
+    {
+      int jj;
+      for (jj = w->Cp[j]; jj < w->Cp[j + 1]; ++jj)
+        {
+          if (w->Ci[jj] != j)
+            cnt[w->Ci[jj]]++;
+        }
+    }
+
+  Tp[0] = 0;
+  for (k = 0; k < n; ++k)
+    {
+      Tp[k + 1] = Tp[k] + cnt[k];
+      cnt[k] = Tp[k];
+    }
+
+  for (j = 0; j < n; ++j)
+    {
+      int jj;
+      for (jj = w->Cp[j]; jj < w->Cp[j + 1]; ++jj)
+        {
+          int i = w->Ci[jj];
+          if (i != j)
+            Ti[cnt[i]++] = j;
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* elimination tree (Liu's algorithm with path compression) */
+static void
+cholesky_etree(const int n, const int *Tp, const int *Ti, int *parent,
+               int *ancestor)
+{
+  int k;
+
+  for (k = 0; k < n; ++k)
+    {
+      int jj;
+
+      parent[k] = -1;
+      ancestor[k] = -1;
+
+      for (jj = Tp[k]; jj < Tp[k + 1]; ++jj)
+        {
+          int i = Ti[jj], inext;
+
+          /* traverse from i to the root of its current subtree */
+          for ( ; i != -1 && i < k; i = inext)
+            {
+              inext = ancestor[i];
+              ancestor[i] = k;
+              if (inext == -1)
+                parent[i] = k;
+            }
+        }
+    }
+}
+
+/* postorder of the forest given by parent, using a depth-first search */
+static int
+cholesky_postorder(const int n, const int *parent, int *post)
+{
+  int *head, *next, *stack;
+  int j, k = 0;
+
+  head = malloc(3 * n * sizeof(int));
+  if (!head)
+    {
+      GSL_ERROR("failed to allocate space for postorder", GSL_ENOMEM);
+    }
+
+  next = head + n;
+  stack = next + n;
+
+  for (j = 0; j < n; ++j)
+    head[j] = -1;
+
+  /* child lists, built in reverse so children are visited in increasing order */
+  for (j = n - 1; j >= 0; --j)
+    {
+      if (parent[j] != -1)
+        {
+          next[j] = head[parent[j]];
+          head[parent[j]] = j;
+        }
+    }
+
+  for (j = 0; j < n; ++j)
+    {
+      int top = 0;
+
+      if (parent[j] != -1)
+        continue;
+
+      stack[0] = j;
+
+      while (top >= 0)
+        {
+          int p = stack[top];
+          int i = head[p];
+
+          if (i == -1)
+            {
+              /* all children of p are ordered */
+              --top;
+              post[k++] = p;
+            }
+          else
+            {
+              head[p] = next[i];
+              stack[++top] = i;
+            }
+        }
+    }
+
+  free(head);
+
+  return GSL_SUCCESS;
+}
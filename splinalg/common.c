@@ -0,0 +1,47 @@
+/* splinalg/common.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+static int splinalg_precon(const gsl_splinalg_precon *P, const gsl_vector *r,
+                           gsl_vector *z);
+static void splinalg_history_add(gsl_splinalg_history *h,
+                                 const double normr);
+
+/* compute z = M^{-1} r, or z = r if there is no preconditioner */
+static int
+splinalg_precon(const gsl_splinalg_precon *P, const gsl_vector *r,
+                gsl_vector *z)
+{
+  if (P == NULL)
+    return gsl_vector_memcpy(z, r);
+  else
+    return P->apply(r, z, P->params);
+}
+
+/* count an inner iteration and record its residual norm */
+static void
+splinalg_history_add(gsl_splinalg_history *h, const double normr)
+{
+  if (h == NULL)
+    return;
+
+  ++(h->niter);
+
+  if (h->n < h->nmax)
+    h->normr[h->n++] = normr;
+}
@@ -0,0 +1,353 @@
+/* fgmres.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * The code in this module implements the flexible GMRES method,
+ * which allows the preconditioner to change from one iteration to
+ * the next (for example an inner iterative solve), see
+ *
+ * [1] Y. Saad, A flexible inner-outer preconditioned GMRES algorithm,
+ *     SIAM J. Sci. Comput. 14(2), 1993.
+ *
+ * [2] Y. Saad, Iterative methods for sparse linear systems,
+ *     2nd edition, SIAM, 2003, algorithm 9.6.
+ *
+ * The Arnoldi basis is orthogonalized with modified Gram-Schmidt.
+ */
+
+typedef struct
+{
+  size_t n;        /* size of linear system */
+  size_t m;        /* dimension of Krylov subspace K_m */
+  gsl_vector *r;   /* residual vector r = b - A*x */
+  gsl_matrix *V;   /* Arnoldi basis, n-by-(m+1) */
+  gsl_matrix *Z;   /* preconditioned basis z_j = M_j^{-1} v_j, n-by-m */
+  gsl_matrix *H;   /* Hessenberg matrix (m+1)-by-m */
+  gsl_vector *g;   /* least squares rhs and solution vector */
+
+  double *c;       /* Givens rotations */
+  double *s;
+
+  double normr;    /* residual norm ||r|| */
+} fgmres_state_t;
+
+static void fgmres_free(void *vstate);
+static int fgmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+                          const double tol, gsl_vector *x,
+                          const gsl_splinalg_precon *P,
+                          gsl_splinalg_history *h, void *vstate);
+
+#include "common.c"
+
+/*
+fgmres_alloc()
+  Allocate a flexible GMRES workspace for solving an n-by-n system A x = b
+
+Inputs: n - size of system
+        m - size of Krylov subspace (ie: number of inner iterations)
+            if this parameter is 0, the value GSL_MIN(n,10) is used
+
+Return: pointer to workspace
+*/
+
+static void *
+fgmres_alloc(const size_t n, const size_t m)
+{
+  fgmres_state_t *state;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  state = calloc(1, sizeof(fgmres_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate fgmres state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+
+  /* compute size of Krylov subspace */
+  if (m == 0)
+    state->m = GSL_MIN(n, 10);
+  else
+    state->m = GSL_MIN(n, m);
+
+  state->r = gsl_vector_alloc(n);
+  if (!state->r)
+    {
+      fgmres_free(state);
+      GSL_ERROR_NULL("failed to allocate r vector", GSL_ENOMEM);
+    }
+
+  state->V = gsl_matrix_alloc(n, state->m + 1);
+  state->Z = gsl_matrix_alloc(n, state->m);
+  if (!state->V || !state->Z)
+    {
+      fgmres_free(state);
+      GSL_ERROR_NULL("failed to allocate Krylov basis", GSL_ENOMEM);
+    }
+
+  state->H = gsl_matrix_alloc(state->m + 1, state->m);
+  if (!state->H)
+    {
+      fgmres_free(state);
+      GSL_ERROR_NULL("failed to allocate H matrix", GSL_ENOMEM);
+    }
+
+  state->g = gsl_vector_alloc(state->m + 1);
+  if (!state->g)
+    {
+      fgmres_free(state);
+      GSL_ERROR_NULL("failed to allocate g vector", GSL_ENOMEM);
+    }
+
+  state->c = malloc(state->m * sizeof(double));
+  state->s = malloc(state->m * sizeof(double));
+  if (!state->c || !state->s)
+    {
+      fgmres_free(state);
+      GSL_ERROR_NULL("failed to allocate Givens vectors", GSL_ENOMEM);
+    }
+
+  state->normr = 0.0;
+
+  return state;
+} /* fgmres_alloc() */
+
+static void
+fgmres_free(void *vstate)
+{
+  fgmres_state_t *state = (fgmres_state_t *) vstate;
+
+  if (state->r)
+    gsl_vector_free(state->r);
+
+  if (state->V)
+    gsl_matrix_free(state->V);
+
+  if (state->Z)
+    gsl_matrix_free(state->Z);
+
+  if (state->H)
+    gsl_matrix_free(state->H);
+
+  if (state->g)
+    gsl_vector_free(state->g);
+
+  if (state->c)
+    free(state->c);
+
+  if (state->s)
+    free(state->s);
+
+  free(state);
+} /* fgmres_free() */
+
+/*
+fgmres_iterate()
+  Solve A*x = b using the flexible GMRES algorithm
+
+Inputs: A    - sparse square matrix
+        b    - right hand side vector
+        tol  - stopping tolerance
+        x    - (input/output) on input, initial estimate x_0;
+               on output, solution vector
+        P    - right preconditioner, or NULL; it may return a
+               different approximation of A^{-1} r at each call
+        h    - (output) iteration count and residual history
+        work - workspace
+
+Return:
+GSL_SUCCESS if ||b - A*x|| <= tol * ||b||, GSL_CONTINUE if not yet
+converged after m inner iterations; calling this function again
+restarts the method from the current x.
+*/
+
+static int
+fgmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+               const double tol, gsl_vector *x,
+               const gsl_splinalg_precon *P,
+               gsl_splinalg_history *h, void *vstate)
+{
+  const size_t N = A->size1;
+  fgmres_state_t *state = (fgmres_state_t *) vstate;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (N != b->size)
+    {
+      GSL_ERROR("matrix does not match right hand side", GSL_EBADLEN);
+    }
+  else if (N != x->size)
+    {
+      GSL_ERROR("matrix does not match solution vector", GSL_EBADLEN);
+    }
+  else if (N != state->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      const size_t maxit = state->m;
+      const double normb = gsl_blas_dnrm2(b);
+      const double reltol = tol * normb;
+      gsl_vector *r = state->r;
+      gsl_vector *g = state->g;
+      gsl_matrix *H = state->H;
+      double normr, beta;
+      size_t i, j, k = 0;
+
+      /* r = b - A*x_0 */
+      gsl_vector_memcpy(r, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r);
+      beta = gsl_blas_dnrm2(r);
+
+      if (beta <= reltol)
+        {
+          state->normr = beta;
+          return GSL_SUCCESS;
+        }
+
+      /* v_1 = r / ||r||, g = ||r|| e_1 */
+      {
+        gsl_vector_view v0 = gsl_matrix_column(state->V, 0);
+        gsl_vector_memcpy(&v0.vector, r);
+        gsl_vector_scale(&v0.vector, 1.0 / beta);
+      }
+
+      gsl_matrix_set_zero(H);
+      gsl_vector_set_zero(g);
+      gsl_vector_set(g, 0, beta);
+
+      for (j = 0; j < maxit; ++j)
+        {
+          gsl_vector_view vj = gsl_matrix_column(state->V, j);
+          gsl_vector_view zj = gsl_matrix_column(state->Z, j);
+          gsl_vector_view w = gsl_matrix_column(state->V, j + 1);
+          gsl_vector_view hj = gsl_matrix_column(H, j);
+          double hjj, hj1j;
+
+          /* z_j = M^{-1} v_j, w = A z_j */
+          status = splinalg_precon(P, &vj.vector, &zj.vector);
+          if (status)
+            return status;
+
+          gsl_spblas_dgemv(CblasNoTrans, 1.0, A, &zj.vector, 0.0, &w.vector);
+
+          /* modified Gram-Schmidt against v_0, ..., v_j */
+          for (i = 0; i <= j; ++i)
+            {
+              gsl_vector_view vi = gsl_matrix_column(state->V, i);
+              double hij;
+
+              gsl_blas_ddot(&w.vector, &vi.vector, &hij);
+              gsl_blas_daxpy(-hij, &vi.vector, &w.vector);
+              gsl_vector_set(&hj.vector, i, hij);
+            }
+
+          hj1j = gsl_blas_dnrm2(&w.vector);
+          gsl_vector_set(&hj.vector, j + 1, hj1j);
+
+          if (hj1j > 0.0)
+            gsl_vector_scale(&w.vector, 1.0 / hj1j);
+
+          /* apply previous Givens rotations to column j of H */
+          for (i = 0; i < j; ++i)
+            gsl_linalg_givens_gv(&hj.vector, i, i + 1, state->c[i], state->s[i]);
+
+          /* compute and apply rotation J_j to eliminate H(j+1,j) */
+          hjj = gsl_vector_get(&hj.vector, j);
+          gsl_linalg_givens(hjj, hj1j, &state->c[j], &state->s[j]);
+          gsl_linalg_givens_gv(&hj.vector, j, j + 1, state->c[j], state->s[j]);
+          gsl_linalg_givens_gv(g, j, j + 1, state->c[j], state->s[j]);
+
+          k = j + 1;
+
+          normr = fabs(gsl_vector_get(g, j + 1));
+          splinalg_history_add(h, normr);
+
+          /* stop on convergence or when the Krylov space is invariant */
+          if (normr <= reltol || hj1j == 0.0)
+            break;
+        }
+
+      /* solve R_k y = g(1:k), in place in g */
+      {
+        gsl_matrix_view Rk = gsl_matrix_submatrix(H, 0, 0, k, k);
+        gsl_vector_view yk = gsl_vector_subvector(g, 0, k);
+
+        gsl_blas_dtrsv(CblasUpper, CblasNoTrans, CblasNonUnit,
+                       &Rk.matrix, &yk.vector);
+
+        /* x <- x + Z_k y */
+        {
+          gsl_matrix_view Zk = gsl_matrix_submatrix(state->Z, 0, 0, N, k);
+          gsl_blas_dgemv(CblasNoTrans, 1.0, &Zk.matrix, &yk.vector, 1.0, x);
+        }
+      }
+
+      /* compute new residual r = b - A*x */
+      gsl_vector_memcpy(r, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r);
+      normr = gsl_blas_dnrm2(r);
+
+      state->normr = normr;
+
+      if (normr <= reltol)
+        return GSL_SUCCESS;
+      else
+        return GSL_CONTINUE;
+    }
+} /* fgmres_iterate() */
+
+static double
+fgmres_normr(const void *vstate)
+{
+  const fgmres_state_t *state = (const fgmres_state_t *) vstate;
+  return state->normr;
+} /* fgmres_normr() */
+
+static const gsl_splinalg_itersolve_type fgmres_type =
+{
+  "fgmres",
+  &fgmres_alloc,
+  &fgmres_iterate,
+  &fgmres_normr,
+  &fgmres_free
+};
+
+const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_fgmres =
+  &fgmres_type;
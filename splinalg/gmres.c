@@ -45,6 +45,7 @@ typedef struct
   size_t n;        /* size of linear system */
   size_t m;        /* dimension of Krylov subspace K_m */
   gsl_vector *r;   /* residual vector r = b - A*x */
+  gsl_vector *z;   /* preconditioned vector z = M^{-1} v */
   gsl_matrix *H;   /* Hessenberg matrix n-by-(m+1) */
   gsl_vector *tau; /* householder scalars */
   gsl_vector *y;   /* least squares rhs and solution vector */
@@ -57,7 +58,11 @@ typedef struct
 
 static void gmres_free(void *vstate);
 static int gmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
-                         const double tol, gsl_vector *x, void *vstate);
+                         const double tol, gsl_vector *x,
+                         const gsl_splinalg_precon *P,
+                         gsl_splinalg_history *h, void *vstate);
+
+#include "common.c"
 
 /*
 gmres_alloc()
@@ -103,6 +108,13 @@ gmres_alloc(const size_t n, const size_t m)
       GSL_ERROR_NULL("failed to allocate r vector", GSL_ENOMEM);
     }
 
+  state->z = gsl_vector_alloc(n);
+  if (!state->z)
+    {
+      gmres_free(state);
+      GSL_ERROR_NULL("failed to allocate z vector", GSL_ENOMEM);
+    }
+
   state->H = gsl_matrix_alloc(n, state->m + 1);
   if (!state->H)
     {
@@ -145,6 +157,9 @@ gmres_free(void *vstate)
   if (state->r)
     gsl_vector_free(state->r);
 
+  if (state->z)
+    gsl_vector_free(state->z);
+
   if (state->H)
     gsl_matrix_free(state->H);
 
@@ -172,6 +187,8 @@ Inputs: A    - sparse square matrix
         tol  - stopping tolerance (see below)
         x    - (input/output) on input, initial estimate x_0;
                on output, solution vector
+        P    - right preconditioner M, or NULL
+        h    - (output) iteration count and residual history
         work - workspace
 
 Return:
@@ -189,12 +206,17 @@ Notes:
 (Saad, 2003 [2])
 
 2) On output, work->normr contains ||b - A*x||
+
+3) With a preconditioner M, the method is applied to the right
+preconditioned system A M^{-1} u = b, x = M^{-1} u, so that the
+residual being minimized is still ||b - A*x||
 */
 
 static int
 gmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
               const double tol, gsl_vector *x,
-              void *vstate)
+              const gsl_splinalg_precon *P,
+              gsl_splinalg_history *h, void *vstate)
 {
   const size_t N = A->size1;
   gmres_state_t *state = (gmres_state_t *) vstate;
@@ -292,8 +314,9 @@ gmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
               gsl_linalg_householder_hv(tau, &uk.vector, &vk.vector);
             }
 
-          /* Step 2a: v_m <- A*v_m */
-          gsl_spblas_dgemv(CblasNoTrans, 1.0, A, &vm.vector, 0.0, r);
+          /* Step 2a: v_m <- A*M^{-1}*v_m */
+          splinalg_precon(P, &vm.vector, state->z);
+          gsl_spblas_dgemv(CblasNoTrans, 1.0, A, state->z, 0.0, r);
           gsl_vector_memcpy(&vm.vector, r);
 
           /* Step 2a: v_m <- P_m ... P_1 v_m */
@@ -347,6 +370,8 @@ gmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
 
           /* Step 2j: check residual w_{m+1} for convergence */
           normr = fabs(gsl_vector_get(w, j + 1));
+          splinalg_history_add(h, normr);
+
           if (normr <= reltol)
             {
               /*
@@ -395,8 +420,9 @@ gmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
           gsl_linalg_householder_hv(tau, &uk.vector, &rk.vector);
         }
 
-      /* x <- x + V_m y_m */
-      gsl_vector_add(x, r);
+      /* x <- x + M^{-1} V_m y_m */
+      splinalg_precon(P, r, state->z);
+      gsl_vector_add(x, state->z);
 
       /* compute new residual r = b - A*x */
       gsl_vector_memcpy(r, b);
@@ -24,6 +24,7 @@
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_permutation.h>
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_types.h>
 
@@ -39,13 +40,31 @@
 
 __BEGIN_DECLS
 
+/* preconditioner: compute z = M^{-1} r */
+typedef struct
+{
+  int (*apply) (const gsl_vector *r, gsl_vector *z, void *params);
+  void *params;
+} gsl_splinalg_precon;
+
+/* iteration count and residual history */
+typedef struct
+{
+  size_t niter;  /* total number of inner iterations performed */
+  size_t n;      /* number of residual norms stored in normr */
+  size_t nmax;   /* length of normr array; 0 if history is not recorded */
+  double *normr; /* residual norm (estimate) after each inner iteration */
+} gsl_splinalg_history;
+
 /* iteration solver type */
 typedef struct
 {
   const char *name;
   void * (*alloc) (const size_t n, const size_t m);
   int (*iterate) (const gsl_spmatrix *A, const gsl_vector *b,
-                  const double tol, gsl_vector *x, void *);
+                  const double tol, gsl_vector *x,
+                  const gsl_splinalg_precon *P,
+                  gsl_splinalg_history *h, void *);
   double (*normr)(const void *);
   void (*free) (void *);
 } gsl_splinalg_itersolve_type;
@@ -54,11 +73,79 @@ typedef struct
 {
   const gsl_splinalg_itersolve_type * type;
   double normr; /* current residual norm || b - A x || */
+  gsl_splinalg_precon precon; /* preconditioner; precon.apply = NULL for none */
+  gsl_splinalg_history history;
   void * state;
 } gsl_splinalg_itersolve;
 
 /* available types */
 GSL_VAR const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_gmres;
+GSL_VAR const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_fgmres;
+GSL_VAR const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_cg;
+GSL_VAR const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_bicgstab;
+GSL_VAR const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_minres;
+
+/* incomplete factorization preconditioners */
+typedef struct
+{
+  size_t n;          /* size of matrix */
+  gsl_spmatrix *L;   /* lower triangular factor (CSR), diagonal last in each row */
+  gsl_spmatrix *U;   /* upper triangular factor (CSR), diagonal first in each row */
+  size_t nlevL;      /* number of levels in forward substitution */
+  size_t nlevU;      /* number of levels in back substitution */
+  size_t *levL_ptr;  /* level k of L is rows levL[levL_ptr[k]..levL_ptr[k+1]-1] */
+  size_t *levL;      /* rows of L ordered by level, length n */
+  size_t *levU_ptr;  /* level k of U is rows levU[levU_ptr[k]..levU_ptr[k+1]-1] */
+  size_t *levU;      /* rows of U ordered by level, length n */
+  double *work;      /* dense row, length n */
+  int *jr;           /* column marker, length n */
+  int *jw;           /* column list, length n */
+  int *ju;           /* column list, length n */
+} gsl_splinalg_ilu_workspace;
+
+/* sparse direct Cholesky factorization P A P^T = L L^T */
+typedef struct
+{
+  size_t n;                /* size of matrix */
+  size_t nnz;              /* number of stored elements of A */
+  size_t nsuper;           /* number of supernodes */
+  size_t nnzL;             /* number of nonzeros in L */
+  gsl_permutation *perm;   /* fill-reducing permutation P */
+  int *pinv;               /* inverse permutation, length n */
+  int *parent;             /* elimination tree of P A P^T, length n */
+  int *Cp;                 /* column pointers of lower triangle of P A P^T, length n + 1 */
+  int *Ci;                 /* row indices of lower triangle of P A P^T */
+  double *Cx;              /* values of lower triangle of P A P^T */
+  int *map;                /* A->data[k] is stored in Cx[map[k]], or -1 */
+  int *super;              /* supernode s is columns super[s]..super[s+1]-1 */
+  int *col2super;          /* supernode containing each column, length n */
+  size_t *Rp;              /* rows of supernode s are Ri[Rp[s]..Rp[s+1]-1] */
+  int *Ri;                 /* row indices of supernodes */
+  size_t *Lp;              /* supernode s is stored in Lx[Lp[s]..], row-major */
+  double *Lx;              /* dense supernodal blocks of L */
+  double *work;            /* update buffer */
+  size_t nwork;            /* size of work */
+  int *iwork;              /* integer workspace, length 4n */
+} gsl_splinalg_cholesky_workspace;
+
+/* sparse direct LU factorization P A Q = L U */
+typedef struct
+{
+  size_t n;                /* size of matrix */
+  size_t nnz;              /* number of stored elements of A */
+  gsl_permutation *p;      /* row permutation P from pivoting */
+  gsl_permutation *q;      /* fill-reducing column permutation Q */
+  int *pinv;               /* inverse row permutation, length n */
+  int *Cp;                 /* column pointers of A Q, length n + 1 */
+  int *Ci;                 /* row indices of A Q */
+  double *Cx;              /* values of A Q */
+  int *map;                /* A->data[k] is stored in Cx[map[k]] */
+  gsl_spmatrix *L;         /* unit lower triangular factor (CSC), diagonal first in each column */
+  gsl_spmatrix *U;         /* upper triangular factor (CSC), diagonal last in each column */
+  double *work;            /* dense column, length n */
+  int *iwork;              /* integer workspace, length 3n */
+  int factored;            /* numeric factorization available */
+} gsl_splinalg_lu_workspace;
 
 /*
  * Prototypes
@@ -73,6 +160,64 @@ int gsl_splinalg_itersolve_iterate(const gsl_spmatrix *A,
                                    const double tol, gsl_vector *x,
                                    gsl_splinalg_itersolve *w);
 double gsl_splinalg_itersolve_normr(const gsl_splinalg_itersolve *w);
+int gsl_splinalg_itersolve_set_precon(gsl_splinalg_itersolve *w,
+                                      const gsl_splinalg_precon *P);
+int gsl_splinalg_itersolve_set_history(gsl_splinalg_itersolve *w,
+                                       const size_t nmax);
+size_t gsl_splinalg_itersolve_niter(const gsl_splinalg_itersolve *w);
+const double *gsl_splinalg_itersolve_history(const gsl_splinalg_itersolve *w,
+                                             size_t *n);
+void gsl_splinalg_itersolve_reset(gsl_splinalg_itersolve *w);
+
+/* incomplete factorizations */
+gsl_splinalg_ilu_workspace *gsl_splinalg_ilu_alloc(const size_t n);
+void gsl_splinalg_ilu_free(gsl_splinalg_ilu_workspace *w);
+int gsl_splinalg_ilu0(const gsl_spmatrix *A, gsl_splinalg_ilu_workspace *w);
+int gsl_splinalg_ilut(const gsl_spmatrix *A, const double droptol,
+                      const size_t lfil, gsl_splinalg_ilu_workspace *w);
+int gsl_splinalg_ic0(const gsl_spmatrix *A, gsl_splinalg_ilu_workspace *w);
+int gsl_splinalg_ilu_solve(const gsl_splinalg_ilu_workspace *w,
+                           const gsl_vector *b, gsl_vector *x);
+int gsl_splinalg_ilu_svx(const gsl_splinalg_ilu_workspace *w, gsl_vector *x);
+int gsl_splinalg_ilu_precon(const gsl_vector *r, gsl_vector *z, void *params);
+
+/* orderings */
+int gsl_splinalg_amd(const gsl_spmatrix *A, gsl_permutation *p);
+int gsl_splinalg_rcm(const gsl_spmatrix *A, gsl_permutation *p);
+int gsl_splinalg_bisect(const gsl_spmatrix *A, const size_t leafsize,
+                        gsl_permutation *p);
+
+/* applying orderings */
+int gsl_splinalg_symperm(const gsl_spmatrix *A, const gsl_permutation *p,
+                         gsl_spmatrix *B);
+int gsl_splinalg_permute_vector(const gsl_permutation *p, const gsl_vector *x,
+                                gsl_vector *y);
+int gsl_splinalg_permute_vector_inverse(const gsl_permutation *p,
+                                        const gsl_vector *y, gsl_vector *x);
+
+/* sparse direct Cholesky */
+gsl_splinalg_cholesky_workspace *gsl_splinalg_cholesky_alloc(const size_t n);
+void gsl_splinalg_cholesky_free(gsl_splinalg_cholesky_workspace *w);
+int gsl_splinalg_cholesky_symbolic(const gsl_spmatrix *A,
+                                   const gsl_permutation *p,
+                                   gsl_splinalg_cholesky_workspace *w);
+int gsl_splinalg_cholesky_numeric(const gsl_spmatrix *A,
+                                  gsl_splinalg_cholesky_workspace *w);
+int gsl_splinalg_cholesky_solve(gsl_splinalg_cholesky_workspace *w,
+                                const gsl_vector *b, gsl_vector *x);
+int gsl_splinalg_cholesky_svx(gsl_splinalg_cholesky_workspace *w, gsl_vector *x);
+
+/* sparse direct LU */
+gsl_splinalg_lu_workspace *gsl_splinalg_lu_alloc(const size_t n);
+void gsl_splinalg_lu_free(gsl_splinalg_lu_workspace *w);
+int gsl_splinalg_lu_symbolic(const gsl_spmatrix *A, const gsl_permutation *q,
+                             gsl_splinalg_lu_workspace *w);
+int gsl_splinalg_lu_numeric(const gsl_spmatrix *A, const double pivtol,
+                            gsl_splinalg_lu_workspace *w);
+int gsl_splinalg_lu_refactor(const gsl_spmatrix *A, gsl_splinalg_lu_workspace *w);
+int gsl_splinalg_lu_solve(gsl_splinalg_lu_workspace *w, const gsl_vector *b,
+                          gsl_vector *x);
+int gsl_splinalg_lu_svx(gsl_splinalg_lu_workspace *w, gsl_vector *x);
 
 __END_DECLS
 
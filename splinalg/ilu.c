@@ -0,0 +1,935 @@
+/* ilu.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * This module implements incomplete factorization preconditioners
+ * for sparse matrices in compressed row (CSR) format:
+ *
+ * ILU(0): A ~ L U with L unit lower triangular, U upper triangular,
+ *         and the sparsity pattern of L+U equal to that of A
+ *
+ * ILUT:   dual threshold incomplete LU; entries smaller than
+ *         droptol * ||a_i|| are dropped and at most lfil entries are
+ *         kept in each row of L and U
+ *
+ * IC(0):  A ~ L L^T for symmetric positive definite A, with the
+ *         pattern of L equal to the lower triangle of A
+ *
+ * The factors are stored in CSR format. The diagonal element is
+ * stored last in each row of L and first in each row of U, and the
+ * remaining column indices of each row are sorted.
+ *
+ * For the triangular solves, the rows of L and U are grouped into
+ * levels: row i of L belongs to level 1 + max{level(j) : L_ij != 0, j < i},
+ * and similarly for U. All rows in a level depend only on rows in
+ * earlier levels, so they are independent and may be processed
+ * concurrently.
+ *
+ * See
+ *
+ * [1] Y. Saad, Iterative methods for sparse linear systems,
+ *     2nd edition, SIAM, 2003, sections 10.3, 10.4 and 11.6.
+ */
+
+static int ilu_compare_int(const void *a, const void *b);
+static int ilu_init(const gsl_spmatrix *A, const size_t nzmax,
+                    gsl_splinalg_ilu_workspace *w);
+static int ilu_push(gsl_spmatrix *M, const int col, const double val);
+static void ilu_qsplit(const double *x, int *ind, const size_t n,
+                       const size_t ncut);
+static int ilu_levels(const gsl_spmatrix *M, const int lower,
+                      size_t *levptr, size_t *lev, int *work);
+static int ilu_schedule(gsl_splinalg_ilu_workspace *w);
+
+/*
+gsl_splinalg_ilu_alloc()
+  Allocate a workspace for incomplete factorizations of
+n-by-n matrices
+
+Inputs: n - size of matrix
+
+Return: pointer to workspace
+*/
+
+gsl_splinalg_ilu_workspace *
+gsl_splinalg_ilu_alloc(const size_t n)
+{
+  gsl_splinalg_ilu_workspace *w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  w = calloc(1, sizeof(gsl_splinalg_ilu_workspace));
+  if (!w)
+    {
+      GSL_ERROR_NULL("failed to allocate ilu workspace", GSL_ENOMEM);
+    }
+
+  w->n = n;
+
+  w->levL_ptr = malloc((n + 1) * sizeof(size_t));
+  w->levL = malloc(n * sizeof(size_t));
+  w->levU_ptr = malloc((n + 1) * sizeof(size_t));
+  w->levU = malloc(n * sizeof(size_t));
+  if (!w->levL_ptr || !w->levL || !w->levU_ptr || !w->levU)
+    {
+      gsl_splinalg_ilu_free(w);
+      GSL_ERROR_NULL("failed to allocate level arrays", GSL_ENOMEM);
+    }
+
+  w->work = malloc(n * sizeof(double));
+  w->jr = malloc(n * sizeof(int));
+  w->jw = malloc(n * sizeof(int));
+  w->ju = malloc(n * sizeof(int));
+  if (!w->work || !w->jr || !w->jw || !w->ju)
+    {
+      gsl_splinalg_ilu_free(w);
+      GSL_ERROR_NULL("failed to allocate work arrays", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_splinalg_ilu_free(gsl_splinalg_ilu_workspace *w)
+{
+  if (w->L)
+    gsl_spmatrix_free(w->L);
+
+  if (w->U)
+    gsl_spmatrix_free(w->U);
+
+  if (w->levL_ptr)
+    free(w->levL_ptr);
+
+  if (w->levL)
+    free(w->levL);
+
+  if (w->levU_ptr)
+    free(w->levU_ptr);
+
+  if (w->levU)
+    free(w->levU);
+
+  if (w->work)
+    free(w->work);
+
+  if (w->jr)
+    free(w->jr);
+
+  if (w->jw)
+    free(w->jw);
+
+  if (w->ju)
+    free(w->ju);
+
+  free(w);
+}
+
+/*
+gsl_splinalg_ilu0()
+  Compute the ILU(0) factorization of a square CSR matrix A
+
+Inputs: A - square sparse matrix in CSR format
+        w - workspace
+
+Return: success/error
+
+Notes:
+1) Missing diagonal elements of A are treated as explicit zeros;
+a zero pivot results in GSL_EDOM
+*/
+
+int
+gsl_splinalg_ilu0(const gsl_spmatrix *A, gsl_splinalg_ilu_workspace *w)
+{
+  int status = ilu_init(A, gsl_spmatrix_nnz(A) + w->n, w);
+
+  if (status)
+    {
+      return status;
+    }
+  else
+    {
+      const int n = (int) w->n;
+      gsl_spmatrix *L = w->L;
+      gsl_spmatrix *U = w->U;
+      double *x = w->work;
+      int *jr = w->jr;
+      int *jw = w->jw;
+      int i;
+
+      for (i = 0; i < n; ++i)
+        {
+          int len = 0;
+          int jj, k;
+
+          /* scatter row i of A, including its diagonal */
+          for (jj = A->p[i]; jj < A->p[i + 1]; ++jj)
+            {
+              int col = A->i[jj];
+              jr[col] = len;
+              jw[len++] = col;
+              x[col] = A->data[jj];
+            }
+
+          if (jr[i] < 0)
+            {
+              jr[i] = len;
+              jw[len++] = i;
+              x[i] = 0.0;
+            }
+
+          qsort(jw, len, sizeof(int), ilu_compare_int);
+
+          /* eliminate with previous rows of U, restricted to the pattern of row i */
+          for (k = 0; k < len && jw[k] < i; ++k)
+            {
+              const int row = jw[k];
+              const int diag = U->p[row];
+              const double lik = x[row] / U->data[diag];
+
+              x[row] = lik;
+
+              for (jj = diag + 1; jj < U->p[row + 1]; ++jj)
+                {
+                  int col = U->i[jj];
+                  if (jr[col] >= 0)
+                    x[col] -= lik * U->data[jj];
+                }
+            }
+
+          if (x[i] == 0.0)
+            {
+              GSL_ERROR("zero pivot encountered in ILU(0)", GSL_EDOM);
+            }
+
+          /* store row i of L and U, clearing the marker */
+          for (k = 0; k < len; ++k)
+            {
+              int col = jw[k];
+
+              if (col < i)
+                status = ilu_push(L, col, x[col]);
+              else if (col == i)
+                {
+                  status = ilu_push(L, i, 1.0);
+                  if (!status)
+                    status = ilu_push(U, i, x[i]);
+                }
+              else
+                status = ilu_push(U, col, x[col]);
+
+              if (status)
+                return status;
+
+              jr[col] = -1;
+            }
+
+          L->p[i + 1] = (int) L->nz;
+          U->p[i + 1] = (int) U->nz;
+        }
+
+      return ilu_schedule(w);
+    }
+}
+
+/*
+gsl_splinalg_ilut()
+  Compute the dual threshold incomplete LU factorization ILUT(droptol,lfil)
+of a square CSR matrix A
+
+Inputs: A       - square sparse matrix in CSR format
+        droptol - relative drop tolerance; elements of row i smaller
+                  than droptol * ||a_i|| in magnitude are dropped
+        lfil    - maximum number of off-diagonal elements kept in
+                  each row of L and of U
+        w       - workspace
+
+Return: success/error
+
+Notes:
+1) A zero pivot is replaced by (1e-4 + droptol) * ||a_i||, following
+SPARSKIT; if row i of A is zero, GSL_EDOM is returned
+*/
+
+int
+gsl_splinalg_ilut(const gsl_spmatrix *A, const double droptol,
+                  const size_t lfil, gsl_splinalg_ilu_workspace *w)
+{
+  int status;
+
+  if (droptol < 0.0)
+    {
+      GSL_ERROR("droptol must be non-negative", GSL_EDOM);
+    }
+
+  status = ilu_init(A, gsl_spmatrix_nnz(A) + w->n, w);
+  if (status)
+    {
+      return status;
+    }
+  else
+    {
+      const int n = (int) w->n;
+      gsl_spmatrix *L = w->L;
+      gsl_spmatrix *U = w->U;
+      double *x = w->work;
+      int *jr = w->jr;
+      int *jw = w->jw; /* lower part of the pattern of row i */
+      int *ju = w->ju; /* upper part of the pattern of row i */
+      int i;
+
+      for (i = 0; i < n; ++i)
+        {
+          size_t lenl = 0, lenu = 0, nkeep;
+          double tnorm = 0.0, tau, diag = 0.0;
+          int jj, k;
+
+          /* scatter row i of A; the diagonal is held separately in diag */
+          for (jj = A->p[i]; jj < A->p[i + 1]; ++jj)
+            {
+              int col = A->i[jj];
+              double val = A->data[jj];
+
+              tnorm += val * val;
+
+              if (col < i)
+                {
+                  jr[col] = (int) lenl;
+                  jw[lenl++] = col;
+                  x[col] = val;
+                }
+              else if (col > i)
+                {
+                  jr[col] = (int) lenu;
+                  ju[lenu++] = col;
+                  x[col] = val;
+                }
+              else
+                {
+                  diag = val;
+                }
+            }
+
+          tnorm = sqrt(tnorm);
+          if (tnorm == 0.0)
+            {
+              GSL_ERROR("matrix has a zero row", GSL_EDOM);
+            }
+
+          tau = droptol * tnorm;
+
+          /*
+           * eliminate in increasing column order; fill-in to the left of
+           * the diagonal is appended to jw, so select the smallest
+           * remaining column at each step
+           */
+          for (k = 0; k < (int) lenl; ++k)
+            {
+              int kmin = k, row, tmp;
+              double lik;
+
+              for (jj = k + 1; jj < (int) lenl; ++jj)
+                {
+                  if (jw[jj] < jw[kmin])
+                    kmin = jj;
+                }
+
+              tmp = jw[k];
+              jw[k] = jw[kmin];
+              jw[kmin] = tmp;
+              jr[jw[k]] = k;
+              jr[jw[kmin]] = kmin;
+
+              row = jw[k];
+              lik = x[row] / U->data[U->p[row]];
+              x[row] = lik;
+
+              if (fabs(lik) <= tau)
+                {
+                  x[row] = 0.0;
+                  continue;
+                }
+
+              for (jj = U->p[row] + 1; jj < U->p[row + 1]; ++jj)
+                {
+                  int col = U->i[jj];
+                  double s = lik * U->data[jj];
+
+                  if (col == i)
+                    {
+                      diag -= s;
+                    }
+                  else if (jr[col] >= 0)
+                    {
+                      x[col] -= s;
+                    }
+                  else if (col < i)
+                    {
+                      /* fill-in in L */
+                      jr[col] = (int) lenl;
+                      jw[lenl++] = col;
+                      x[col] = -s;
+                    }
+                  else
+                    {
+                      /* fill-in in U */
+                      jr[col] = (int) lenu;
+                      ju[lenu++] = col;
+                      x[col] = -s;
+                    }
+                }
+            }
+
+          /* clear marker */
+          for (k = 0; k < (int) lenl; ++k)
+            jr[jw[k]] = -1;
+          for (k = 0; k < (int) lenu; ++k)
+            jr[ju[k]] = -1;
+
+          /* drop small elements of L, then keep the lfil largest */
+          nkeep = 0;
+          for (k = 0; k < (int) lenl; ++k)
+            {
+              if (fabs(x[jw[k]]) > tau)
+                jw[nkeep++] = jw[k];
+            }
+
+          if (nkeep > lfil)
+            {
+              ilu_qsplit(x, jw, nkeep, lfil);
+              nkeep = lfil;
+            }
+
+          qsort(jw, nkeep, sizeof(int), ilu_compare_int);
+
+          for (k = 0; k < (int) nkeep; ++k)
+            {
+              status = ilu_push(L, jw[k], x[jw[k]]);
+              if (status)
+                return status;
+            }
+
+          status = ilu_push(L, i, 1.0);
+          if (status)
+            return status;
+
+          /* same for U, whose diagonal is always kept */
+          if (diag == 0.0)
+            diag = (1.0e-4 + droptol) * tnorm;
+
+          status = ilu_push(U, i, diag);
+          if (status)
+            return status;
+
+          nkeep = 0;
+          for (k = 0; k < (int) lenu; ++k)
+            {
+              if (fabs(x[ju[k]]) > tau)
+                ju[nkeep++] = ju[k];
+            }
+
+          if (nkeep > lfil)
+            {
+              ilu_qsplit(x, ju, nkeep, lfil);
+              nkeep = lfil;
+            }
+
+          qsort(ju, nkeep, sizeof(int), ilu_compare_int);
+
+          for (k = 0; k < (int) nkeep; ++k)
+            {
+              status = ilu_push(U, ju[k], x[ju[k]]);
+              if (status)
+                return status;
+            }
+
+          L->p[i + 1] = (int) L->nz;
+          U->p[i + 1] = (int) U->nz;
+        }
+
+      return ilu_schedule(w);
+    }
+}
+
+/*
+gsl_splinalg_ic0()
+  Compute the incomplete Cholesky factorization IC(0) A ~ L L^T
+of a symmetric positive definite CSR matrix A
+
+Inputs: A - symmetric positive definite sparse matrix in CSR format;
+            only the lower triangle is referenced
+        w - workspace
+
+Return: success/error
+
+Notes:
+1) On output, w->L = L and w->U = L^T
+2) If a non-positive pivot is encountered, GSL_EDOM is returned
+*/
+
+int
+gsl_splinalg_ic0(const gsl_spmatrix *A, gsl_splinalg_ilu_workspace *w)
+{
+  int status = ilu_init(A, gsl_spmatrix_nnz(A) / 2 + w->n, w);
+
+  if (status)
+    {
+      return status;
+    }
+  else
+    {
+      const int n = (int) w->n;
+      gsl_spmatrix *L = w->L;
+      gsl_spmatrix *U = w->U;
+      double *x = w->work;
+      int *jr = w->jr;
+      int *jw = w->jw;
+      int *cnt = w->ju;
+      int i, k;
+
+      for (i = 0; i < n; ++i)
+        {
+          int len = 0;
+          int jj;
+          double d = 0.0;
+
+          /* scatter lower triangle of row i of A */
+          for (jj = A->p[i]; jj < A->p[i + 1]; ++jj)
+            {
+              int col = A->i[jj];
+
+              if (col < i)
+                {
+                  jr[col] = len;
+                  jw[len++] = col;
+                  x[col] = A->data[jj];
+                }
+              else if (col == i)
+                {
+                  d = A->data[jj];
+                }
+            }
+
+          qsort(jw, len, sizeof(int), ilu_compare_int);
+
+          /* L_ij = (a_ij - sum_{k<j} L_ik L_jk) / L_jj */
+          for (k = 0; k < len; ++k)
+            {
+              const int row = jw[k];
+              const int diag = L->p[row + 1] - 1;
+              double s = x[row];
+
+              for (jj = L->p[row]; jj < diag; ++jj)
+                {
+                  int col = L->i[jj];
+                  if (jr[col] >= 0)
+                    s -= x[col] * L->data[jj];
+                }
+
+              x[row] = s / L->data[diag];
+              d -= x[row] * x[row];
+            }
+
+          if (d <= 0.0)
+            {
+              GSL_ERROR("matrix is not positive definite", GSL_EDOM);
+            }
+
+          for (k = 0; k < len; ++k)
+            {
+              status = ilu_push(L, jw[k], x[jw[k]]);
+              if (status)
+                return status;
+
+              jr[jw[k]] = -1;
+            }
+
+          status = ilu_push(L, i, sqrt(d));
+          if (status)
+            return status;
+
+          L->p[i + 1] = (int) L->nz;
+        }
+
+      /* U = L^T; rows of L are visited in order so the diagonal comes first */
+      if (U->nzmax < L->nz)
+        {
+          status = gsl_spmatrix_realloc(L->nz, U);
+          if (status)
+            return status;
+        }
+
+      for (i = 0; i < n; ++i)
+        cnt[i] = 0;
+
+      for (k = 0; k < (int) L->nz; ++k)
+        cnt[L->i[k]]++;
+
+      U->p[0] = 0;
+      for (i = 0; i < n; ++i)
+        {
+          U->p[i + 1] = U->p[i] + cnt[i];
+          cnt[i] = U->p[i];
+        }
+
+      for (i = 0; i < n; ++i)
+        {
+          int jj;
+
+          for (jj = L->p[i]; jj < L->p[i + 1]; ++jj)
+            {
+              int idx = cnt[L->i[jj]]++;
+              U->i[idx] = i;
+              U->data[idx] = L->data[jj];
+            }
+        }
+
+      U->nz = L->nz;
+
+      return ilu_schedule(w);
+    }
+}
+
+/*
+gsl_splinalg_ilu_solve()
+  Solve L U x = b using the incomplete factors stored in w
+
+Inputs: w - workspace containing factorization
+        b - right hand side vector
+        x - (output) solution vector
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_ilu_solve(const gsl_splinalg_ilu_workspace *w,
+                       const gsl_vector *b, gsl_vector *x)
+{
+  if (w->n != b->size)
+    {
+      GSL_ERROR("right hand side vector does not match factorization", GSL_EBADLEN);
+    }
+  else if (w->n != x->size)
+    {
+      GSL_ERROR("solution vector does not match factorization", GSL_EBADLEN);
+    }
+  else
+    {
+      int status = gsl_vector_memcpy(x, b);
+
+      if (status)
+        return status;
+
+      return gsl_splinalg_ilu_svx(w, x);
+    }
+}
+
+/*
+gsl_splinalg_ilu_svx()
+  Solve L U x = b in place
+
+Inputs: w - workspace containing factorization
+        x - (input/output) on input, right hand side vector b;
+            on output, solution vector
+
+Return: success/error
+
+Notes:
+1) Both triangular solves proceed level by level; within a level
+the loop over rows carries no dependencies
+*/
+
+int
+gsl_splinalg_ilu_svx(const gsl_splinalg_ilu_workspace *w, gsl_vector *x)
+{
+  if (w->L == NULL || w->U == NULL)
+    {
+      GSL_ERROR("factorization has not been computed", GSL_EINVAL);
+    }
+  else if (w->n != x->size)
+    {
+      GSL_ERROR("solution vector does not match factorization", GSL_EBADLEN);
+    }
+  else
+    {
+      const gsl_spmatrix *L = w->L;
+      const gsl_spmatrix *U = w->U;
+      const size_t stride = x->stride;
+      double *xd = x->data;
+      size_t lev, k;
+
+      /* forward substitution L y = b, diagonal last in each row */
+      for (lev = 0; lev < w->nlevL; ++lev)
+        {
+          for (k = w->levL_ptr[lev]; k < w->levL_ptr[lev + 1]; ++k)
+            {
+              const size_t i = w->levL[k];
+              const int diag = L->p[i + 1] - 1;
+              double s = xd[i * stride];
+              int jj;
+
+              for (jj = L->p[i]; jj < diag; ++jj)
+                s -= L->data[jj] * xd[L->i[jj] * stride];
+
+              xd[i * stride] = s / L->data[diag];
+            }
+        }
+
+      /* back substitution U x = y, diagonal first in each row */
+      for (lev = 0; lev < w->nlevU; ++lev)
+        {
+          for (k = w->levU_ptr[lev]; k < w->levU_ptr[lev + 1]; ++k)
+            {
+              const size_t i = w->levU[k];
+              const int diag = U->p[i];
+              double s = xd[i * stride];
+              int jj;
+
+              for (jj = diag + 1; jj < U->p[i + 1]; ++jj)
+                s -= U->data[jj] * xd[U->i[jj] * stride];
+
+              xd[i * stride] = s / U->data[diag];
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_ilu_precon()
+  Preconditioner callback for gsl_splinalg_precon: z = (L U)^{-1} r
+
+Inputs: r      - input vector
+        z      - (output) preconditioned vector
+        params - pointer to gsl_splinalg_ilu_workspace
+*/
+
+int
+gsl_splinalg_ilu_precon(const gsl_vector *r, gsl_vector *z, void *params)
+{
+  const gsl_splinalg_ilu_workspace *w = (const gsl_splinalg_ilu_workspace *) params;
+  return gsl_splinalg_ilu_solve(w, r, z);
+}
+
+static int
+ilu_compare_int(const void *a, const void *b)
+{
+  const int ia = *(const int *) a;
+  const int ib = *(const int *) b;
+  return (ia > ib) - (ia < ib);
+}
+
+/* check A and prepare empty CSR factors L and U with room for nzmax elements */
+static int
+ilu_init(const gsl_spmatrix *A, const size_t nzmax,
+         gsl_splinalg_ilu_workspace *w)
+{
+  const size_t n = w->n;
+  size_t i;
+
+  if (!GSL_SPMATRIX_ISCSR(A))
+    {
+      GSL_ERROR("matrix must be in CSR format", GSL_EINVAL);
+    }
+  else if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (A->size1 != n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+
+  if (w->L == NULL)
+    {
+      w->L = gsl_spmatrix_alloc_nzmax(n, n, nzmax, GSL_SPMATRIX_CSR);
+      if (!w->L)
+        {
+          GSL_ERROR("failed to allocate L factor", GSL_ENOMEM);
+        }
+    }
+
+  if (w->U == NULL)
+    {
+      w->U = gsl_spmatrix_alloc_nzmax(n, n, nzmax, GSL_SPMATRIX_CSR);
+      if (!w->U)
+        {
+          GSL_ERROR("failed to allocate U factor", GSL_ENOMEM);
+        }
+    }
+
+  w->L->nz = 0;
+  w->L->p[0] = 0;
+  w->U->nz = 0;
+  w->U->p[0] = 0;
+  w->nlevL = 0;
+  w->nlevU = 0;
+
+  for (i = 0; i < n; ++i)
+    w->jr[i] = -1;
+
+  return GSL_SUCCESS;
+}
+
+/* append element to the current last row of the CSR matrix M */
+static int
+ilu_push(gsl_spmatrix *M, const int col, const double val)
+{
+  if (M->nz >= M->nzmax)
+    {
+      int status = gsl_spmatrix_realloc(2 * M->nzmax, M);
+      if (status)
+        return status;
+    }
+
+  M->i[M->nz] = col;
+  M->data[M->nz] = val;
+  ++(M->nz);
+
+  return GSL_SUCCESS;
+}
+
+/*
+ilu_qsplit()
+  Partially sort ind[0..n-1] so that the first ncut entries index
+the ncut largest values of |x[ind[k]]| (quick-split, as in SPARSKIT)
+*/
+
+static void
+ilu_qsplit(const double *x, int *ind, const size_t n, const size_t ncut)
+{
+  size_t first = 0, last = n - 1;
+
+  if (ncut == 0 || ncut >= n)
+    return;
+
+  while (1)
+    {
+      size_t mid = first, j;
+      const double abskey = fabs(x[ind[first]]);
+      int tmp;
+
+      for (j = first + 1; j <= last; ++j)
+        {
+          if (fabs(x[ind[j]]) > abskey)
+            {
+              ++mid;
+              tmp = ind[mid];
+              ind[mid] = ind[j];
+              ind[j] = tmp;
+            }
+        }
+
+      tmp = ind[mid];
+      ind[mid] = ind[first];
+      ind[first] = tmp;
+
+      if (mid == ncut - 1 || mid == ncut)
+        return;
+      else if (mid > ncut)
+        last = mid - 1;
+      else
+        first = mid + 1;
+    }
+}
+
+/*
+ilu_levels()
+  Compute the level sets of the triangular CSR matrix M
+
+Inputs: M      - triangular matrix
+        lower  - 1 if M is lower triangular, 0 if upper
+        levptr - (output) level k consists of rows lev[levptr[k]..levptr[k+1]-1],
+                 length n + 1
+        lev    - (output) rows ordered by level, length n
+        work   - workspace, length n
+
+Return: number of levels
+*/
+
+static int
+ilu_levels(const gsl_spmatrix *M, const int lower,
+           size_t *levptr, size_t *lev, int *work)
+{
+  const int n = (int) M->size1;
+  int nlev = 0;
+  int i, k;
+
+  for (k = 0; k < n; ++k)
+    {
+      const int row = lower ? k : n - 1 - k;
+      int l = 0, jj;
+
+      for (jj = M->p[row]; jj < M->p[row + 1]; ++jj)
+        {
+          int col = M->i[jj];
+          if (col != row)
+            l = GSL_MAX(l, work[col] + 1);
+        }
+
+      work[row] = l;
+      nlev = GSL_MAX(nlev, l + 1);
+    }
+
+  /* counting sort of rows by level */
+  for (k = 0; k <= nlev; ++k)
+    levptr[k] = 0;
+
+  for (i = 0; i < n; ++i)
+    levptr[work[i] + 1]++;
+
+  for (k = 0; k < nlev; ++k)
+    levptr[k + 1] += levptr[k];
+
+  for (k = 0; k < n; ++k)
+    {
+      const int row = lower ? k : n - 1 - k;
+      lev[levptr[work[row]]++] = row;
+    }
+
+  for (k = nlev; k > 0; --k)
+    levptr[k] = levptr[k - 1];
+
+  levptr[0] = 0;
+
+  return nlev;
+}
+
+/* compute level schedules of L and U */
+static int
+ilu_schedule(gsl_splinalg_ilu_workspace *w)
+{
+  w->nlevL = ilu_levels(w->L, 1, w->levL_ptr, w->levL, w->jw);
+  w->nlevU = ilu_levels(w->U, 0, w->levU_ptr, w->levU, w->jw);
+  return GSL_SUCCESS;
+}
@@ -41,6 +41,8 @@ gsl_splinalg_itersolve_alloc(const gsl_splinalg_itersolve_type *T,
 
   w->type = T;
   w->normr = 0.0;
+  w->precon.apply = NULL;
+  w->precon.params = NULL;
 
   w->state = w->type->alloc(n, m);
   if (w->state == NULL)
@@ -61,6 +63,9 @@ gsl_splinalg_itersolve_free(gsl_splinalg_itersolve *w)
   if (w->state)
     w->type->free(w->state);
 
+  if (w->history.normr)
+    free(w->history.normr);
+
   free(w);
 }
 
@@ -75,7 +80,8 @@ gsl_splinalg_itersolve_iterate(const gsl_spmatrix *A, const gsl_vector *b,
                                const double tol, gsl_vector *x,
                                gsl_splinalg_itersolve *w)
 {
-  int status = w->type->iterate(A, b, tol, x, w->state);
+  const gsl_splinalg_precon *P = (w->precon.apply != NULL) ? &(w->precon) : NULL;
+  int status = w->type->iterate(A, b, tol, x, P, &(w->history), w->state);
 
   /* store current residual */
   w->normr = w->type->normr(w->state);
@@ -88,3 +94,98 @@ gsl_splinalg_itersolve_normr(const gsl_splinalg_itersolve *w)
 {
   return w->normr;
 }
+
+/*
+gsl_splinalg_itersolve_set_precon()
+  Set the preconditioner M used by subsequent calls to
+gsl_splinalg_itersolve_iterate(). The callback P->apply must
+compute z = M^{-1} r; the structure P is copied, but P->params
+must remain valid while the preconditioner is in use.
+
+Inputs: w - workspace
+        P - preconditioner, or NULL to remove a previously set one
+*/
+
+int
+gsl_splinalg_itersolve_set_precon(gsl_splinalg_itersolve *w,
+                                  const gsl_splinalg_precon *P)
+{
+  if (P == NULL)
+    {
+      w->precon.apply = NULL;
+      w->precon.params = NULL;
+    }
+  else if (P->apply == NULL)
+    {
+      GSL_ERROR("preconditioner apply function must be provided", GSL_EINVAL);
+    }
+  else
+    {
+      w->precon = *P;
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_splinalg_itersolve_set_history()
+  Record the residual norm after each inner iteration, for up
+to nmax iterations. Setting nmax = 0 disables the history. The
+iteration counter and any previously recorded history are reset.
+*/
+
+int
+gsl_splinalg_itersolve_set_history(gsl_splinalg_itersolve *w,
+                                   const size_t nmax)
+{
+  if (w->history.normr)
+    {
+      free(w->history.normr);
+      w->history.normr = NULL;
+    }
+
+  w->history.nmax = 0;
+
+  if (nmax > 0)
+    {
+      w->history.normr = malloc(nmax * sizeof(double));
+      if (w->history.normr == NULL)
+        {
+          GSL_ERROR("failed to allocate space for residual history",
+                    GSL_ENOMEM);
+        }
+
+      w->history.nmax = nmax;
+    }
+
+  gsl_splinalg_itersolve_reset(w);
+
+  return GSL_SUCCESS;
+}
+
+/* total number of inner iterations since allocation or the last reset */
+size_t
+gsl_splinalg_itersolve_niter(const gsl_splinalg_itersolve *w)
+{
+  return w->history.niter;
+}
+
+/*
+gsl_splinalg_itersolve_history()
+  Return the recorded residual norms; on output n contains
+the number of stored values
+*/
+
+const double *
+gsl_splinalg_itersolve_history(const gsl_splinalg_itersolve *w, size_t *n)
+{
+  *n = w->history.n;
+  return w->history.normr;
+}
+
+void
+gsl_splinalg_itersolve_reset(gsl_splinalg_itersolve *w)
+{
+  w->history.niter = 0;
+  w->history.n = 0;
+}
@@ -0,0 +1,683 @@
+/* splinalg/lu.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * This module implements a sparse LU factorization
+ *
+ * P A Q = L U
+ *
+ * with L unit lower triangular and U upper triangular. The column
+ * permutation Q is a fill-reducing ordering computed in the symbolic
+ * phase, and the row permutation P results from threshold partial
+ * pivoting in the numeric phase.
+ *
+ * The numeric phase is the left-looking algorithm of Gilbert and
+ * Peierls: column k of L and U is obtained from the sparse triangular
+ * solve L x = A(:,q[k]), whose nonzero pattern is found by a depth-first
+ * search in the graph of L. The pivot sequence and the patterns of L
+ * and U may be reused by gsl_splinalg_lu_refactor() for matrices with
+ * the same pattern, which skips the depth-first searches and the pivot
+ * search.
+ *
+ * See
+ *
+ * [1] J. R. Gilbert and T. Peierls, Sparse partial pivoting in time
+ *     proportional to arithmetic operations, SIAM J. Sci. Stat. Comput.
+ *     9(5), 1988.
+ *
+ * [2] T. A. Davis, Direct methods for sparse linear systems, SIAM, 2006.
+ */
+
+#include "pattern.c"
+
+static void lu_free_symbolic(gsl_splinalg_lu_workspace *w);
+static int lu_reach(const gsl_spmatrix *L, const int k,
+                    gsl_splinalg_lu_workspace *w);
+static int lu_reserve(gsl_spmatrix *M, const size_t nz);
+
+/*
+gsl_splinalg_lu_alloc()
+  Allocate a workspace for the sparse LU factorization of
+n-by-n matrices
+
+Inputs: n - size of matrix
+
+Return: pointer to workspace
+*/
+
+gsl_splinalg_lu_workspace *
+gsl_splinalg_lu_alloc(const size_t n)
+{
+  gsl_splinalg_lu_workspace *w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  w = calloc(1, sizeof(gsl_splinalg_lu_workspace));
+  if (!w)
+    {
+      GSL_ERROR_NULL("failed to allocate lu workspace", GSL_ENOMEM);
+    }
+
+  w->n = n;
+
+  w->p = gsl_permutation_alloc(n);
+  w->q = gsl_permutation_alloc(n);
+  if (!w->p || !w->q)
+    {
+      gsl_splinalg_lu_free(w);
+      GSL_ERROR_NULL("failed to allocate permutations", GSL_ENOMEM);
+    }
+
+  w->pinv = malloc(n * sizeof(int));
+  w->Cp = malloc((n + 1) * sizeof(int));
+  w->iwork = malloc(3 * n * sizeof(int));
+  w->work = malloc(n * sizeof(double));
+  if (!w->pinv || !w->Cp || !w->iwork || !w->work)
+    {
+      gsl_splinalg_lu_free(w);
+      GSL_ERROR_NULL("failed to allocate work arrays", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_splinalg_lu_free(gsl_splinalg_lu_workspace *w)
+{
+  lu_free_symbolic(w);
+
+  if (w->p)
+    gsl_permutation_free(w->p);
+
+  if (w->q)
+    gsl_permutation_free(w->q);
+
+  if (w->pinv)
+    free(w->pinv);
+
+  if (w->Cp)
+    free(w->Cp);
+
+  if (w->iwork)
+    free(w->iwork);
+
+  if (w->work)
+    free(w->work);
+
+  free(w);
+}
+
+/*
+gsl_splinalg_lu_symbolic()
+  Symbolic analysis for the sparse LU factorization of A
+
+Inputs: A - square sparse matrix in COO, CSC or CSR format
+        q - fill-reducing column permutation; if NULL, an approximate
+            minimum degree ordering of A + A^T is computed
+        w - workspace
+
+Return: success/error
+
+Notes:
+1) The analysis may be reused by gsl_splinalg_lu_numeric() for any
+matrix with the same sparsity pattern and storage format as A
+*/
+
+int
+gsl_splinalg_lu_symbolic(const gsl_spmatrix *A, const gsl_permutation *q,
+                         gsl_splinalg_lu_workspace *w)
+{
+  const size_t n = w->n;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (A->size1 != n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else if (q != NULL && q->size != n)
+    {
+      GSL_ERROR("permutation does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t nzA = gsl_spmatrix_nnz(A);
+      int *qinv = w->iwork;
+      size_t k;
+      int status;
+
+      lu_free_symbolic(w);
+
+      if (q != NULL)
+        status = gsl_permutation_memcpy(w->q, q);
+      else
+        status = gsl_splinalg_amd(A, w->q);
+
+      if (status)
+        return status;
+
+      w->nnz = nzA;
+      w->Ci = malloc((nzA + 1) * sizeof(int));
+      w->Cx = malloc((nzA + 1) * sizeof(double));
+      w->map = malloc((nzA + 1) * sizeof(int));
+      if (!w->Ci || !w->Cx || !w->map)
+        {
+          lu_free_symbolic(w);
+          GSL_ERROR("failed to allocate pattern arrays", GSL_ENOMEM);
+        }
+
+      /* pattern of A Q */
+      for (k = 0; k < n; ++k)
+        qinv[w->q->data[k]] = (int) k;
+
+      status = pattern_csc(A, NULL, qinv, 0, w->Cp, w->Ci, w->map);
+      if (status)
+        {
+          lu_free_symbolic(w);
+          return status;
+        }
+
+      /* initial guess for the size of the factors; they grow as needed */
+      w->L = gsl_spmatrix_alloc_nzmax(n, n, 2 * nzA + n, GSL_SPMATRIX_CSC);
+      w->U = gsl_spmatrix_alloc_nzmax(n, n, 2 * nzA + n, GSL_SPMATRIX_CSC);
+      if (!w->L || !w->U)
+        {
+          lu_free_symbolic(w);
+          GSL_ERROR("failed to allocate factors", GSL_ENOMEM);
+        }
+
+      w->factored = 0;
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_lu_numeric()
+  Numeric sparse LU factorization P A Q = L U with threshold partial
+pivoting
+
+Inputs: A      - square sparse matrix, with the same pattern and storage
+                 format as the matrix given to the symbolic phase
+        pivtol - pivot tolerance in [0,1]; the diagonal element
+                 A(q[k],q[k]) is chosen as pivot if its magnitude is at
+                 least pivtol times the largest candidate in its column,
+                 so pivtol = 1 gives partial pivoting
+        w      - workspace
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_lu_numeric(const gsl_spmatrix *A, const double pivtol,
+                        gsl_splinalg_lu_workspace *w)
+{
+  if (w->L == NULL)
+    {
+      GSL_ERROR("symbolic analysis has not been computed", GSL_EINVAL);
+    }
+  else if (A->size1 != w->n || A->size2 != w->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else if (gsl_spmatrix_nnz(A) != w->nnz)
+    {
+      GSL_ERROR("matrix pattern does not match symbolic analysis", GSL_EINVAL);
+    }
+  else if (pivtol < 0.0 || pivtol > 1.0)
+    {
+      GSL_ERROR("pivot tolerance must be in [0,1]", GSL_EDOM);
+    }
+  else
+    {
+      const int n = (int) w->n;
+      gsl_spmatrix *L = w->L;
+      gsl_spmatrix *U = w->U;
+      double *x = w->work;
+      int *pinv = w->pinv;
+      int *xi = w->iwork;
+      int *mark = xi + 2 * n;
+      size_t lnz = 0, unz = 0;
+      size_t t;
+      int i, k, status;
+
+      for (t = 0; t < w->nnz; ++t)
+        {
+          if (w->map[t] >= 0)
+            w->Cx[w->map[t]] = A->data[t];
+        }
+
+      w->factored = 0;
+
+      for (i = 0; i < n; ++i)
+        {
+          x[i] = 0.0;
+          pinv[i] = -1;
+          mark[i] = -1;
+        }
+
+      for (k = 0; k < n; ++k)
+        {
+          const int diag = (int) w->q->data[k];
+          int ipiv = -1, top, px;
+          double a = -1.0, pivot;
+
+          L->p[k] = (int) lnz;
+          U->p[k] = (int) unz;
+
+          status = lu_reserve(L, lnz + n);
+          if (!status)
+            status = lu_reserve(U, unz + n);
+          if (status)
+            return status;
+
+          /* x = L \ A(:,q[k]); the pattern of x is xi[top..n-1], in topological order */
+          top = lu_reach(L, k, w);
+
+          for (px = w->Cp[k]; px < w->Cp[k + 1]; ++px)
+            x[w->Ci[px]] += w->Cx[px];
+
+          for (px = top; px < n; ++px)
+            {
+              const int j = xi[px];
+              const int J = pinv[j];
+              int p;
+
+              if (J < 0)
+                continue;
+
+              /* L has unit diagonal, stored first in each column */
+              for (p = L->p[J] + 1; p < L->p[J + 1]; ++p)
+                x[L->i[p]] -= L->data[p] * x[j];
+            }
+
+          /* store U(:,k) and find the largest candidate pivot */
+          for (px = top; px < n; ++px)
+            {
+              const int j = xi[px];
+
+              if (pinv[j] < 0)
+                {
+                  double t2 = fabs(x[j]);
+                  if (t2 > a)
+                    {
+                      a = t2;
+                      ipiv = j;
+                    }
+                }
+              else
+                {
+                  U->i[unz] = pinv[j];
+                  U->data[unz++] = x[j];
+                }
+            }
+
+          if (ipiv == -1 || a <= 0.0)
+            {
+              GSL_ERROR("matrix is singular", GSL_EDOM);
+            }
+
+          /* prefer the diagonal if it is large enough */
+          if (pinv[diag] < 0 && fabs(x[diag]) >= pivtol * a)
+            ipiv = diag;
+
+          pivot = x[ipiv];
+          U->i[unz] = k;
+          U->data[unz++] = pivot;
+          pinv[ipiv] = k;
+
+          L->i[lnz] = ipiv;
+          L->data[lnz++] = 1.0;
+
+          for (px = top; px < n; ++px)
+            {
+              const int j = xi[px];
+
+              if (pinv[j] < 0)
+                {
+                  L->i[lnz] = j;
+                  L->data[lnz++] = x[j] / pivot;
+                }
+
+              x[j] = 0.0;
+            }
+        }
+
+      L->p[n] = (int) lnz;
+      U->p[n] = (int) unz;
+      L->nz = lnz;
+      U->nz = unz;
+
+      /* renumber the rows of L by pivot order, and store P */
+      for (t = 0; t < lnz; ++t)
+        L->i[t] = pinv[L->i[t]];
+
+      for (i = 0; i < n; ++i)
+        w->p->data[pinv[i]] = (size_t) i;
+
+      w->factored = 1;
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_lu_refactor()
+  Numeric sparse LU factorization, reusing the row permutation and
+the patterns of L and U from a previous call to gsl_splinalg_lu_numeric()
+
+Inputs: A - square sparse matrix, with the same pattern and storage
+            format as the previously factored matrix
+        w - workspace
+
+Return: success/error
+
+Notes:
+1) No pivoting is performed; if a zero pivot occurs, GSL_EDOM is
+returned and gsl_splinalg_lu_numeric() should be called instead
+*/
+
+int
+gsl_splinalg_lu_refactor(const gsl_spmatrix *A, gsl_splinalg_lu_workspace *w)
+{
+  if (!w->factored)
+    {
+      GSL_ERROR("numeric factorization has not been computed", GSL_EINVAL);
+    }
+  else if (A->size1 != w->n || A->size2 != w->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else if (gsl_spmatrix_nnz(A) != w->nnz)
+    {
+      GSL_ERROR("matrix pattern does not match symbolic analysis", GSL_EINVAL);
+    }
+  else
+    {
+      const int n = (int) w->n;
+      gsl_spmatrix *L = w->L;
+      gsl_spmatrix *U = w->U;
+      double *x = w->work;
+      const int *pinv = w->pinv;
+      size_t t;
+      int k;
+
+      for (t = 0; t < w->nnz; ++t)
+        {
+          if (w->map[t] >= 0)
+            w->Cx[w->map[t]] = A->data[t];
+        }
+
+      for (k = 0; k < n; ++k)
+        x[k] = 0.0;
+
+      for (k = 0; k < n; ++k)
+        {
+          const int ulast = U->p[k + 1] - 1;
+          double pivot;
+          int p, q;
+
+          for (p = w->Cp[k]; p < w->Cp[k + 1]; ++p)
+            x[pinv[w->Ci[p]]] += w->Cx[p];
+
+          /* U(:,k) is stored in topological order, with the diagonal last */
+          for (p = U->p[k]; p < ulast; ++p)
+            {
+              const int j = U->i[p];
+              const double ujk = x[j];
+
+              U->data[p] = ujk;
+              x[j] = 0.0;
+
+              for (q = L->p[j] + 1; q < L->p[j + 1]; ++q)
+                x[L->i[q]] -= L->data[q] * ujk;
+            }
+
+          pivot = x[k];
+          x[k] = 0.0;
+
+          if (pivot == 0.0)
+            {
+              w->factored = 0;
+              GSL_ERROR("zero pivot encountered, refactor with pivoting", GSL_EDOM);
+            }
+
+          U->data[ulast] = pivot;
+
+          for (q = L->p[k] + 1; q < L->p[k + 1]; ++q)
+            {
+              L->data[q] = x[L->i[q]] / pivot;
+              x[L->i[q]] = 0.0;
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_lu_solve()
+  Solve A x = b using the sparse LU factorization
+
+Inputs: w - workspace containing factorization
+        b - right hand side vector
+        x - (output) solution vector
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_lu_solve(gsl_splinalg_lu_workspace *w, const gsl_vector *b,
+                      gsl_vector *x)
+{
+  if (w->n != b->size)
+    {
+      GSL_ERROR("right hand side vector does not match factorization", GSL_EBADLEN);
+    }
+  else if (w->n != x->size)
+    {
+      GSL_ERROR("solution vector does not match factorization", GSL_EBADLEN);
+    }
+  else
+    {
+      int status = gsl_vector_memcpy(x, b);
+
+      if (status)
+        return status;
+
+      return gsl_splinalg_lu_svx(w, x);
+    }
+}
+
+/*
+gsl_splinalg_lu_svx()
+  Solve A x = b in place using the sparse LU factorization
+
+Inputs: w - workspace containing factorization
+        x - (input/output) on input, right hand side vector b;
+            on output, solution vector
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_lu_svx(gsl_splinalg_lu_workspace *w, gsl_vector *x)
+{
+  if (!w->factored)
+    {
+      GSL_ERROR("factorization has not been computed", GSL_EINVAL);
+    }
+  else if (w->n != x->size)
+    {
+      GSL_ERROR("solution vector does not match factorization", GSL_EBADLEN);
+    }
+  else
+    {
+      const int n = (int) w->n;
+      const gsl_spmatrix *L = w->L;
+      const gsl_spmatrix *U = w->U;
+      double *y = w->work;
+      int j, p;
+
+      /* y = P b */
+      for (j = 0; j < n; ++j)
+        y[w->pinv[j]] = gsl_vector_get(x, j);
+
+      /* L y = P b */
+      for (j = 0; j < n; ++j)
+        {
+          const double yj = y[j];
+          for (p = L->p[j] + 1; p < L->p[j + 1]; ++p)
+            y[L->i[p]] -= L->data[p] * yj;
+        }
+
+      /* U z = y */
+      for (j = n - 1; j >= 0; --j)
+        {
+          const int ulast = U->p[j + 1] - 1;
+          double yj;
+
+          y[j] /= U->data[ulast];
+          yj = y[j];
+
+          for (p = U->p[j]; p < ulast; ++p)
+            y[U->i[p]] -= U->data[p] * yj;
+        }
+
+      /* x = Q z */
+      for (j = 0; j < n; ++j)
+        gsl_vector_set(x, w->q->data[j], y[j]);
+
+      return GSL_SUCCESS;
+    }
+}
+
+static void
+lu_free_symbolic(gsl_splinalg_lu_workspace *w)
+{
+  free(w->Ci);
+  free(w->Cx);
+  free(w->map);
+
+  if (w->L)
+    gsl_spmatrix_free(w->L);
+
+  if (w->U)
+    gsl_spmatrix_free(w->U);
+
+  w->Ci = NULL;
+  w->Cx = NULL;
+  w->map = NULL;
+  w->L = NULL;
+  w->U = NULL;
+  w->factored = 0;
+}
+
+/*
+lu_reach()
+  Compute the nonzero pattern of the solution of L x = A(:,q[k]), which
+is the set of nodes reachable from the pattern of A(:,q[k]) in the graph
+of L (columns 0..k-1)
+
+Return: top, such that the pattern is xi[top..n-1] in topological order
+*/
+
+static int
+lu_reach(const gsl_spmatrix *L, const int k, gsl_splinalg_lu_workspace *w)
+{
+  const int n = (int) w->n;
+  const int *pinv = w->pinv;
+  int *xi = w->iwork;
+  int *pstack = xi + n;
+  int *mark = pstack + n;
+  int top = n;
+  int px;
+
+  for (px = w->Cp[k]; px < w->Cp[k + 1]; ++px)
+    {
+      int head = 0;
+
+      if (mark[w->Ci[px]] == k)
+        continue;
+
+      /* non-recursive depth-first search, stack in xi[0..head] */
+      xi[0] = w->Ci[px];
+
+      while (head >= 0)
+        {
+          const int j = xi[head];
+          const int J = pinv[j];
+          int done = 1, p, pend;
+
+          if (mark[j] != k)
+            {
+              mark[j] = k;
+              pstack[head] = (J < 0) ? 0 : L->p[J] + 1;
+            }
+
+          pend = (J < 0) ? 0 : L->p[J + 1];
+
+          for (p = pstack[head]; p < pend; ++p)
+            {
+              const int i = L->i[p];
+
+              if (mark[i] == k)
+                continue;
+
+              pstack[head] = p + 1;
+              xi[++head] = i;
+              done = 0;
+              break;
+            }
+
+          if (done)
+            {
+              --head;
+              xi[--top] = j;
+            }
+        }
+    }
+
+  return top;
+}
+
+/* ensure M can hold nz elements */
+static int
+lu_reserve(gsl_spmatrix *M, const size_t nz)
+{
+  if (nz > M->nzmax)
+    return gsl_spmatrix_realloc(GSL_MAX(nz, 2 * M->nzmax), M);
+
+  return GSL_SUCCESS;
+}
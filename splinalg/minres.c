@@ -0,0 +1,343 @@
+/* minres.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * The code in this module implements the preconditioned MINRES
+ * method for symmetric (possibly indefinite) systems, see
+ *
+ * [1] C. C. Paige and M. A. Saunders, Solution of sparse indefinite
+ *     systems of linear equations, SIAM J. Numer. Anal. 12(4), 1975.
+ *
+ * The Lanczos vectors are generated with a symmetric positive
+ * definite preconditioner M, and the residual is minimized in
+ * the M^{-1} norm. The implementation follows the structure of the
+ * SOL reference code by Paige and Saunders.
+ */
+
+typedef struct
+{
+  size_t n;        /* size of linear system */
+  size_t maxit;    /* maximum iterations per call to iterate */
+  gsl_vector *r1;  /* Lanczos residuals */
+  gsl_vector *r2;
+  gsl_vector *y;   /* preconditioned Lanczos vector */
+  gsl_vector *v;   /* normalized Lanczos vector */
+  gsl_vector *w;   /* search directions w_k, w_{k-1}, w_{k-2} */
+  gsl_vector *w1;
+  gsl_vector *w2;
+
+  double normr;    /* residual norm ||r|| */
+} minres_state_t;
+
+static void minres_free(void *vstate);
+static int minres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+                          const double tol, gsl_vector *x,
+                          const gsl_splinalg_precon *P,
+                          gsl_splinalg_history *h, void *vstate);
+
+#include "common.c"
+
+/*
+minres_alloc()
+  Allocate a MINRES workspace for solving an n-by-n system A x = b
+
+Inputs: n - size of system
+        m - maximum number of iterations performed by each call
+            to iterate; if 0, the value n is used
+
+Return: pointer to workspace
+*/
+
+static void *
+minres_alloc(const size_t n, const size_t m)
+{
+  minres_state_t *state;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  state = calloc(1, sizeof(minres_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate minres state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+  state->maxit = (m == 0) ? n : m;
+
+  state->r1 = gsl_vector_alloc(n);
+  state->r2 = gsl_vector_alloc(n);
+  state->y = gsl_vector_alloc(n);
+  state->v = gsl_vector_alloc(n);
+  state->w = gsl_vector_alloc(n);
+  state->w1 = gsl_vector_alloc(n);
+  state->w2 = gsl_vector_alloc(n);
+  if (!state->r1 || !state->r2 || !state->y || !state->v ||
+      !state->w || !state->w1 || !state->w2)
+    {
+      minres_free(state);
+      GSL_ERROR_NULL("failed to allocate minres vectors", GSL_ENOMEM);
+    }
+
+  state->normr = 0.0;
+
+  return state;
+} /* minres_alloc() */
+
+static void
+minres_free(void *vstate)
+{
+  minres_state_t *state = (minres_state_t *) vstate;
+
+  if (state->r1)
+    gsl_vector_free(state->r1);
+
+  if (state->r2)
+    gsl_vector_free(state->r2);
+
+  if (state->y)
+    gsl_vector_free(state->y);
+
+  if (state->v)
+    gsl_vector_free(state->v);
+
+  if (state->w)
+    gsl_vector_free(state->w);
+
+  if (state->w1)
+    gsl_vector_free(state->w1);
+
+  if (state->w2)
+    gsl_vector_free(state->w2);
+
+  free(state);
+} /* minres_free() */
+
+/*
+minres_iterate()
+  Solve A*x = b using the MINRES method
+
+Inputs: A    - sparse symmetric matrix
+        b    - right hand side vector
+        tol  - stopping tolerance
+        x    - (input/output) on input, initial estimate x_0;
+               on output, solution vector
+        P    - symmetric positive definite preconditioner M, or NULL
+        h    - (output) iteration count and residual history
+        work - workspace
+
+Return:
+GSL_SUCCESS if ||b - A*x|| <= tol * ||b||, GSL_CONTINUE if the
+maximum number of iterations was reached first. In the latter case
+calling this function again restarts the method from the current x.
+
+Notes:
+1) The residual history records the MINRES estimate of ||r||_{M^{-1}},
+which equals ||r|| without preconditioning
+*/
+
+static int
+minres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+               const double tol, gsl_vector *x,
+               const gsl_splinalg_precon *P,
+               gsl_splinalg_history *h, void *vstate)
+{
+  const size_t N = A->size1;
+  minres_state_t *state = (minres_state_t *) vstate;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (N != b->size)
+    {
+      GSL_ERROR("matrix does not match right hand side", GSL_EBADLEN);
+    }
+  else if (N != x->size)
+    {
+      GSL_ERROR("matrix does not match solution vector", GSL_EBADLEN);
+    }
+  else if (N != state->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      const double normb = gsl_blas_dnrm2(b);
+      const double reltol = tol * normb;
+      gsl_vector *r1 = state->r1;
+      gsl_vector *r2 = state->r2;
+      gsl_vector *y = state->y;
+      gsl_vector *v = state->v;
+      gsl_vector *w = state->w;
+      gsl_vector *w1 = state->w1;
+      gsl_vector *w2 = state->w2;
+      double beta1, beta, oldb, alpha, tmp;
+      double dbar = 0.0, epsln = 0.0, oldeps;
+      double delta, gbar, gamma, phi, phibar;
+      double cs = -1.0, sn = 0.0;
+      double normr;
+      size_t k;
+
+      /* r1 = b - A*x_0, y = M^{-1} r1 */
+      gsl_vector_memcpy(r1, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r1);
+      normr = gsl_blas_dnrm2(r1);
+
+      if (normr <= reltol)
+        {
+          state->normr = normr;
+          return GSL_SUCCESS;
+        }
+
+      status = splinalg_precon(P, r1, y);
+      if (status)
+        return status;
+
+      gsl_blas_ddot(r1, y, &tmp);
+      if (tmp <= 0.0)
+        {
+          GSL_ERROR("preconditioner is not positive definite", GSL_EDOM);
+        }
+
+      beta1 = sqrt(tmp);
+      beta = beta1;
+      oldb = 0.0;
+      phibar = beta1;
+
+      gsl_vector_memcpy(r2, r1);
+      gsl_vector_set_zero(w);
+      gsl_vector_set_zero(w2);
+
+      for (k = 0; k < state->maxit; ++k)
+        {
+          gsl_vector *wtmp;
+
+          /* v = y / beta, y = A*v */
+          gsl_vector_memcpy(v, y);
+          gsl_vector_scale(v, 1.0 / beta);
+          gsl_spblas_dgemv(CblasNoTrans, 1.0, A, v, 0.0, y);
+
+          if (k > 0)
+            gsl_blas_daxpy(-beta / oldb, r1, y);
+
+          gsl_blas_ddot(v, y, &alpha);
+          gsl_blas_daxpy(-alpha / beta, r2, y);
+
+          /* r1 = r2, r2 = y, y = M^{-1} r2 */
+          gsl_vector_memcpy(r1, r2);
+          gsl_vector_memcpy(r2, y);
+
+          status = splinalg_precon(P, r2, y);
+          if (status)
+            return status;
+
+          oldb = beta;
+          gsl_blas_ddot(r2, y, &tmp);
+          if (tmp < 0.0)
+            {
+              GSL_ERROR("preconditioner is not positive definite", GSL_EDOM);
+            }
+
+          beta = sqrt(tmp);
+
+          /* apply previous rotation and compute the next one */
+          oldeps = epsln;
+          delta = cs * dbar + sn * alpha;
+          gbar = sn * dbar - cs * alpha;
+          epsln = sn * beta;
+          dbar = -cs * beta;
+
+          gamma = gsl_hypot(gbar, beta);
+          gamma = GSL_MAX(gamma, GSL_DBL_EPSILON);
+          cs = gbar / gamma;
+          sn = beta / gamma;
+          phi = cs * phibar;
+          phibar = sn * phibar;
+
+          /* w = (v - oldeps*w1 - delta*w2) / gamma, rotating w -> w2 -> w1 */
+          wtmp = w1;
+          w1 = w2;
+          w2 = w;
+          w = wtmp;
+
+          gsl_vector_memcpy(w, v);
+          gsl_blas_daxpy(-oldeps, w1, w);
+          gsl_blas_daxpy(-delta, w2, w);
+          gsl_vector_scale(w, 1.0 / gamma);
+
+          /* x = x + phi*w */
+          gsl_blas_daxpy(phi, w, x);
+
+          splinalg_history_add(h, phibar);
+
+          if (phibar <= reltol || beta == 0.0)
+            break;
+        }
+
+      /* restore vector pointers, which were rotated above */
+      state->w = w;
+      state->w1 = w1;
+      state->w2 = w2;
+
+      /* compute true residual r = b - A*x */
+      gsl_vector_memcpy(r1, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r1);
+      normr = gsl_blas_dnrm2(r1);
+
+      state->normr = normr;
+
+      if (normr <= reltol)
+        return GSL_SUCCESS;
+      else
+        return GSL_CONTINUE;
+    }
+} /* minres_iterate() */
+
+static double
+minres_normr(const void *vstate)
+{
+  const minres_state_t *state = (const minres_state_t *) vstate;
+  return state->normr;
+} /* minres_normr() */
+
+static const gsl_splinalg_itersolve_type minres_type =
+{
+  "minres",
+  &minres_alloc,
+  &minres_iterate,
+  &minres_normr,
+  &minres_free
+};
+
+const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_minres =
+  &minres_type;
@@ -0,0 +1,1392 @@
+/* order.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * This module contains fill-reducing orderings of sparse matrices
+ */
+
+#include "pattern.c"
+
+/* growable list of integers */
+typedef struct
+{
+  int *data;
+  size_t len;
+  size_t cap;
+} order_list;
+
+/* graph with vertex and edge weights, used by the multilevel bisection */
+typedef struct
+{
+  size_t n;
+  int *xadj;    /* neighbors of vertex i are adj[xadj[i]..xadj[i+1]-1] */
+  int *adj;
+  int *ew;      /* edge weights */
+  int *vw;      /* vertex weights */
+} order_wgraph;
+
+/* stop coarsening at this many vertices */
+#define ORDER_COARSEN_MIN     100
+
+/* maximum number of coarsening levels */
+#define ORDER_MAX_LEVELS      64
+
+/* number of initial partitions tried on the coarsest graph */
+#define ORDER_INIT_TRIALS     4
+
+/* maximum number of refinement passes per level */
+#define ORDER_REFINE_PASSES   8
+
+static int order_graph(const gsl_spmatrix *A, int *xadj, int **adj);
+static int order_push(order_list *l, const int x);
+static size_t order_bfs(const int *xadj, const int *adj, const int root,
+                        int *mark, const int tag, int *queue, size_t *nreach,
+                        size_t *nlast);
+static void order_sort_degree(int *v, const size_t n, const int *deg, int *tmp);
+static int order_wgraph_alloc(const size_t n, const size_t nedge, order_wgraph *g);
+static void order_wgraph_free(order_wgraph *g);
+static int order_coarsen(const order_wgraph *g, order_wgraph *gc, int *cmap);
+static int order_initpart(const order_wgraph *g, int *part);
+static void order_refine(const order_wgraph *g, int *part);
+static int order_mlbisect(const order_wgraph *g, int *part);
+static int order_subgraph(const order_wgraph *g, const int *part, const int which,
+                          order_wgraph *s, int *map);
+static int order_bisect_recurse(const order_wgraph *g, const int *label,
+                                const size_t leafsize, size_t *out, size_t *pos);
+
+/*
+gsl_splinalg_amd()
+  Compute an approximate minimum degree ordering of the symmetric
+matrix A + A^T
+
+Inputs: A - square sparse matrix in COO, CSC or CSR format
+        p - (output) permutation; row/column k of P A P^T is row/column
+            p[k] of A
+
+Return: success/error
+
+Notes:
+1) The elimination is simulated on the quotient graph, in which each
+eliminated node becomes an element whose variable list is the clique
+it creates; elements adjacent to the pivot are absorbed into the new
+element, and edges between variables of the new element are pruned.
+
+2) The external degree of variable i is bounded by
+
+   d_i <= |A_i| + sum_{e in E_i} |L_e \ {i}|
+
+where A_i are the variables and E_i the elements adjacent to i,
+which is the approximation used to select pivots.
+
+3) See P. R. Amestoy, T. A. Davis and I. S. Duff, An approximate
+minimum degree ordering algorithm, SIAM J. Matrix Anal. Appl.
+17(4), 1996.
+*/
+
+int
+gsl_splinalg_amd(const gsl_spmatrix *A, gsl_permutation *p)
+{
+  const size_t n = A->size1;
+
+  if (n != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (n != p->size)
+    {
+      GSL_ERROR("permutation does not match matrix", GSL_EBADLEN);
+    }
+  else
+    {
+      int status = GSL_SUCCESS;
+      order_list *avar;  /* A_i: variables adjacent to variable i */
+      order_list *eadj;  /* E_i: elements adjacent to variable i */
+      order_list *elist; /* L_e: variables of element e */
+      int *xadj, *adj = NULL;
+      int *iwork;
+      int *deg, *head, *next, *prev, *mark, *state;
+      int tag = 0;
+      size_t mindeg = 0;
+      size_t i, k;
+
+      iwork = malloc((7 * n + 2) * sizeof(int));
+      avar = calloc(3 * n, sizeof(order_list));
+      if (!iwork || !avar)
+        {
+          free(iwork);
+          free(avar);
+          GSL_ERROR("failed to allocate space for amd", GSL_ENOMEM);
+        }
+
+      eadj = avar + n;
+      elist = eadj + n;
+      deg = iwork;       /* approximate degree of each variable */
+      head = deg + n;    /* head[d]: first variable of degree d, length n + 1 */
+      next = head + n + 1;
+      prev = next + n;
+      mark = prev + n;
+      state = mark + n;  /* 0 = variable, 1 = element, 2 = absorbed element */
+      xadj = state + n;  /* length n + 1 */
+
+      status = order_graph(A, xadj, &adj);
+      if (status)
+        goto cleanup;
+
+      for (i = 0; i <= n; ++i)
+        head[i] = -1;
+
+      for (i = 0; i < n; ++i)
+        {
+          const int d = xadj[i + 1] - xadj[i];
+
+          /* A_i initially points into adj and is only shrunk in place */
+          avar[i].data = adj + xadj[i];
+          avar[i].len = d;
+          avar[i].cap = 0;
+
+          deg[i] = d;
+          mark[i] = 0;
+          state[i] = 0;
+          prev[i] = -1;
+          next[i] = head[d];
+          if (head[d] >= 0)
+            prev[head[d]] = (int) i;
+          head[d] = (int) i;
+        }
+
+      for (k = 0; k < n; ++k)
+        {
+          order_list *Lp;
+          int piv;
+          size_t t;
+
+          /* select a variable of minimum approximate degree */
+          while (head[mindeg] < 0)
+            ++mindeg;
+
+          piv = head[mindeg];
+          head[mindeg] = next[piv];
+          if (next[piv] >= 0)
+            prev[next[piv]] = -1;
+
+          p->data[k] = (size_t) piv;
+          state[piv] = 1;
+
+          /* form the new element L_p = A_p u (L_e for e in E_p), absorbing each e */
+          ++tag;
+          Lp = &elist[piv];
+
+          for (t = 0; t < avar[piv].len; ++t)
+            {
+              int v = avar[piv].data[t];
+              if (state[v] == 0 && mark[v] != tag)
+                {
+                  mark[v] = tag;
+                  status = order_push(Lp, v);
+                  if (status)
+                    goto cleanup;
+                }
+            }
+
+          for (t = 0; t < eadj[piv].len; ++t)
+            {
+              int e = eadj[piv].data[t];
+              size_t u;
+
+              if (state[e] != 1)
+                continue;
+
+              for (u = 0; u < elist[e].len; ++u)
+                {
+                  int v = elist[e].data[u];
+                  if (state[v] == 0 && mark[v] != tag)
+                    {
+                      mark[v] = tag;
+                      status = order_push(Lp, v);
+                      if (status)
+                        goto cleanup;
+                    }
+                }
+
+              state[e] = 2;
+              free(elist[e].data);
+              elist[e].data = NULL;
+              elist[e].len = elist[e].cap = 0;
+            }
+
+          if (avar[piv].cap)
+            free(avar[piv].data);
+          free(eadj[piv].data);
+          avar[piv].data = eadj[piv].data = NULL;
+          avar[piv].len = eadj[piv].len = 0;
+          avar[piv].cap = eadj[piv].cap = 0;
+
+          /* update the variables of the new element */
+          for (t = 0; t < Lp->len; ++t)
+            {
+              const int v = Lp->data[t];
+              order_list *Av = &avar[v];
+              order_list *Ev = &eadj[v];
+              size_t u, len, d;
+
+              /* remove v from its degree list */
+              if (prev[v] >= 0)
+                next[prev[v]] = next[v];
+              else
+                head[deg[v]] = next[v];
+
+              if (next[v] >= 0)
+                prev[next[v]] = prev[v];
+
+              /* E_v = (E_v \ absorbed) u {p} */
+              for (u = 0, len = 0; u < Ev->len; ++u)
+                {
+                  if (state[Ev->data[u]] == 1)
+                    Ev->data[len++] = Ev->data[u];
+                }
+
+              Ev->len = len;
+              status = order_push(Ev, piv);
+              if (status)
+                goto cleanup;
+
+              /* A_v = A_v \ (L_p u eliminated variables) */
+              for (u = 0, len = 0; u < Av->len; ++u)
+                {
+                  int w = Av->data[u];
+                  if (state[w] == 0 && mark[w] != tag)
+                    Av->data[len++] = w;
+                }
+
+              Av->len = len;
+
+              /* approximate external degree */
+              d = Av->len + Lp->len - 1;
+              for (u = 0; u + 1 < Ev->len; ++u)
+                d += elist[Ev->data[u]].len - 1;
+
+              d = GSL_MIN(d, n - k - 1);
+              deg[v] = (int) d;
+
+              prev[v] = -1;
+              next[v] = head[d];
+              if (head[d] >= 0)
+                prev[head[d]] = v;
+              head[d] = v;
+
+              mindeg = GSL_MIN(mindeg, d);
+            }
+        }
+
+cleanup:
+      for (i = 0; i < n; ++i)
+        {
+          if (avar[i].cap)
+            free(avar[i].data);
+          free(eadj[i].data);
+          free(elist[i].data);
+        }
+
+      free(avar);
+      free(iwork);
+      free(adj);
+
+      return status;
+    }
+}
+
+/*
+gsl_splinalg_rcm()
+  Compute a reverse Cuthill-McKee ordering of the symmetric matrix
+A + A^T, which reduces its bandwidth and profile
+
+Inputs: A - square sparse matrix in COO, CSC or CSR format
+        p - (output) permutation; row/column k of P A P^T is row/column
+            p[k] of A
+
+Return: success/error
+
+Notes:
+1) Each connected component is numbered by a breadth first search
+starting from a pseudo-peripheral vertex, found with the algorithm of
+Gibbs, Poole and Stockmeyer as modified by George and Liu; the
+neighbors of each vertex are visited in order of increasing degree.
+The final ordering is reversed.
+
+2) See A. George and J. W. H. Liu, Computer Solution of Large Sparse
+Positive Definite Systems, Prentice-Hall, 1981.
+*/
+
+int
+gsl_splinalg_rcm(const gsl_spmatrix *A, gsl_permutation *p)
+{
+  const size_t n = A->size1;
+
+  if (n != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (n != p->size)
+    {
+      GSL_ERROR("permutation does not match matrix", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      int *iwork, *xadj, *adj = NULL;
+      int *deg, *mark, *queue, *tmp;
+      int tag = 0;
+      size_t i, k = 0;
+
+      iwork = malloc((5 * n + 1) * sizeof(int));
+      if (!iwork)
+        {
+          GSL_ERROR("failed to allocate space for rcm", GSL_ENOMEM);
+        }
+
+      xadj = iwork;         /* length n + 1 */
+      deg = xadj + n + 1;
+      mark = deg + n;       /* BFS tag, or -1 for numbered vertices */
+      queue = mark + n;
+      tmp = queue + n;
+
+      status = order_graph(A, xadj, &adj);
+      if (status)
+        {
+          free(iwork);
+          return status;
+        }
+
+      for (i = 0; i < n; ++i)
+        {
+          deg[i] = xadj[i + 1] - xadj[i];
+          mark[i] = 0;
+        }
+
+      for (i = 0; i < n; ++i)
+        {
+          int root = (int) i;
+          size_t nlevels, nreach, nlast, head;
+
+          if (mark[i] < 0)
+            continue;
+
+          /* find a pseudo-peripheral vertex of this component */
+          nlevels = order_bfs(xadj, adj, root, mark, ++tag, queue, &nreach, &nlast);
+
+          while (1)
+            {
+              int x = queue[nreach - nlast];
+              size_t t, nlevels_x;
+
+              /* vertex of minimum degree in the last level */
+              for (t = nreach - nlast + 1; t < nreach; ++t)
+                {
+                  if (deg[queue[t]] < deg[x])
+                    x = queue[t];
+                }
+
+              nlevels_x = order_bfs(xadj, adj, x, mark, ++tag, queue, &nreach, &nlast);
+              if (nlevels_x <= nlevels)
+                break;
+
+              root = x;
+              nlevels = nlevels_x;
+            }
+
+          /* Cuthill-McKee numbering of the component */
+          p->data[k++] = (size_t) root;
+          mark[root] = -1;
+
+          for (head = k - 1; head < k; ++head)
+            {
+              const size_t v = p->data[head];
+              size_t cnt = 0, t;
+              int q;
+
+              for (q = xadj[v]; q < xadj[v + 1]; ++q)
+                {
+                  int w = adj[q];
+                  if (mark[w] >= 0)
+                    {
+                      mark[w] = -1;
+                      queue[cnt++] = w;
+                    }
+                }
+
+              order_sort_degree(queue, cnt, deg, tmp);
+
+              for (t = 0; t < cnt; ++t)
+                p->data[k++] = (size_t) queue[t];
+            }
+        }
+
+      /* reverse */
+      for (i = 0; i < n / 2; ++i)
+        {
+          size_t tmpi = p->data[i];
+          p->data[i] = p->data[n - 1 - i];
+          p->data[n - 1 - i] = tmpi;
+        }
+
+      free(iwork);
+      free(adj);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_bisect()
+  Compute an ordering of the symmetric matrix A + A^T by recursive
+multilevel bisection of its graph, which improves the locality of
+sparse matrix-vector products
+
+Inputs: A        - square sparse matrix in COO, CSC or CSR format
+        leafsize - the graph is bisected until each part has at most
+                   leafsize vertices
+        p        - (output) permutation; row/column k of P A P^T is
+                   row/column p[k] of A
+
+Return: success/error
+
+Notes:
+1) Each part is numbered contiguously, so that rows which are close in
+the graph, and hence access nearby entries of x, are close in memory.
+Vertices within a leaf keep their original relative order.
+
+2) Each bisection coarsens the graph by heavy edge matching, bisects
+the coarsest graph by graph growing, and refines the partition at each
+level while projecting it back to the original graph, as in
+G. Karypis and V. Kumar, A fast and high quality multilevel scheme for
+partitioning irregular graphs, SIAM J. Sci. Comput. 20(1), 1998.
+*/
+
+int
+gsl_splinalg_bisect(const gsl_spmatrix *A, const size_t leafsize,
+                    gsl_permutation *p)
+{
+  const size_t n = A->size1;
+
+  if (n != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (n != p->size)
+    {
+      GSL_ERROR("permutation does not match matrix", GSL_EBADLEN);
+    }
+  else if (leafsize == 0)
+    {
+      GSL_ERROR("leafsize must be positive", GSL_EINVAL);
+    }
+  else
+    {
+      int status;
+      order_wgraph g;
+      int *xadj, *adj = NULL, *label;
+      size_t i, nedge, pos = 0;
+
+      xadj = malloc((2 * n + 1) * sizeof(int));
+      if (!xadj)
+        {
+          GSL_ERROR("failed to allocate space for bisection", GSL_ENOMEM);
+        }
+
+      label = xadj + n + 1;
+
+      status = order_graph(A, xadj, &adj);
+      if (status)
+        {
+          free(xadj);
+          return status;
+        }
+
+      nedge = (size_t) xadj[n];
+
+      status = order_wgraph_alloc(n, nedge, &g);
+      if (status)
+        {
+          free(xadj);
+          free(adj);
+          return status;
+        }
+
+      for (i = 0; i <= n; ++i)
+        g.xadj[i] = xadj[i];
+
+      for (i = 0; i < nedge; ++i)
+        {
+          g.adj[i] = adj[i];
+          g.ew[i] = 1;
+        }
+
+      for (i = 0; i < n; ++i)
+        {
+          g.vw[i] = 1;
+          label[i] = (int) i;
+        }
+
+      free(adj);
+
+      status = order_bisect_recurse(&g, label, leafsize, p->data, &pos);
+
+      order_wgraph_free(&g);
+      free(xadj);
+
+      return status;
+    }
+}
+
+/*
+order_graph()
+  Compute the adjacency structure of the graph of A + A^T, excluding
+self loops
+
+Inputs: A    - square sparse matrix
+        xadj - (output) neighbors of node i are adj[xadj[i]..xadj[i+1]-1],
+               length n + 1
+        adj  - (output) allocated adjacency array, to be freed by caller
+
+Return: success/error
+*/
+
+static int
+order_graph(const gsl_spmatrix *A, int *xadj, int **adj)
+{
+  const size_t n = A->size1;
+  const size_t nz = gsl_spmatrix_nnz(A);
+  int *Cp, *Ci, *w;
+  size_t i;
+  int status;
+
+  Cp = malloc((2 * n + 1 + nz) * sizeof(int));
+  if (!Cp)
+    {
+      GSL_ERROR("failed to allocate space for graph", GSL_ENOMEM);
+    }
+
+  w = Cp + n + 1;
+  Ci = w + n;
+
+  status = pattern_csc(A, NULL, NULL, 0, Cp, Ci, NULL);
+  if (status)
+    {
+      free(Cp);
+      return status;
+    }
+
+  /* count entries of A + A^T, which are at most 2*nz */
+  for (i = 0; i < n; ++i)
+    w[i] = 0;
+
+  for (i = 0; i < n; ++i)
+    {
+      int jj;
+      for (jj = Cp[i]; jj < Cp[i + 1]; ++jj)
+        {
+          int r = Ci[jj];
+          if (r != (int) i)
+            {
+              w[r]++;
+              w[i]++;
+            }
+        }
+    }
+
+  xadj[0] = 0;
+  for (i = 0; i < n; ++i)
+    xadj[i + 1] = xadj[i] + w[i];
+
+  *adj = malloc((xadj[n] + 1) * sizeof(int));
+  if (!*adj)
+    {
+      free(Cp);
+      GSL_ERROR("failed to allocate space for graph", GSL_ENOMEM);
+    }
+
+  for (i = 0; i < n; ++i)
+    w[i] = xadj[i];
+
+  for (i = 0; i < n; ++i)
+    {
+      int jj;
+      for (jj = Cp[i]; jj < Cp[i + 1]; ++jj)
+        {
+          int r = Ci[jj];
+          if (r != (int) i)
+            {
+              (*adj)[w[r]++] = (int) i;
+              (*adj)[w[i]++] = r;
+            }
+        }
+    }
+
+  /* remove duplicate edges, arising from symmetric entries of A */
+  {
+    int *last = Cp; /* reuse, length n */
+    int pos = 0;
+
+    for (i = 0; i < n; ++i)
+      last[i] = -1;
+
+    for (i = 0; i < n; ++i)
+      {
+        int start = xadj[i], jj;
+
+        xadj[i] = pos;
+
+        for (jj = start; jj < w[i]; ++jj)
+          {
+            int v = (*adj)[jj];
+            if (last[v] != (int) i)
+              {
+                last[v] = (int) i;
+                (*adj)[pos++] = v;
+              }
+          }
+      }
+
+    xadj[n] = pos;
+  }
+
+  free(Cp);
+
+  return GSL_SUCCESS;
+}
+
+static int
+order_push(order_list *l, const int x)
+{
+  if (l->len >= l->cap)
+    {
+      size_t cap = GSL_MAX(2 * l->cap, 8);
+      int *ptr = realloc(l->data, cap * sizeof(int));
+
+      if (!ptr)
+        {
+          GSL_ERROR("failed to allocate space for list", GSL_ENOMEM);
+        }
+
+      l->data = ptr;
+      l->cap = cap;
+    }
+
+  l->data[l->len++] = x;
+
+  return GSL_SUCCESS;
+}
+
+/*
+order_bfs()
+  Breadth first search from a root vertex
+
+Inputs: xadj   - adjacency pointers
+        adj    - adjacency lists
+        root   - starting vertex
+        mark   - vertices reached are marked with tag
+        tag    - value different from all entries of mark in the
+                 component of root
+        queue  - (output) vertices in order of discovery
+        nreach - (output) number of vertices reached
+        nlast  - (output) number of vertices in the last level, which
+                 are queue[nreach-nlast..nreach-1]
+
+Return: number of levels
+*/
+
+static size_t
+order_bfs(const int *xadj, const int *adj, const int root, int *mark,
+          const int tag, int *queue, size_t *nreach, size_t *nlast)
+{
+  size_t head = 0, tail = 0, start = 0, nlevels = 0;
+
+  queue[tail++] = root;
+  mark[root] = tag;
+
+  while (head < tail)
+    {
+      const size_t end = tail;
+
+      start = head;
+      ++nlevels;
+
+      for (; head < end; ++head)
+        {
+          const int v = queue[head];
+          int q;
+
+          for (q = xadj[v]; q < xadj[v + 1]; ++q)
+            {
+              int w = adj[q];
+              if (mark[w] != tag)
+                {
+                  mark[w] = tag;
+                  queue[tail++] = w;
+                }
+            }
+        }
+    }
+
+  *nreach = tail;
+  *nlast = tail - start;
+
+  return nlevels;
+}
+
+/* stable sort of v by increasing deg[v], using tmp of length n */
+static void
+order_sort_degree(int *v, const size_t n, const int *deg, int *tmp)
+{
+  size_t width, i, j;
+
+  if (n < 16)
+    {
+      for (i = 1; i < n; ++i)
+        {
+          int x = v[i];
+
+          for (j = i; j > 0 && deg[v[j - 1]] > deg[x]; --j)
+            v[j] = v[j - 1];
+
+          v[j] = x;
+        }
+
+      return;
+    }
+
+  for (width = 1; width < n; width *= 2)
+    {
+      for (i = 0; i < n; i += 2 * width)
+        {
+          size_t a = i, amax = GSL_MIN(i + width, n);
+          size_t b = amax, bmax = GSL_MIN(i + 2 * width, n);
+
+          j = i;
+          while (a < amax && b < bmax)
+            tmp[j++] = (deg[v[b]] < deg[v[a]]) ? v[b++] : v[a++];
+
+          while (a < amax)
+            tmp[j++] = v[a++];
+
+          while (b < bmax)
+            tmp[j++] = v[b++];
+        }
+
+      for (i = 0; i < n; ++i)
+        v[i] = tmp[i];
+    }
+}
+
+static int
+order_wgraph_alloc(const size_t n, const size_t nedge, order_wgraph *g)
+{
+  g->n = n;
+  g->xadj = malloc((n + 1) * sizeof(int));
+  g->vw = malloc((n + 1) * sizeof(int));
+  g->adj = malloc((nedge + 1) * sizeof(int));
+  g->ew = malloc((nedge + 1) * sizeof(int));
+
+  if (!g->xadj || !g->vw || !g->adj || !g->ew)
+    {
+      order_wgraph_free(g);
+      GSL_ERROR("failed to allocate space for graph", GSL_ENOMEM);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static void
+order_wgraph_free(order_wgraph *g)
+{
+  free(g->xadj);
+  free(g->vw);
+  free(g->adj);
+  free(g->ew);
+  g->xadj = g->vw = g->adj = g->ew = NULL;
+}
+
+/*
+order_coarsen()
+  Coarsen a graph by heavy edge matching: each vertex is matched with
+the unmatched neighbor joined by the heaviest edge, and matched pairs
+are collapsed into single vertices
+
+Inputs: g    - graph
+        gc   - (output) coarse graph, allocated here
+        cmap - (output) vertex v of g is vertex cmap[v] of gc
+
+Return: success/error
+*/
+
+static int
+order_coarsen(const order_wgraph *g, order_wgraph *gc, int *cmap)
+{
+  const size_t n = g->n;
+  int *match, *htable;
+  size_t nc = 0, v;
+  int pos = 0, status;
+
+  match = malloc((2 * n + 1) * sizeof(int));
+  if (!match)
+    {
+      GSL_ERROR("failed to allocate space for matching", GSL_ENOMEM);
+    }
+
+  htable = match + n;
+
+  for (v = 0; v < n; ++v)
+    match[v] = -1;
+
+  for (v = 0; v < n; ++v)
+    {
+      int best = -1, bestw = 0, q;
+
+      if (match[v] >= 0)
+        continue;
+
+      for (q = g->xadj[v]; q < g->xadj[v + 1]; ++q)
+        {
+          int u = g->adj[q];
+          if (match[u] < 0 && u != (int) v && g->ew[q] > bestw)
+            {
+              best = u;
+              bestw = g->ew[q];
+            }
+        }
+
+      if (best >= 0)
+        {
+          match[v] = best;
+          match[best] = (int) v;
+        }
+      else
+        {
+          match[v] = (int) v;
+        }
+    }
+
+  /* number each pair at its smaller vertex */
+  for (v = 0; v < n; ++v)
+    {
+      if ((int) v <= match[v])
+        {
+          cmap[v] = (int) nc;
+          cmap[match[v]] = (int) nc;
+          ++nc;
+        }
+    }
+
+  status = order_wgraph_alloc(nc, (size_t) g->xadj[n], gc);
+  if (status)
+    {
+      free(match);
+      return status;
+    }
+
+  for (v = 0; v < nc; ++v)
+    htable[v] = -1;
+
+  for (v = 0; v < n; ++v)
+    {
+      const int c = cmap[v];
+      const int start = pos;
+      int f[2], nf, t;
+
+      if ((int) v > match[v])
+        continue;
+
+      f[0] = (int) v;
+      f[1] = match[v];
+      nf = (match[v] == (int) v) ? 1 : 2;
+
+      gc->xadj[c] = pos;
+      gc->vw[c] = 0;
+
+      for (t = 0; t < nf; ++t)
+        {
+          int q;
+
+          gc->vw[c] += g->vw[f[t]];
+
+          for (q = g->xadj[f[t]]; q < g->xadj[f[t] + 1]; ++q)
+            {
+              int cw = cmap[g->adj[q]];
+
+              if (cw == c)
+                continue;
+
+              if (htable[cw] >= start)
+                {
+                  gc->ew[htable[cw]] += g->ew[q];
+                }
+              else
+                {
+                  htable[cw] = pos;
+                  gc->adj[pos] = cw;
+                  gc->ew[pos] = g->ew[q];
+                  ++pos;
+                }
+            }
+        }
+    }
+
+  gc->xadj[nc] = pos;
+
+  free(match);
+
+  return GSL_SUCCESS;
+}
+
+/*
+order_initpart()
+  Bisect a graph by growing part 0 breadth first from a few starting
+vertices until it holds half the vertex weight; the refined partition
+with the smallest edge cut is kept
+
+Inputs: g    - graph
+        part - (output) part[v] = 0 or 1
+
+Return: success/error
+*/
+
+static int
+order_initpart(const order_wgraph *g, int *part)
+{
+  const size_t n = g->n;
+  int *queue, *mark, *best;
+  long W = 0, bestcut = -1;
+  size_t v, t;
+
+  queue = malloc((3 * n + 1) * sizeof(int));
+  if (!queue)
+    {
+      GSL_ERROR("failed to allocate space for partition", GSL_ENOMEM);
+    }
+
+  mark = queue + n;
+  best = mark + n;
+
+  for (v = 0; v < n; ++v)
+    W += g->vw[v];
+
+  for (t = 0; t < ORDER_INIT_TRIALS && t < n; ++t)
+    {
+      size_t head = 0, tail = 0, next = 0;
+      long w0 = 0, cut = 0;
+
+      for (v = 0; v < n; ++v)
+        {
+          part[v] = 1;
+          mark[v] = 0;
+        }
+
+      v = t * n / ORDER_INIT_TRIALS;
+      queue[tail++] = (int) v;
+      mark[v] = 1;
+
+      while (2 * w0 < W)
+        {
+          int u, q;
+
+          if (head == tail)
+            {
+              /* disconnected graph: continue from an unvisited vertex */
+              while (next < n && mark[next])
+                ++next;
+
+              if (next == n)
+                break;
+
+              queue[tail++] = (int) next;
+              mark[next] = 1;
+            }
+
+          u = queue[head++];
+          part[u] = 0;
+          w0 += g->vw[u];
+
+          for (q = g->xadj[u]; q < g->xadj[u + 1]; ++q)
+            {
+              int w = g->adj[q];
+              if (!mark[w])
+                {
+                  mark[w] = 1;
+                  queue[tail++] = w;
+                }
+            }
+        }
+
+      order_refine(g, part);
+
+      for (v = 0; v < n; ++v)
+        {
+          int q;
+          for (q = g->xadj[v]; q < g->xadj[v + 1]; ++q)
+            {
+              if (part[g->adj[q]] != part[v])
+                cut += g->ew[q];
+            }
+        }
+
+      if (bestcut < 0 || cut < bestcut)
+        {
+          bestcut = cut;
+          for (v = 0; v < n; ++v)
+            best[v] = part[v];
+        }
+    }
+
+  for (v = 0; v < n; ++v)
+    part[v] = best[v];
+
+  free(queue);
+
+  return GSL_SUCCESS;
+}
+
+/*
+order_refine()
+  Improve a bisection by greedily moving boundary vertices which
+reduce the edge cut without violating the balance tolerance, or which
+restore the balance of an unbalanced partition
+*/
+
+static void
+order_refine(const order_wgraph *g, int *part)
+{
+  const size_t n = g->n;
+  long w[2] = { 0, 0 };
+  long maxvw = 0, maxdiff;
+  size_t v, pass;
+
+  for (v = 0; v < n; ++v)
+    {
+      w[part[v]] += g->vw[v];
+      maxvw = GSL_MAX(maxvw, (long) g->vw[v]);
+    }
+
+  maxdiff = GSL_MAX((w[0] + w[1]) / 32, maxvw);
+
+  for (pass = 0; pass < ORDER_REFINE_PASSES; ++pass)
+    {
+      size_t nmoved = 0;
+
+      for (v = 0; v < n; ++v)
+        {
+          const int from = part[v];
+          const int to = 1 - from;
+          const long vw = g->vw[v];
+          long ext = 0, in = 0, gain, before, after;
+          int q;
+
+          for (q = g->xadj[v]; q < g->xadj[v + 1]; ++q)
+            {
+              if (part[g->adj[q]] == from)
+                in += g->ew[q];
+              else
+                ext += g->ew[q];
+            }
+
+          if (ext == 0)
+            continue;
+
+          gain = ext - in;
+          before = labs(w[0] - w[1]);
+          after = labs((w[from] - vw) - (w[to] + vw));
+
+          if ((gain > 0 && after <= maxdiff) ||
+              (gain == 0 && after < before) ||
+              (before > maxdiff && w[from] > w[to] && after < before))
+            {
+              part[v] = to;
+              w[from] -= vw;
+              w[to] += vw;
+              ++nmoved;
+            }
+        }
+
+      if (nmoved == 0)
+        break;
+    }
+}
+
+/*
+order_mlbisect()
+  Multilevel bisection of a graph
+
+Inputs: g    - graph
+        part - (output) part[v] = 0 or 1
+
+Return: success/error
+*/
+
+static int
+order_mlbisect(const order_wgraph *g, int *part)
+{
+  order_wgraph levels[ORDER_MAX_LEVELS];
+  int *cmap[ORDER_MAX_LEVELS];
+  const order_wgraph *G = g;
+  int *partc = NULL;
+  const char *reason = NULL;
+  size_t nlevels = 0, l, v;
+  int status = GSL_SUCCESS;
+
+  /* coarsening phase */
+  while (nlevels < ORDER_MAX_LEVELS && G->n > ORDER_COARSEN_MIN)
+    {
+      cmap[nlevels] = malloc(G->n * sizeof(int));
+      if (!cmap[nlevels])
+        {
+          status = GSL_ENOMEM;
+          reason = "failed to allocate space for coarsening";
+          goto cleanup;
+        }
+
+      status = order_coarsen(G, &levels[nlevels], cmap[nlevels]);
+      if (status)
+        {
+          free(cmap[nlevels]);
+          goto cleanup;
+        }
+
+      /* stop when the matching no longer reduces the graph */
+      if (20 * levels[nlevels].n > 19 * G->n)
+        {
+          order_wgraph_free(&levels[nlevels]);
+          free(cmap[nlevels]);
+          break;
+        }
+
+      G = &levels[nlevels++];
+    }
+
+  /* initial partition of the coarsest graph */
+  partc = (nlevels == 0) ? part : malloc((G->n + 1) * sizeof(int));
+  if (!partc)
+    {
+      status = GSL_ENOMEM;
+      reason = "failed to allocate space for partition";
+      goto cleanup;
+    }
+
+  status = order_initpart(G, partc);
+  if (status)
+    goto cleanup;
+
+  /* uncoarsening phase */
+  for (l = nlevels; l-- > 0; )
+    {
+      const order_wgraph *F = (l == 0) ? g : &levels[l - 1];
+      int *partf = (l == 0) ? part : malloc((F->n + 1) * sizeof(int));
+
+      if (!partf)
+        {
+          status = GSL_ENOMEM;
+          reason = "failed to allocate space for partition";
+          goto cleanup;
+        }
+
+      for (v = 0; v < F->n; ++v)
+        partf[v] = partc[cmap[l][v]];
+
+      free(partc);
+      partc = partf;
+
+      order_refine(F, partf);
+    }
+
+cleanup:
+  if (partc != part)
+    free(partc);
+
+  for (l = 0; l < nlevels; ++l)
+    {
+      order_wgraph_free(&levels[l]);
+      free(cmap[l]);
+    }
+
+  if (reason != NULL)
+    {
+      GSL_ERROR(reason, status);
+    }
+
+  return status;
+}
+
+/*
+order_subgraph()
+  Extract the subgraph induced by the vertices of one part
+
+Inputs: g     - graph
+        part  - partition of g
+        which - part to extract
+        s     - (output) subgraph, allocated here
+        map   - (output) vertex v of g is vertex map[v] of s, or -1
+
+Return: success/error
+*/
+
+static int
+order_subgraph(const order_wgraph *g, const int *part, const int which,
+               order_wgraph *s, int *map)
+{
+  const size_t n = g->n;
+  size_t ns = 0, nedge = 0, v;
+  int pos = 0, status;
+
+  for (v = 0; v < n; ++v)
+    {
+      if (part[v] == which)
+        {
+          int q;
+
+          map[v] = (int) ns++;
+
+          for (q = g->xadj[v]; q < g->xadj[v + 1]; ++q)
+            {
+              if (part[g->adj[q]] == which)
+                ++nedge;
+            }
+        }
+      else
+        {
+          map[v] = -1;
+        }
+    }
+
+  status = order_wgraph_alloc(ns, nedge, s);
+  if (status)
+    return status;
+
+  for (v = 0; v < n; ++v)
+    {
+      const int c = map[v];
+      int q;
+
+      if (c < 0)
+        continue;
+
+      s->xadj[c] = pos;
+      s->vw[c] = g->vw[v];
+
+      for (q = g->xadj[v]; q < g->xadj[v + 1]; ++q)
+        {
+          int u = g->adj[q];
+          if (part[u] == which)
+            {
+              s->adj[pos] = map[u];
+              s->ew[pos] = g->ew[q];
+              ++pos;
+            }
+        }
+    }
+
+  s->xadj[ns] = pos;
+
+  return GSL_SUCCESS;
+}
+
+/*
+order_bisect_recurse()
+  Recursively bisect a graph and number its vertices part by part
+
+Inputs: g        - graph
+        label    - vertex v of g is vertex label[v] of the original graph
+        leafsize - maximum number of vertices of a part
+        out      - (output) original vertices in their new order
+        pos      - (input/output) next position of out
+
+Return: success/error
+*/
+
+static int
+order_bisect_recurse(const order_wgraph *g, const int *label,
+                     const size_t leafsize, size_t *out, size_t *pos)
+{
+  const size_t n = g->n;
+  int *part, *map, *sublabel;
+  size_t v, n0 = 0;
+  int which, status;
+
+  if (n <= leafsize)
+    {
+      for (v = 0; v < n; ++v)
+        out[(*pos)++] = (size_t) label[v];
+
+      return GSL_SUCCESS;
+    }
+
+  part = malloc((3 * n + 1) * sizeof(int));
+  if (!part)
+    {
+      GSL_ERROR("failed to allocate space for bisection", GSL_ENOMEM);
+    }
+
+  map = part + n;
+  sublabel = map + n;
+
+  status = order_mlbisect(g, part);
+  if (status)
+    {
+      free(part);
+      return status;
+    }
+
+  for (v = 0; v < n; ++v)
+    n0 += (part[v] == 0);
+
+  /* guarantee progress for degenerate partitions */
+  if (n0 == 0 || n0 == n)
+    {
+      for (v = 0; v < n; ++v)
+        part[v] = (v >= n / 2);
+    }
+
+  for (which = 0; which < 2 && status == GSL_SUCCESS; ++which)
+    {
+      order_wgraph s;
+
+      status = order_subgraph(g, part, which, &s, map);
+      if (status)
+        break;
+
+      for (v = 0; v < n; ++v)
+        {
+          if (map[v] >= 0)
+            sublabel[map[v]] = label[v];
+        }
+
+      status = order_bisect_recurse(&s, sublabel, leafsize, out, pos);
+
+      order_wgraph_free(&s);
+    }
+
+  free(part);
+
+  return status;
+}
@@ -0,0 +1,168 @@
+/* splinalg/pattern.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Sparsity pattern utilities shared by the orderings and the sparse
+ * direct solvers. This file is #included by the sources which use it.
+ */
+
+static int pattern_csc(const gsl_spmatrix *A, const int *rinv,
+                       const int *cinv, const int lower, int *Bp, int *Bi,
+                       int *map);
+
+/*
+pattern_csc()
+  Compute the compressed column pattern of the permuted matrix B,
+with B(rinv[i],cinv[j]) = A(i,j)
+
+Inputs: A     - sparse matrix in COO, CSC or CSR format
+        rinv  - row permutation, or NULL for the identity
+        cinv  - column permutation, or NULL for the identity
+        lower - if nonzero, A is symmetric and only its lower triangle
+                i >= j is used; each entry is stored in the lower
+                triangle of B
+        Bp    - (output) column pointers, length A->size2 + 1
+        Bi    - (output) row indices, length nnz(A)
+        map   - (output) entry A->data[k] is stored at position map[k]
+                of B, or map[k] = -1 if it is not used; may be NULL
+
+Return: success/error
+
+Notes:
+1) The row indices in each column of B are not sorted
+*/
+
+static int
+pattern_csc(const gsl_spmatrix *A, const int *rinv, const int *cinv,
+            const int lower, int *Bp, int *Bi, int *map)
+{
+  const size_t nz = gsl_spmatrix_nnz(A);
+  const size_t N = A->size2;
+  int *row, *col;
+  size_t j, k;
+
+  if (!GSL_SPMATRIX_ISCOO(A) && !GSL_SPMATRIX_ISCSC(A) && !GSL_SPMATRIX_ISCSR(A))
+    {
+      GSL_ERROR("matrix must be in COO, CSC or CSR format", GSL_EINVAL);
+    }
+
+  row = malloc((2 * nz + 1) * sizeof(int));
+  if (!row)
+    {
+      GSL_ERROR("failed to allocate space for pattern", GSL_ENOMEM);
+    }
+
+  col = row + nz;
+
+  /* (row,col) of each stored entry of A, in storage order */
+  if (GSL_SPMATRIX_ISCOO(A))
+    {
+      for (k = 0; k < nz; ++k)
+        {
+          row[k] = A->i[k];
+          col[k] = A->p[k];
+        }
+    }
+  else if (GSL_SPMATRIX_ISCSC(A))
+    {
+      for (j = 0; j < A->size2; ++j)
+        {
+          int p;
+          for (p = A->p[j]; p < A->p[j + 1]; ++p)
+            {
+              row[p] = A->i[p];
+              col[p] = (int) j;
+            }
+        }
+    }
+  else
+    {
+      for (j = 0; j < A->size1; ++j)
+        {
+          int p;
+          for (p = A->p[j]; p < A->p[j + 1]; ++p)
+            {
+              row[p] = (int) j;
+              col[p] = A->i[p];
+            }
+        }
+    }
+
+  /* permute, and discard the upper triangle of symmetric matrices */
+  for (k = 0; k < nz; ++k)
+    {
+      int r = rinv ? rinv[row[k]] : row[k];
+      int c = cinv ? cinv[col[k]] : col[k];
+
+      if (lower)
+        {
+          if (row[k] < col[k])
+            {
+              col[k] = -1;
+              continue;
+            }
+          else if (r < c)
+            {
+              int tmp = r;
+              r = c;
+              c = tmp;
+            }
+        }
+
+      row[k] = r;
+      col[k] = c;
+    }
+
+  /* counting sort by column */
+  for (j = 0; j <= N; ++j)
+    Bp[j] = 0;
+
+  for (k = 0; k < nz; ++k)
+    {
+      if (col[k] >= 0)
+        Bp[col[k] + 1]++;
+    }
+
+  for (j = 0; j < N; ++j)
+    Bp[j + 1] += Bp[j];
+
+  for (k = 0; k < nz; ++k)
+    {
+      if (col[k] >= 0)
+        {
+          int idx = Bp[col[k]]++;
+          Bi[idx] = row[k];
+          if (map)
+            map[k] = idx;
+        }
+      else if (map)
+        {
+          map[k] = -1;
+        }
+    }
+
+  for (j = N; j > 0; --j)
+    Bp[j] = Bp[j - 1];
+
+  Bp[0] = 0;
+
+  free(row);
+
+  return GSL_SUCCESS;
+}
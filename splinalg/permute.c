@@ -0,0 +1,247 @@
+/* splinalg/permute.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * This module applies orderings to sparse matrices and vectors. With
+ * the convention used by the orderings, row and column k of P A P^T
+ * are row and column p[k] of A, so a system A x = b is solved in the
+ * reordered space as (P A P^T) (P x) = P b
+ */
+
+/*
+gsl_splinalg_symperm()
+  Apply a symmetric permutation to a sparse matrix,
+
+B = P A P^T, B(i,j) = A(p[i],p[j])
+
+Inputs: A - square sparse matrix in CSC or CSR format
+        p - permutation
+        B - (output) sparse matrix with the same dimensions and
+            format as A; reallocated if too small
+
+Return: success/error
+
+Notes:
+1) The indices within each row (CSR) or column (CSC) of B are sorted
+*/
+
+int
+gsl_splinalg_symperm(const gsl_spmatrix *A, const gsl_permutation *p,
+                     gsl_spmatrix *B)
+{
+  const size_t n = A->size1;
+
+  if (n != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (n != p->size)
+    {
+      GSL_ERROR("permutation does not match matrix", GSL_EBADLEN);
+    }
+  else if (B->size1 != n || B->size2 != n)
+    {
+      GSL_ERROR("output matrix must match input", GSL_EBADLEN);
+    }
+  else if (!GSL_SPMATRIX_ISCSC(A) && !GSL_SPMATRIX_ISCSR(A))
+    {
+      GSL_ERROR("matrix must be in CSC or CSR format", GSL_EINVAL);
+    }
+  else if (A->sptype != B->sptype)
+    {
+      GSL_ERROR("output matrix must have same format as input", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t nz = A->nz;
+      int *pinv, *Tp, *Ti;
+      double *Tx;
+      size_t i, k;
+
+      if (B->nzmax < nz)
+        {
+          int status = gsl_spmatrix_realloc(nz, B);
+          if (status)
+            return status;
+        }
+
+      pinv = malloc((2 * n + 2 + nz) * sizeof(int));
+      Tx = malloc((nz + 1) * sizeof(double));
+      if (!pinv || !Tx)
+        {
+          free(pinv);
+          free(Tx);
+          GSL_ERROR("failed to allocate space for permutation", GSL_ENOMEM);
+        }
+
+      Tp = pinv + n;
+      Ti = Tp + n + 1;
+
+      for (k = 0; k < n; ++k)
+        pinv[p->data[k]] = (int) k;
+
+      /*
+       * The storage is the same for CSR and CSC, so only the outer
+       * (pointer) and inner (index) dimensions are used. Compute the
+       * transpose T of B by visiting the outer vectors of B in order,
+       * which leaves the inner indices of T sorted, then transpose T
+       * back into B, which sorts the inner indices of B
+       */
+      for (i = 0; i <= n; ++i)
+        Tp[i] = 0;
+
+      for (k = 0; k < nz; ++k)
+        Tp[pinv[A->i[k]] + 1]++;
+
+      for (i = 0; i < n; ++i)
+        Tp[i + 1] += Tp[i];
+
+      for (k = 0; k < n; ++k)
+        {
+          const size_t src = p->data[k];
+          int q;
+
+          for (q = A->p[src]; q < A->p[src + 1]; ++q)
+            {
+              int idx = Tp[pinv[A->i[q]]]++;
+              Ti[idx] = (int) k;
+              Tx[idx] = A->data[q];
+            }
+        }
+
+      for (i = n; i > 0; --i)
+        Tp[i] = Tp[i - 1];
+
+      Tp[0] = 0;
+
+      for (i = 0; i <= n; ++i)
+        B->p[i] = 0;
+
+      for (k = 0; k < nz; ++k)
+        B->p[Ti[k] + 1]++;
+
+      for (i = 0; i < n; ++i)
+        B->p[i + 1] += B->p[i];
+
+      for (i = 0; i < n; ++i)
+        {
+          int q;
+
+          for (q = Tp[i]; q < Tp[i + 1]; ++q)
+            {
+              int idx = B->p[Ti[q]]++;
+              B->i[idx] = (int) i;
+              B->data[idx] = Tx[q];
+            }
+        }
+
+      for (i = n; i > 0; --i)
+        B->p[i] = B->p[i - 1];
+
+      B->p[0] = 0;
+      B->nz = nz;
+
+      free(pinv);
+      free(Tx);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_permute_vector()
+  Permute a vector into the reordered space, y = P x, y[k] = x[p[k]]
+
+Inputs: p - permutation
+        x - input vector
+        y - (output) permuted vector
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_permute_vector(const gsl_permutation *p, const gsl_vector *x,
+                            gsl_vector *y)
+{
+  const size_t n = p->size;
+
+  if (x->size != n || y->size != n)
+    {
+      GSL_ERROR("vector length does not match permutation", GSL_EBADLEN);
+    }
+  else if (x == y)
+    {
+      GSL_ERROR("input and output vectors must be different", GSL_EINVAL);
+    }
+  else
+    {
+      size_t k;
+
+      for (k = 0; k < n; ++k)
+        gsl_vector_set(y, k, gsl_vector_get(x, p->data[k]));
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_permute_vector_inverse()
+  Permute a vector back from the reordered space, x = P^T y,
+x[p[k]] = y[k]
+
+Inputs: p - permutation
+        y - vector in reordered space
+        x - (output) vector in original ordering
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_permute_vector_inverse(const gsl_permutation *p,
+                                    const gsl_vector *y, gsl_vector *x)
+{
+  const size_t n = p->size;
+
+  if (x->size != n || y->size != n)
+    {
+      GSL_ERROR("vector length does not match permutation", GSL_EBADLEN);
+    }
+  else if (x == y)
+    {
+      GSL_ERROR("input and output vectors must be different", GSL_EINVAL);
+    }
+  else
+    {
+      size_t k;
+
+      for (k = 0; k < n; ++k)
+        gsl_vector_set(x, p->data[k], gsl_vector_get(y, k));
+
+      return GSL_SUCCESS;
+    }
+}
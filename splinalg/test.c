@@ -29,6 +29,7 @@
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_test.h>
 #include <gsl/gsl_blas.h>
+#include <gsl/gsl_permutation.h>
 #include <gsl/gsl_spmatrix.h>
 #include <gsl/gsl_spblas.h>
 #include <gsl/gsl_splinalg.h>
@@ -100,9 +101,9 @@ test_poisson()
   epsrel is the relative error threshold with the exact solution
 */
 static void
-test_poisson(const size_t N, const double epsrel, const int compress)
+test_poisson(const gsl_splinalg_itersolve_type *T, const size_t N,
+             const double epsrel, const int compress)
 {
-  const gsl_splinalg_itersolve_type *T = gsl_splinalg_itersolve_gmres;
   const size_t n = N - 2;                     /* subtract 2 to exclude boundaries */
   const double h = 1.0 / (N - 1.0);           /* grid spacing */
   const double tol = 1.0e-9;
@@ -135,14 +136,14 @@ test_poisson(const size_t N, const double epsrel, const int compress)
   gsl_spmatrix_set(A, n - 1, n - 1, -2.0);
   gsl_spmatrix_set(A, n - 1, n - 2, 1.0);
 
-  /* scale by h^2 */
-  gsl_spmatrix_scale(A, 1.0 / (h * h));
+  /* scale by -h^2 so that the system -u'' = pi^2 sin(pi*x) is positive definite */
+  gsl_spmatrix_scale(A, -1.0 / (h * h));
 
   /* construct right hand side vector */
   for (i = 0; i < n; ++i)
     {
       double xi = (i + 1) * h;
-      double bi = -M_PI * M_PI * sin(M_PI * xi);
+      double bi = M_PI * M_PI * sin(M_PI * xi);
       gsl_vector_set(b, i, bi);
     }
 
@@ -209,13 +210,12 @@ rhs = ones(n,1)
 */
 
 static void
-test_toeplitz(const size_t N, const double a, const double b,
-              const double c)
+test_toeplitz(const gsl_splinalg_itersolve_type *T, const size_t N,
+              const double a, const double b, const double c)
 {
   int status;
   const double tol = 1.0e-10;
   const size_t max_iter = 10;
-  const gsl_splinalg_itersolve_type *T = gsl_splinalg_itersolve_gmres;
   const char *desc;
   gsl_spmatrix *A;
   gsl_vector *rhs, *x;
@@ -285,9 +285,9 @@ test_toeplitz(const size_t N, const double a, const double b,
 } /* test_toeplitz() */
 
 static void
-test_random(const size_t N, const gsl_rng *r, const int compress)
+test_random(const gsl_splinalg_itersolve_type *T, const size_t N,
+            const gsl_rng *r, const int compress)
 {
-  const gsl_splinalg_itersolve_type *T = gsl_splinalg_itersolve_gmres;
   const double tol = 1.0e-8;
   int status;
   gsl_spmatrix *A = create_random_sparse(N, N, 0.3, r);
@@ -302,13 +302,30 @@ test_random(const size_t N, const gsl_rng *r, const int compress)
 
   create_random_vector(b, r);
 
-  if (compress)
-    B = gsl_spmatrix_compcol(A);
+  if (compress == 1)
+    {
+      B = gsl_spmatrix_compcol(A);
+    }
+  else if (compress == 2)
+    {
+      gsl_spmatrix *C = gsl_spmatrix_crs(A);
+      B = gsl_spmatrix_alloc_sell(N, N, 1, 4, 16);
+      gsl_spmatrix_sell(B, C);
+      gsl_spmatrix_free(C);
+    }
+  else if (compress == 3)
+    {
+      gsl_spmatrix *C = gsl_spmatrix_crs(A);
+      B = gsl_spmatrix_alloc_bsr(N, N, 1, (N % 2 == 0) ? 2 : 1);
+      gsl_spmatrix_bsr(B, C);
+      gsl_spmatrix_free(C);
+    }
   else
     B = A;
 
   status = gsl_splinalg_itersolve_iterate(B, b, tol, x, w);
-  gsl_test(status, "%s random status s=%d N=%zu", desc, status, N);
+  gsl_test(status, "%s random status s=%d N=%zu format=%s", desc, status, N,
+           gsl_spmatrix_type(B));
 
   /* check that the residual satisfies ||r|| <= tol*||b|| */
   {
@@ -337,33 +354,871 @@ test_random(const size_t N, const gsl_rng *r, const int compress)
     gsl_spmatrix_free(B);
 } /* test_random() */
 
+/* Jacobi preconditioner z = D^{-1} r */
+static int
+jacobi_apply(const gsl_vector *r, gsl_vector *z, void *params)
+{
+  const gsl_vector *d = (const gsl_vector *) params;
+  gsl_vector_memcpy(z, r);
+  return gsl_vector_div(z, d);
+}
+
+/*
+test_precon()
+  Solve a symmetric positive definite, badly scaled diagonally
+dominant system with a Jacobi preconditioner, and check that it
+needs fewer iterations than the unpreconditioned solver, which is
+stopped after max_iter calls
+*/
+
+static void
+test_precon(const gsl_splinalg_itersolve_type *T, const size_t N,
+            const gsl_rng *r)
+{
+  const double tol = 1.0e-10;
+  const size_t max_iter = 50;
+  gsl_spmatrix *A = gsl_spmatrix_alloc(N, N);
+  gsl_spmatrix *C;
+  gsl_vector *d = gsl_vector_alloc(N);
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_splinalg_itersolve *w = gsl_splinalg_itersolve_alloc(T, N, 0);
+  const char *desc = gsl_splinalg_itersolve_name(w);
+  gsl_splinalg_precon P;
+  size_t niter[2];
+  size_t i, k;
+
+  /* A = S (I + E) S with random symmetric E and S = diag(1, ..., 1e3) */
+  for (i = 0; i < N; ++i)
+    {
+      double si = pow(1.0e3, (double) i / (N - 1.0));
+      gsl_vector_set(d, i, si);
+    }
+
+  for (i = 0; i < N; ++i)
+    {
+      double si = gsl_vector_get(d, i);
+      gsl_spmatrix_set(A, i, i, si * si);
+
+      if (i + 1 < N)
+        {
+          double sj = gsl_vector_get(d, i + 1);
+          double e = 0.25 * gsl_rng_uniform(r) * si * sj;
+          gsl_spmatrix_set(A, i, i + 1, e);
+          gsl_spmatrix_set(A, i + 1, i, e);
+        }
+    }
+
+  /* d = diag(A) */
+  for (i = 0; i < N; ++i)
+    gsl_vector_set(d, i, gsl_spmatrix_get(A, i, i));
+
+  C = gsl_spmatrix_crs(A);
+  create_random_vector(b, r);
+
+  P.apply = jacobi_apply;
+  P.params = d;
+
+  gsl_splinalg_itersolve_set_history(w, 10 * N);
+
+  for (k = 0; k < 2; ++k)
+    {
+      size_t iter = 0, nhist;
+      const double *hist;
+      int status;
+
+      gsl_splinalg_itersolve_set_precon(w, k ? &P : NULL);
+      gsl_splinalg_itersolve_reset(w);
+      gsl_vector_set_zero(x);
+
+      do
+        {
+          status = gsl_splinalg_itersolve_iterate(C, b, tol, x, w);
+        }
+      while (status == GSL_CONTINUE && ++iter < max_iter);
+
+      niter[k] = gsl_splinalg_itersolve_niter(w);
+      hist = gsl_splinalg_itersolve_history(w, &nhist);
+
+      gsl_test(niter[k] == 0 || nhist != GSL_MIN(niter[k], 10 * N) || hist == NULL,
+               "%s precon=%zu history N=%zu niter=%zu nhist=%zu",
+               desc, k, N, niter[k], nhist);
+
+      /* the unpreconditioned system is too badly scaled to converge */
+      if (k == 0)
+        continue;
+
+      gsl_test(status, "%s precon status s=%d N=%zu", desc, status, N);
+
+      /* check that the residual satisfies ||r|| <= tol*||b|| */
+      {
+        gsl_vector *res = gsl_vector_alloc(N);
+        double normr, normb;
+
+        gsl_vector_memcpy(res, b);
+        gsl_spblas_dgemv(CblasNoTrans, -1.0, C, x, 1.0, res);
+
+        normr = gsl_blas_dnrm2(res);
+        normb = gsl_blas_dnrm2(b);
+
+        status = (normr <= tol*normb) != 1;
+        gsl_test(status, "%s precon residual N=%zu normr=%.12e normb=%.12e",
+                 desc, N, normr, normb);
+
+        gsl_vector_free(res);
+      }
+    }
+
+  gsl_test(niter[1] >= niter[0], "%s precon iterations N=%zu niter=%zu/%zu",
+           desc, N, niter[1], niter[0]);
+
+  gsl_splinalg_itersolve_free(w);
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(C);
+  gsl_vector_free(d);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+} /* test_precon() */
+
+/*
+test_ilu_exact()
+  For matrices whose factors have no fill-in, ILU(0) and IC(0) are
+exact factorizations; ILUT with droptol = 0 and lfil = N is an exact
+LU decomposition of any matrix not requiring pivoting. Check that
+the preconditioner solves A x = b in these cases.
+*/
+
+static void
+test_ilu_exact(const size_t N, const gsl_rng *r)
+{
+  const double tol = 1.0e-10;
+  gsl_spmatrix *A = gsl_spmatrix_alloc(N, N);
+  gsl_spmatrix *C;
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_vector *res = gsl_vector_alloc(N);
+  gsl_splinalg_ilu_workspace *w = gsl_splinalg_ilu_alloc(N);
+  size_t i, k;
+
+  create_random_vector(b, r);
+
+  for (k = 0; k < 3; ++k)
+    {
+      const char *desc;
+      double normr, normb;
+      int status;
+
+      gsl_spmatrix_set_zero(A);
+
+      if (k < 2)
+        {
+          /* tridiagonal, diagonally dominant; symmetric for IC(0) */
+          for (i = 0; i < N; ++i)
+            {
+              gsl_spmatrix_set(A, i, i, 4.0 + gsl_rng_uniform(r));
+
+              if (i + 1 < N)
+                {
+                  double lower = gsl_rng_uniform(r) - 0.5;
+                  double upper = (k == 1) ? lower : gsl_rng_uniform(r) - 0.5;
+                  gsl_spmatrix_set(A, i + 1, i, lower);
+                  gsl_spmatrix_set(A, i, i + 1, upper);
+                }
+            }
+        }
+      else
+        {
+          /* random sparse, made diagonally dominant */
+          gsl_spmatrix *R = create_random_sparse(N, N, 0.2, r);
+          gsl_spmatrix_memcpy(A, R);
+          gsl_spmatrix_free(R);
+
+          for (i = 0; i < N; ++i)
+            gsl_spmatrix_set(A, i, i, gsl_spmatrix_get(A, i, i) + (double) N);
+        }
+
+      C = gsl_spmatrix_crs(A);
+
+      if (k == 0)
+        {
+          desc = "ilu0";
+          status = gsl_splinalg_ilu0(C, w);
+        }
+      else if (k == 1)
+        {
+          desc = "ic0";
+          status = gsl_splinalg_ic0(C, w);
+        }
+      else
+        {
+          desc = "ilut";
+          status = gsl_splinalg_ilut(C, 0.0, N, w);
+        }
+
+      gsl_test(status, "%s exact factorization N=%zu status=%d", desc, N, status);
+
+      status = gsl_splinalg_ilu_solve(w, b, x);
+      gsl_test(status, "%s exact solve N=%zu status=%d", desc, N, status);
+
+      gsl_vector_memcpy(res, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, C, x, 1.0, res);
+
+      normr = gsl_blas_dnrm2(res);
+      normb = gsl_blas_dnrm2(b);
+
+      gsl_test(normr > tol * normb, "%s exact residual N=%zu normr=%.12e normb=%.12e",
+               desc, N, normr, normb);
+
+      /* a tridiagonal factor has no parallelism in its triangular solves */
+      if (k < 2)
+        {
+          gsl_test(w->nlevL != N || w->nlevU != N,
+                   "%s exact levels N=%zu nlevL=%zu nlevU=%zu",
+                   desc, N, w->nlevL, w->nlevU);
+        }
+
+      gsl_spmatrix_free(C);
+    }
+
+  gsl_spmatrix_free(A);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_vector_free(res);
+  gsl_splinalg_ilu_free(w);
+} /* test_ilu_exact() */
+
+/*
+test_ilu_convdiff()
+  Solve the 2D convection-diffusion equation
+
+  -(u_xx + u_yy) + beta (u_x + u_y) = f
+
+on an nx-by-nx grid (upwind differences for the convection term)
+with and without an incomplete factorization preconditioner, and
+check that the preconditioned solver needs fewer iterations.
+For beta = 0 the matrix is symmetric positive definite.
+
+Inputs: T    - iterative solver
+        nx   - grid points in each dimension
+        beta - convection coefficient
+        type - 0 = ILU(0), 1 = ILUT, 2 = IC(0)
+*/
+
+static void
+test_ilu_convdiff(const gsl_splinalg_itersolve_type *T, const size_t nx,
+                  const double beta, const int type, const gsl_rng *r)
+{
+  const size_t N = nx * nx;
+  const double h = 1.0 / (nx + 1.0);
+  const double tol = 1.0e-8;
+  const size_t max_iter = 200;
+  gsl_spmatrix *A = gsl_spmatrix_alloc(N, N);
+  gsl_spmatrix *C;
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_splinalg_itersolve *w = gsl_splinalg_itersolve_alloc(T, N, 0);
+  gsl_splinalg_ilu_workspace *ilu = gsl_splinalg_ilu_alloc(N);
+  const char *desc = gsl_splinalg_itersolve_name(w);
+  const char *pdesc[] = { "ilu0", "ilut", "ic0" };
+  gsl_splinalg_precon P;
+  size_t niter[2];
+  size_t i, j, k;
+  int status;
+
+  for (i = 0; i < nx; ++i)
+    {
+      for (j = 0; j < nx; ++j)
+        {
+          size_t row = i * nx + j;
+
+          gsl_spmatrix_set(A, row, row, 4.0 + 2.0 * beta * h);
+
+          if (i > 0)
+            gsl_spmatrix_set(A, row, row - nx, -1.0 - beta * h);
+          if (i + 1 < nx)
+            gsl_spmatrix_set(A, row, row + nx, -1.0);
+          if (j > 0)
+            gsl_spmatrix_set(A, row, row - 1, -1.0 - beta * h);
+          if (j + 1 < nx)
+            gsl_spmatrix_set(A, row, row + 1, -1.0);
+        }
+    }
+
+  C = gsl_spmatrix_crs(A);
+  create_random_vector(b, r);
+
+  if (type == 0)
+    status = gsl_splinalg_ilu0(C, ilu);
+  else if (type == 1)
+    status = gsl_splinalg_ilut(C, 1.0e-3, 10, ilu);
+  else
+    status = gsl_splinalg_ic0(C, ilu);
+
+  gsl_test(status, "%s/%s convdiff factorization nx=%zu", desc, pdesc[type], nx);
+
+  P.apply = gsl_splinalg_ilu_precon;
+  P.params = ilu;
+
+  for (k = 0; k < 2; ++k)
+    {
+      size_t iter = 0;
+
+      gsl_splinalg_itersolve_set_precon(w, k ? &P : NULL);
+      gsl_splinalg_itersolve_reset(w);
+      gsl_vector_set_zero(x);
+
+      do
+        {
+          status = gsl_splinalg_itersolve_iterate(C, b, tol, x, w);
+        }
+      while (status == GSL_CONTINUE && ++iter < max_iter);
+
+      gsl_test(status, "%s/%s convdiff precon=%zu status s=%d nx=%zu beta=%g",
+               desc, pdesc[type], k, status, nx, beta);
+
+      niter[k] = gsl_splinalg_itersolve_niter(w);
+    }
+
+  gsl_test(niter[1] >= niter[0], "%s/%s convdiff iterations nx=%zu niter=%zu/%zu",
+           desc, pdesc[type], nx, niter[1], niter[0]);
+
+  gsl_splinalg_itersolve_free(w);
+  gsl_splinalg_ilu_free(ilu);
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(C);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+} /* test_ilu_convdiff() */
+
+/*
+test_cholesky_poisson()
+  Factor the 2D Poisson matrix on an nx-by-nx grid with the sparse
+Cholesky solver. The symbolic analysis is computed once and reused
+for several numeric factorizations with shifted diagonals. Also check
+that the minimum degree ordering produces less fill-in than the
+natural ordering.
+
+Inputs: nx     - grid points in each dimension
+        format - storage format of the input matrix
+*/
+
+static void
+test_cholesky_poisson(const size_t nx, const int format, const gsl_rng *r)
+{
+  const size_t N = nx * nx;
+  const double tol = 1.0e-10;
+  gsl_spmatrix *A = gsl_spmatrix_alloc(N, N);
+  gsl_spmatrix *C;
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_vector *res = gsl_vector_alloc(N);
+  gsl_permutation *perm = gsl_permutation_alloc(N);
+  gsl_splinalg_cholesky_workspace *w = gsl_splinalg_cholesky_alloc(N);
+  size_t nnzL_natural;
+  size_t i, j, k;
+  int status;
+
+  for (i = 0; i < nx; ++i)
+    {
+      for (j = 0; j < nx; ++j)
+        {
+          size_t row = i * nx + j;
+
+          gsl_spmatrix_set(A, row, row, 4.0);
+
+          if (i > 0)
+            gsl_spmatrix_set(A, row, row - nx, -1.0);
+          if (i + 1 < nx)
+            gsl_spmatrix_set(A, row, row + nx, -1.0);
+          if (j > 0)
+            gsl_spmatrix_set(A, row, row - 1, -1.0);
+          if (j + 1 < nx)
+            gsl_spmatrix_set(A, row, row + 1, -1.0);
+        }
+    }
+
+  if (format == GSL_SPMATRIX_CCS)
+    C = gsl_spmatrix_ccs(A);
+  else if (format == GSL_SPMATRIX_CRS)
+    C = gsl_spmatrix_crs(A);
+  else
+    {
+      C = gsl_spmatrix_alloc_nzmax(N, N, gsl_spmatrix_nnz(A), GSL_SPMATRIX_TRIPLET);
+      gsl_spmatrix_memcpy(C, A);
+    }
+
+  /* natural ordering */
+  gsl_permutation_init(perm);
+  status = gsl_splinalg_cholesky_symbolic(C, perm, w);
+  gsl_test(status, "cholesky poisson natural symbolic nx=%zu format=%d", nx, format);
+  nnzL_natural = w->nnzL;
+
+  status = gsl_splinalg_cholesky_symbolic(C, NULL, w);
+  gsl_test(status, "cholesky poisson amd symbolic nx=%zu format=%d", nx, format);
+
+  if (nx >= 10)
+    {
+      gsl_test(w->nnzL >= nnzL_natural, "cholesky poisson fill-in nx=%zu nnzL=%zu/%zu",
+               nx, w->nnzL, nnzL_natural);
+    }
+
+  create_random_vector(b, r);
+
+  for (k = 0; k < 3; ++k)
+    {
+      double normr, normb;
+
+      /* change the values, keeping the pattern */
+      if (k > 0)
+        {
+          for (i = 0; i < gsl_spmatrix_nnz(C); ++i)
+            {
+              if (C->data[i] > 0.0)
+                C->data[i] += gsl_rng_uniform(r);
+            }
+        }
+
+      status = gsl_splinalg_cholesky_numeric(C, w);
+      gsl_test(status, "cholesky poisson numeric nx=%zu format=%d k=%zu", nx, format, k);
+
+      status = gsl_splinalg_cholesky_solve(w, b, x);
+      gsl_test(status, "cholesky poisson solve nx=%zu format=%d k=%zu", nx, format, k);
+
+      gsl_vector_memcpy(res, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, C, x, 1.0, res);
+
+      normr = gsl_blas_dnrm2(res);
+      normb = gsl_blas_dnrm2(b);
+
+      gsl_test(normr > tol * normb,
+               "cholesky poisson residual nx=%zu format=%d k=%zu normr=%.12e normb=%.12e",
+               nx, format, k, normr, normb);
+    }
+
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(C);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_vector_free(res);
+  gsl_permutation_free(perm);
+  gsl_splinalg_cholesky_free(w);
+} /* test_cholesky_poisson() */
+
+/*
+test_cholesky_random()
+  Factor the random symmetric positive definite matrix B + B^T + N I
+with the sparse Cholesky solver
+*/
+
+static void
+test_cholesky_random(const size_t N, const gsl_rng *r)
+{
+  const double tol = 1.0e-10;
+  gsl_spmatrix *B = create_random_sparse(N, N, 0.1, r);
+  gsl_spmatrix *A = gsl_spmatrix_alloc(N, N);
+  gsl_spmatrix *C;
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_vector *res = gsl_vector_alloc(N);
+  gsl_splinalg_cholesky_workspace *w = gsl_splinalg_cholesky_alloc(N);
+  double normr, normb;
+  size_t i;
+  int status;
+
+  for (i = 0; i < B->nz; ++i)
+    {
+      size_t row = B->i[i], col = B->p[i];
+      double val = B->data[i];
+
+      gsl_spmatrix_set(A, row, col, gsl_spmatrix_get(A, row, col) + val);
+      gsl_spmatrix_set(A, col, row, gsl_spmatrix_get(A, col, row) + val);
+    }
+
+  for (i = 0; i < N; ++i)
+    gsl_spmatrix_set(A, i, i, gsl_spmatrix_get(A, i, i) + (double) N);
+
+  C = gsl_spmatrix_ccs(A);
+  create_random_vector(b, r);
+
+  status = gsl_splinalg_cholesky_symbolic(C, NULL, w);
+  gsl_test(status, "cholesky random symbolic N=%zu", N);
+
+  status = gsl_splinalg_cholesky_numeric(C, w);
+  gsl_test(status, "cholesky random numeric N=%zu", N);
+
+  status = gsl_splinalg_cholesky_solve(w, b, x);
+  gsl_test(status, "cholesky random solve N=%zu", N);
+
+  gsl_vector_memcpy(res, b);
+  gsl_spblas_dgemv(CblasNoTrans, -1.0, C, x, 1.0, res);
+
+  normr = gsl_blas_dnrm2(res);
+  normb = gsl_blas_dnrm2(b);
+
+  gsl_test(normr > tol * normb, "cholesky random residual N=%zu normr=%.12e normb=%.12e",
+           N, normr, normb);
+
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(B);
+  gsl_spmatrix_free(C);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_vector_free(res);
+  gsl_splinalg_cholesky_free(w);
+} /* test_cholesky_random() */
+
+/*
+test_lu_random()
+  Factor a random nonsymmetric sparse matrix with the sparse LU
+solver, then refactor a matrix with the same pattern and different
+values. If small_diag is set, the diagonal is scaled by 1e-8 so that
+pivoting is required.
+*/
+
+static void
+test_lu_random(const size_t N, const int small_diag, const gsl_rng *r)
+{
+  const double tol = 1.0e-10;
+  gsl_spmatrix *A = create_random_sparse(N, N, 0.2, r);
+  gsl_spmatrix *C;
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_vector *res = gsl_vector_alloc(N);
+  gsl_splinalg_lu_workspace *w = gsl_splinalg_lu_alloc(N);
+  size_t i, k;
+  int status;
+
+  if (small_diag)
+    {
+      for (i = 0; i < N; ++i)
+        gsl_spmatrix_set(A, i, i, 1.0e-8 * gsl_spmatrix_get(A, i, i));
+
+      /* make sure every row and column has an off-diagonal entry */
+      for (i = 0; i < N; ++i)
+        gsl_spmatrix_set(A, i, (i + 1) % N, 1.0 + gsl_rng_uniform(r));
+    }
+
+  C = gsl_spmatrix_ccs(A);
+  create_random_vector(b, r);
+
+  status = gsl_splinalg_lu_symbolic(C, NULL, w);
+  gsl_test(status, "lu random symbolic N=%zu small_diag=%d", N, small_diag);
+
+  for (k = 0; k < 2; ++k)
+    {
+      double normr, normb, normA = 0.0;
+
+      if (k == 0)
+        {
+          status = gsl_splinalg_lu_numeric(C, 1.0, w);
+          gsl_test(status, "lu random numeric N=%zu small_diag=%d", N, small_diag);
+        }
+      else
+        {
+          /* perturb the values, keeping the pattern */
+          for (i = 0; i < C->nz; ++i)
+            C->data[i] *= 1.0 + 0.1 * gsl_rng_uniform(r);
+
+          status = gsl_splinalg_lu_refactor(C, w);
+          gsl_test(status, "lu random refactor N=%zu small_diag=%d", N, small_diag);
+        }
+
+      status = gsl_splinalg_lu_solve(w, b, x);
+      gsl_test(status, "lu random solve N=%zu small_diag=%d k=%zu", N, small_diag, k);
+
+      gsl_vector_memcpy(res, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, C, x, 1.0, res);
+
+      for (i = 0; i < C->nz; ++i)
+        normA += C->data[i] * C->data[i];
+
+      normr = gsl_blas_dnrm2(res);
+      normb = gsl_blas_dnrm2(b);
+      normA = sqrt(normA);
+
+      gsl_test(normr > tol * (normA * gsl_blas_dnrm2(x) + normb),
+               "lu random residual N=%zu small_diag=%d k=%zu normr=%.12e normb=%.12e",
+               N, small_diag, k, normr, normb);
+    }
+
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(C);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_vector_free(res);
+  gsl_splinalg_lu_free(w);
+} /* test_lu_random() */
+
+/* bandwidth and total distance |i - j| of the entries of a CSR/CSC matrix */
+static void
+order_stats(const gsl_spmatrix *A, size_t *bw, double *dist)
+{
+  size_t j;
+
+  *bw = 0;
+  *dist = 0.0;
+
+  for (j = 0; j < A->size1; ++j)
+    {
+      int p;
+      for (p = A->p[j]; p < A->p[j + 1]; ++p)
+        {
+          size_t d = (A->i[p] > (int) j) ? A->i[p] - j : j - A->i[p];
+          *bw = GSL_MAX(*bw, d);
+          *dist += (double) d;
+        }
+    }
+}
+
+/*
+test_order()
+  Scramble the 2D Poisson matrix on an nx-by-nx grid with a random
+permutation, and check that the reverse Cuthill-McKee and bisection
+orderings recover a small bandwidth and good locality. Also check
+the symmetric permutation and vector permutation routines.
+
+Inputs: nx     - grid points in each dimension
+        format - GSL_SPMATRIX_CSC or GSL_SPMATRIX_CSR
+*/
+
+static void
+test_order(const size_t nx, const int format, const gsl_rng *r)
+{
+  const size_t N = nx * nx;
+  const double tol = 1.0e-12;
+  gsl_spmatrix *T = gsl_spmatrix_alloc(N, N);
+  gsl_spmatrix *A, *B, *C;
+  gsl_permutation *q = gsl_permutation_alloc(N);
+  gsl_permutation *p = gsl_permutation_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_vector *y = gsl_vector_alloc(N);
+  gsl_vector *z = gsl_vector_alloc(N);
+  gsl_vector *u = gsl_vector_alloc(N);
+  size_t bwA, bwB, bwC;
+  double distA, distB, distC;
+  size_t i, j;
+  int status;
+
+  for (i = 0; i < nx; ++i)
+    {
+      for (j = 0; j < nx; ++j)
+        {
+          size_t row = i * nx + j;
+
+          gsl_spmatrix_set(T, row, row, 4.0 + gsl_rng_uniform(r));
+
+          if (i > 0)
+            gsl_spmatrix_set(T, row, row - nx, -1.0);
+          if (i + 1 < nx)
+            gsl_spmatrix_set(T, row, row + nx, -1.0);
+          if (j > 0)
+            gsl_spmatrix_set(T, row, row - 1, -1.0);
+          if (j + 1 < nx)
+            gsl_spmatrix_set(T, row, row + 1, -1.0);
+        }
+    }
+
+  A = (format == GSL_SPMATRIX_CSC) ? gsl_spmatrix_ccs(T) : gsl_spmatrix_crs(T);
+  B = gsl_spmatrix_alloc_nzmax(N, N, 1, format);
+  C = gsl_spmatrix_alloc_nzmax(N, N, 1, format);
+
+  /* random permutation */
+  gsl_permutation_init(q);
+  for (i = N; i > 1; --i)
+    gsl_permutation_swap(q, i - 1, gsl_rng_uniform_int(r, i));
+
+  status = gsl_splinalg_symperm(A, q, B);
+  gsl_test(status, "order symperm nx=%zu format=%d", nx, format);
+
+  /* B(i,j) = A(q[i],q[j]), with sorted indices */
+  status = (B->nz != A->nz);
+  for (i = 0; i < N; ++i)
+    {
+      int k;
+      for (k = B->p[i]; k < B->p[i + 1]; ++k)
+        {
+          size_t row = (format == GSL_SPMATRIX_CSR) ? i : (size_t) B->i[k];
+          size_t col = (format == GSL_SPMATRIX_CSR) ? (size_t) B->i[k] : i;
+
+          if (k > B->p[i] && B->i[k] <= B->i[k - 1])
+            status = 1;
+
+          if (B->data[k] != gsl_spmatrix_get(A, q->data[row], q->data[col]))
+            status = 1;
+        }
+    }
+
+  gsl_test(status, "order symperm entries nx=%zu format=%d", nx, format);
+
+  /* B (Q x) = Q (A x) */
+  create_random_vector(x, r);
+  gsl_splinalg_permute_vector(q, x, y);
+  gsl_spblas_dgemv(CblasNoTrans, 1.0, B, y, 0.0, z);
+  gsl_spblas_dgemv(CblasNoTrans, 1.0, A, x, 0.0, u);
+  gsl_splinalg_permute_vector(q, u, y);
+  gsl_vector_sub(y, z);
+  gsl_test(gsl_blas_dnrm2(y) > tol * gsl_blas_dnrm2(u),
+           "order permute_vector nx=%zu format=%d", nx, format);
+
+  gsl_splinalg_permute_vector(q, x, y);
+  gsl_splinalg_permute_vector_inverse(q, y, z);
+  gsl_vector_sub(z, x);
+  gsl_test(!gsl_vector_isnull(z), "order permute_vector_inverse nx=%zu format=%d", nx, format);
+
+  order_stats(A, &bwA, &distA);
+  order_stats(B, &bwB, &distB);
+
+  /* reverse Cuthill-McKee */
+  status = gsl_splinalg_rcm(B, p);
+  gsl_test(status || gsl_permutation_valid(p), "order rcm nx=%zu format=%d", nx, format);
+
+  gsl_splinalg_symperm(B, p, C);
+  order_stats(C, &bwC, &distC);
+  gsl_test(bwC > bwA + 1 || (nx > 5 && bwC >= bwB),
+           "order rcm bandwidth nx=%zu format=%d bw=%zu natural=%zu scrambled=%zu",
+           nx, format, bwC, bwA, bwB);
+
+  /* multilevel bisection */
+  status = gsl_splinalg_bisect(B, 16, p);
+  gsl_test(status || gsl_permutation_valid(p), "order bisect nx=%zu format=%d", nx, format);
+
+  gsl_splinalg_symperm(B, p, C);
+  order_stats(C, &bwC, &distC);
+  gsl_test(nx > 10 && distC > 0.25 * distB,
+           "order bisect locality nx=%zu format=%d dist=%g scrambled=%g",
+           nx, format, distC, distB);
+
+  gsl_spmatrix_free(T);
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(B);
+  gsl_spmatrix_free(C);
+  gsl_permutation_free(p);
+  gsl_permutation_free(q);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(z);
+  gsl_vector_free(u);
+} /* test_order() */
+
+/*
+test_order_random()
+  Check that the orderings return valid permutations for random,
+possibly disconnected, nonsymmetric matrices
+*/
+
+static void
+test_order_random(const size_t N, const double density, const gsl_rng *r)
+{
+  gsl_spmatrix *A = create_random_sparse(N, N, density, r);
+  gsl_permutation *p = gsl_permutation_alloc(N);
+  int status;
+
+  status = gsl_splinalg_rcm(A, p);
+  gsl_test(status || gsl_permutation_valid(p), "order rcm random N=%zu density=%g", N, density);
+
+  status = gsl_splinalg_bisect(A, 4, p);
+  gsl_test(status || gsl_permutation_valid(p), "order bisect random N=%zu density=%g", N, density);
+
+  gsl_spmatrix_free(A);
+  gsl_permutation_free(p);
+} /* test_order_random() */
+
 int
 main()
 {
+  const gsl_splinalg_itersolve_type **T;
+  const gsl_splinalg_itersolve_type *types[] =
+    {
+      NULL, NULL, NULL, NULL, NULL, NULL
+    };
   gsl_rng *r = gsl_rng_alloc(gsl_rng_default);
   size_t n;
 
-  test_poisson(7, 1.0e-1, 0);
-  test_poisson(7, 1.0e-1, 1);
+  types[0] = gsl_splinalg_itersolve_gmres;
+  types[1] = gsl_splinalg_itersolve_fgmres;
+  types[2] = gsl_splinalg_itersolve_cg;
+  types[3] = gsl_splinalg_itersolve_bicgstab;
+  types[4] = gsl_splinalg_itersolve_minres;
+
+  for (T = types; *T != NULL; ++T)
+    {
+      test_poisson(*T, 7, 1.0e-1, 0);
+      test_poisson(*T, 7, 1.0e-1, 1);
+
+      test_poisson(*T, 543, 1.0e-5, 0);
+      test_poisson(*T, 543, 1.0e-5, 1);
+
+      test_poisson(*T, 1000, 1.0e-6, 0);
+      test_poisson(*T, 1000, 1.0e-6, 1);
+
+      test_poisson(*T, 5000, 1.0e-7, 0);
+      test_poisson(*T, 5000, 1.0e-7, 1);
 
-  test_poisson(543, 1.0e-5, 0);
-  test_poisson(543, 1.0e-5, 1);
+      test_precon(*T, 50, r);
+      test_precon(*T, 200, r);
+    }
+
+  /* nonsymmetric systems */
+  for (T = types; *T != NULL; ++T)
+    {
+      if (*T == gsl_splinalg_itersolve_cg || *T == gsl_splinalg_itersolve_minres)
+        continue;
 
-  test_poisson(1000, 1.0e-6, 0);
-  test_poisson(1000, 1.0e-6, 1);
+      test_toeplitz(*T, 15, 0.01, 1.0, 0.01);
+      test_toeplitz(*T, 15, 1.0, 1.0, 0.01);
+      test_toeplitz(*T, 50, 1.0, 2.0, 0.01);
+      test_toeplitz(*T, 1000, 0.5, 1.0, 0.01);
+    }
 
-  test_poisson(5000, 1.0e-7, 0);
-  test_poisson(5000, 1.0e-7, 1);
+  for (n = 1; n <= 50; ++n)
+    test_ilu_exact(n, r);
+
+  test_ilu_convdiff(gsl_splinalg_itersolve_gmres, 30, 50.0, 0, r);
+  test_ilu_convdiff(gsl_splinalg_itersolve_gmres, 30, 50.0, 1, r);
+  test_ilu_convdiff(gsl_splinalg_itersolve_bicgstab, 30, 50.0, 0, r);
+  test_ilu_convdiff(gsl_splinalg_itersolve_bicgstab, 30, 50.0, 1, r);
+  test_ilu_convdiff(gsl_splinalg_itersolve_fgmres, 30, 50.0, 1, r);
+  test_ilu_convdiff(gsl_splinalg_itersolve_cg, 30, 0.0, 2, r);
+  test_ilu_convdiff(gsl_splinalg_itersolve_minres, 30, 0.0, 2, r);
+
+  test_cholesky_poisson(1, GSL_SPMATRIX_TRIPLET, r);
+  test_cholesky_poisson(5, GSL_SPMATRIX_CCS, r);
+  test_cholesky_poisson(20, GSL_SPMATRIX_TRIPLET, r);
+  test_cholesky_poisson(20, GSL_SPMATRIX_CCS, r);
+  test_cholesky_poisson(20, GSL_SPMATRIX_CRS, r);
+  test_cholesky_poisson(50, GSL_SPMATRIX_CCS, r);
+
+  for (n = 1; n <= 50; ++n)
+    {
+      test_cholesky_random(n, r);
+      test_lu_random(n, 0, r);
+      test_lu_random(n, 1, r);
+    }
+
+  test_lu_random(500, 0, r);
+  test_lu_random(500, 1, r);
+
+  test_order(1, GSL_SPMATRIX_CSR, r);
+  test_order(5, GSL_SPMATRIX_CSR, r);
+  test_order(30, GSL_SPMATRIX_CSR, r);
+  test_order(30, GSL_SPMATRIX_CSC, r);
+  test_order(100, GSL_SPMATRIX_CSR, r);
+
+  for (n = 1; n <= 50; ++n)
+    {
+      test_order_random(n, 0.02, r);
+      test_order_random(n, 0.2, r);
+    }
 
-  test_toeplitz(15, 0.01, 1.0, 0.01);
-  test_toeplitz(15, 1.0, 1.0, 0.01);
-  test_toeplitz(50, 1.0, 2.0, 0.01);
-  test_toeplitz(1000, 0.5, 1.0, 0.01);
+  test_order_random(2000, 0.001, r);
 
   for (n = 1; n <= 100; ++n)
     {
-      test_random(n, r, 0);
-      test_random(n, r, 1);
+      test_random(gsl_splinalg_itersolve_gmres, n, r, 0);
+      test_random(gsl_splinalg_itersolve_gmres, n, r, 1);
+      test_random(gsl_splinalg_itersolve_gmres, n, r, 2);
+      test_random(gsl_splinalg_itersolve_gmres, n, r, 3);
+      test_random(gsl_splinalg_itersolve_fgmres, n, r, 1);
     }
 
   gsl_rng_free(r);
@@ -1,8 +1,82 @@
 #include <config.h>
 #include <stddef.h>
+#include <stdlib.h>
 #include <gsl/gsl_spmatrix.h>
 #include <gsl/gsl_errno.h>
 
+typedef struct
+{
+  int len;
+  int row;
+} spmatrix_sell_row;
+
+static int
+spmatrix_sell_compare(const void * a, const void * b)
+{
+  const spmatrix_sell_row * ra = (const spmatrix_sell_row *) a;
+  const spmatrix_sell_row * rb = (const spmatrix_sell_row *) b;
+
+  /* decreasing row length; ties keep the original row order */
+  if (ra->len != rb->len)
+    return (ra->len > rb->len) ? -1 : 1;
+  else
+    return (ra->row > rb->row) - (ra->row < rb->row);
+}
+
+/*
+spmatrix_sell_perm()
+  Compute the SELL-C-sigma row permutation, which sorts the rows
+of a CSR matrix by decreasing length within consecutive windows
+of sigma rows
+
+Inputs: M     - number of rows
+        Ap    - CSR row pointers, length M + 1
+        sigma - sorting window
+        perm  - (output) perm[k] = original index of sorted row k
+*/
+
+static int
+spmatrix_sell_perm(const size_t M, const int * Ap, const size_t sigma, int * perm)
+{
+  size_t k;
+
+  if (sigma <= 1)
+    {
+      for (k = 0; k < M; ++k)
+        perm[k] = (int) k;
+    }
+  else
+    {
+      spmatrix_sell_row * rows = malloc(GSL_MIN(sigma, M) * sizeof(spmatrix_sell_row));
+      size_t start;
+
+      if (rows == NULL)
+        {
+          GSL_ERROR("failed to allocate space for row lengths", GSL_ENOMEM);
+        }
+
+      for (start = 0; start < M; start += sigma)
+        {
+          const size_t n = GSL_MIN(sigma, M - start);
+
+          for (k = 0; k < n; ++k)
+            {
+              rows[k].row = (int) (start + k);
+              rows[k].len = Ap[start + k + 1] - Ap[start + k];
+            }
+
+          qsort(rows, n, sizeof(spmatrix_sell_row), spmatrix_sell_compare);
+
+          for (k = 0; k < n; ++k)
+            perm[start + k] = rows[k].row;
+        }
+
+      free(rows);
+    }
+
+  return GSL_SUCCESS;
+}
+
 #define BASE_GSL_COMPLEX_LONG
 #include "templates_on.h"
 #include "compress_source.c"
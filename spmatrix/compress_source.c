@@ -186,6 +186,236 @@ FUNCTION (gsl_spmatrix, csr) (TYPE (gsl_spmatrix) * dest, const TYPE (gsl_spmatr
     }
 }
 
+/*
+gsl_spmatrix_bsr()
+  Convert a CSR matrix to block compressed row format
+
+Inputs: dest - (output) sparse matrix in BSR format; the block size
+               is taken from dest->block_size
+        src  - sparse matrix in CSR format
+
+Return: success/error
+
+Notes:
+1) Every b-by-b block containing at least one element of src is
+stored densely, with zeros filling the remaining positions
+
+2) Within each block row, blocks appear in the order in which they
+are first encountered in src
+*/
+
+int
+FUNCTION (gsl_spmatrix, bsr) (TYPE (gsl_spmatrix) * dest, const TYPE (gsl_spmatrix) * src)
+{
+  if (!GSL_SPMATRIX_ISCSR(src))
+    {
+      GSL_ERROR("input matrix must be in CSR format", GSL_EINVAL);
+    }
+  else if (!GSL_SPMATRIX_ISBSR(dest))
+    {
+      GSL_ERROR("output matrix must be in BSR format", GSL_EINVAL);
+    }
+  else if (src->size1 != dest->size1 || src->size2 != dest->size2)
+    {
+      GSL_ERROR("matrices must have same dimensions", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      const size_t b = dest->block_size;
+      const size_t bs2 = b * b;
+      const size_t nb1 = dest->size1 / b; /* number of block rows */
+      const size_t nb2 = dest->size2 / b; /* number of block columns */
+      const int *Ap = src->p;
+      const int *Aj = src->i;
+      int *Bp = dest->p;
+      int *w = dest->work.work_int;       /* w[J] = position of block column J in current block row */
+      size_t I, n, r;
+      int nblocks = 0;
+      int p;
+
+      for (n = 0; n < nb2; ++n)
+        w[n] = -1;
+
+      /* first pass: count blocks in each block row */
+      for (I = 0; I < nb1; ++I)
+        {
+          for (p = Ap[I * b]; p < Ap[(I + 1) * b]; ++p)
+            {
+              int J = Aj[p] / (int) b;
+
+              if (w[J] != (int) I)
+                {
+                  w[J] = (int) I;
+                  ++nblocks;
+                }
+            }
+        }
+
+      if (dest->nzmax < (size_t) nblocks)
+        {
+          status = FUNCTION (gsl_spmatrix, realloc) (nblocks, dest);
+          if (status)
+            return status;
+        }
+
+      for (n = 0; n < nb2; ++n)
+        w[n] = -1;
+
+      for (n = 0; n < nblocks * bs2 * MULTIPLICITY; ++n)
+        dest->data[n] = (ATOMIC) 0;
+
+      /* second pass: assign block positions and scatter elements */
+      Bp[0] = 0;
+      for (I = 0; I < nb1; ++I)
+        {
+          int nz = Bp[I];
+
+          for (p = Ap[I * b]; p < Ap[(I + 1) * b]; ++p)
+            {
+              int J = Aj[p] / (int) b;
+
+              if (w[J] < 0)
+                {
+                  w[J] = nz;
+                  dest->i[nz++] = J;
+                }
+            }
+
+          for (n = I * b; n < (I + 1) * b; ++n)
+            {
+              for (p = Ap[n]; p < Ap[n + 1]; ++p)
+                {
+                  size_t idx = w[Aj[p] / (int) b] * bs2 + (n % b) * b + Aj[p] % (int) b;
+
+                  for (r = 0; r < MULTIPLICITY; ++r)
+                    dest->data[MULTIPLICITY * idx + r] = src->data[MULTIPLICITY * p + r];
+                }
+            }
+
+          /* reset markers for the next block row */
+          for (p = Bp[I]; p < nz; ++p)
+            w[dest->i[p]] = -1;
+
+          Bp[I + 1] = nz;
+        }
+
+      dest->nz = nblocks;
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_spmatrix_sell()
+  Convert a CSR matrix to sliced ELLPACK (SELL-C-sigma) format
+
+Inputs: dest - (output) sparse matrix in SELL format; the slice
+               height C and sorting window sigma are taken from
+               dest->block_size and dest->sigma
+        src  - sparse matrix in CSR format
+
+Return: success/error
+
+Notes:
+1) Padding entries are stored with value 0 and the column index of
+the last element of their row (or 0 for an empty row), so that
+kernels may process all lanes of a slice without branching
+*/
+
+int
+FUNCTION (gsl_spmatrix, sell) (TYPE (gsl_spmatrix) * dest, const TYPE (gsl_spmatrix) * src)
+{
+  if (!GSL_SPMATRIX_ISCSR(src))
+    {
+      GSL_ERROR("input matrix must be in CSR format", GSL_EINVAL);
+    }
+  else if (!GSL_SPMATRIX_ISSELL(dest))
+    {
+      GSL_ERROR("output matrix must be in SELL format", GSL_EINVAL);
+    }
+  else if (src->size1 != dest->size1 || src->size2 != dest->size2)
+    {
+      GSL_ERROR("matrices must have same dimensions", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      const size_t M = dest->size1;
+      const size_t C = dest->block_size;
+      const size_t nslices = (M + C - 1) / C;
+      const int *Ap = src->p;
+      const int *Aj = src->i;
+      int *Sp = dest->p;
+      int *perm = dest->perm;
+      size_t s, k, r, n;
+
+      /* sort rows by decreasing length within each sigma window */
+      status = spmatrix_sell_perm(M, Ap, dest->sigma, perm);
+      if (status)
+        return status;
+
+      /* compute slice pointers from the longest row of each slice */
+      Sp[0] = 0;
+      for (s = 0; s < nslices; ++s)
+        {
+          int width = 0;
+
+          for (r = 0; r < C && s * C + r < M; ++r)
+            {
+              int row = perm[s * C + r];
+              width = GSL_MAX(width, Ap[row + 1] - Ap[row]);
+            }
+
+          Sp[s + 1] = Sp[s] + width * (int) C;
+        }
+
+      if (dest->nzmax < (size_t) Sp[nslices])
+        {
+          status = FUNCTION (gsl_spmatrix, realloc) (Sp[nslices], dest);
+          if (status)
+            return status;
+        }
+
+      for (s = 0; s < nslices; ++s)
+        {
+          const size_t width = (Sp[s + 1] - Sp[s]) / C;
+
+          for (r = 0; r < C; ++r)
+            {
+              int row = (s * C + r < M) ? perm[s * C + r] : -1;
+              int start = (row >= 0) ? Ap[row] : 0;
+              size_t len = (row >= 0) ? (size_t) (Ap[row + 1] - Ap[row]) : 0;
+              int pad = (len > 0) ? Aj[start + len - 1] : 0;
+
+              for (k = 0; k < width; ++k)
+                {
+                  size_t idx = Sp[s] + k * C + r;
+
+                  if (k < len)
+                    {
+                      dest->i[idx] = Aj[start + k];
+
+                      for (n = 0; n < MULTIPLICITY; ++n)
+                        dest->data[MULTIPLICITY * idx + n] = src->data[MULTIPLICITY * (start + k) + n];
+                    }
+                  else
+                    {
+                      dest->i[idx] = pad;
+
+                      for (n = 0; n < MULTIPLICITY; ++n)
+                        dest->data[MULTIPLICITY * idx + n] = (ATOMIC) 0;
+                    }
+                }
+            }
+        }
+
+      dest->nz = src->nz;
+
+      return GSL_SUCCESS;
+    }
+}
+
 /* XXX deprecated function */
 TYPE (gsl_spmatrix) *
 FUNCTION (gsl_spmatrix, crs) (const TYPE (gsl_spmatrix) * src)
@@ -1,8 +1,376 @@
 #include <config.h>
 #include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
 #include <gsl/gsl_spmatrix.h>
 #include <gsl/gsl_errno.h>
 
+/*
+ * Matrix Market reader: the file is read in large chunks and split
+ * into lines in place, and indices are parsed by hand, which avoids
+ * the per-line overhead of fgets() and sscanf()
+ */
+
+#define SPMATRIX_MM_CHUNK       (1 << 20)
+
+/* field qualifiers */
+#define SPMATRIX_MM_UNKNOWN     -1
+#define SPMATRIX_MM_REAL        0
+#define SPMATRIX_MM_INTEGER     1
+#define SPMATRIX_MM_COMPLEX     2
+#define SPMATRIX_MM_PATTERN     3
+
+/* symmetry qualifiers */
+#define SPMATRIX_MM_GENERAL     0
+#define SPMATRIX_MM_SYMMETRIC   1
+#define SPMATRIX_MM_SKEW        2
+#define SPMATRIX_MM_HERMITIAN   3
+
+typedef struct
+{
+  FILE *stream;
+  char *buf;
+  size_t size;      /* size of buf */
+  size_t pos;       /* start of unread data in buf */
+  size_t len;       /* end of valid data in buf */
+  int eof;
+} spmatrix_mm_reader;
+
+typedef struct
+{
+  size_t size1;
+  size_t size2;
+  size_t nz;        /* number of entries in file */
+  int field;
+  int symmetry;
+} spmatrix_mm_header;
+
+static int spmatrix_mm_init(FILE * stream, spmatrix_mm_reader * r);
+static void spmatrix_mm_free(spmatrix_mm_reader * r);
+static char *spmatrix_mm_getline(spmatrix_mm_reader * r);
+static int spmatrix_mm_header_read(spmatrix_mm_reader * r, spmatrix_mm_header * h);
+static int spmatrix_mm_index(char ** s, size_t * x);
+static int spmatrix_mm_double(char ** s, double * x);
+static int spmatrix_mm_blank(const char * s);
+
+static int
+spmatrix_mm_init(FILE * stream, spmatrix_mm_reader * r)
+{
+  r->stream = stream;
+  r->size = SPMATRIX_MM_CHUNK;
+  r->pos = 0;
+  r->len = 0;
+  r->eof = 0;
+
+  r->buf = malloc(r->size);
+  if (!r->buf)
+    {
+      GSL_ERROR("failed to allocate space for read buffer", GSL_ENOMEM);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static void
+spmatrix_mm_free(spmatrix_mm_reader * r)
+{
+  free(r->buf);
+}
+
+/*
+spmatrix_mm_getline()
+  Return the next line of the input, with the newline replaced by a
+NUL character. The returned pointer is valid until the next call.
+
+Return: pointer to line, or NULL at end of file or on error
+*/
+
+static char *
+spmatrix_mm_getline(spmatrix_mm_reader * r)
+{
+  while (1)
+    {
+      char *start = r->buf + r->pos;
+      char *nl = memchr(start, '\n', r->len - r->pos);
+      size_t n;
+
+      if (nl != NULL)
+        {
+          *nl = '\0';
+          r->pos = (size_t) (nl - r->buf) + 1;
+          return start;
+        }
+
+      if (r->eof)
+        {
+          /* last line without a trailing newline */
+          if (r->pos < r->len)
+            {
+              r->buf[r->len] = '\0';
+              r->pos = r->len;
+              return start;
+            }
+
+          return NULL;
+        }
+
+      /* move the partial line to the front of the buffer and refill */
+      memmove(r->buf, start, r->len - r->pos);
+      r->len -= r->pos;
+      r->pos = 0;
+
+      if (r->len + 1 >= r->size)
+        {
+          /* line longer than the buffer */
+          char *ptr = realloc(r->buf, 2 * r->size);
+          if (!ptr)
+            {
+              GSL_ERROR_NULL("failed to grow read buffer", GSL_ENOMEM);
+            }
+
+          r->buf = ptr;
+          r->size *= 2;
+        }
+
+      /* leave room for the terminating NUL of the last line */
+      n = fread(r->buf + r->len, 1, r->size - r->len - 1, r->stream);
+      if (n == 0)
+        r->eof = 1;
+
+      r->len += n;
+    }
+}
+
+/*
+spmatrix_mm_header_read()
+  Read the banner line, if present, and the size line
+
+%%MatrixMarket matrix coordinate field symmetry
+M N NNZ
+
+Files without a banner are accepted as general matrices
+*/
+
+static int
+spmatrix_mm_header_read(spmatrix_mm_reader * r, spmatrix_mm_header * h)
+{
+  char *line;
+
+  h->field = SPMATRIX_MM_UNKNOWN;
+  h->symmetry = SPMATRIX_MM_GENERAL;
+
+  while ((line = spmatrix_mm_getline(r)) != NULL)
+    {
+      char *s = line;
+
+      if (strncmp(line, "%%MatrixMarket", 14) == 0)
+        {
+          char tok[4][32];
+          size_t k;
+          char *c;
+
+          if (sscanf(line + 14, "%31s %31s %31s %31s", tok[0], tok[1], tok[2], tok[3]) != 4)
+            {
+              GSL_ERROR("invalid Matrix Market banner", GSL_EFAILED);
+            }
+
+          for (k = 0; k < 4; ++k)
+            {
+              for (c = tok[k]; *c; ++c)
+                *c = (char) tolower((unsigned char) *c);
+            }
+
+          if (strcmp(tok[0], "matrix") != 0)
+            {
+              GSL_ERROR("Matrix Market object is not a matrix", GSL_EFAILED);
+            }
+          else if (strcmp(tok[1], "coordinate") != 0)
+            {
+              GSL_ERROR("only coordinate Matrix Market format is supported", GSL_EFAILED);
+            }
+
+          if (strcmp(tok[2], "real") == 0)
+            h->field = SPMATRIX_MM_REAL;
+          else if (strcmp(tok[2], "integer") == 0)
+            h->field = SPMATRIX_MM_INTEGER;
+          else if (strcmp(tok[2], "complex") == 0)
+            h->field = SPMATRIX_MM_COMPLEX;
+          else if (strcmp(tok[2], "pattern") == 0)
+            h->field = SPMATRIX_MM_PATTERN;
+          else
+            {
+              GSL_ERROR("unknown Matrix Market field qualifier", GSL_EFAILED);
+            }
+
+          if (strcmp(tok[3], "general") == 0)
+            h->symmetry = SPMATRIX_MM_GENERAL;
+          else if (strcmp(tok[3], "symmetric") == 0)
+            h->symmetry = SPMATRIX_MM_SYMMETRIC;
+          else if (strcmp(tok[3], "skew-symmetric") == 0)
+            h->symmetry = SPMATRIX_MM_SKEW;
+          else if (strcmp(tok[3], "hermitian") == 0)
+            h->symmetry = SPMATRIX_MM_HERMITIAN;
+          else
+            {
+              GSL_ERROR("unknown Matrix Market symmetry qualifier", GSL_EFAILED);
+            }
+
+          continue;
+        }
+
+      /* skip comments and blank lines */
+      if (*line == '%' || spmatrix_mm_blank(line))
+        continue;
+
+      if (spmatrix_mm_index(&s, &(h->size1)) ||
+          spmatrix_mm_index(&s, &(h->size2)) ||
+          spmatrix_mm_index(&s, &(h->nz)))
+        break;
+
+      if (h->symmetry != SPMATRIX_MM_GENERAL && h->size1 != h->size2)
+        {
+          GSL_ERROR("symmetric Matrix Market file must be square", GSL_ENOTSQR);
+        }
+
+      return GSL_SUCCESS;
+    }
+
+  GSL_ERROR("fscanf failed reading header", GSL_EFAILED);
+}
+
+/* parse a nonnegative decimal integer */
+static int
+spmatrix_mm_index(char ** s, size_t * x)
+{
+  char *p = *s;
+  size_t v = 0;
+
+  while (*p == ' ' || *p == '\t')
+    ++p;
+
+  if (*p < '0' || *p > '9')
+    return GSL_EFAILED;
+
+  while (*p >= '0' && *p <= '9')
+    v = 10 * v + (size_t) (*p++ - '0');
+
+  *x = v;
+  *s = p;
+
+  return GSL_SUCCESS;
+}
+
+/*
+spmatrix_mm_double()
+  Parse a double precision number. Numbers with at most 19 significant
+digits and a decimal exponent of magnitude at most 22 are converted
+exactly with a single rounding, since both the digits and the power of
+ten are representable; all others are passed to strtod()
+*/
+
+static int
+spmatrix_mm_double(char ** s, double * x)
+{
+  static const double pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  char *p = *s, *end;
+  uint64_t mant = 0;
+  int neg = 0, ndigit = 0, nsig = 0, exp10 = 0;
+
+  while (*p == ' ' || *p == '\t')
+    ++p;
+
+  *s = p;
+
+  if (*p == '-' || *p == '+')
+    neg = (*p++ == '-');
+
+  for (; *p >= '0' && *p <= '9'; ++p, ++ndigit)
+    {
+      if (mant != 0 || *p != '0')
+        {
+          mant = 10 * mant + (uint64_t) (*p - '0');
+          ++nsig;
+        }
+    }
+
+  if (*p == '.')
+    {
+      for (++p; *p >= '0' && *p <= '9'; ++p, ++ndigit)
+        {
+          if (mant != 0 || *p != '0')
+            {
+              mant = 10 * mant + (uint64_t) (*p - '0');
+              ++nsig;
+            }
+
+          --exp10;
+        }
+    }
+
+  if (ndigit > 0 && (*p == 'e' || *p == 'E'))
+    {
+      int eneg = 0, e = 0;
+
+      ++p;
+      if (*p == '-' || *p == '+')
+        eneg = (*p++ == '-');
+
+      if (*p < '0' || *p > '9')
+        goto fallback;
+
+      for (; *p >= '0' && *p <= '9'; ++p)
+        {
+          if (e < 10000)
+            e = 10 * e + (*p - '0');
+        }
+
+      exp10 += eneg ? -e : e;
+    }
+
+  if (ndigit > 0 && nsig <= 19 && mant < ((uint64_t) 1 << 53) &&
+      exp10 >= -22 && exp10 <= 22 &&
+      (*p == '\0' || isspace((unsigned char) *p)))
+    {
+      double v = (double) mant;
+
+      if (exp10 < 0)
+        v /= pow10[-exp10];
+      else
+        v *= pow10[exp10];
+
+      *x = neg ? -v : v;
+      *s = p;
+
+      return GSL_SUCCESS;
+    }
+
+fallback:
+  *x = strtod(*s, &end);
+  if (end == *s)
+    return GSL_EFAILED;
+
+  *s = end;
+
+  return GSL_SUCCESS;
+}
+
+static int
+spmatrix_mm_blank(const char * s)
+{
+  while (*s)
+    {
+      if (!isspace((unsigned char) *s++))
+        return 0;
+    }
+
+  return 1;
+}
+
 #define BASE_GSL_COMPLEX_LONG
 #include "templates_on.h"
 #include "file_source.c"
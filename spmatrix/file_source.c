@@ -197,96 +197,349 @@ FUNCTION (gsl_spmatrix, fprintf) (FILE * stream, const TYPE (gsl_spmatrix) * m,
   return GSL_SUCCESS;
 }
 
-TYPE (gsl_spmatrix) *
-FUNCTION (gsl_spmatrix, fscanf) (FILE * stream)
+/* parse one real number, or one component of a complex number */
+static int
+FUNCTION (spmatrix, mm_atomic) (char ** s, ATOMIC * x)
+{
+#if defined(BASE_DOUBLE) || defined(BASE_GSL_COMPLEX)
+  return spmatrix_mm_double(s, x);
+#else
+  char *end;
+
+#if defined(BASE_FLOAT) || defined(BASE_GSL_COMPLEX_FLOAT)
+  *x = strtof(*s, &end);
+#elif defined(BASE_LONG_DOUBLE) || defined(BASE_GSL_COMPLEX_LONG)
+  *x = strtold(*s, &end);
+#elif defined(BASE_ULONG) || defined(BASE_UINT) || defined(BASE_USHORT) || defined(BASE_UCHAR)
+  *x = (ATOMIC) strtoul(*s, &end, 10);
+#else
+  *x = (ATOMIC) strtol(*s, &end, 10);
+#endif
+
+  if (end == *s)
+    return GSL_EFAILED;
+
+  *s = end;
+
+  return GSL_SUCCESS;
+#endif
+}
+
+/*
+spmatrix_mm_assemble()
+  Assemble triplets (ti,tj,tx) into a sparse matrix of the given
+format, by two stable counting sorts; the first on the inner index and
+the second on the outer index. Duplicate entries are adjacent after
+sorting, and the last one read is kept, as with gsl_spmatrix_set()
+
+Inputs: size1  - number of rows
+        size2  - number of columns
+        n      - number of triplets
+        ti     - row indices, length n
+        tj     - column indices, length n
+        tx     - values, length MULTIPLICITY*n
+        sptype - GSL_SPMATRIX_COO, GSL_SPMATRIX_CSC or GSL_SPMATRIX_CSR
+
+Return: pointer to new matrix, or NULL on error
+*/
+
+static TYPE (gsl_spmatrix) *
+FUNCTION (spmatrix, mm_assemble) (const size_t size1, const size_t size2, const size_t n,
+                                  const int * ti, const int * tj, const ATOMIC * tx,
+                                  const int sptype)
 {
   TYPE (gsl_spmatrix) * m;
-  unsigned int size1, size2, nz;
-  char buf[1024];
-  int found_header = 0;
+  const int csc = (sptype == GSL_SPMATRIX_CSC);
+  const int * outer = csc ? tj : ti;
+  const int * inner = csc ? ti : tj;
+  const size_t nouter = csc ? size2 : size1;
+  const size_t ninner = csc ? size1 : size2;
+  const size_t ncount = GSL_MAX(nouter, ninner) + 1;
+  int *count, *perm, *ord;
+  size_t k, nu;
+
+  count = malloc((ncount + 2 * n + 1) * sizeof(int));
+  if (!count)
+    {
+      GSL_ERROR_NULL("failed to allocate space for assembly", GSL_ENOMEM);
+    }
+
+  perm = count + ncount;
+  ord = perm + n;
+
+  /* sort by inner index */
+  for (k = 0; k <= ninner; ++k)
+    count[k] = 0;
+
+  for (k = 0; k < n; ++k)
+    count[inner[k] + 1]++;
+
+  for (k = 0; k < ninner; ++k)
+    count[k + 1] += count[k];
+
+  for (k = 0; k < n; ++k)
+    perm[count[inner[k]]++] = (int) k;
+
+  /* stable sort by outer index */
+  for (k = 0; k <= nouter; ++k)
+    count[k] = 0;
 
-  /* read file until we find rows,cols,nz header */
-  while (fgets(buf, 1024, stream) != NULL)
+  for (k = 0; k < n; ++k)
+    count[outer[k] + 1]++;
+
+  for (k = 0; k < nouter; ++k)
+    count[k + 1] += count[k];
+
+  for (k = 0; k < n; ++k)
     {
-      int c;
+      int t = perm[k];
+      ord[count[outer[t]]++] = t;
+    }
 
-      /* skip comments */
-      if (*buf == '%')
+  /* keep the last entry of each run of duplicates */
+  for (k = 0, nu = 0; k < n; ++k)
+    {
+      int t = ord[k];
+
+      if (k + 1 < n && outer[ord[k + 1]] == outer[t] && inner[ord[k + 1]] == inner[t])
         continue;
 
-      c = sscanf(buf, "%u %u %u", &size1, &size2, &nz);
-      if (c == 3)
+      ord[nu++] = t;
+    }
+
+  m = FUNCTION (gsl_spmatrix, alloc_nzmax) (size1, size2, GSL_MAX(nu, 1), sptype);
+  if (!m)
+    {
+      free(count);
+      return NULL;
+    }
+
+  for (k = 0; k < nu; ++k)
+    {
+      const int t = ord[k];
+      int c;
+
+      for (c = 0; c < MULTIPLICITY; ++c)
+        m->data[MULTIPLICITY * k + c] = tx[MULTIPLICITY * t + c];
+    }
+
+  if (sptype == GSL_SPMATRIX_COO)
+    {
+      for (k = 0; k < nu; ++k)
         {
-          found_header = 1;
-          break;
+          m->i[k] = ti[ord[k]];
+          m->p[k] = tj[ord[k]];
+        }
+
+      m->nz = nu;
+
+      if (FUNCTION (gsl_spmatrix, tree_rebuild) (m))
+        {
+          FUNCTION (gsl_spmatrix, free) (m);
+          free(count);
+          return NULL;
+        }
+    }
+  else
+    {
+      for (k = 0; k <= nouter; ++k)
+        m->p[k] = 0;
+
+      for (k = 0; k < nu; ++k)
+        {
+          m->i[k] = inner[ord[k]];
+          m->p[outer[ord[k]] + 1]++;
         }
+
+      for (k = 0; k < nouter; ++k)
+        m->p[k + 1] += m->p[k];
+
+      m->nz = nu;
+    }
+
+  free(count);
+
+  return m;
+}
+
+TYPE (gsl_spmatrix) *
+FUNCTION (gsl_spmatrix, fscanf) (FILE * stream)
+{
+  return FUNCTION (gsl_spmatrix, fscanf_compress) (stream, GSL_SPMATRIX_COO);
+}
+
+/*
+gsl_spmatrix_fscanf_compress()
+  Read a sparse matrix in Matrix Market coordinate format directly
+into the requested storage format
+
+Inputs: stream - input stream
+        sptype - GSL_SPMATRIX_COO, GSL_SPMATRIX_CSC or GSL_SPMATRIX_CSR
+
+Return: pointer to new matrix, or NULL on error
+
+Notes:
+1) The field qualifiers real, integer, complex and pattern are
+supported; entries of pattern matrices are set to 1. Complex files can
+only be read into complex matrices.
+
+2) For symmetric, skew-symmetric and hermitian files the entries
+stored in the file are mirrored, so that the full matrix is returned.
+
+3) Files without a banner line are read as general matrices with real
+entries, or complex entries for complex matrix types.
+*/
+
+TYPE (gsl_spmatrix) *
+FUNCTION (gsl_spmatrix, fscanf_compress) (FILE * stream, const int sptype)
+{
+  TYPE (gsl_spmatrix) * m = NULL;
+  spmatrix_mm_reader r;
+  spmatrix_mm_header h;
+  int *ti = NULL, *tj = NULL;
+  ATOMIC *tx = NULL;
+  size_t nmax, n = 0, nread = 0;
+  const char *reason = NULL;
+  char *line;
+  int status;
+
+  if (sptype != GSL_SPMATRIX_COO && sptype != GSL_SPMATRIX_CSC &&
+      sptype != GSL_SPMATRIX_CSR)
+    {
+      GSL_ERROR_NULL("sptype must be COO, CSC or CSR", GSL_EINVAL);
+    }
+
+  status = spmatrix_mm_init(stream, &r);
+  if (status)
+    return NULL;
+
+  status = spmatrix_mm_header_read(&r, &h);
+  if (status)
+    {
+      spmatrix_mm_free(&r);
+      return NULL;
     }
 
-  if (!found_header)
+  if (h.field == SPMATRIX_MM_UNKNOWN)
+    h.field = (MULTIPLICITY == 2) ? SPMATRIX_MM_COMPLEX : SPMATRIX_MM_REAL;
+
+  if (h.field == SPMATRIX_MM_COMPLEX && MULTIPLICITY == 1)
     {
-      GSL_ERROR_NULL ("fscanf failed reading header", GSL_EFAILED);
+      spmatrix_mm_free(&r);
+      GSL_ERROR_NULL("cannot read complex matrix into real matrix", GSL_EINVAL);
     }
 
-  m = FUNCTION (gsl_spmatrix, alloc_nzmax) ((size_t) size1, (size_t) size2, (size_t) nz, GSL_SPMATRIX_COO);
-  if (!m)
+  /* symmetric files store at most one triangle */
+  nmax = (h.symmetry == SPMATRIX_MM_GENERAL) ? h.nz : 2 * h.nz;
+
+  ti = malloc((2 * nmax + 1) * sizeof(int));
+  tx = malloc((MULTIPLICITY * nmax + 1) * sizeof(ATOMIC));
+  if (!ti || !tx)
     {
-      GSL_ERROR_NULL ("error allocating m", GSL_ENOMEM);
+      free(ti);
+      free(tx);
+      spmatrix_mm_free(&r);
+      GSL_ERROR_NULL("failed to allocate space for entries", GSL_ENOMEM);
     }
 
-#if defined(BASE_GSL_COMPLEX_LONG) || defined(BASE_GSL_COMPLEX) || defined(BASE_GSL_COMPLEX_FLOAT)
+  tj = ti + nmax;
+
+  while ((line = spmatrix_mm_getline(&r)) != NULL)
+    {
+      char *s = line;
+      size_t i, j;
+      ATOMIC x[2];
 
-  {
-    unsigned int i, j;
-    ATOMIC_IO xr, xi;
-    BASE x;
-
-    while (fgets(buf, 1024, stream) != NULL)
-      {
-        int c = sscanf(buf, "%u %u " IN_FORMAT " " IN_FORMAT, &i, &j, &xr, &xi);
-        if (c < 4 || i == 0 || j == 0)
-          {
-            GSL_ERROR_NULL ("error in input file format", GSL_EFAILED);
-          }
-        else if ((i > size1) || (j > size2))
-          {
-            GSL_ERROR_NULL ("element exceeds matrix dimensions", GSL_EBADLEN);
-          }
-        else
-          {
-            /* subtract 1 from (i,j) since indexing starts at 1 */
-            GSL_REAL(x) = xr;
-            GSL_IMAG(x) = xi;
-            FUNCTION (gsl_spmatrix, set) (m, i - 1, j - 1, x);
-          }
-      }
-  }
+      if (*line == '%' || spmatrix_mm_blank(line))
+        continue;
 
-#else
+      if (spmatrix_mm_index(&s, &i) || spmatrix_mm_index(&s, &j) || i == 0 || j == 0)
+        {
+          status = GSL_EFAILED;
+          reason = "error in input file format";
+          break;
+        }
+      else if (i > h.size1 || j > h.size2)
+        {
+          status = GSL_EBADLEN;
+          reason = "element exceeds matrix dimensions";
+          break;
+        }
+      else if (nread >= h.nz)
+        {
+          status = GSL_EBADLEN;
+          reason = "file contains more entries than specified in header";
+          break;
+        }
+
+      x[1] = (ATOMIC) 0;
+
+      if (h.field == SPMATRIX_MM_PATTERN)
+        {
+          x[0] = (ATOMIC) 1;
+        }
+      else if (FUNCTION (spmatrix, mm_atomic) (&s, &x[0]) ||
+               (h.field == SPMATRIX_MM_COMPLEX && FUNCTION (spmatrix, mm_atomic) (&s, &x[1])))
+        {
+          status = GSL_EFAILED;
+          reason = "error in input file format";
+          break;
+        }
+
+      ++nread;
 
-  {
-    unsigned int i, j;
-    ATOMIC_IO tmp;
-
-    while (fgets(buf, 1024, stream) != NULL)
-      {
-        int c = sscanf(buf, "%u %u " IN_FORMAT, &i, &j, &tmp);
-        if (c < 3 || i == 0 || j == 0)
-          {
-            GSL_ERROR_NULL ("error in input file format", GSL_EFAILED);
-          }
-        else if ((i > size1) || (j > size2))
-          {
-            GSL_ERROR_NULL ("element exceeds matrix dimensions", GSL_EBADLEN);
-          }
-        else
-          {
-            /* subtract 1 from (i,j) since indexing starts at 1 */
-            FUNCTION (gsl_spmatrix, set) (m, i - 1, j - 1, tmp);
-          }
-      }
-  }
+      /* subtract 1 from (i,j) since indexing starts at 1 */
+      ti[n] = (int) i - 1;
+      tj[n] = (int) j - 1;
+      tx[MULTIPLICITY * n] = x[0];
+#if MULTIPLICITY == 2
+      tx[MULTIPLICITY * n + 1] = x[1];
+#endif
+      ++n;
+
+      if (h.symmetry != SPMATRIX_MM_GENERAL && i != j)
+        {
+          ti[n] = (int) j - 1;
+          tj[n] = (int) i - 1;
 
+          if (h.symmetry == SPMATRIX_MM_SKEW)
+            {
+              tx[MULTIPLICITY * n] = -x[0];
+#if MULTIPLICITY == 2
+              tx[MULTIPLICITY * n + 1] = -x[1];
 #endif
+            }
+          else
+            {
+              tx[MULTIPLICITY * n] = x[0];
+#if MULTIPLICITY == 2
+              /* hermitian: A(j,i) = conj(A(i,j)) */
+              tx[MULTIPLICITY * n + 1] = (h.symmetry == SPMATRIX_MM_HERMITIAN) ? -x[1] : x[1];
+#endif
+            }
+
+          ++n;
+        }
+    }
+
+  if (status == GSL_SUCCESS && nread < h.nz)
+    {
+      status = GSL_EBADLEN;
+      reason = "file contains fewer entries than specified in header";
+    }
+
+  spmatrix_mm_free(&r);
+
+  if (status == GSL_SUCCESS)
+    m = FUNCTION (spmatrix, mm_assemble) (h.size1, h.size2, n, ti, tj, tx, sptype);
+
+  free(ti);
+  free(tx);
+
+  if (reason != NULL)
+    {
+      GSL_ERROR_NULL(reason, status);
+    }
 
   return m;
 }
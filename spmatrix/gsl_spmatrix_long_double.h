@@ -60,6 +60,23 @@ __BEGIN_DECLS
  *   A->p[i] <= n < A->p[i+1]
  * so that row i is stored in
  * [ data[p[i]], data[p[i] + 1], ..., data[p[i+1] - 1] ]
+ *
+ * Block compressed row format (BSR), with b = A->block_size:
+ *
+ * Same as CSR, but on the (size1/b)-by-(size2/b) grid of dense
+ * b-by-b blocks. A->p[I] <= n < A->p[I+1] are the blocks of block
+ * row I, A->i[n] is the block column index and the block itself
+ * is stored row-major in data[n*b*b], ..., data[(n+1)*b*b - 1].
+ * A->nz is the number of stored blocks.
+ *
+ * Sliced ELLPACK format (SELL-C-sigma), with C = A->block_size:
+ *
+ * Rows are sorted by decreasing length within windows of A->sigma
+ * rows; row k of the sorted matrix is row A->perm[k] of A. Slice s
+ * holds sorted rows s*C, ..., s*C + C - 1, padded to the length w
+ * of its longest row and stored column-major, so that element k of
+ * lane r is at data[p[s] + k*C + r] with column index i[p[s] + k*C + r],
+ * and w = (p[s+1] - p[s]) / C. Padding entries are zero.
  */
 
 typedef struct
@@ -103,6 +120,10 @@ typedef struct
 
   int sptype;                /* sparse storage type */
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
+
+  size_t block_size;         /* BSR: block dimension b; SELL: slice height C */
+  size_t sigma;              /* SELL: row sorting window */
+  int *perm;                 /* SELL: row permutation of length size1 */
 } gsl_spmatrix_long_double;
 
 /*
@@ -115,6 +136,10 @@ gsl_spmatrix_long_double * gsl_spmatrix_long_double_alloc (const size_t n1, cons
 gsl_spmatrix_long_double * gsl_spmatrix_long_double_alloc_nzmax (const size_t n1, const size_t n2,
                                                      const size_t nzmax, const int sptype);
 void gsl_spmatrix_long_double_free (gsl_spmatrix_long_double * m);
+gsl_spmatrix_long_double * gsl_spmatrix_long_double_alloc_bsr (const size_t n1, const size_t n2,
+                                                                 const size_t nzmax, const size_t b);
+gsl_spmatrix_long_double * gsl_spmatrix_long_double_alloc_sell (const size_t n1, const size_t n2, const size_t nzmax,
+                                                                  const size_t C, const size_t sigma);
 int gsl_spmatrix_long_double_realloc (const size_t nzmax, gsl_spmatrix_long_double * m);
 size_t gsl_spmatrix_long_double_nnz (const gsl_spmatrix_long_double * m);
 const char * gsl_spmatrix_long_double_type (const gsl_spmatrix_long_double * m);
@@ -125,6 +150,8 @@ int gsl_spmatrix_long_double_tree_rebuild (gsl_spmatrix_long_double * m);
 
 int gsl_spmatrix_long_double_csc (gsl_spmatrix_long_double * dest, const gsl_spmatrix_long_double * src);
 int gsl_spmatrix_long_double_csr (gsl_spmatrix_long_double * dest, const gsl_spmatrix_long_double * src);
+int gsl_spmatrix_long_double_bsr (gsl_spmatrix_long_double * dest, const gsl_spmatrix_long_double * src);
+int gsl_spmatrix_long_double_sell (gsl_spmatrix_long_double * dest, const gsl_spmatrix_long_double * src);
 gsl_spmatrix_long_double * gsl_spmatrix_long_double_compress (const gsl_spmatrix_long_double * src, const int sptype);
 gsl_spmatrix_long_double * gsl_spmatrix_long_double_compcol (const gsl_spmatrix_long_double * src);
 gsl_spmatrix_long_double * gsl_spmatrix_long_double_ccs (const gsl_spmatrix_long_double * src);
@@ -138,6 +165,7 @@ int gsl_spmatrix_long_double_memcpy (gsl_spmatrix_long_double * dest, const gsl_
 
 int gsl_spmatrix_long_double_fprintf (FILE * stream, const gsl_spmatrix_long_double * m, const char * format);
 gsl_spmatrix_long_double * gsl_spmatrix_long_double_fscanf (FILE * stream);
+gsl_spmatrix_long_double * gsl_spmatrix_long_double_fscanf_compress (FILE * stream, const int sptype);
 int gsl_spmatrix_long_double_fwrite (FILE * stream, const gsl_spmatrix_long_double * m);
 int gsl_spmatrix_long_double_fread (FILE * stream, gsl_spmatrix_long_double * m);
 
@@ -22,6 +22,8 @@ static int FUNCTION (spmatrix, pool_init) (TYPE (gsl_spmatrix) * m);
 static int FUNCTION (spmatrix, pool_free) (TYPE (gsl_spmatrix) * m);
 static void * FUNCTION (spmatrix, malloc) (size_t size, void * params);
 static void FUNCTION (spmatrix, free) (void * block, void * params);
+static TYPE (gsl_spmatrix) * FUNCTION (spmatrix, alloc_blocked) (const size_t n1, const size_t n2, const size_t nzmax,
+                                                                 const int sptype, const size_t bs, const size_t sigma);
 
 static const gsl_bst_allocator FUNCTION(spmatrix, allocator) =
 {
@@ -44,8 +46,75 @@ FUNCTION (gsl_spmatrix, alloc) (const size_t n1, const size_t n2)
 TYPE (gsl_spmatrix) *
 FUNCTION (gsl_spmatrix, alloc_nzmax) (const size_t n1, const size_t n2,
                                       const size_t nzmax, const int sptype)
+{
+  return FUNCTION (spmatrix, alloc_blocked) (n1, n2, nzmax, sptype, 1, 1);
+}
+
+/*
+gsl_spmatrix_alloc_bsr()
+  Allocate a matrix in block compressed row format
+
+Inputs: n1    - number of rows
+        n2    - number of columns
+        nzmax - maximum number of b-by-b blocks
+        b     - block dimension; must divide n1 and n2
+
+Return: pointer to new matrix
+*/
+
+TYPE (gsl_spmatrix) *
+FUNCTION (gsl_spmatrix, alloc_bsr) (const size_t n1, const size_t n2,
+                                    const size_t nzmax, const size_t b)
+{
+  if (b == 0)
+    {
+      GSL_ERROR_NULL ("block size must be positive", GSL_EINVAL);
+    }
+  else if (n1 % b != 0 || n2 % b != 0)
+    {
+      GSL_ERROR_NULL ("matrix dimensions must be multiples of block size",
+                      GSL_EBADLEN);
+    }
+
+  return FUNCTION (spmatrix, alloc_blocked) (n1, n2, nzmax, GSL_SPMATRIX_BSR, b, 1);
+}
+
+/*
+gsl_spmatrix_alloc_sell()
+  Allocate a matrix in SELL-C-sigma format
+
+Inputs: n1    - number of rows
+        n2    - number of columns
+        nzmax - maximum number of stored elements, including padding
+        C     - slice height (number of rows per slice)
+        sigma - sorting window; rows are sorted by length within
+                consecutive windows of sigma rows (1 = no sorting)
+
+Return: pointer to new matrix
+*/
+
+TYPE (gsl_spmatrix) *
+FUNCTION (gsl_spmatrix, alloc_sell) (const size_t n1, const size_t n2, const size_t nzmax,
+                                     const size_t C, const size_t sigma)
+{
+  if (C == 0)
+    {
+      GSL_ERROR_NULL ("slice height C must be positive", GSL_EINVAL);
+    }
+  else if (sigma == 0)
+    {
+      GSL_ERROR_NULL ("sorting window sigma must be positive", GSL_EINVAL);
+    }
+
+  return FUNCTION (spmatrix, alloc_blocked) (n1, n2, nzmax, GSL_SPMATRIX_SELL, C, sigma);
+}
+
+static TYPE (gsl_spmatrix) *
+FUNCTION (spmatrix, alloc_blocked) (const size_t n1, const size_t n2, const size_t nzmax,
+                                    const int sptype, const size_t bs, const size_t sigma)
 {
   TYPE(gsl_spmatrix) * m;
+  size_t ndata;
 
   if (n1 == 0)
     {
@@ -70,6 +139,8 @@ FUNCTION (gsl_spmatrix, alloc_nzmax) (const size_t n1, const size_t n2,
   m->nz = 0;
   m->nzmax = GSL_MAX(nzmax, 1);
   m->sptype = sptype;
+  m->block_size = bs;
+  m->sigma = sigma;
 
   if (n1 == 1 && n2 == 1)
     m->spflags = GSL_SPMATRIX_FLG_GROW; /* allow matrix size to grow */
@@ -131,8 +202,36 @@ FUNCTION (gsl_spmatrix, alloc_nzmax) (const size_t n1, const size_t n2,
                          GSL_ENOMEM);
         }
     }
+  else if (sptype == GSL_SPMATRIX_BSR)
+    {
+      m->p = calloc(n1 / bs + 1, sizeof(int));
+      m->work.work_void = malloc(GSL_MAX(n1, n2) * MULTIPLICITY *
+                                 GSL_MAX(sizeof(int), sizeof(BASE)));
+      if (!m->p || !m->work.work_void)
+        {
+          FUNCTION(gsl_spmatrix, free) (m);
+          GSL_ERROR_NULL("failed to allocate space for block row pointers",
+                         GSL_ENOMEM);
+        }
+    }
+  else if (sptype == GSL_SPMATRIX_SELL)
+    {
+      m->p = calloc((n1 + bs - 1) / bs + 1, sizeof(int));
+      m->perm = malloc(n1 * sizeof(int));
+      m->work.work_void = malloc(GSL_MAX(GSL_MAX(n1, n2), bs) * MULTIPLICITY *
+                                 GSL_MAX(sizeof(int), sizeof(BASE)));
+      if (!m->p || !m->perm || !m->work.work_void)
+        {
+          FUNCTION(gsl_spmatrix, free) (m);
+          GSL_ERROR_NULL("failed to allocate space for slice pointers",
+                         GSL_ENOMEM);
+        }
+    }
+
+  /* BSR stores a dense b-by-b block for each of the nzmax entries */
+  ndata = (sptype == GSL_SPMATRIX_BSR) ? m->nzmax * bs * bs : m->nzmax;
 
-  m->data = malloc(m->nzmax * MULTIPLICITY * sizeof (ATOMIC));
+  m->data = malloc(ndata * MULTIPLICITY * sizeof (ATOMIC));
   if (!m->data)
     {
       FUNCTION(gsl_spmatrix, free) (m);
@@ -158,6 +257,9 @@ FUNCTION (gsl_spmatrix, free) (TYPE (gsl_spmatrix) * m)
   if (m->work.work_void)
     free(m->work.work_void);
 
+  if (m->perm)
+    free(m->perm);
+
   /* binary tree should be freed before pool */
   if (m->tree)
     gsl_bst_free(m->tree);
@@ -198,7 +300,10 @@ FUNCTION (gsl_spmatrix, realloc) (const size_t nzmax, TYPE (gsl_spmatrix) * m)
       m->p = (int *) ptr;
     }
 
-  ptr_atomic = realloc(m->data, nzmax * MULTIPLICITY * sizeof (ATOMIC));
+  if (GSL_SPMATRIX_ISBSR(m))
+    ptr_atomic = realloc(m->data, nzmax * m->block_size * m->block_size * MULTIPLICITY * sizeof (ATOMIC));
+  else
+    ptr_atomic = realloc(m->data, nzmax * MULTIPLICITY * sizeof (ATOMIC));
   if (!ptr_atomic)
     {
       GSL_ERROR("failed to allocate space for data", GSL_ENOMEM);
@@ -269,6 +374,10 @@ FUNCTION (gsl_spmatrix, type) (const TYPE (gsl_spmatrix) * m)
     return "CSR";
   else if (GSL_SPMATRIX_ISCSC(m))
     return "CSC";
+  else if (GSL_SPMATRIX_ISBSR(m))
+    return "BSR";
+  else if (GSL_SPMATRIX_ISSELL(m))
+    return "SELL";
   else
     return "unknown";
 }
@@ -276,6 +385,21 @@ FUNCTION (gsl_spmatrix, type) (const TYPE (gsl_spmatrix) * m)
 int
 FUNCTION (gsl_spmatrix, set_zero) (TYPE (gsl_spmatrix) * m)
 {
+  if (GSL_SPMATRIX_ISBSR(m) || GSL_SPMATRIX_ISSELL(m))
+    {
+      /* clear the stored blocks/slices and empty every block row/slice */
+      const size_t bs = m->block_size;
+      const size_t np = GSL_SPMATRIX_ISBSR(m) ? m->size1 / bs : (m->size1 + bs - 1) / bs;
+      const size_t ndata = GSL_SPMATRIX_ISBSR(m) ? m->nz * bs * bs : (size_t) m->p[np];
+      size_t k;
+
+      for (k = 0; k < MULTIPLICITY * ndata; ++k)
+        m->data[k] = (ATOMIC) 0;
+
+      for (k = 0; k <= np; ++k)
+        m->p[k] = 0;
+    }
+
   m->nz = 0;
 
   if (m->tree != NULL)
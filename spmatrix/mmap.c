@@ -0,0 +1,169 @@
+/* spmatrix/mmap.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+
+#include "../matrix/mmapfile.c"
+
+/*
+gsl_spmatrix_mmap_write()
+  Write a sparse matrix to a file in the memory mapped binary format
+
+Inputs: filename - output file
+        m        - sparse matrix in CSC or CSR format
+
+Return: success/error
+*/
+
+int
+gsl_spmatrix_mmap_write (const char * filename, const gsl_spmatrix * m)
+{
+  if (!GSL_SPMATRIX_ISCSC(m) && !GSL_SPMATRIX_ISCSR(m))
+    {
+      GSL_ERROR("matrix must be in CSC or CSR format", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t np = (GSL_SPMATRIX_ISCSC(m) ? m->size2 : m->size1) + 1;
+      mmapfile_header hdr;
+      mmapfile_array a[MMAPFILE_NARRAY];
+
+      memset(&hdr, 0, sizeof(hdr));
+      memset(a, 0, sizeof(a));
+
+      hdr.object = MMAPFILE_SPMATRIX;
+      hdr.type = MMAPFILE_DOUBLE;
+      hdr.atomic_size = sizeof(double);
+      hdr.index_size = sizeof(int);
+      hdr.sptype = (uint32_t) m->sptype;
+      hdr.size1 = m->size1;
+      hdr.size2 = m->size2;
+      hdr.nz = m->nz;
+
+      a[0].ptr = m->data;
+      a[0].nrows = 1;
+      a[0].rowbytes = m->nz * sizeof(double);
+
+      a[1].ptr = m->i;
+      a[1].nrows = 1;
+      a[1].rowbytes = m->nz * sizeof(int);
+
+      a[2].ptr = m->p;
+      a[2].nrows = 1;
+      a[2].rowbytes = np * sizeof(int);
+
+      return mmapfile_write(filename, &hdr, a);
+    }
+}
+
+/*
+gsl_spmatrix_mmap_open()
+  Map a sparse matrix file written by gsl_spmatrix_mmap_write() into
+memory
+
+Inputs: filename - input file
+
+Return: pointer to mapped matrix, or NULL on error
+
+Notes:
+1) The arrays of the matrix are not copied: the matrix refers directly
+to the pages of the file, which are loaded on first access and shared
+between all processes mapping the same file. Only the workspace of the
+matrix, of size MAX(size1,size2), is allocated. The matrix is
+read-only, and must not be modified.
+
+2) On systems without mmap(), the file is read into memory instead
+*/
+
+gsl_spmatrix_mmap *
+gsl_spmatrix_mmap_open (const char * filename)
+{
+  gsl_spmatrix_mmap *w;
+  gsl_spmatrix *m;
+  mmapfile_header hdr;
+  char *addr;
+  size_t length, np;
+  int mapped;
+  int status;
+
+  w = calloc(1, sizeof(gsl_spmatrix_mmap));
+  if (!w)
+    {
+      GSL_ERROR_NULL("failed to allocate space for mapped matrix", GSL_ENOMEM);
+    }
+
+  status = mmapfile_open(filename, MMAPFILE_SPMATRIX, &hdr, &addr, &length, &mapped);
+  if (status)
+    {
+      free(w);
+      return NULL;
+    }
+
+  np = (size_t) ((hdr.sptype == GSL_SPMATRIX_CSC) ? hdr.size2 : hdr.size1) + 1;
+
+  if ((hdr.sptype != GSL_SPMATRIX_CSC && hdr.sptype != GSL_SPMATRIX_CSR) ||
+      hdr.length[0] != hdr.nz * sizeof(double) ||
+      hdr.length[1] != hdr.nz * sizeof(int) ||
+      hdr.length[2] != np * sizeof(int) ||
+      ((int *) (addr + hdr.offset[2]))[np - 1] != (int) hdr.nz)
+    {
+      mmapfile_close(addr, length, mapped);
+      free(w);
+      GSL_ERROR_NULL("file is truncated or corrupt", GSL_EINVAL);
+    }
+
+  m = &w->matrix;
+  m->size1 = (size_t) hdr.size1;
+  m->size2 = (size_t) hdr.size2;
+  m->data = (double *) (addr + hdr.offset[0]);
+  m->i = (int *) (addr + hdr.offset[1]);
+  m->p = (int *) (addr + hdr.offset[2]);
+  m->nz = (size_t) hdr.nz;
+  m->nzmax = m->nz;
+  m->sptype = (int) hdr.sptype;
+  m->spflags = GSL_SPMATRIX_FLG_FIXED;
+
+  m->work.work_void = malloc(GSL_MAX(m->size1, m->size2) *
+                             GSL_MAX(sizeof(double), sizeof(int)));
+  if (!m->work.work_void)
+    {
+      mmapfile_close(addr, length, mapped);
+      free(w);
+      GSL_ERROR_NULL("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->addr = addr;
+  w->length = length;
+  w->mapped = mapped;
+
+  return w;
+}
+
+void
+gsl_spmatrix_mmap_close (gsl_spmatrix_mmap * w)
+{
+  RETURN_IF_NULL (w);
+  free(w->matrix.work.work_void);
+  mmapfile_close(w->addr, w->length, w->mapped);
+  free(w);
+}
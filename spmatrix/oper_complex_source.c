@@ -26,9 +26,16 @@ FUNCTION (gsl_spmatrix, scale) (TYPE (gsl_spmatrix) * m, const BASE x)
 {
   const ATOMIC xr = GSL_REAL (x);
   const ATOMIC xi = GSL_IMAG (x);
+  size_t ndata = m->nz;
   size_t i;
 
-  for (i = 0; i < m->nz; ++i)
+  if (GSL_SPMATRIX_ISBSR(m))
+    ndata = m->nz * m->block_size * m->block_size;
+  else if (GSL_SPMATRIX_ISSELL(m))
+    ndata = m->p[(m->size1 + m->block_size - 1) / m->block_size];
+
+  /* padding entries of BSR/SELL are zero and remain so */
+  for (i = 0; i < ndata; ++i)
     {
       ATOMIC mr = m->data[2 * i];
       ATOMIC mi = m->data[2 * i + 1];
@@ -367,6 +374,59 @@ FUNCTION (gsl_spmatrix, add_to_dense) (TYPE (gsl_matrix) * a, const TYPE (gsl_sp
                 }
             }
         }
+      else if (GSL_SPMATRIX_ISBSR(b))
+        {
+          const size_t bs = b->block_size;
+          const int * bj = b->i;
+          const int * bp = b->p;
+          size_t I, r, c;
+          int p;
+
+          for (I = 0; I < M / bs; ++I)
+            {
+              for (p = bp[I]; p < bp[I + 1]; ++p)
+                {
+                  const ATOMIC * blk = bd + 2 * p * bs * bs;
+
+                  for (r = 0; r < bs; ++r)
+                    for (c = 0; c < bs; ++c)
+                      {
+                        const size_t idx = 2 * ((I * bs + r) * tda_a + bj[p] * bs + c);
+                        a->data[idx] += blk[2 * (r * bs + c)];
+                        a->data[idx + 1] += blk[2 * (r * bs + c) + 1];
+                      }
+                }
+            }
+        }
+      else if (GSL_SPMATRIX_ISSELL(b))
+        {
+          /* padding entries are zero and add nothing */
+          const size_t C = b->block_size;
+          const size_t nslices = (M + C - 1) / C;
+          const int * bj = b->i;
+          const int * bp = b->p;
+          size_t s, r;
+          int p;
+
+          for (s = 0; s < nslices; ++s)
+            {
+              for (r = 0; r < C && s * C + r < M; ++r)
+                {
+                  const size_t i = b->perm[s * C + r];
+
+                  for (p = bp[s] + r; p < bp[s + 1]; p += (int) C)
+                    {
+                      const size_t idx = 2 * (i * tda_a + bj[p]);
+                      a->data[idx] += bd[2 * p];
+                      a->data[idx + 1] += bd[2 * p + 1];
+                    }
+                }
+            }
+        }
+      else
+        {
+          GSL_ERROR("unknown sparse matrix type", GSL_EINVAL);
+        }
 
       return GSL_SUCCESS;
     }
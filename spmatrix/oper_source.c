@@ -24,9 +24,16 @@ FUNCTION (spmatrix, scatter) (const TYPE (gsl_spmatrix) * A, const size_t j, int
 int
 FUNCTION (gsl_spmatrix, scale) (TYPE (gsl_spmatrix) * m, const BASE x)
 {
+  size_t ndata = m->nz;
   size_t i;
 
-  for (i = 0; i < m->nz; ++i)
+  if (GSL_SPMATRIX_ISBSR(m))
+    ndata = m->nz * m->block_size * m->block_size;
+  else if (GSL_SPMATRIX_ISSELL(m))
+    ndata = m->p[(m->size1 + m->block_size - 1) / m->block_size];
+
+  /* padding entries of BSR/SELL are zero and remain so */
+  for (i = 0; i < ndata; ++i)
     m->data[i] *= x;
 
   return GSL_SUCCESS;
@@ -153,7 +160,12 @@ FUNCTION (gsl_spmatrix, minmax) (const TYPE (gsl_spmatrix) * m,
   ATOMIC min, max;
   size_t n;
 
-  if (m->nz == 0)
+  if (GSL_SPMATRIX_ISBSR(m) || GSL_SPMATRIX_ISSELL(m))
+    {
+      /* zero fill of blocks/slices cannot be told apart from stored zeros */
+      GSL_ERROR("BSR and SELL formats not supported", GSL_EINVAL);
+    }
+  else if (m->nz == 0)
     {
       GSL_ERROR("matrix is empty", GSL_EINVAL);
     }
@@ -343,6 +355,51 @@ FUNCTION (gsl_spmatrix, add_to_dense) (TYPE (gsl_matrix) * a, const TYPE (gsl_sp
                 }
             }
         }
+      else if (GSL_SPMATRIX_ISBSR(b))
+        {
+          const size_t bs = b->block_size;
+          const int * bj = b->i;
+          const int * bp = b->p;
+          size_t I, r, c;
+          int p;
+
+          for (I = 0; I < M / bs; ++I)
+            {
+              for (p = bp[I]; p < bp[I + 1]; ++p)
+                {
+                  const ATOMIC * blk = bd + p * bs * bs;
+
+                  for (r = 0; r < bs; ++r)
+                    for (c = 0; c < bs; ++c)
+                      a->data[(I * bs + r) * tda_a + bj[p] * bs + c] += blk[r * bs + c];
+                }
+            }
+        }
+      else if (GSL_SPMATRIX_ISSELL(b))
+        {
+          /* padding entries are zero and add nothing */
+          const size_t C = b->block_size;
+          const size_t nslices = (M + C - 1) / C;
+          const int * bj = b->i;
+          const int * bp = b->p;
+          size_t s, r;
+          int p;
+
+          for (s = 0; s < nslices; ++s)
+            {
+              for (r = 0; r < C && s * C + r < M; ++r)
+                {
+                  const size_t i = b->perm[s * C + r];
+
+                  for (p = bp[s] + r; p < bp[s + 1]; p += (int) C)
+                    a->data[i * tda_a + bj[p]] += bd[p];
+                }
+            }
+        }
+      else
+        {
+          GSL_ERROR("unknown sparse matrix type", GSL_EINVAL);
+        }
 
       return GSL_SUCCESS;
     }
@@ -23,6 +23,7 @@
 #include <unistd.h>
 #include <math.h>
 #include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
 #include <gsl/gsl_test.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_spmatrix.h>
@@ -113,6 +114,189 @@ int status = 0;
 #include "templates_off.h"
 #undef  BASE_CHAR
 
+/* write a matrix in the mapped format and check the mapped copy */
+static void
+test_mmap (const size_t M, const size_t N, const double density,
+           const gsl_rng * r)
+{
+  const char filename[] = "test_mmap.dat";
+  gsl_spmatrix *A = test_random(M, N, density, -10.0, 10.0, r);
+  size_t k;
+
+  for (k = 0; k < 2; ++k)
+    {
+      gsl_spmatrix *B = (k == 0) ? gsl_spmatrix_ccs(A) : gsl_spmatrix_crs(A);
+      gsl_spmatrix_mmap *w;
+      size_t i, j;
+
+      status = gsl_spmatrix_mmap_write(filename, B);
+      gsl_test(status, "test_mmap: write M=%zu N=%zu sptype=%d", M, N, B->sptype);
+
+      w = gsl_spmatrix_mmap_open(filename);
+      gsl_test(w == NULL, "test_mmap: open M=%zu N=%zu sptype=%d", M, N, B->sptype);
+
+      if (w == NULL)
+        {
+          gsl_spmatrix_free(B);
+          continue;
+        }
+
+      gsl_test(w->matrix.sptype != B->sptype || w->matrix.nz != B->nz ||
+               w->matrix.size1 != M || w->matrix.size2 != N,
+               "test_mmap: header M=%zu N=%zu sptype=%d", M, N, B->sptype);
+
+      gsl_test(((size_t) w->matrix.data) % 64 != 0 ||
+               ((size_t) w->matrix.i) % 64 != 0 ||
+               ((size_t) w->matrix.p) % 64 != 0,
+               "test_mmap: alignment M=%zu N=%zu sptype=%d", M, N, B->sptype);
+
+      status = 0;
+      for (i = 0; i < M; ++i)
+        {
+          for (j = 0; j < N; ++j)
+            {
+              if (gsl_spmatrix_get(&w->matrix, i, j) != gsl_spmatrix_get(A, i, j))
+                status = 1;
+            }
+        }
+
+      gsl_test(status, "test_mmap: elements M=%zu N=%zu sptype=%d", M, N, B->sptype);
+
+      gsl_spmatrix_mmap_close(w);
+      gsl_spmatrix_free(B);
+    }
+
+  /* reject other formats and corrupt files */
+  {
+    FILE *f;
+    gsl_error_handler_t *old = gsl_set_error_handler_off();
+
+    status = gsl_spmatrix_mmap_write(filename, A);
+    gsl_test(status != GSL_EINVAL, "test_mmap: COO write M=%zu N=%zu", M, N);
+
+    f = fopen(filename, "wb");
+    fprintf(f, "%0300d", 0);
+    fclose(f);
+
+    gsl_test(gsl_spmatrix_mmap_open(filename) != NULL,
+             "test_mmap: bad magic M=%zu N=%zu", M, N);
+
+    gsl_set_error_handler(old);
+  }
+
+  unlink(filename);
+  gsl_spmatrix_free(A);
+}
+
+/* Matrix Market qualifiers and malformed files */
+static void
+test_mm_qualifiers (void)
+{
+  const char filename[] = "test_mm.dat";
+  gsl_spmatrix *A;
+  gsl_spmatrix_complex *Z;
+  FILE *f;
+
+  f = fopen(filename, "w");
+  fprintf(f, "%%%%MatrixMarket matrix coordinate real symmetric\n");
+  fprintf(f, "%% comment\n\n3 3 4\n1 1 2.5\n2 1 -1e-3\n3 2 4\r\n3 3 1.0E+2");
+  fclose(f);
+
+  f = fopen(filename, "r");
+  A = gsl_spmatrix_fscanf_compress(f, GSL_SPMATRIX_CSR);
+  fclose(f);
+
+  gsl_test(A == NULL || A->nz != 6 ||
+           gsl_spmatrix_get(A, 0, 0) != 2.5 ||
+           gsl_spmatrix_get(A, 1, 0) != -1e-3 || gsl_spmatrix_get(A, 0, 1) != -1e-3 ||
+           gsl_spmatrix_get(A, 2, 1) != 4.0 || gsl_spmatrix_get(A, 1, 2) != 4.0 ||
+           gsl_spmatrix_get(A, 2, 2) != 100.0,
+           "test_mm_qualifiers: symmetric");
+  gsl_spmatrix_free(A);
+
+  f = fopen(filename, "w");
+  fprintf(f, "%%%%MatrixMarket matrix coordinate pattern skew-symmetric\n");
+  fprintf(f, "2 2 1\n2 1\n");
+  fclose(f);
+
+  f = fopen(filename, "r");
+  A = gsl_spmatrix_fscanf_compress(f, GSL_SPMATRIX_CSC);
+  fclose(f);
+
+  gsl_test(A == NULL || A->nz != 2 ||
+           gsl_spmatrix_get(A, 1, 0) != 1.0 || gsl_spmatrix_get(A, 0, 1) != -1.0,
+           "test_mm_qualifiers: pattern skew-symmetric");
+  gsl_spmatrix_free(A);
+
+  f = fopen(filename, "w");
+  fprintf(f, "%%%%MatrixMarket matrix coordinate complex hermitian\n");
+  fprintf(f, "2 2 2\n1 1 3 0\n2 1 1 2\n");
+  fclose(f);
+
+  f = fopen(filename, "r");
+  Z = gsl_spmatrix_complex_fscanf_compress(f, GSL_SPMATRIX_COO);
+  fclose(f);
+
+  {
+    gsl_complex z10 = gsl_spmatrix_complex_get(Z, 1, 0);
+    gsl_complex z01 = gsl_spmatrix_complex_get(Z, 0, 1);
+
+    gsl_test(Z == NULL || Z->nz != 3 ||
+             GSL_REAL(z10) != 1.0 || GSL_IMAG(z10) != 2.0 ||
+             GSL_REAL(z01) != 1.0 || GSL_IMAG(z01) != -2.0,
+             "test_mm_qualifiers: hermitian");
+  }
+  gsl_spmatrix_complex_free(Z);
+
+  /* duplicate entries: the last one is kept */
+  f = fopen(filename, "w");
+  fprintf(f, "2 3 3\n1 3 1.0\n2 2 5.0\n1 3 7.0\n");
+  fclose(f);
+
+  f = fopen(filename, "r");
+  A = gsl_spmatrix_fscanf_compress(f, GSL_SPMATRIX_CSC);
+  fclose(f);
+
+  gsl_test(A == NULL || A->nz != 2 || gsl_spmatrix_get(A, 0, 2) != 7.0,
+           "test_mm_qualifiers: duplicates");
+  gsl_spmatrix_free(A);
+
+  {
+    gsl_error_handler_t *old = gsl_set_error_handler_off();
+
+    f = fopen(filename, "w");
+    fprintf(f, "%%%%MatrixMarket matrix coordinate complex general\n1 1 1\n1 1 1 1\n");
+    fclose(f);
+
+    f = fopen(filename, "r");
+    A = gsl_spmatrix_fscanf(f);
+    fclose(f);
+    gsl_test(A != NULL, "test_mm_qualifiers: complex into real");
+
+    f = fopen(filename, "w");
+    fprintf(f, "2 2 3\n1 1 1.0\n2 2 1.0\n");
+    fclose(f);
+
+    f = fopen(filename, "r");
+    A = gsl_spmatrix_fscanf(f);
+    fclose(f);
+    gsl_test(A != NULL, "test_mm_qualifiers: missing entries");
+
+    f = fopen(filename, "w");
+    fprintf(f, "2 2 1\n3 1 1.0\n");
+    fclose(f);
+
+    f = fopen(filename, "r");
+    A = gsl_spmatrix_fscanf(f);
+    fclose(f);
+    gsl_test(A != NULL, "test_mm_qualifiers: index out of range");
+
+    gsl_set_error_handler(old);
+  }
+
+  unlink(filename);
+}
+
 int
 main (void)
 {
@@ -140,8 +324,12 @@ main (void)
       test_complex_all (M[i], N[i], density[i], r);
       test_complex_float_all (M[i], N[i], density[i], r);
       test_complex_long_double_all (M[i], N[i], density[i], r);
+
+      test_mmap (M[i], N[i], density[i], r);
     }
 
+  test_mm_qualifiers ();
+
   gsl_rng_free(r);
 
   exit (gsl_test_summary ());
@@ -652,6 +652,113 @@ FUNCTION (test, minmax) (const size_t M, const size_t N, const int sptype,
   FUNCTION (gsl_spmatrix, free) (B);
 }
 
+/*
+test_blocked()
+  Test scale, minmax, add_to_dense and set_zero on the BSR and
+SELL formats; scale must reach every stored element, including the
+zero fill of blocks and slices, and minmax must reject both formats
+*/
+
+static void
+FUNCTION (test, blocked) (const size_t M, const size_t N, const double density,
+                          gsl_rng * r)
+{
+  const size_t b = 3;                   /* BSR block size and SELL slice height */
+  const size_t Mb = M - M % b;
+  const size_t Nb = N - N % b;
+  TYPE (gsl_spmatrix) * A = FUNCTION (test, random) (Mb, Nb, density, 1.0, 20.0, r);
+  TYPE (gsl_spmatrix) * B = FUNCTION (gsl_spmatrix, compress) (A, GSL_SPMATRIX_CSR);
+  TYPE (gsl_spmatrix) * B2 = FUNCTION (gsl_spmatrix, compress) (A, GSL_SPMATRIX_CSR);
+  TYPE (gsl_matrix) * D = FUNCTION (gsl_matrix, alloc) (Mb, Nb);
+  TYPE (gsl_matrix) * D2 = FUNCTION (gsl_matrix, alloc) (Mb, Nb);
+  size_t k;
+
+  FUNCTION (gsl_spmatrix, scale) (B2, 2.0);
+
+  for (k = 0; k < 2; ++k)
+    {
+      TYPE (gsl_spmatrix) * S;
+      TYPE (gsl_spmatrix) * S2;
+      TYPE (gsl_spmatrix) * E;
+      gsl_error_handler_t *old;
+      BASE min, max;
+      size_t n, ndata;
+
+      if (k == 0)
+        {
+          S = FUNCTION (gsl_spmatrix, alloc_bsr) (Mb, Nb, 1, b);
+          S2 = FUNCTION (gsl_spmatrix, alloc_bsr) (Mb, Nb, 1, b);
+          FUNCTION (gsl_spmatrix, bsr) (S, B);
+          FUNCTION (gsl_spmatrix, bsr) (S2, B2);
+          ndata = S->nz * b * b;
+        }
+      else
+        {
+          S = FUNCTION (gsl_spmatrix, alloc_sell) (Mb, Nb, 1, b, 2 * b);
+          S2 = FUNCTION (gsl_spmatrix, alloc_sell) (Mb, Nb, 1, b, 2 * b);
+          FUNCTION (gsl_spmatrix, sell) (S, B);
+          FUNCTION (gsl_spmatrix, sell) (S2, B2);
+          ndata = S->p[(Mb + b - 1) / b];
+        }
+
+      FUNCTION (gsl_spmatrix, scale) (S, 2.0);
+
+      status = 0;
+      for (n = 0; n < ndata; ++n)
+        {
+          if (S->data[n] != S2->data[n])
+            status = 1;
+        }
+
+      gsl_test (status, NAME (gsl_spmatrix) "_scale[%zu,%zu](%s)",
+                Mb, Nb, FUNCTION (gsl_spmatrix, type) (S));
+
+      old = gsl_set_error_handler_off();
+      status = FUNCTION (gsl_spmatrix, minmax) (S, &min, &max) != GSL_EINVAL;
+      gsl_set_error_handler(old);
+
+      gsl_test (status, NAME (gsl_spmatrix) "_minmax[%zu,%zu](%s) rejected",
+                Mb, Nb, FUNCTION (gsl_spmatrix, type) (S));
+
+      /* add_to_dense must agree with the CSR matrix */
+      FUNCTION (gsl_matrix, set_zero) (D);
+      FUNCTION (gsl_matrix, set_zero) (D2);
+      FUNCTION (gsl_spmatrix, add_to_dense) (D, S);
+      FUNCTION (gsl_spmatrix, add_to_dense) (D2, B2);
+
+      status = !FUNCTION (gsl_matrix, equal) (D, D2);
+      gsl_test (status, NAME (gsl_spmatrix) "_add_to_dense[%zu,%zu](%s)",
+                Mb, Nb, FUNCTION (gsl_spmatrix, type) (S));
+
+      /* a zeroed matrix must contribute nothing */
+      FUNCTION (gsl_spmatrix, set_zero) (S);
+      FUNCTION (gsl_matrix, set_zero) (D);
+      FUNCTION (gsl_spmatrix, add_to_dense) (D, S);
+
+      status = !FUNCTION (gsl_matrix, isnull) (D);
+      gsl_test (status, NAME (gsl_spmatrix) "_set_zero[%zu,%zu](%s)",
+                Mb, Nb, FUNCTION (gsl_spmatrix, type) (S));
+
+      /* scaling a newly allocated matrix touches no storage */
+      E = (k == 0) ? FUNCTION (gsl_spmatrix, alloc_bsr) (Mb, Nb, 1, b)
+                   : FUNCTION (gsl_spmatrix, alloc_sell) (Mb, Nb, 1, b, 2 * b);
+      status = FUNCTION (gsl_spmatrix, scale) (E, 2.0) != GSL_SUCCESS;
+      gsl_test (status, NAME (gsl_spmatrix) "_scale[%zu,%zu](%s) empty",
+                Mb, Nb, FUNCTION (gsl_spmatrix, type) (E));
+
+      FUNCTION (gsl_spmatrix, free) (E);
+      FUNCTION (gsl_spmatrix, free) (S);
+      FUNCTION (gsl_spmatrix, free) (S2);
+    }
+
+  FUNCTION (gsl_matrix, free) (D);
+  FUNCTION (gsl_matrix, free) (D2);
+
+  FUNCTION (gsl_spmatrix, free) (A);
+  FUNCTION (gsl_spmatrix, free) (B);
+  FUNCTION (gsl_spmatrix, free) (B2);
+}
+
 static void
 FUNCTION (test, io_ascii) (const size_t M, const size_t N, const int sptype,
                            const double density, gsl_rng * r)
@@ -659,8 +766,10 @@ FUNCTION (test, io_ascii) (const size_t M, const size_t N, const int sptype,
   TYPE (gsl_spmatrix) * A = FUNCTION (test, random_int) (M, N, density, 1.0, 20.0, r);
   TYPE (gsl_spmatrix) * B = FUNCTION (gsl_spmatrix, compress) (A, sptype);
   TYPE (gsl_spmatrix) * C;
+  TYPE (gsl_spmatrix) * D;
   char filename[] = "test.dat";
   FILE *f;
+  size_t i, j;
 
   f = fopen (filename, "w");
   FUNCTION (gsl_spmatrix, fprintf) (f, B, OUT_FORMAT);
@@ -674,11 +783,30 @@ FUNCTION (test, io_ascii) (const size_t M, const size_t N, const int sptype,
   gsl_test (status, NAME (gsl_spmatrix) "_fscanf[%zu,%zu](%s)",
             M, N, FUNCTION (gsl_spmatrix, type) (B));
 
+  f = fopen (filename, "r");
+  D = FUNCTION (gsl_spmatrix, fscanf_compress) (f, sptype);
+  fclose (f);
+
+  /* entries within a row/column need not be in the same order as B */
+  status = D->sptype != B->sptype || D->nz != B->nz;
+  for (i = 0; i < M && !status; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          if (FUNCTION (gsl_spmatrix, get) (B, i, j) != FUNCTION (gsl_spmatrix, get) (D, i, j))
+            status = 1;
+        }
+    }
+
+  gsl_test (status, NAME (gsl_spmatrix) "_fscanf_compress[%zu,%zu](%s)",
+            M, N, FUNCTION (gsl_spmatrix, type) (B));
+
   unlink (filename);
 
   FUNCTION (gsl_spmatrix, free) (A);
   FUNCTION (gsl_spmatrix, free) (B);
   FUNCTION (gsl_spmatrix, free) (C);
+  FUNCTION (gsl_spmatrix, free) (D);
 }
 
 static void
@@ -750,6 +878,8 @@ FUNCTION (test, all) (const size_t M, const size_t N, const double density, gsl_
   FUNCTION (test, minmax) (M, N, GSL_SPMATRIX_CSC, density, r);
   FUNCTION (test, minmax) (M, N, GSL_SPMATRIX_CSR, density, r);
 
+  FUNCTION (test, blocked) (M, N, density, r);
+
   FUNCTION (test, io_ascii) (M, N, GSL_SPMATRIX_COO, density, r);
   FUNCTION (test, io_ascii) (M, N, GSL_SPMATRIX_CSC, density, r);
   FUNCTION (test, io_ascii) (M, N, GSL_SPMATRIX_CSR, density, r);
@@ -68,6 +68,63 @@ typedef struct
 }
 gsl_wavelet_workspace;
 
+typedef enum {
+  gsl_wavelet_symmetric = 0, gsl_wavelet_periodic = 1
+}
+gsl_wavelet_boundary;
+
+#define GSL_WAVELET_LIFT_MAXSTEPS 32
+
+typedef struct
+{
+  int update;                   /* 1 for s += U d, 0 for d += P s */
+  int lo;                       /* offset of the first coefficient */
+  size_t len;                   /* number of coefficients */
+  double *c;
+}
+gsl_wavelet_lift_step;
+
+typedef struct
+{
+  size_t nsteps;
+  gsl_wavelet_lift_step step[GSL_WAVELET_LIFT_MAXSTEPS];
+  double scale[2];              /* final scaling of s and d */
+  int shift[2];                 /* final shifts of s and d */
+  int odd;                      /* steps start from the odd samples */
+  gsl_wavelet_boundary boundary;
+  size_t n;                     /* maximum length of the transforms */
+  double *scratch;
+}
+gsl_wavelet_lift;
+
+typedef struct
+{
+  long first;                   /* index of the first coefficient */
+  size_t count;                 /* inputs (forward) or pairs (inverse) received */
+  size_t sched;                 /* inputs of the forward level (inverse) */
+  double *hist;                 /* recent inputs, or recent (s,d) pairs */
+  double *queue;                /* details waiting for their approximation */
+  size_t qcap;
+  size_t qhead;
+  size_t qlen;
+}
+gsl_wavelet_stream_level;
+
+typedef struct
+{
+  const double *h1;
+  const double *g1;
+  const double *h2;
+  const double *g2;
+  size_t nc;
+  size_t offset;
+  size_t levels;
+  gsl_wavelet_direction dir;
+  size_t chain;                 /* level of the next coefficient (inverse) */
+  gsl_wavelet_stream_level *level;
+}
+gsl_wavelet_stream;
+
 GSL_VAR const gsl_wavelet_type *gsl_wavelet_daubechies;
 GSL_VAR const gsl_wavelet_type *gsl_wavelet_daubechies_centered;
 GSL_VAR const gsl_wavelet_type *gsl_wavelet_haar;
@@ -95,6 +152,34 @@ int gsl_wavelet_transform_inverse (const gsl_wavelet * w,
                                     double *data, size_t stride, size_t n, 
                                     gsl_wavelet_workspace * work);
 
+gsl_wavelet_lift *gsl_wavelet_lift_alloc (const gsl_wavelet * w, size_t n,
+                                          gsl_wavelet_boundary boundary);
+void gsl_wavelet_lift_free (gsl_wavelet_lift * l);
+
+int gsl_wavelet_lift_transform (gsl_wavelet_lift * l,
+                                double *data, size_t stride, size_t n,
+                                gsl_wavelet_direction dir);
+
+int gsl_wavelet_lift_transform_forward (gsl_wavelet_lift * l,
+                                        double *data, size_t stride, size_t n);
+
+int gsl_wavelet_lift_transform_inverse (gsl_wavelet_lift * l,
+                                        double *data, size_t stride, size_t n);
+
+gsl_wavelet_stream *gsl_wavelet_stream_alloc (const gsl_wavelet * w,
+                                              size_t levels,
+                                              gsl_wavelet_direction dir);
+void gsl_wavelet_stream_free (gsl_wavelet_stream * s);
+void gsl_wavelet_stream_reset (gsl_wavelet_stream * s);
+
+int gsl_wavelet_stream_forward (gsl_wavelet_stream * s,
+                                const double *x, size_t n,
+                                double *c, size_t * level, size_t * nout);
+
+int gsl_wavelet_stream_inverse (gsl_wavelet_stream * s,
+                                const double *c, size_t n,
+                                double *x, size_t * nx);
+
 __END_DECLS
 
 #endif /* __GSL_WAVELET_H__ */
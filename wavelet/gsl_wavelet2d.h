@@ -102,6 +102,16 @@ gsl_wavelet2d_nstransform_matrix_inverse (const gsl_wavelet * w,
                                           gsl_matrix * a, 
                                           gsl_wavelet_workspace * work);
 
+int gsl_wavelet2d_lift_transform (gsl_wavelet_lift * l,
+                                  double *data,
+                                  size_t tda, size_t size1, size_t size2,
+                                  gsl_wavelet_direction dir);
+
+int gsl_wavelet2d_lift_nstransform (gsl_wavelet_lift * l,
+                                    double *data,
+                                    size_t tda, size_t size1, size_t size2,
+                                    gsl_wavelet_direction dir);
+
 __END_DECLS
 
 #endif /* __GSL_WAVELET2D_H__ */
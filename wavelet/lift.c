@@ -0,0 +1,1039 @@
+/* wavelet/lift.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Wavelet transforms with the lifting scheme.
+ *
+ * The analysis filters of a wavelet are split into their even and odd
+ * polyphase components, giving the 2x2 polyphase matrix
+ *
+ *   [ s ]   [ He(z) Ho(z) ] [ e ]
+ *   [ d ] = [ Ge(z) Go(z) ] [ o ]
+ *
+ * which maps the even and odd samples e, o to the approximation and
+ * detail coefficients s, d. Here a Laurent polynomial A(z) acts on a
+ * sequence by correlation, (A x)_i = sum_j a_j x_{i+j}. Since the
+ * determinant of the polyphase matrix is a monomial, the Euclidean
+ * algorithm applied to its first row factors it into lifting steps
+ *
+ *   d += P(z) s    or    s += U(z) d
+ *
+ * followed by a scaling (and shift) of the two channels (Daubechies
+ * and Sweldens, 1998). Each lifting step is inverted by subtracting
+ * the same quantity, so the transform is exactly invertible whatever
+ * values are used beyond the ends of the signal. This allows
+ * symmetric extension of signals of arbitrary length, and about half
+ * the arithmetic of the filter bank implementation in dwt.c.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_wavelet.h>
+#include <gsl/gsl_wavelet2d.h>
+
+/* maximum length of the Laurent polynomials in the factorization */
+#define LIFT_MAXLEN 64
+
+/* number of rows or columns transformed together in 2d transforms */
+#define LIFT_BLOCK 8
+
+typedef struct
+{
+  int lo;                       /* power of z of the first coefficient */
+  size_t len;                   /* number of coefficients, 0 for A = 0 */
+  double c[LIFT_MAXLEN];
+}
+lift_poly;
+
+static void
+poly_trim (lift_poly * a)
+{
+  size_t i = 0;
+
+  while (i < a->len && a->c[i] == 0.0)
+    i++;
+
+  if (i > 0)
+    {
+      size_t j;
+
+      for (j = i; j < a->len; j++)
+        a->c[j - i] = a->c[j];
+
+      a->len -= i;
+      a->lo += (int) i;
+    }
+
+  while (a->len > 0 && a->c[a->len - 1] == 0.0)
+    a->len--;
+}
+
+/* a -= q b */
+static int
+poly_submul (lift_poly * a, const lift_poly * q, const lift_poly * b)
+{
+  int lo, hi, k;
+  size_t i, j;
+  double c[LIFT_MAXLEN];
+
+  if (q->len == 0 || b->len == 0)
+    return GSL_SUCCESS;
+
+  lo = q->lo + b->lo;
+  hi = q->lo + b->lo + (int) (q->len + b->len) - 2;
+
+  if (a->len > 0)
+    {
+      lo = GSL_MIN (lo, a->lo);
+      hi = GSL_MAX (hi, a->lo + (int) a->len - 1);
+    }
+
+  if (hi - lo + 1 > LIFT_MAXLEN)
+    {
+      GSL_ERROR ("lifting polynomial too long", GSL_EFAILED);
+    }
+
+  for (k = 0; k <= hi - lo; k++)
+    c[k] = 0.0;
+
+  for (i = 0; i < a->len; i++)
+    c[a->lo + (int) i - lo] = a->c[i];
+
+  for (i = 0; i < q->len; i++)
+    for (j = 0; j < b->len; j++)
+      c[q->lo + b->lo + (int) (i + j) - lo] -= q->c[i] * b->c[j];
+
+  a->lo = lo;
+  a->len = hi - lo + 1;
+
+  for (k = 0; k <= hi - lo; k++)
+    a->c[k] = c[k];
+
+  poly_trim (a);
+
+  return GSL_SUCCESS;
+}
+
+static double
+poly_maxabs (const lift_poly * a)
+{
+  double m = 0.0;
+  size_t i;
+
+  for (i = 0; i < a->len; i++)
+    m = GSL_MAX (m, fabs (a->c[i]));
+
+  return m;
+}
+
+/* Divide a by b, with len(a) >= len(b) > 0, returning a quotient q of
+ * len(a) - len(b) + 1 terms and replacing a by the remainder, which has
+ * len(b) - 1 terms. The quotient cancels the t lowest coefficients of
+ * a and the rest from the top, which gives len(a) - len(b) + 2
+ * different divisions.
+ */
+static void
+poly_divide (lift_poly * a, const lift_poly * b, lift_poly * q, size_t t)
+{
+  const size_t nq = a->len - b->len + 1;
+  const double blo = b->c[0];
+  const double bhi = b->c[b->len - 1];
+  const double tol = 1e-13 * poly_maxabs (a);
+  size_t i, j;
+
+  q->lo = a->lo - b->lo;
+  q->len = nq;
+
+  for (i = 0; i < t; i++)
+    {
+      const double c = a->c[i] / blo;
+      for (j = 0; j < b->len; j++)
+        a->c[i + j] -= c * b->c[j];
+      q->c[i] = c;
+    }
+
+  for (i = 0; i < nq - t; i++)
+    {
+      const size_t top = a->len - 1 - i;
+      const double c = a->c[top] / bhi;
+      for (j = 0; j < b->len; j++)
+        a->c[top - j] -= c * b->c[b->len - 1 - j];
+      q->c[nq - 1 - i] = c;
+    }
+
+  /* the remainder is exactly the middle b->len - 1 coefficients,
+     where terms at the level of rounding errors are exact zeros */
+  for (i = 0; i + 1 < b->len; i++)
+    a->c[i] = (fabs (a->c[t + i]) > tol) ? a->c[t + i] : 0.0;
+
+  a->lo += (int) t;
+  a->len = b->len - 1;
+
+  poly_trim (a);
+  poly_trim (q);
+}
+
+/* polyphase component p (0 even, 1 odd) of the analysis filter f, for
+ * output i computed from the samples x_{2i + k - offset}, k = 0..nc-1
+ */
+static void
+poly_polyphase (lift_poly * a, const double *f, size_t nc, size_t offset,
+                int p)
+{
+  int k, lo = 0, hi = -1;
+
+  for (k = 0; k < (int) nc; k++)
+    {
+      const int t = k - (int) offset;
+      const int r = ((t % 2) + 2) % 2;
+      const int j = (t - r) / 2;
+
+      if (r != p)
+        continue;
+
+      if (hi < lo)
+        lo = hi = j;
+      else
+        hi = j;
+
+      a->c[j - lo] = f[k];
+    }
+
+  a->lo = lo;
+  a->len = hi - lo + 1;
+
+  poly_trim (a);
+}
+
+/* the single term of a monomial, which must dominate all others */
+static int
+poly_monomial (const lift_poly * a, double *c, int *k)
+{
+  size_t i, imax = 0;
+
+  if (a->len == 0)
+    {
+      return GSL_FAILURE;
+    }
+
+  for (i = 1; i < a->len; i++)
+    {
+      if (fabs (a->c[i]) > fabs (a->c[imax]))
+        imax = i;
+    }
+
+  for (i = 0; i < a->len; i++)
+    {
+      if (i != imax && fabs (a->c[i]) > 1e-10 * fabs (a->c[imax]))
+        return GSL_FAILURE;
+    }
+
+  *c = a->c[imax];
+  *k = a->lo + (int) imax;
+
+  return GSL_SUCCESS;
+}
+
+/* a factorization into lifting steps */
+typedef struct
+{
+  size_t nsteps;
+  int update[GSL_WAVELET_LIFT_MAXSTEPS];
+  lift_poly p[GSL_WAVELET_LIFT_MAXSTEPS];
+  double scale[2];
+  int shift[2];
+  int odd;
+  double cost;
+}
+lift_chain;
+
+/* Complete the factorization cur of the matrix with first row (a, 0),
+ * second row m2 and coefficients up to cmax so far, keeping it in best
+ * if it is better conditioned.
+ */
+static void
+lift_finish (const lift_poly * a, const lift_poly m2[2], lift_chain * cur,
+             lift_chain * best, double cmax)
+{
+  lift_poly x = m2[0], y = m2[1];
+  double ca, cy, cost;
+  int ka, ky;
+  size_t k, i, nsteps = cur->nsteps;
+
+  /* apply the column operations to the second row */
+  for (k = 0; k < cur->nsteps; k++)
+    {
+      int status = cur->update[k] ? poly_submul (&y, &cur->p[k], &x)
+                                  : poly_submul (&x, &cur->p[k], &y);
+      if (status)
+        return;
+    }
+
+  /* the matrix is now [a 0; x y] = diag(a, y) [1 0; x/y 1] with a, y
+   * monomials, giving a last step d += (x/y) s and the scaling
+   */
+  if (poly_monomial (a, &ca, &ka) || poly_monomial (&y, &cy, &ky))
+    return;
+
+  x.lo -= ky;
+
+  /* x is zero in exact arithmetic for many wavelets */
+  for (i = 0; i < x.len; i++)
+    {
+      x.c[i] /= cy;
+
+      if (fabs (x.c[i]) < 1e-14)
+        x.c[i] = 0.0;
+    }
+
+  poly_trim (&x);
+
+  if (x.len > 0 && nsteps > 0 && !cur->update[nsteps - 1])
+    {
+      /* merge with the preceding detail step */
+      lift_poly one;
+
+      one.lo = 0;
+      one.len = 1;
+      one.c[0] = -1.0;
+
+      if (poly_submul (&x, &cur->p[nsteps - 1], &one))
+        return;
+
+      nsteps--;
+    }
+
+  cmax = GSL_MAX (cmax, poly_maxabs (&x));
+  cmax = GSL_MAX (cmax, GSL_MAX (fabs (ca), 1.0 / fabs (ca)));
+  cmax = GSL_MAX (cmax, GSL_MAX (fabs (cy), 1.0 / fabs (cy)));
+
+  /* large coefficients amplify rounding errors, and at the boundaries
+     of symmetric transforms also the mismatch between the extended
+     channels; among similar factorizations prefer fewer steps */
+  cost = cmax * (1.0 + 0.125 * (nsteps + (x.len > 0)));
+
+  if (cost < best->cost && nsteps + 1 < GSL_WAVELET_LIFT_MAXSTEPS)
+    {
+      *best = *cur;
+      best->nsteps = nsteps;
+
+      if (x.len > 0)
+        {
+          best->update[nsteps] = 0;
+          best->p[nsteps] = x;
+          best->nsteps++;
+        }
+
+      best->scale[0] = ca;
+      best->scale[1] = cy;
+      best->shift[0] = ka;
+      best->shift[1] = ky;
+      best->cost = cost;
+    }
+}
+
+static void lift_search (lift_poly a, lift_poly b, const lift_poly m2[2],
+                         lift_chain * cur, lift_chain * best, double cmax);
+
+/* Try the divisions of b by a (update step) or of a by b (detail
+ * step), in order of increasing quotient size so that good
+ * factorizations are found early and prune the rest of the search.
+ */
+static void
+lift_search_divide (const lift_poly * a, const lift_poly * b, int update,
+                    const lift_poly m2[2], lift_chain * cur,
+                    lift_chain * best, double cmax)
+{
+  const lift_poly *num = update ? b : a;
+  const lift_poly *den = update ? a : b;
+  const size_t nt = num->len - den->len + 2;
+  const size_t k = cur->nsteps;
+  double qmax[LIFT_MAXLEN + 1];
+  size_t order[LIFT_MAXLEN + 1];
+  size_t t, i;
+
+  for (t = 0; t < nt; t++)
+    {
+      lift_poly r = *num;
+
+      poly_divide (&r, den, &cur->p[k], t);
+      qmax[t] = poly_maxabs (&cur->p[k]);
+
+      /* insertion sort of the splits by quotient size */
+      for (i = t; i > 0 && qmax[order[i - 1]] > qmax[t]; i--)
+        order[i] = order[i - 1];
+
+      order[i] = t;
+    }
+
+  for (i = 0; i < nt; i++)
+    {
+      lift_poly r = *num;
+
+      poly_divide (&r, den, &cur->p[k], order[i]);
+      cur->update[k] = update;
+      cur->nsteps++;
+
+      if (update)
+        lift_search (*a, r, m2, cur, best, GSL_MAX (cmax, qmax[order[i]]));
+      else
+        lift_search (r, *b, m2, cur, best, GSL_MAX (cmax, qmax[order[i]]));
+
+      cur->nsteps--;
+    }
+}
+
+/* Search the factorizations of the matrix with first row (a, b) by
+ * column operations, which correspond to lifting steps applied to the
+ * input. Each division step reduces the length of one entry of the
+ * first row, and the choice of which coefficients the quotient cancels
+ * gives different factorizations.
+ */
+static void
+lift_search (lift_poly a, lift_poly b, const lift_poly m2[2],
+             lift_chain * cur, lift_chain * best, double cmax)
+{
+  const size_t k = cur->nsteps;
+
+  /* the cost of any completion is at least cmax (1 + k/8) */
+  if (cmax * (1.0 + 0.125 * k) >= best->cost
+      || k + 2 >= GSL_WAVELET_LIFT_MAXSTEPS)
+    return;
+
+  if (b.len == 0)
+    {
+      lift_finish (&a, m2, cur, best, cmax);
+      return;
+    }
+
+  if (a.len == 0)
+    {
+      /* move the gcd to column 1 by d -= s, so column 1 += column 2 */
+      cur->update[k] = 0;
+      cur->p[k].lo = 0;
+      cur->p[k].len = 1;
+      cur->p[k].c[0] = -1.0;
+      cur->nsteps++;
+      lift_search (b, b, m2, cur, best, GSL_MAX (cmax, 1.0));
+      cur->nsteps--;
+      return;
+    }
+
+  if (b.len >= a.len)
+    {
+      /* s += U d, column 2 -= U column 1 */
+      lift_search_divide (&a, &b, 1, m2, cur, best, cmax);
+    }
+
+  if (a.len >= b.len)
+    {
+      /* d += P s, column 1 -= P column 2 */
+      lift_search_divide (&a, &b, 0, m2, cur, best, cmax);
+    }
+}
+
+/* Factor the polyphase matrix of w into lifting steps. The lifting
+ * steps may also be applied starting from the odd samples, which for
+ * the even samples e' = o and odd samples o' = z e gives the matrix
+ * [Ho z^-1 He; Go z^-1 Ge]; both are searched for the factorization
+ * with the smallest coefficients.
+ */
+static int
+lift_factor (gsl_wavelet_lift * l, const gsl_wavelet * w)
+{
+  lift_poly m[2][2], m2[2];
+  lift_chain *cur, *best;
+  int odd, status = GSL_SUCCESS;
+  size_t k, i;
+
+  cur = (lift_chain *) malloc (sizeof (lift_chain));
+  best = (lift_chain *) malloc (sizeof (lift_chain));
+
+  if (cur == NULL || best == NULL)
+    {
+      free (cur);
+      free (best);
+      GSL_ERROR ("failed to allocate lifting factorization", GSL_ENOMEM);
+    }
+
+  poly_polyphase (&m[0][0], w->h1, w->nc, w->offset, 0);
+  poly_polyphase (&m[0][1], w->h1, w->nc, w->offset, 1);
+  poly_polyphase (&m[1][0], w->g1, w->nc, w->offset, 0);
+  poly_polyphase (&m[1][1], w->g1, w->nc, w->offset, 1);
+
+  best->cost = GSL_POSINF;
+
+  for (odd = 0; odd <= 1; odd++)
+    {
+      lift_poly a = m[0][0], b = m[0][1];
+
+      m2[0] = m[1][0];
+      m2[1] = m[1][1];
+
+      if (odd)
+        {
+          a = m[0][1];
+          b = m[0][0];
+          b.lo--;
+          m2[0] = m[1][1];
+          m2[1] = m[1][0];
+          m2[1].lo--;
+        }
+
+      cur->nsteps = 0;
+      cur->odd = odd;
+      lift_search (a, b, m2, cur, best, 0.0);
+    }
+
+  if (best->cost == GSL_POSINF)
+    {
+      status = GSL_EFAILED;
+    }
+  else
+    {
+      l->nsteps = best->nsteps;
+      l->odd = best->odd;
+
+      for (k = 0; k < 2; k++)
+        {
+          l->scale[k] = best->scale[k];
+          l->shift[k] = best->shift[k];
+        }
+
+      for (k = 0; k < best->nsteps; k++)
+        {
+          gsl_wavelet_lift_step *s = &(l->step[k]);
+          const lift_poly *p = &(best->p[k]);
+
+          s->update = best->update[k];
+          s->lo = p->lo;
+          s->len = p->len;
+          s->c = (double *) malloc (p->len * sizeof (double));
+
+          if (s->c == NULL)
+            {
+              l->nsteps = k;
+              status = GSL_ENOMEM;
+              break;
+            }
+
+          for (i = 0; i < p->len; i++)
+            s->c[i] = p->c[i];
+        }
+    }
+
+  free (cur);
+  free (best);
+
+  if (status)
+    {
+      GSL_ERROR ("failed to factor polyphase matrix", status);
+    }
+
+  return GSL_SUCCESS;
+}
+
+gsl_wavelet_lift *
+gsl_wavelet_lift_alloc (const gsl_wavelet * w, size_t n,
+                        gsl_wavelet_boundary boundary)
+{
+  gsl_wavelet_lift *l;
+  int status;
+
+  if (n == 0)
+    {
+      GSL_ERROR_VAL ("length n must be positive integer", GSL_EDOM, 0);
+    }
+
+  l = (gsl_wavelet_lift *) calloc (1, sizeof (gsl_wavelet_lift));
+
+  if (l == NULL)
+    {
+      GSL_ERROR_VAL ("failed to allocate struct", GSL_ENOMEM, 0);
+    }
+
+  l->n = n;
+  l->boundary = boundary;
+  l->scratch = (double *) malloc (n * LIFT_BLOCK * sizeof (double));
+
+  if (l->scratch == NULL)
+    {
+      free (l);
+      GSL_ERROR_VAL ("failed to allocate scratch space", GSL_ENOMEM, 0);
+    }
+
+  status = lift_factor (l, w);
+
+  if (status)
+    {
+      gsl_wavelet_lift_free (l);
+      GSL_ERROR_VAL ("failed to compute lifting steps", status, 0);
+    }
+
+  return l;
+}
+
+void
+gsl_wavelet_lift_free (gsl_wavelet_lift * l)
+{
+  size_t i;
+
+  RETURN_IF_NULL (l);
+
+  for (i = 0; i < l->nsteps; i++)
+    free (l->step[i].c);
+
+  free (l->scratch);
+  free (l);
+}
+
+/* Map an index of a channel of length n onto the channel. With
+ * symmetric extension of a signal x of length m about its first and
+ * last samples, the even samples s are reflected about s_0 and the odd
+ * samples d about d_{-1/2}. At the other end the channel holding the
+ * last sample (s for odd m, d for even m) is reflected about it, and
+ * the other channel about the point halfway past its last sample.
+ */
+static size_t
+lift_index (int i, size_t n, int whole_lo, int whole_hi, int periodic)
+{
+  const int nn = (int) n;
+
+  if (periodic)
+    {
+      i %= nn;
+      return (size_t) (i < 0 ? i + nn : i);
+    }
+
+  if (nn == 1)
+    return 0;
+
+  while (i < 0 || i >= nn)
+    {
+      if (i < 0)
+        i = whole_lo ? -i : -1 - i;
+      else
+        i = whole_hi ? 2 * (nn - 1) - i : 2 * nn - 1 - i;
+    }
+
+  return (size_t) i;
+}
+
+/* Apply the lifting step k with sign +1 or -1 to the nb vectors stored
+ * in x, where x[e * nb + v] is element e of vector v, with the ns
+ * approximation samples followed by the nd detail samples.
+ */
+static void
+lift_step (const gsl_wavelet_lift * l, size_t k, double sign, double *x,
+           size_t ns, size_t nd, size_t nb)
+{
+  const gsl_wavelet_lift_step *step = &(l->step[k]);
+  const int periodic = (l->boundary == gsl_wavelet_periodic);
+  const int modd = (ns > nd);
+  const int lo = step->lo;
+  const size_t len = step->len;
+  double *dst, *src;
+  size_t nt, nsrc, i, j, v;
+  int whole_lo, whole_hi;
+  int i0, i1;
+
+  if (step->update)
+    {
+      /* s += U d, d reflected about -1/2 and about nd - 1/2 (m odd)
+         or nd - 1 (m even) */
+      dst = x;
+      nt = ns;
+      src = x + ns * nb;
+      nsrc = nd;
+      whole_lo = 0;
+      whole_hi = !modd;
+    }
+  else
+    {
+      /* d += P s, s reflected about 0 and about ns - 1 (m odd) or
+         ns - 1/2 (m even) */
+      dst = x + ns * nb;
+      nt = nd;
+      src = x;
+      nsrc = ns;
+      whole_lo = 1;
+      whole_hi = modd;
+    }
+
+  if (nsrc == 0 || nt == 0)
+    return;
+
+  /* outputs i0 <= i < i1 need no boundary handling */
+  i0 = GSL_MAX (0, -lo);
+  i1 = GSL_MIN ((int) nt, (int) nsrc - lo - (int) len + 1);
+
+  if (i1 < i0)
+    i1 = i0 = (int) nt;
+
+  for (i = 0; i < nt; i++)
+    {
+      double *t = dst + i * nb;
+
+      if ((int) i == i0)
+        {
+          /* interior */
+          if (nb == 1)
+            {
+              for (; (int) i < i1; i++)
+                {
+                  const double *sp = src + (int) i + lo;
+                  double sum = 0.0;
+
+                  for (j = 0; j < len; j++)
+                    sum += step->c[j] * sp[j];
+
+                  dst[i] += sign * sum;
+                }
+            }
+          else
+            {
+              for (; (int) i < i1; i++)
+                {
+                  double *ti = dst + i * nb;
+                  const double *sp = src + ((int) i + lo) * (int) nb;
+
+                  for (j = 0; j < len; j++)
+                    {
+                      const double c = sign * step->c[j];
+                      const double *sj = sp + j * nb;
+
+                      for (v = 0; v < nb; v++)
+                        ti[v] += c * sj[v];
+                    }
+                }
+            }
+
+          if (i == nt)
+            break;
+
+          t = dst + i * nb;
+        }
+
+      for (j = 0; j < len; j++)
+        {
+          const size_t is = lift_index ((int) i + lo + (int) j, nsrc,
+                                        whole_lo, whole_hi, periodic);
+          const double c = sign * step->c[j];
+          const double *sj = src + is * nb;
+
+          for (v = 0; v < nb; v++)
+            t[v] += c * sj[v];
+        }
+    }
+}
+
+/* dst[i * dstep + v * dvstride] = scale * src[i * sstep + v * svstride]
+ * for i < n, v < nb
+ */
+static void
+lift_copy (double *dst, size_t dstep, size_t dvstride,
+           const double *src, size_t sstep, size_t svstride,
+           size_t n, size_t nb, double scale)
+{
+  size_t i, v;
+
+  if (nb == 1)
+    {
+      for (i = 0; i < n; i++)
+        dst[i * dstep] = scale * src[i * sstep];
+    }
+  else
+    {
+      for (i = 0; i < n; i++)
+        {
+          double *d = dst + i * dstep;
+          const double *s = src + i * sstep;
+
+          for (v = 0; v < nb; v++)
+            d[v * dvstride] = scale * s[v * svstride];
+        }
+    }
+}
+
+/* One level of the transform of nb vectors of length m, with element e
+ * of vector v at data[e * estride + v * vstride]. The forward
+ * transform replaces the samples by the approximation and detail
+ * coefficients, in that order, and the inverse transform undoes it.
+ * The lifting steps run on a copy of the even and odd samples in the
+ * scratch space, where element e of vector v is at x[e * nb + v].
+ */
+static void
+lift_level (const gsl_wavelet_lift * l, double *data, size_t estride,
+            size_t vstride, size_t m, size_t nb, gsl_wavelet_direction dir)
+{
+  const int periodic = (l->boundary == gsl_wavelet_periodic);
+  const size_t ns = (m + 1) / 2;
+  const size_t nd = m / 2;
+  const size_t rot = (periodic && l->odd) ? 1 : 0;
+  const size_t es = 2 * estride;
+  double *x = l->scratch;
+  double *xd = x + ns * nb;
+  double *ds = data;
+  double *dd = data + ns * estride;
+  size_t shs = 0, shd = 0, k;
+
+  /* in periodic transforms the channels are rotated by the shifts of
+     the factorization, and the samples by one if the steps start from
+     the odd samples */
+  if (periodic)
+    {
+      shs = lift_index (l->shift[0], ns, 0, 0, 1);
+      shd = lift_index (l->shift[1], nd, 0, 0, 1);
+    }
+
+  if (dir == gsl_wavelet_forward)
+    {
+      lift_copy (x, nb, 1, data + rot * estride, es, vstride, ns, nb, 1.0);
+      lift_copy (xd, nb, 1, data + (1 + rot) * estride, es, vstride,
+                 nd - rot, nb, 1.0);
+      if (rot)
+        lift_copy (xd + (nd - 1) * nb, nb, 1, data, es, vstride, 1, nb, 1.0);
+
+      for (k = 0; k < l->nsteps; k++)
+        lift_step (l, k, 1.0, x, ns, nd, nb);
+
+      lift_copy (ds, estride, vstride, x + shs * nb, nb, 1, ns - shs, nb,
+                 l->scale[0]);
+      lift_copy (ds + (ns - shs) * estride, estride, vstride, x, nb, 1,
+                 shs, nb, l->scale[0]);
+      lift_copy (dd, estride, vstride, xd + shd * nb, nb, 1, nd - shd, nb,
+                 l->scale[1]);
+      lift_copy (dd + (nd - shd) * estride, estride, vstride, xd, nb, 1,
+                 shd, nb, l->scale[1]);
+    }
+  else
+    {
+      lift_copy (x + shs * nb, nb, 1, ds, estride, vstride, ns - shs, nb,
+                 1.0 / l->scale[0]);
+      lift_copy (x, nb, 1, ds + (ns - shs) * estride, estride, vstride,
+                 shs, nb, 1.0 / l->scale[0]);
+      lift_copy (xd + shd * nb, nb, 1, dd, estride, vstride, nd - shd, nb,
+                 1.0 / l->scale[1]);
+      lift_copy (xd, nb, 1, dd + (nd - shd) * estride, estride, vstride,
+                 shd, nb, 1.0 / l->scale[1]);
+
+      for (k = l->nsteps; k-- > 0;)
+        lift_step (l, k, -1.0, x, ns, nd, nb);
+
+      lift_copy (data + rot * estride, es, vstride, x, nb, 1, ns, nb, 1.0);
+      lift_copy (data + (1 + rot) * estride, es, vstride, xd, nb, 1,
+                 nd - rot, nb, 1.0);
+      if (rot)
+        lift_copy (data, es, vstride, xd + (nd - 1) * nb, nb, 1, 1, nb, 1.0);
+    }
+}
+
+static int
+lift_check (const gsl_wavelet_lift * l, size_t n)
+{
+  if (n > l->n)
+    {
+      GSL_ERROR ("length n exceeds the size of the lifting workspace",
+                 GSL_EINVAL);
+    }
+
+  if (l->boundary == gsl_wavelet_periodic && (n & (n - 1)) != 0)
+    {
+      GSL_ERROR ("n is not a power of 2", GSL_EINVAL);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* number of levels of the transform of length n, down to length 1 */
+static size_t
+lift_levels (size_t n)
+{
+  size_t levels = 0;
+
+  while (n >= 2)
+    {
+      n = (n + 1) / 2;
+      levels++;
+    }
+
+  return levels;
+}
+
+/* full multilevel transforms of nb vectors of length n */
+static void
+lift_transform (const gsl_wavelet_lift * l, double *data, size_t estride,
+                size_t vstride, size_t n, size_t nb,
+                gsl_wavelet_direction dir)
+{
+  const size_t levels = lift_levels (n);
+  size_t k;
+
+  if (dir == gsl_wavelet_forward)
+    {
+      for (k = 0; k < levels; k++)
+        lift_level (l, data, estride, vstride, (n + ((size_t) 1 << k) - 1) >> k, nb, dir);
+    }
+  else
+    {
+      for (k = levels; k-- > 0;)
+        lift_level (l, data, estride, vstride, (n + ((size_t) 1 << k) - 1) >> k, nb, dir);
+    }
+}
+
+int
+gsl_wavelet_lift_transform (gsl_wavelet_lift * l,
+                            double *data, size_t stride, size_t n,
+                            gsl_wavelet_direction dir)
+{
+  int status = lift_check (l, n);
+
+  if (status)
+    return status;
+
+  lift_transform (l, data, stride, 0, n, 1, dir);
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_wavelet_lift_transform_forward (gsl_wavelet_lift * l,
+                                    double *data, size_t stride, size_t n)
+{
+  return gsl_wavelet_lift_transform (l, data, stride, n, gsl_wavelet_forward);
+}
+
+int
+gsl_wavelet_lift_transform_inverse (gsl_wavelet_lift * l,
+                                    double *data, size_t stride, size_t n)
+{
+  return gsl_wavelet_lift_transform (l, data, stride, n, gsl_wavelet_backward);
+}
+
+/* Transform the rows (or columns) of a matrix, LIFT_BLOCK at a time.
+ * For the columns the block is gathered from contiguous elements of
+ * each row, and the lifting steps then run over the block in the
+ * innermost loop.
+ */
+static void
+lift_rows (const gsl_wavelet_lift * l, double *data, size_t tda,
+           size_t nrows, size_t ncols, size_t levels, int columns,
+           gsl_wavelet_direction dir)
+{
+  const size_t estride = columns ? tda : 1;
+  const size_t vstride = columns ? 1 : tda;
+  const size_t nvec = columns ? ncols : nrows;
+  const size_t n = columns ? nrows : ncols;
+  size_t i;
+
+  for (i = 0; i < nvec; i += LIFT_BLOCK)
+    {
+      const size_t nb = GSL_MIN (LIFT_BLOCK, nvec - i);
+      double *block = data + i * vstride;
+
+      if (levels == 0)
+        {
+          lift_transform (l, block, estride, vstride, n, nb, dir);
+        }
+      else
+        {
+          lift_level (l, block, estride, vstride, n, nb, dir);
+        }
+    }
+}
+
+int
+gsl_wavelet2d_lift_transform (gsl_wavelet_lift * l,
+                              double *data, size_t tda, size_t size1,
+                              size_t size2, gsl_wavelet_direction dir)
+{
+  int status;
+
+  if (tda < size2)
+    {
+      GSL_ERROR ("tda must be at least size2", GSL_EINVAL);
+    }
+
+  status = lift_check (l, GSL_MAX (size1, size2));
+
+  if (status)
+    return status;
+
+  if (dir == gsl_wavelet_forward)
+    {
+      lift_rows (l, data, tda, size1, size2, 0, 0, dir);
+      lift_rows (l, data, tda, size1, size2, 0, 1, dir);
+    }
+  else
+    {
+      lift_rows (l, data, tda, size1, size2, 0, 1, dir);
+      lift_rows (l, data, tda, size1, size2, 0, 0, dir);
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_wavelet2d_lift_nstransform (gsl_wavelet_lift * l,
+                                double *data, size_t tda, size_t size1,
+                                size_t size2, gsl_wavelet_direction dir)
+{
+  const size_t levels = GSL_MAX (lift_levels (size1), lift_levels (size2));
+  size_t k;
+  int status;
+
+  if (tda < size2)
+    {
+      GSL_ERROR ("tda must be at least size2", GSL_EINVAL);
+    }
+
+  status = lift_check (l, GSL_MAX (size1, size2));
+
+  if (status)
+    return status;
+
+  /* at level k, transform the first m1 rows and m2 columns of the
+     approximation of the previous level; once one dimension is down
+     to a single sample only the other one is transformed further */
+  for (k = 0; k < levels; k++)
+    {
+      const size_t kk = (dir == gsl_wavelet_forward) ? k : levels - 1 - k;
+      const size_t m1 = (size1 + ((size_t) 1 << kk) - 1) >> kk;
+      const size_t m2 = (size2 + ((size_t) 1 << kk) - 1) >> kk;
+
+      if (dir == gsl_wavelet_forward)
+        {
+          if (m2 >= 2)
+            lift_rows (l, data, tda, m1, m2, 1, 0, dir);
+          if (m1 >= 2)
+            lift_rows (l, data, tda, m1, m2, 1, 1, dir);
+        }
+      else
+        {
+          if (m1 >= 2)
+            lift_rows (l, data, tda, m1, m2, 1, 1, dir);
+          if (m2 >= 2)
+            lift_rows (l, data, tda, m1, m2, 1, 0, dir);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
@@ -0,0 +1,374 @@
+/* wavelet/stream.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Streaming wavelet transforms.
+ *
+ * The signal x_t, t >= 0, is taken to be zero for t < 0, and each level
+ * j = 1..J of the transform computes
+ *
+ *   s_j[i] = sum_k h1[k] s_{j-1}[2i + k - offset]
+ *   d_j[i] = sum_k g1[k] s_{j-1}[2i + k - offset]
+ *
+ * from s_0 = x, with the same filters as the periodic transform in
+ * dwt.c. A coefficient is final once the last sample in its support
+ * has arrived, so each level only keeps the last nc samples of its
+ * input. Since the input of each level starts at some index, the
+ * coefficients of level j start at a (possibly negative) index
+ * first[j], and there are slightly more coefficients than samples.
+ *
+ * The inverse transform receives the coefficients in the order they
+ * are produced by the forward transform, from which it can tell the
+ * level of each coefficient. It reconstructs
+ *
+ *   s_{j-1}[t] = sum_i h2[t - 2i + offset] s_j[i] + g2[t - 2i + offset] d_j[i]
+ *
+ * as soon as the coefficient pair i = floor((t + offset)/2) of level j
+ * is complete. The detail coefficients of the finer levels are
+ * produced long before the approximation coefficients they combine
+ * with, so the inverse transform queues them, which takes about
+ * 2^J nc values in total.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_wavelet.h>
+
+/* index of the output coefficient computed when the input sample t
+   arrives at a level is (t - lag)/2 */
+#define LAG(s) ((long) ((s)->nc - 1) - (long) (s)->offset)
+
+/* ceil(a/2) for any sign of a */
+static long
+half_ceil (long a)
+{
+  return (a >= 0) ? (a + 1) / 2 : -((-a) / 2);
+}
+
+gsl_wavelet_stream *
+gsl_wavelet_stream_alloc (const gsl_wavelet * w, size_t levels,
+                          gsl_wavelet_direction dir)
+{
+  gsl_wavelet_stream *s;
+  size_t j;
+
+  if (levels == 0)
+    {
+      GSL_ERROR_VAL ("number of levels must be positive", GSL_EDOM, 0);
+    }
+
+  if (levels >= 8 * sizeof (long) - 2)
+    {
+      GSL_ERROR_VAL ("too many levels", GSL_EDOM, 0);
+    }
+
+  s = (gsl_wavelet_stream *) calloc (1, sizeof (gsl_wavelet_stream));
+
+  if (s == NULL)
+    {
+      GSL_ERROR_VAL ("failed to allocate struct", GSL_ENOMEM, 0);
+    }
+
+  s->h1 = w->h1;
+  s->g1 = w->g1;
+  s->h2 = w->h2;
+  s->g2 = w->g2;
+  s->nc = w->nc;
+  s->offset = w->offset;
+  s->levels = levels;
+  s->dir = dir;
+
+  s->level = (gsl_wavelet_stream_level *)
+    calloc (levels + 1, sizeof (gsl_wavelet_stream_level));
+
+  if (s->level == NULL)
+    {
+      free (s);
+      GSL_ERROR_VAL ("failed to allocate levels", GSL_ENOMEM, 0);
+    }
+
+  /* level[j] holds the state of level j = 1..J, and level[0].first = 0
+     the index of the first sample */
+  for (j = 1; j <= levels; j++)
+    {
+      gsl_wavelet_stream_level *L = &(s->level[j]);
+
+      L->first = half_ceil (s->level[j - 1].first - LAG (s));
+
+      if (dir == gsl_wavelet_forward)
+        {
+          L->hist = (double *) malloc (s->nc * sizeof (double));
+        }
+      else
+        {
+          /* the pair i contributes to s_{j-1}[t] for t < 2i + nc -
+             offset, so nc/2 + 1 pairs are needed at a time; the
+             details of level j wait at most (2^(J-j) - 1)(nc - 1)
+             input samples of level j for their approximation */
+          L->hist = (double *) malloc ((s->nc + 2) * sizeof (double));
+          L->qcap = (((size_t) 1 << (levels - j)) - 1) * (s->nc - 1) + 4;
+          L->queue = (double *) malloc (L->qcap * sizeof (double));
+
+          if (L->queue == NULL)
+            {
+              gsl_wavelet_stream_free (s);
+              GSL_ERROR_VAL ("failed to allocate queue", GSL_ENOMEM, 0);
+            }
+        }
+
+      if (L->hist == NULL)
+        {
+          gsl_wavelet_stream_free (s);
+          GSL_ERROR_VAL ("failed to allocate history", GSL_ENOMEM, 0);
+        }
+    }
+
+  gsl_wavelet_stream_reset (s);
+
+  return s;
+}
+
+void
+gsl_wavelet_stream_free (gsl_wavelet_stream * s)
+{
+  size_t j;
+
+  RETURN_IF_NULL (s);
+
+  for (j = 1; j <= s->levels; j++)
+    {
+      free (s->level[j].hist);
+      free (s->level[j].queue);
+    }
+
+  free (s->level);
+  free (s);
+}
+
+void
+gsl_wavelet_stream_reset (gsl_wavelet_stream * s)
+{
+  size_t j;
+
+  for (j = 1; j <= s->levels; j++)
+    {
+      gsl_wavelet_stream_level *L = &(s->level[j]);
+
+      L->count = 0;
+      L->sched = 0;
+      L->qhead = 0;
+      L->qlen = 0;
+    }
+
+  s->chain = 1;
+}
+
+/* push the sample v of s_{j-1} into level j of the forward transform */
+static void
+stream_push (gsl_wavelet_stream * s, size_t j, double v,
+             double *c, size_t * level, size_t * nout)
+{
+  gsl_wavelet_stream_level *L = &(s->level[j]);
+  const size_t nc = s->nc;
+  const long first = s->level[j - 1].first;
+  const long t = first + (long) L->count;
+
+  L->hist[L->count % nc] = v;
+  L->count++;
+
+  if ((t - LAG (s)) % 2 == 0)
+    {
+      /* the inputs t - nc + 1 .. t are available, those before the
+         first input are zero */
+      double a = 0.0, d = 0.0;
+      size_t k;
+
+      for (k = 0; k < nc; k++)
+        {
+          const long tk = t - (long) (nc - 1 - k);
+
+          if (tk >= first)
+            {
+              const double x = L->hist[(size_t) (tk - first) % nc];
+              a += s->h1[k] * x;
+              d += s->g1[k] * x;
+            }
+        }
+
+      c[*nout] = d;
+      if (level)
+        level[*nout] = j;
+      (*nout)++;
+
+      if (j == s->levels)
+        {
+          c[*nout] = a;
+          if (level)
+            level[*nout] = 0;
+          (*nout)++;
+        }
+      else
+        {
+          stream_push (s, j + 1, a, c, level, nout);
+        }
+    }
+}
+
+int
+gsl_wavelet_stream_forward (gsl_wavelet_stream * s, const double *x,
+                            size_t n, double *c, size_t * level,
+                            size_t * nout)
+{
+  size_t i;
+
+  if (s->dir != gsl_wavelet_forward)
+    {
+      GSL_ERROR ("stream is allocated for the inverse transform", GSL_EINVAL);
+    }
+
+  *nout = 0;
+
+  for (i = 0; i < n; i++)
+    stream_push (s, 1, x[i], c, level, nout);
+
+  return GSL_SUCCESS;
+}
+
+/* The approximation coefficient v = s_j[i] has been reconstructed (or
+ * received for j = J); combine it with the queued detail coefficient
+ * d_j[i] and reconstruct the samples of s_{j-1} which are now final.
+ */
+static int
+stream_pull (gsl_wavelet_stream * s, size_t j, double v,
+             double *x, size_t * nx)
+{
+  gsl_wavelet_stream_level *L = &(s->level[j]);
+  const size_t nc = s->nc;
+  const size_t npair = nc / 2 + 1;
+  const long off = (long) s->offset;
+  const long first = s->level[j - 1].first;
+  long i, t;
+  double d;
+
+  if (L->qlen == 0)
+    {
+      GSL_ERROR ("missing detail coefficient", GSL_ESANITY);
+    }
+
+  d = L->queue[L->qhead];
+  L->qhead = (L->qhead + 1) % L->qcap;
+  L->qlen--;
+
+  L->hist[2 * (L->count % npair)] = v;
+  L->hist[2 * (L->count % npair) + 1] = d;
+  i = L->first + (long) L->count;
+  L->count++;
+
+  for (t = 2 * i - off; t <= 2 * i + 1 - off; t++)
+    {
+      double a = 0.0;
+      long ip;
+
+      if (t < first)
+        continue;
+
+      /* pairs ip <= i with 0 <= t - 2 ip + off < nc */
+      for (ip = i; ip >= L->first && t - 2 * ip + off < (long) nc; ip--)
+        {
+          const size_t k = (size_t) (t - 2 * ip + off);
+          const size_t p = (size_t) (ip - L->first) % npair;
+
+          a += s->h2[k] * L->hist[2 * p] + s->g2[k] * L->hist[2 * p + 1];
+        }
+
+      if (j == 1)
+        {
+          x[(*nx)++] = a;
+        }
+      else
+        {
+          int status = stream_pull (s, j - 1, a, x, nx);
+
+          if (status)
+            return status;
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_wavelet_stream_inverse (gsl_wavelet_stream * s, const double *c,
+                            size_t n, double *x, size_t * nx)
+{
+  const size_t J = s->levels;
+  size_t i;
+
+  if (s->dir != gsl_wavelet_backward)
+    {
+      GSL_ERROR ("stream is allocated for the forward transform", GSL_EINVAL);
+    }
+
+  *nx = 0;
+
+  for (i = 0; i < n; i++)
+    {
+      const size_t j = s->chain;
+
+      if (j == 0)
+        {
+          /* approximation coefficient of the last level */
+          int status = stream_pull (s, J, c[i], x, nx);
+
+          if (status)
+            return status;
+
+          s->chain = 1;
+        }
+      else
+        {
+          /* detail coefficient of level j; follow the forward transform
+             to find the level of the next coefficient */
+          gsl_wavelet_stream_level *L = &(s->level[j]);
+
+          if (L->qlen == L->qcap)
+            {
+              GSL_ERROR ("detail coefficient queue overflow", GSL_ESANITY);
+            }
+
+          L->queue[(L->qhead + L->qlen) % L->qcap] = c[i];
+          L->qlen++;
+
+          if (j == J)
+            {
+              s->chain = 0;
+            }
+          else
+            {
+              gsl_wavelet_stream_level *L1 = &(s->level[j + 1]);
+              const long t = L->first + (long) L1->sched;
+
+              L1->sched++;
+              s->chain = ((t - LAG (s)) % 2 == 0) ? j + 1 : 1;
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
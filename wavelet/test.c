@@ -3,6 +3,7 @@
 #include <math.h>
 
 #include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_test.h>
@@ -31,6 +32,17 @@ test_1d (size_t N, size_t stride, const gsl_wavelet_type * T, size_t member);
 void
 test_2d (size_t N, size_t tda, const gsl_wavelet_type * T, size_t member, int type);
 
+void
+test_lift_1d (size_t N, size_t stride, const gsl_wavelet_type * T, size_t member);
+
+void
+test_lift_2d (size_t N1, size_t N2, size_t tda, const gsl_wavelet_type * T,
+              size_t member, int type);
+
+void
+test_stream (size_t levels, size_t block, const gsl_wavelet_type * T,
+             size_t member);
+
 int
 main (int argc, char **argv)
 {
@@ -92,6 +104,95 @@ main (int argc, char **argv)
         }
     }
 
+  /* Lifting transforms, of arbitrary lengths with symmetric extension
+     and of powers of 2 with periodic boundaries */
+
+  for (N = 1; N <= 4100; N = (N < 40) ? N + 1 : 3 * N + 1)
+    {
+      for (stride = 1; stride <= 3; stride += 2)
+        {
+          for (i = 0; i < N_BS; i++)
+            {
+              test_lift_1d (N, stride, gsl_wavelet_bspline, member[i]);
+              test_lift_1d (N, stride, gsl_wavelet_bspline_centered, member[i]);
+            }
+
+          for (i = 4; i <= 20; i += 2)
+            {
+              test_lift_1d (N, stride, gsl_wavelet_daubechies, i);
+              test_lift_1d (N, stride, gsl_wavelet_daubechies_centered, i);
+            }
+
+          test_lift_1d (N, stride, gsl_wavelet_haar, 2);
+          test_lift_1d (N, stride, gsl_wavelet_haar_centered, 2);
+        }
+    }
+
+  for (N = 1; N <= 64; N = (N < 8) ? N + 1 : 2 * N + 1)
+    {
+      const size_t N2[3] = { 1, 16, 37 };
+      size_t j;
+
+      for (j = 0; j < 3; j++)
+        {
+          for (tda = N2[j]; tda <= N2[j] + 3; tda += 3)
+            {
+              for (i = 0; i < N_BS; i++)
+                {
+                  test_lift_2d (N, N2[j], tda, gsl_wavelet_bspline, member[i], S);
+                  test_lift_2d (N, N2[j], tda, gsl_wavelet_bspline, member[i], NS);
+                }
+
+              for (i = 4; i <= 20; i += 4)
+                {
+                  test_lift_2d (N, N2[j], tda, gsl_wavelet_daubechies, i, S);
+                  test_lift_2d (N, N2[j], tda, gsl_wavelet_daubechies_centered, i, NS);
+                }
+
+              test_lift_2d (N, N2[j], tda, gsl_wavelet_haar, 2, S);
+              test_lift_2d (N, N2[j], tda, gsl_wavelet_haar, 2, NS);
+            }
+        }
+    }
+
+  for (N = 1; N <= 64; N *= 2)
+    {
+      for (i = 4; i <= 20; i += 8)
+        {
+          test_lift_2d (N, N, N + 1, gsl_wavelet_daubechies, i, S);
+          test_lift_2d (N, N, N + 1, gsl_wavelet_daubechies_centered, i, NS);
+          test_lift_2d (N, N, N + 1, gsl_wavelet_bspline, 309, S);
+          test_lift_2d (N, N, N + 1, gsl_wavelet_bspline_centered, 309, NS);
+        }
+    }
+
+  /* Streaming transforms, with blocks of random lengths up to 1, 7
+     and 1000 samples or coefficients */
+
+  for (N = 1; N <= 6; N++)
+    {
+      const size_t block[3] = { 1, 7, 1000 };
+      size_t j;
+
+      for (j = 0; j < 3; j++)
+        {
+          for (i = 0; i < N_BS; i += 2)
+            {
+              test_stream (N, block[j], gsl_wavelet_bspline, member[i]);
+              test_stream (N, block[j], gsl_wavelet_bspline_centered, member[i]);
+            }
+
+          for (i = 4; i <= 20; i += 4)
+            {
+              test_stream (N, block[j], gsl_wavelet_daubechies, i);
+              test_stream (N, block[j], gsl_wavelet_daubechies_centered, i);
+            }
+
+          test_stream (N, block[j], gsl_wavelet_haar, 2);
+          test_stream (N, block[j], gsl_wavelet_haar_centered, 2);
+        }
+    }
+
   exit (gsl_test_summary ());
 }
 
@@ -268,3 +369,294 @@ test_2d (size_t N, size_t tda, const gsl_wavelet_type * T, size_t member, int ty
   gsl_matrix_free (m2);
   gsl_matrix_free (mdelta);
 }
+
+
+/* Test the lifting transform of length N against its inverse, and for
+   powers of 2 the periodic lifting transform against the filter bank
+   transform, which compute the same coefficients */
+
+void
+test_lift_1d (size_t N, size_t stride, const gsl_wavelet_type * T, size_t member)
+{
+  gsl_wavelet *w = gsl_wavelet_alloc (T, member);
+  gsl_wavelet_lift *l = gsl_wavelet_lift_alloc (w, N, gsl_wavelet_symmetric);
+  double *data = (double *) malloc (N * stride * sizeof (double));
+  double *v1 = (double *) malloc (N * sizeof (double));
+  double maxerr = 0.0;
+  int status = 0;
+  size_t i;
+
+  for (i = 0; i < N * stride; i++)
+    data[i] = 12345.0 + i;
+
+  for (i = 0; i < N; i++)
+    {
+      v1[i] = urand ();
+      data[i * stride] = v1[i];
+    }
+
+  gsl_wavelet_lift_transform_forward (l, data, stride, N);
+  gsl_wavelet_lift_transform_inverse (l, data, stride, N);
+
+  for (i = 0; i < N; i++)
+    maxerr = GSL_MAX (maxerr, fabs (data[i * stride] - v1[i]));
+
+  gsl_test (maxerr > N * 1e-15,
+            "%s(%d) lifting, n = %d, stride = %d, maxerr = %g",
+            gsl_wavelet_name (w), member, N, stride, maxerr);
+
+  for (i = 0; i < N * stride; i++)
+    {
+      if (i % stride != 0)
+        status |= (data[i] != (12345.0 + i));
+    }
+
+  gsl_test (status, "%s(%d) lifting other data untouched, n = %d, stride = %d",
+            gsl_wavelet_name (w), member, N, stride);
+
+  gsl_wavelet_lift_free (l);
+
+  if ((N & (N - 1)) == 0)
+    {
+      gsl_wavelet_workspace *work = gsl_wavelet_workspace_alloc (N);
+
+      l = gsl_wavelet_lift_alloc (w, N, gsl_wavelet_periodic);
+
+      for (i = 0; i < N; i++)
+        data[i * stride] = v1[i];
+
+      gsl_wavelet_transform_forward (w, v1, 1, N, work);
+      gsl_wavelet_lift_transform_forward (l, data, stride, N);
+
+      maxerr = 0.0;
+
+      for (i = 0; i < N; i++)
+        maxerr = GSL_MAX (maxerr, fabs (data[i * stride] - v1[i]));
+
+      gsl_test (maxerr > N * 1e-14,
+                "%s(%d) periodic lifting against dwt, n = %d, stride = %d, maxerr = %g",
+                gsl_wavelet_name (w), member, N, stride, maxerr);
+
+      gsl_wavelet_lift_free (l);
+      gsl_wavelet_workspace_free (work);
+    }
+
+  gsl_wavelet_free (w);
+  free (v1);
+  free (data);
+}
+
+
+void
+test_lift_2d (size_t N1, size_t N2, size_t tda, const gsl_wavelet_type * T,
+              size_t member, int type)
+{
+  gsl_wavelet *w = gsl_wavelet_alloc (T, member);
+  const size_t n = GSL_MAX (N1, N2);
+  gsl_wavelet_lift *l = gsl_wavelet_lift_alloc (w, n, gsl_wavelet_symmetric);
+  double *data = (double *) malloc (N1 * tda * sizeof (double));
+  double *m1 = (double *) malloc (N1 * N2 * sizeof (double));
+  const char *name = (type == 1) ? "standard" : "nonstd";
+  double maxerr = 0.0;
+  int status = 0;
+  size_t i, j;
+
+  for (i = 0; i < N1 * tda; i++)
+    data[i] = 12345.0 + i;
+
+  for (i = 0; i < N1; i++)
+    {
+      for (j = 0; j < N2; j++)
+        {
+          m1[i * N2 + j] = urand ();
+          data[i * tda + j] = m1[i * N2 + j];
+        }
+    }
+
+  if (type == 1)
+    {
+      gsl_wavelet2d_lift_transform (l, data, tda, N1, N2, gsl_wavelet_forward);
+      gsl_wavelet2d_lift_transform (l, data, tda, N1, N2, gsl_wavelet_backward);
+    }
+  else
+    {
+      gsl_wavelet2d_lift_nstransform (l, data, tda, N1, N2, gsl_wavelet_forward);
+      gsl_wavelet2d_lift_nstransform (l, data, tda, N1, N2, gsl_wavelet_backward);
+    }
+
+  for (i = 0; i < N1; i++)
+    {
+      for (j = 0; j < N2; j++)
+        maxerr = GSL_MAX (maxerr, fabs (data[i * tda + j] - m1[i * N2 + j]));
+    }
+
+  gsl_test (maxerr > n * 1e-15,
+            "%s(%d)-2d %s lifting, n1 = %d, n2 = %d, tda = %d, maxerr = %g",
+            gsl_wavelet_name (w), member, name, N1, N2, tda, maxerr);
+
+  for (i = 0; i < N1; i++)
+    {
+      for (j = N2; j < tda; j++)
+        status |= (data[i * tda + j] != (12345.0 + (i * tda + j)));
+    }
+
+  gsl_test (status, "%s(%d)-2d %s lifting other data untouched, n1 = %d, n2 = %d, tda = %d",
+            gsl_wavelet_name (w), member, name, N1, N2, tda);
+
+  gsl_wavelet_lift_free (l);
+
+  if (N1 == N2 && (N1 & (N1 - 1)) == 0)
+    {
+      gsl_wavelet_workspace *work = gsl_wavelet_workspace_alloc (N1);
+
+      l = gsl_wavelet_lift_alloc (w, N1, gsl_wavelet_periodic);
+
+      for (i = 0; i < N1; i++)
+        {
+          for (j = 0; j < N2; j++)
+            data[i * tda + j] = m1[i * N2 + j];
+        }
+
+      if (type == 1)
+        {
+          gsl_wavelet2d_transform_forward (w, m1, N2, N1, N2, work);
+          gsl_wavelet2d_lift_transform (l, data, tda, N1, N2, gsl_wavelet_forward);
+        }
+      else
+        {
+          gsl_wavelet2d_nstransform_forward (w, m1, N2, N1, N2, work);
+          gsl_wavelet2d_lift_nstransform (l, data, tda, N1, N2, gsl_wavelet_forward);
+        }
+
+      maxerr = 0.0;
+
+      for (i = 0; i < N1; i++)
+        {
+          for (j = 0; j < N2; j++)
+            maxerr = GSL_MAX (maxerr, fabs (data[i * tda + j] - m1[i * N2 + j]));
+        }
+
+      gsl_test (maxerr > N1 * 1e-14,
+                "%s(%d)-2d %s periodic lifting against dwt, n = %d, tda = %d, maxerr = %g",
+                gsl_wavelet_name (w), member, name, N1, tda, maxerr);
+
+      gsl_wavelet_lift_free (l);
+      gsl_wavelet_workspace_free (work);
+    }
+
+  gsl_wavelet_free (w);
+  free (m1);
+  free (data);
+}
+
+
+/* Stream a periodic signal through the forward transform and check
+   that, once the filters only see the signal, the detail coefficients
+   match the periodic transform of one period. Then stream the
+   coefficients through the inverse transform and check that it
+   reconstructs the signal. */
+
+void
+test_stream (size_t levels, size_t block, const gsl_wavelet_type * T,
+             size_t member)
+{
+  gsl_wavelet *w = gsl_wavelet_alloc (T, member);
+  gsl_wavelet_stream *fwd = gsl_wavelet_stream_alloc (w, levels, gsl_wavelet_forward);
+  gsl_wavelet_stream *inv = gsl_wavelet_stream_alloc (w, levels, gsl_wavelet_backward);
+  const size_t P = (size_t) 8 << levels;
+  const size_t N = 4 * P + ((size_t) 4 << levels) * w->nc;
+  gsl_wavelet_workspace *work = gsl_wavelet_workspace_alloc (P);
+  double *period = (double *) malloc (P * sizeof (double));
+  double *x = (double *) malloc (N * sizeof (double));
+  const size_t M = N + levels * w->nc + 1;  /* bound on the number of coefficients */
+  double *c = (double *) malloc (M * sizeof (double));
+  size_t *level = (size_t *) malloc (M * sizeof (size_t));
+  double *y = (double *) malloc ((M + ((size_t) 1 << levels)) * sizeof (double));
+  size_t count[32] = { 0 };
+  long valid[32];
+  size_t i, j, n, nc = 0, ny = 0, bad = 0;
+  double maxerr = 0.0;
+  int status = 0;
+
+  for (i = 0; i < P; i++)
+    period[i] = urand ();
+
+  for (i = 0; i < N; i++)
+    x[i] = period[i % P];
+
+  gsl_wavelet_transform_forward (w, period, 1, P, work);
+
+  /* coefficient i of level j only depends on the signal for i >= valid[j] */
+  valid[0] = 0;
+  for (j = 1; j <= levels; j++)
+    valid[j] = (valid[j - 1] + (long) w->offset + 1) / 2;
+
+  for (i = 0; i < N; i += n)
+    {
+      size_t nout;
+
+      n = 1 + (size_t) (urand () * block);
+      n = GSL_MIN (N - i, n);
+      status |= gsl_wavelet_stream_forward (fwd, x + i, n, c + nc, level + nc, &nout);
+      bad |= (nout > n + levels + 1);
+
+      for (j = nc; j < nc + nout; j++)
+        {
+          const size_t lev = level[j];
+
+          if (lev > 0)
+            {
+              const long ii = fwd->level[lev].first + (long) count[lev];
+              const size_t len = P >> lev;
+
+              if (ii >= valid[lev])
+                maxerr = GSL_MAX (maxerr, fabs (c[j] - period[len + ii % len]));
+
+              count[lev]++;
+            }
+        }
+
+      nc += nout;
+    }
+
+  gsl_test (status || bad, "%s(%d) stream forward, levels = %d, block = %d",
+            gsl_wavelet_name (w), member, levels, block);
+
+  gsl_test (maxerr > P * 1e-14,
+            "%s(%d) stream forward against dwt, levels = %d, block = %d, maxerr = %g",
+            gsl_wavelet_name (w), member, levels, block, maxerr);
+
+  for (i = 0; i < nc; i += n)
+    {
+      size_t nout;
+
+      n = 1 + (size_t) (urand () * block);
+      n = GSL_MIN (nc - i, n);
+      status |= gsl_wavelet_stream_inverse (inv, c + i, n, y + ny, &nout);
+      bad |= (nout > n + levels + 1 + ((size_t) 1 << levels));
+      ny += nout;
+    }
+
+  maxerr = 0.0;
+
+  for (i = 0; i < ny; i++)
+    maxerr = GSL_MAX (maxerr, fabs (y[i] - x[i]));
+
+  gsl_test (status || bad || ny > N || ny + ((size_t) 2 << levels) * w->nc < N,
+            "%s(%d) stream inverse, levels = %d, block = %d, n = %d",
+            gsl_wavelet_name (w), member, levels, block, ny);
+
+  gsl_test (maxerr > levels * 1e-14,
+            "%s(%d) stream round trip, levels = %d, block = %d, maxerr = %g",
+            gsl_wavelet_name (w), member, levels, block, maxerr);
+
+  gsl_wavelet_stream_free (inv);
+  gsl_wavelet_stream_free (fwd);
+  gsl_wavelet_workspace_free (work);
+  gsl_wavelet_free (w);
+  free (y);
+  free (level);
+  free (c);
+  free (x);
+  free (period);
+}